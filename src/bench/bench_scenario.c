@@ -0,0 +1,170 @@
+#include "bench/bench_scenario.h"
+#include "modules/core/logger.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const struct { const char* name; button_t button; } k_buttons[] = {
+    { "left",     BTN_LEFT },
+    { "right",    BTN_RIGHT },
+    { "up",       BTN_UP },
+    { "down",     BTN_DOWN },
+    { "interact", BTN_INTERACT },
+    { "lift",     BTN_LIFT },
+    { "mouse_l",  BTN_MOUSE_L },
+    { "mouse_r",  BTN_MOUSE_R },
+};
+
+static bool button_from_name(const char* name, button_t* out)
+{
+    for (size_t i = 0; i < sizeof(k_buttons) / sizeof(k_buttons[0]); ++i) {
+        if (strcmp(k_buttons[i].name, name) == 0) {
+            *out = k_buttons[i].button;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool push_input(bench_scenario_t* sc, bench_input_event_t ev)
+{
+    if (sc->input_count >= BENCH_MAX_INPUTS) return false;
+    sc->inputs[sc->input_count++] = ev;
+    return true;
+}
+
+static bool parse_line(bench_scenario_t* sc, const char* line)
+{
+    char key[16];
+    char word[BENCH_PATH_MAX];
+    int a = 0, b = 0, n = 0;
+    float x = 0.0f, y = 0.0f;
+
+    if (sscanf(line, "%15s", key) != 1) return true; // blank
+
+    if (strcmp(key, "map") == 0) {
+        return sscanf(line, "%*s %255s", sc->map) == 1;
+    }
+    if (strcmp(key, "ticks") == 0) {
+        return sscanf(line, "%*s %d", &sc->ticks) == 1 && sc->ticks > 0;
+    }
+    if (strcmp(key, "warmup") == 0) {
+        return sscanf(line, "%*s %d", &sc->warmup) == 1 && sc->warmup >= 0;
+    }
+    if (strcmp(key, "seed") == 0) {
+        unsigned seed = 0;
+        if (sscanf(line, "%*s %u", &seed) != 1) return false;
+        sc->seed = (uint32_t)seed;
+        return true;
+    }
+    if (strcmp(key, "spawn") == 0) {
+        if (sc->spawn_count >= BENCH_MAX_SPAWNS) return false;
+        bench_spawn_t* s = &sc->spawns[sc->spawn_count];
+        if (sscanf(line, "%*s %255s %d", s->prefab, &n) != 2 || n < 0) return false;
+        s->count = n;
+        sc->spawn_count++;
+        return true;
+    }
+    if (strcmp(key, "hold") == 0) {
+        button_t btn;
+        if (sscanf(line, "%*s %d %d %255s", &a, &b, word) != 3 || b < a) return false;
+        if (!button_from_name(word, &btn)) return false;
+        return push_input(sc, (bench_input_event_t){ .kind = BENCH_INPUT_HOLD, .from = a, .to = b, .button = btn });
+    }
+    if (strcmp(key, "press") == 0) {
+        button_t btn;
+        if (sscanf(line, "%*s %d %255s", &a, word) != 2) return false;
+        if (!button_from_name(word, &btn)) return false;
+        return push_input(sc, (bench_input_event_t){ .kind = BENCH_INPUT_PRESS, .from = a, .to = a + 1, .button = btn });
+    }
+    if (strcmp(key, "mouse") == 0) {
+        if (sscanf(line, "%*s %d %d %f %f", &a, &b, &x, &y) != 4 || b < a) return false;
+        return push_input(sc, (bench_input_event_t){ .kind = BENCH_INPUT_MOUSE, .from = a, .to = b, .x = x, .y = y });
+    }
+    return false;
+}
+
+bool bench_scenario_parse(const char* text, bench_scenario_t* out)
+{
+    if (!text || !out) return false;
+    *out = (bench_scenario_t){ .map = "assets/maps/start.tmx", .ticks = 600, .warmup = 60, .seed = 1u };
+
+    int line_no = 0;
+    const char* p = text;
+    while (*p) {
+        const char* end = strchr(p, '\n');
+        size_t len = end ? (size_t)(end - p) : strlen(p);
+        char line[512];
+        if (len >= sizeof(line)) len = sizeof(line) - 1;
+        memcpy(line, p, len);
+        line[len] = '\0';
+        ++line_no;
+
+        char* hash = strchr(line, '#');
+        if (hash) *hash = '\0';
+        if (!parse_line(out, line)) {
+            LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "bench: scenario line %d: can't parse '%s'", line_no, line);
+            return false;
+        }
+        if (!end) break;
+        p = end + 1;
+    }
+    return true;
+}
+
+bool bench_scenario_load(const char* path, bench_scenario_t* out)
+{
+    FILE* f = path ? fopen(path, "rb") : NULL;
+    if (!f) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "bench: can't open scenario '%s'", path ? path : "(null)");
+        return false;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char* text = (size >= 0) ? (char*)malloc((size_t)size + 1) : NULL;
+    if (!text) {
+        fclose(f);
+        return false;
+    }
+    size_t got = fread(text, 1, (size_t)size, f);
+    text[got] = '\0';
+    fclose(f);
+
+    bool ok = bench_scenario_parse(text, out);
+    free(text);
+    return ok;
+}
+
+input_t bench_scenario_input_at(const bench_scenario_t* sc, int tick)
+{
+    input_t in = {0};
+    if (!sc) return in;
+
+    for (int i = 0; i < sc->input_count; ++i) {
+        const bench_input_event_t* ev = &sc->inputs[i];
+        if (tick < ev->from || tick >= ev->to) continue;
+        switch (ev->kind) {
+            case BENCH_INPUT_HOLD:
+                in.down |= 1ull << ev->button;
+                if (tick == ev->from) in.pressed |= 1ull << ev->button;
+                break;
+            case BENCH_INPUT_PRESS:
+                in.down |= 1ull << ev->button;
+                in.pressed |= 1ull << ev->button;
+                break;
+            case BENCH_INPUT_MOUSE:
+                in.mouse = (input_vec2){ ev->x, ev->y };
+                break;
+        }
+    }
+
+    // Same normalisation as input_for_tick().
+    in.moveX = (input_down(&in, BTN_RIGHT) ? 1.f : 0.f) - (input_down(&in, BTN_LEFT) ? 1.f : 0.f);
+    in.moveY = (input_down(&in, BTN_DOWN) ? 1.f : 0.f) - (input_down(&in, BTN_UP) ? 1.f : 0.f);
+    float mag = sqrtf(in.moveX * in.moveX + in.moveY * in.moveY);
+    if (mag > 0.f) { in.moveX /= mag; in.moveY /= mag; }
+    return in;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "modules/core/input.h"
+
+// Scenario for build/src/game_bench. Line based, '#' starts a comment:
+//
+//   map     assets/maps/start.tmx
+//   ticks   1200                         measured ticks
+//   warmup  120                          ticks run before measuring
+//   seed    7                            spawn placement seed
+//   spawn   assets/prefabs/plastic.ent 200
+//   hold    0 300 right                  hold a button for ticks [0, 300)
+//   press   400 interact                 press edge on one tick
+//   mouse   0 1200 320 200               mouse position for ticks [0, 1200)
+//
+// Tick numbers count from the first warmup tick.
+
+#define BENCH_PATH_MAX   256
+#define BENCH_MAX_SPAWNS 16
+#define BENCH_MAX_INPUTS 64
+
+typedef struct {
+    char prefab[BENCH_PATH_MAX];
+    int  count;
+} bench_spawn_t;
+
+typedef enum {
+    BENCH_INPUT_HOLD = 0,
+    BENCH_INPUT_PRESS,
+    BENCH_INPUT_MOUSE,
+} bench_input_kind_t;
+
+typedef struct {
+    bench_input_kind_t kind;
+    int      from, to;  // [from, to)
+    button_t button;
+    float    x, y;
+} bench_input_event_t;
+
+typedef struct {
+    char     map[BENCH_PATH_MAX];
+    int      ticks;
+    int      warmup;
+    uint32_t seed;
+    bench_spawn_t       spawns[BENCH_MAX_SPAWNS];
+    int                 spawn_count;
+    bench_input_event_t inputs[BENCH_MAX_INPUTS];
+    int                 input_count;
+} bench_scenario_t;
+
+// Parse scenario text; logs the offending line and returns false on error.
+bool bench_scenario_parse(const char* text, bench_scenario_t* out);
+bool bench_scenario_load(const char* path, bench_scenario_t* out);
+
+// Input snapshot the timeline produces for `tick`.
+input_t bench_scenario_input_at(const bench_scenario_t* sc, int tick);
@@ -0,0 +1,250 @@
+// Deterministic headless benchmark: loads a scenario (map, prefab spawns, input timeline, tick
+// count), runs warmup ticks, then reports ns/tick per phase and per system, allocations and per-tag
+// memory (peaks include the map load) as JSON.
+// Usage: build/src/game_bench <scenario.scn> [--out report.json]
+#include "bench/bench_scenario.h"
+#include "modules/common/mem_tag.h"
+#include "modules/core/engine.h"
+#include "modules/core/logger.h"
+#include "modules/core/time.h"
+#include "modules/ecs/ecs.h"
+#include "modules/ecs/ecs_internal.h"
+#include "modules/ecs/ecs_prefab_loading.h"
+#include "modules/systems/systems.h"
+#include "modules/world/world_query.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Allocation counters; the bench links with -Wl,--wrap=malloc,... so every engine allocation
+// passes through here, including the map preloader and parallel_for workers, hence the atomics.
+static long   g_alloc_count;
+static size_t g_alloc_bytes;
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t n, size_t size);
+void* __real_realloc(void* p, size_t size);
+void  __real_free(void* p);
+
+static void count_alloc(size_t size)
+{
+    __atomic_fetch_add(&g_alloc_count, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&g_alloc_bytes, size, __ATOMIC_RELAXED);
+}
+
+void* __wrap_malloc(size_t size)
+{
+    count_alloc(size);
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t n, size_t size)
+{
+    count_alloc(n * size);
+    return __real_calloc(n, size);
+}
+
+void* __wrap_realloc(void* p, size_t size)
+{
+    count_alloc(size);
+    return __real_realloc(p, size);
+}
+
+void __wrap_free(void* p)
+{
+    __real_free(p);
+}
+
+static const char* k_phase_names[PHASE_COUNT] = {
+    [PHASE_INPUT]    = "input",
+    [PHASE_SIM_PRE]  = "sim_pre",
+    [PHASE_PHYSICS]  = "physics",
+    [PHASE_SIM_POST] = "sim_post",
+    [PHASE_DEBUG]    = "debug",
+    [PHASE_PRESENT]  = "present",
+    [PHASE_RENDER]   = "render",
+};
+
+static uint32_t lcg(uint32_t* s)
+{
+    *s = *s * 1664525u + 1013904223u;
+    return *s >> 8;
+}
+
+// Scatter prefab instances over walkable tiles; placement only depends on the seed.
+static void spawn_prefabs(const bench_scenario_t* sc)
+{
+    int map_w = 0, map_h = 0;
+    world_size_px(&map_w, &map_h);
+    const int tile = world_tile_size() > 0 ? world_tile_size() : 16;
+    if (map_w <= 0 || map_h <= 0) return;
+
+    uint32_t rng = sc->seed;
+    for (int s = 0; s < sc->spawn_count; ++s) {
+        for (int n = 0; n < sc->spawns[s].count; ++n) {
+            for (int attempt = 0; attempt < 64; ++attempt) {
+                float x = (float)(lcg(&rng) % (uint32_t)map_w);
+                float y = (float)(lcg(&rng) % (uint32_t)map_h);
+                if (!world_is_walkable_rect_px(x, y, tile * 0.5f, tile * 0.5f)) continue;
+
+                tiled_object_t obj = { .x = x, .y = y };
+                ecs_prefab_spawn_entity_from_path(sc->spawns[s].prefab, &obj);
+                break;
+            }
+        }
+    }
+}
+
+static int alive_entities(void)
+{
+    int n = 0;
+    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) n += ecs_alive_idx(i) ? 1 : 0;
+    return n;
+}
+
+static int cmp_double(const void* a, const void* b)
+{
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Paths come from the command line and the scenario file; quote them as JSON strings.
+static void write_json_string(FILE* f, const char* s)
+{
+    fputc('"', f);
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') fputc('\\', f);
+        if ((unsigned char)*s < 0x20) continue;
+        fputc(*s, f);
+    }
+    fputc('"', f);
+}
+
+static void write_report(FILE* f, const char* scenario_path, const bench_scenario_t* sc, int entities,
+                         double* tick_ns, long allocs, size_t alloc_bytes)
+{
+    const int n = sc->ticks;
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i) sum += tick_ns[i];
+    qsort(tick_ns, (size_t)n, sizeof(double), cmp_double);
+    int p99 = (int)((double)n * 0.99 + 0.999999) - 1;
+    if (p99 < 0) p99 = 0;
+
+    size_t count = systems_profile_stats(NULL, 0);
+    systems_profile_stats_t* stats = (systems_profile_stats_t*)calloc(count ? count : 1, sizeof(*stats));
+    count = systems_profile_stats(stats, count);
+
+    double phase_ns[PHASE_COUNT] = {0};
+    for (size_t i = 0; i < count; ++i) phase_ns[stats[i].phase] += stats[i].total_ms * 1e6 / n;
+
+    fprintf(f, "{\n");
+    fprintf(f, "  \"scenario\": ");
+    write_json_string(f, scenario_path);
+    fprintf(f, ",\n");
+    fprintf(f, "  \"map\": ");
+    write_json_string(f, sc->map);
+    fprintf(f, ",\n");
+    fprintf(f, "  \"seed\": %u,\n", (unsigned)sc->seed);
+    fprintf(f, "  \"warmup\": %d,\n", sc->warmup);
+    fprintf(f, "  \"ticks\": %d,\n", n);
+    fprintf(f, "  \"sim_hz\": %d,\n", engine_sim_hz());
+    fprintf(f, "  \"entities\": %d,\n", entities);
+    fprintf(f, "  \"tick_ns\": { \"mean\": %.0f, \"p50\": %.0f, \"p99\": %.0f, \"max\": %.0f },\n",
+            sum / n, tick_ns[n / 2], tick_ns[p99], tick_ns[n - 1]);
+    fprintf(f, "  \"phases\": [\n");
+    bool first = true;
+    for (int p = 0; p < PHASE_COUNT; ++p) {
+        if (phase_ns[p] <= 0.0) continue;
+        fprintf(f, "%s    { \"phase\": \"%s\", \"ns_per_tick\": %.0f }", first ? "" : ",\n", k_phase_names[p], phase_ns[p]);
+        first = false;
+    }
+    fprintf(f, "\n  ],\n");
+    fprintf(f, "  \"systems\": [\n");
+    for (size_t i = 0; i < count; ++i) {
+        fprintf(f, "    { \"phase\": \"%s\", \"system\": \"%s\", \"calls\": %ld, \"ns_per_tick\": %.0f, \"p99_ns\": %.0f }%s\n",
+                k_phase_names[stats[i].phase], stats[i].name, stats[i].calls,
+                stats[i].total_ms * 1e6 / n, stats[i].p99_ms * 1e6, (i + 1 < count) ? "," : "");
+    }
+    fprintf(f, "  ],\n");
+    fprintf(f, "  \"allocs\": { \"count\": %ld, \"bytes\": %zu, \"per_tick\": %.2f, \"bytes_per_tick\": %.1f },\n",
+            allocs, alloc_bytes, (double)allocs / n, (double)alloc_bytes / n);
+    fprintf(f, "  \"memory\": [\n");
+    for (int t = 0; t < MEM_TAG_COUNT; ++t) {
+        mem_tag_stats_t st;
+        mem_tag_stats((mem_tag_t)t, &st);
+        fprintf(f, "    { \"tag\": \"%s\", \"live_bytes\": %zu, \"peak_bytes\": %zu, \"live_blocks\": %llu, \"allocs\": %llu }%s\n",
+                mem_tag_name((mem_tag_t)t), st.live_bytes, st.peak_bytes, (unsigned long long)st.live_blocks,
+                (unsigned long long)st.alloc_count, (t + 1 < MEM_TAG_COUNT) ? "," : "");
+    }
+    fprintf(f, "  ]\n");
+    fprintf(f, "}\n");
+    free(stats);
+}
+
+int main(int argc, char** argv)
+{
+    const char* scenario_path = NULL;
+    const char* out_path = NULL;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) out_path = argv[++i];
+        else scenario_path = argv[i];
+    }
+    if (!scenario_path) {
+        fprintf(stderr, "usage: %s <scenario.scn> [--out report.json]\n", argv[0]);
+        return 1;
+    }
+
+    static bench_scenario_t sc;
+    if (!bench_scenario_load(scenario_path, &sc)) return 1;
+
+    engine_set_start_map(sc.map);
+    if (!engine_init("game_bench")) return 1;
+    log_set_min_level(LOG_LVL_WARN);
+
+    const int before = alive_entities();
+    spawn_prefabs(&sc);
+    const int entities = alive_entities();
+    if (entities == before && sc.spawn_count > 0) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_WARN, "bench: no prefab instances spawned");
+    }
+
+    const float dt = 1.0f / (float)engine_sim_hz();
+    double* tick_ns = (double*)calloc((size_t)sc.ticks, sizeof(double));
+    if (!tick_ns) return 1;
+
+    const int total = sc.warmup + sc.ticks;
+    for (int t = 0; t < total; ++t) {
+        if (t == sc.warmup) {
+            systems_profile_reset();
+            __atomic_store_n(&g_alloc_count, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&g_alloc_bytes, 0, __ATOMIC_RELAXED);
+        }
+        input_t in = bench_scenario_input_at(&sc, t);
+        double t0 = time_now();
+        ecs_store_prev_positions();
+        systems_tick(dt, &in);
+        engine_after_tick();
+        ecs_set_render_alpha(1.0f);
+        systems_present(dt);
+        double t1 = time_now();
+        if (t >= sc.warmup) tick_ns[t - sc.warmup] = (t1 - t0) * 1e9;
+    }
+    const long allocs = __atomic_load_n(&g_alloc_count, __ATOMIC_RELAXED);
+    const size_t alloc_bytes = __atomic_load_n(&g_alloc_bytes, __ATOMIC_RELAXED);
+
+    FILE* f = out_path ? fopen(out_path, "wb") : stdout;
+    if (!f) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "bench: can't write '%s'", out_path);
+        free(tick_ns);
+        engine_shutdown();
+        return 1;
+    }
+    write_report(f, scenario_path, &sc, entities, tick_ns, allocs, alloc_bytes);
+    if (f != stdout) fclose(f);
+
+    free(tick_ns);
+    engine_shutdown();
+    return 0;
+}
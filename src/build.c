@@ -100,6 +100,21 @@ static bool gather_module_sources(Nob_File_Paths *out_sources, const Nob_File_Pa
     return gather_module_sources_recursive("src/modules", replacement_bases, out_sources);
 }
 
+static bool gather_bench_sources(Nob_File_Paths *out_sources)
+{
+    Nob_File_Paths children = {0};
+    if (!nob_read_entire_dir("src/bench", &children)) return false;
+
+    for (size_t i = 0; i < children.count; ++i) {
+        const char *name = children.items[i];
+        if (is_dot_entry(name)) continue;
+        if (!cstr_ends_with(name, ".c")) continue;
+        nob_da_append(out_sources, nob_temp_sprintf("src/bench/%s", name));
+    }
+
+    return true;
+}
+
 static void sb_append_paths(Nob_String_Builder *sb, const Nob_File_Paths *paths)
 {
     for (size_t i = 0; i < paths->count; ++i) {
@@ -113,20 +128,62 @@ int main(int argc, char **argv) {
 
 	    bool debug_build = false;
 	    bool headless_build = false;
+	    bool bench_build = false;
     for (int i = 1; i < argc; ++i) {
         if (nob_sv_eq(nob_sv_from_cstr(argv[i]), nob_sv_from_cstr("--debug"))) debug_build = true;
         if (nob_sv_eq(nob_sv_from_cstr(argv[i]), nob_sv_from_cstr("--release"))) debug_build = false;
         if (nob_sv_eq(nob_sv_from_cstr(argv[i]), nob_sv_from_cstr("--headless"))) headless_build = true;
+        if (nob_sv_eq(nob_sv_from_cstr(argv[i]), nob_sv_from_cstr("--bench"))) bench_build = true;
     }
     if (headless_build) debug_build = true; // simplify: headless is always debug
 
     if (!nob_mkdir_if_not_exists("build")) return 1;
     if (!nob_mkdir_if_not_exists("build/src")) return 1;
     if (!nob_mkdir_if_not_exists("build/test")) return 1;
-    nob_log(NOB_INFO, "Mode: %s%s", debug_build ? "debug" : "release", headless_build ? " (headless)" : "");
+    nob_log(NOB_INFO, "Mode: %s%s", debug_build ? "debug" : "release",
+            headless_build ? " (headless)" : bench_build ? " (bench)" : "");
 
     Nob_Cmd cmd = {0};
 
+#if !defined(_WIN32)
+	    // game_bench: headless backend with release flags, src/bench/ in place of src/main.c, and
+	    // malloc/calloc/realloc/free wrapped so the bench can count allocations.
+	    if (bench_build) {
+	        Nob_File_Paths headless_sources = {0};
+	        Nob_File_Paths replacement_bases = {0};
+	        Nob_File_Paths module_sources = {0};
+	        Nob_File_Paths bench_sources = {0};
+	        if (!gather_headless_sources(&headless_sources, &replacement_bases)) return 1;
+	        if (!gather_module_sources(&module_sources, &replacement_bases)) return 1;
+	        if (!gather_bench_sources(&bench_sources)) return 1;
+
+	        Nob_String_Builder sb = {0};
+	        nob_sb_appendf(&sb,
+	            "gcc -std=c99 -Wall -Wextra -O2 -fno-fast-math -fno-finite-math-only "
+	            "-DDEBUG_BUILD=0 -DDEBUG_COLLISION=0 -DDEBUG_TRIGGERS=0 -DDEBUG_FPS=0 -DNDEBUG -DHEADLESS=1 "
+	            "-I %s -I src ",
+	            XML_INCLUDE_DIR
+	        );
+	        sb_append_paths(&sb, &bench_sources);
+	        sb_append_paths(&sb, &module_sources);
+	        sb_append_paths(&sb, &headless_sources);
+	        nob_sb_appendf(&sb,
+	            "-o build/src/game_bench "
+	            "-L %s -l:%s "
+	            "-Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free "
+	            "-lm -lpthread -ldl -lrt",
+	            XML_LIB_DIR,
+	            XML_LIB_NAME
+	        );
+	        nob_sb_append_null(&sb);
+	        nob_cmd_append(&cmd, "sh", "-lc", sb.items);
+
+	        if (!nob_cmd_run_sync_and_reset(&cmd)) return 1;
+	        nob_sb_free(sb);
+	        return 0;
+	    }
+#endif
+
 #if !defined(_WIN32)
 	    const char *debug_flags = debug_build
 	        ? "-DDEBUG_BUILD=1 -DDEBUG_COLLISION=1 -DDEBUG_TRIGGERS=1 -DDEBUG_FPS=1 -g"
@@ -1,12 +1,15 @@
 #include "modules/core/input.h"
+#include "modules/core/input_record.h"
 
 void input_init_defaults(void) { }
 void input_bind(button_t btn, int keycode) { (void)btn; (void)keycode; }
 
 void input_begin_frame(void) { }
 
+// No devices headless: ticks come from an input recording when one is open, else idle input.
 input_t input_for_tick(void)
 {
-    return (input_t){0};
+    input_t in;
+    input_replay_next(&in);
+    return in;
 }
-
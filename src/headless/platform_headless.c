@@ -11,6 +11,8 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include "modules/core/input_record.h"
+
 #ifndef PATH_MAX
 #define PATH_MAX 4096
 #endif
@@ -62,5 +64,6 @@ bool platform_should_close(void)
         if (max_frames <= 0) max_frames = 1;
     }
 
-    return (frames++ >= max_frames);
+    // A finished input replay ends the run early.
+    return frames++ >= max_frames || input_replay_finished();
 }
@@ -9,6 +9,7 @@ bool renderer_toggle_phys_colliders(void) { return false; }
 bool renderer_toggle_static_colliders(void) { return false; }
 bool renderer_toggle_triggers(void) { return false; }
 bool renderer_toggle_fps_overlay(void) { return false; }
+bool renderer_toggle_profiler_overlay(void) { return false; }
 
 void draw_debug_collision_overlays(const render_view_t* view) { (void)view; }
 void draw_debug_trigger_overlays(const render_view_t* view) { (void)view; }
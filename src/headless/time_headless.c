@@ -1,4 +1,9 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "modules/core/time.h"
+#include <unistd.h> // _POSIX_TIMERS
 
 #if defined(_POSIX_TIMERS) && (_POSIX_TIMERS > 0)
 #include <time.h>
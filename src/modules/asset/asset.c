@@ -2,6 +2,11 @@
 #include "modules/asset/asset_backend.h"
 #include "modules/asset/asset_backend_internal.h"
 #include "modules/core/logger.h"
+#include "modules/core/metrics.h"
+#include "modules/core/trace.h"
+#include "modules/common/hashmap.h"
+#include "modules/common/mem_tag.h"
+#include "modules/common/path_util.h"
 #include "modules/systems/systems_registration.h"
 
 #include <stdlib.h>
@@ -13,9 +18,16 @@ typedef struct Slot {
     bool      used;
     uint32_t  refc;
     char*     path;
+    size_t    pixel_bytes; // counted under MEM_TAG_ASSET while loaded
 } Slot;
 
+// Loaded path -> slot index; keys are the slots' own path strings.
+HM_DECLARE(path_index, const char*, int, hm_hash_str, hm_eq_str, MEM_TAG_ASSET)
+
 static Slot s_tex[MAX_TEX];
+static int  s_used_count;
+static path_index_t s_by_path;
+static metric_t* s_m_loaded;
 
 static Slot* slot_from_handle(tex_handle_t h) {
     if (h.idx >= MAX_TEX) return NULL;
@@ -28,12 +40,15 @@ static tex_handle_t make_handle(uint32_t idx, uint32_t gen) {
     tex_handle_t h; h.idx = idx; h.gen = gen; return h;
 }
 
-static char* xstrdup(const char* s) {
-    if (!s) return NULL;
-    size_t n = strlen(s) + 1;
-    char* p = (char*)malloc(n);
-    if (p) memcpy(p, s, n);
-    return p;
+// Pixels live with the backend (VRAM under raylib) but are what a map load actually costs, so
+// they're counted as RGBA8 next to the slot bookkeeping. Re-measured after a hot reload.
+static void slot_account_pixels(Slot* s) {
+    int w = 0, h = 0;
+    if (s->tex) asset_backend_texture_size(s->tex, &w, &h);
+    const size_t bytes = (w > 0 && h > 0) ? (size_t)w * (size_t)h * 4u : 0;
+    if (s->pixel_bytes) mem_track_free(MEM_TAG_ASSET, s->pixel_bytes);
+    if (bytes) mem_track_alloc(MEM_TAG_ASSET, bytes);
+    s->pixel_bytes = bytes;
 }
 
 static void unload_slot(Slot* s) {
@@ -42,14 +57,20 @@ static void unload_slot(Slot* s) {
         asset_backend_unload_texture(s->tex);
         s->tex = NULL;
     }
-    free(s->path);
+    slot_account_pixels(s);
+    if (s->path) path_index_remove(&s_by_path, s->path);
+    mem_free_str(MEM_TAG_ASSET, s->path);
     s->path = NULL;
     s->used = false;
     s->refc = 0;
+    s_used_count--;
 }
 
 void asset_init(void) {
     memset(s_tex, 0, sizeof(s_tex));
+    s_used_count = 0;
+    path_index_clear(&s_by_path);
+    s_m_loaded = metrics_counter("asset_textures_loaded_total", "Textures loaded from disk", NULL);
 }
 
 void asset_shutdown(void) {
@@ -57,6 +78,7 @@ void asset_shutdown(void) {
         unload_slot(&s_tex[i]);
         s_tex[i].gen = 0;
     }
+    path_index_free(&s_by_path);
 }
 
 void asset_collect(void) {
@@ -71,14 +93,11 @@ void asset_collect(void) {
 
 static int find_by_path(const char* path) {
     if (!path) return -1;
-    for (int i = 0; i < MAX_TEX; ++i) {
-        Slot* s = &s_tex[i];
-        if (s->used && s->path && strcmp(s->path, path) == 0) return i;
-    }
-    return -1;
+    const int* idx = path_index_get(&s_by_path, path);
+    return idx ? *idx : -1;
 }
 
-tex_handle_t asset_acquire_texture(const char* path) {
+static tex_handle_t acquire_texture_impl(const char* path) {
     if (!path) return (tex_handle_t){0};
 
     int idx = find_by_path(path);
@@ -98,9 +117,13 @@ tex_handle_t asset_acquire_texture(const char* path) {
             }
             s->tex = backend;
             s->used = true;
+            s_used_count++;
+            metrics_add(s_m_loaded, 1);
             s->refc = 1;
-            free(s->path);
-            s->path = xstrdup(path);
+            mem_free_str(MEM_TAG_ASSET, s->path);
+            s->path = mem_strdup(MEM_TAG_ASSET, path);
+            if (s->path) path_index_put(&s_by_path, s->path, i);
+            slot_account_pixels(s);
             return make_handle((uint32_t)i, s->gen);
         }
     }
@@ -109,6 +132,13 @@ tex_handle_t asset_acquire_texture(const char* path) {
     return (tex_handle_t){0};
 }
 
+tex_handle_t asset_acquire_texture(const char* path) {
+    TRACE_BEGIN("asset_acquire_texture");
+    tex_handle_t h = acquire_texture_impl(path);
+    TRACE_END();
+    return h;
+}
+
 void asset_addref_texture(tex_handle_t h) {
     Slot* s = slot_from_handle(h);
     if (s) s->refc++;
@@ -143,6 +173,10 @@ uint32_t asset_texture_refcount(tex_handle_t h) {
     return s ? s->refc : 0;
 }
 
+int asset_texture_slots_used(void) {
+    return s_used_count;
+}
+
 void asset_log_debug(void) {
     LOGC(LOGCAT_ASSET, LOG_LVL_DEBUG, "---- Asset Texture Debug Dump ----");
     for (int i = 0; i < MAX_TEX; ++i) {
@@ -171,6 +205,21 @@ void asset_reload_all(void) {
         asset_backend_reload_texture(s->tex, s->path);
     }
     asset_backend_reload_all_end();
+    for (int i = 0; i < MAX_TEX; ++i) {
+        if (s_tex[i].used) slot_account_pixels(&s_tex[i]);
+    }
+}
+
+bool asset_reload_texture_path(const char* path) {
+    if (!path) return false;
+    for (int i = 0; i < MAX_TEX; ++i) {
+        Slot* s = &s_tex[i];
+        if (!s->used || !s->path || !s->tex || !path_same(s->path, path)) continue;
+        asset_backend_reload_texture(s->tex, s->path);
+        slot_account_pixels(s);
+        return true;
+    }
+    return false;
 }
 
 AssetBackendTexture* asset_backend_lookup_texture(tex_handle_t h) {
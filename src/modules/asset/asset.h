@@ -11,6 +11,7 @@ void asset_collect(void);
 
 //DEBUG FEATURES
 void asset_reload_all(void);
+bool asset_reload_texture_path(const char* path); // reloads the one slot loaded from path; false if not loaded
 void asset_log_debug(void);
 
 tex_handle_t asset_acquire_texture(const char* path); // +1 (load or reuse)
@@ -21,3 +22,4 @@ bool         asset_texture_valid(tex_handle_t h);
 void         asset_texture_size(tex_handle_t h, int* out_w, int* out_h);
 const char*  asset_texture_path(tex_handle_t h);
 uint32_t     asset_texture_refcount(tex_handle_t h);
+int          asset_texture_slots_used(void);
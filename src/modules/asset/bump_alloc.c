@@ -3,49 +3,217 @@
 #include <stdlib.h>
 #include <string.h>
 
-bool bump_init(bump_alloc_t *b, size_t capacity)
+// Header at the start of each malloc'd chunk; the payload follows, aligned to BUMP_CHUNK_ALIGN
+// so offsets within a chunk align the same way addresses do.
+struct bump_chunk {
+    bump_chunk_t *prev;
+    uint8_t      *payload;
+    size_t        base;     // logical offset of payload[0]
+    size_t        capacity;
+    size_t        used;     // bytes handed out before the next chunk was added
+};
+
+static size_t align_up(size_t x, size_t align)
 {
-    if (!b) return false;
-    bump_free(b);
-    b->data = (uint8_t *)malloc(capacity);
-    if (!b->data) {
+    size_t mask = align - 1;
+    return (x + mask) & ~mask;
+}
+
+static size_t chunk_block_bytes(size_t capacity)
+{
+    return sizeof(bump_chunk_t) + BUMP_CHUNK_ALIGN - 1 + capacity;
+}
+
+static bump_chunk_t *chunk_new(mem_tag_t tag, size_t base, size_t capacity)
+{
+    bump_chunk_t *c = (bump_chunk_t *)mem_alloc(tag, chunk_block_bytes(capacity));
+    if (!c) return NULL;
+    c->prev = NULL;
+    c->payload = (uint8_t *)align_up((uintptr_t)(c + 1), BUMP_CHUNK_ALIGN);
+    c->base = base;
+    c->capacity = capacity;
+    c->used = 0;
+    return c;
+}
+
+static void chunk_free(mem_tag_t tag, bump_chunk_t *c)
+{
+    mem_free(tag, c, chunk_block_bytes(c->capacity));
+}
+
+static void push_chunk(bump_alloc_t *b, bump_chunk_t *c)
+{
+    if (b->chunk) b->chunk->used = b->offset;
+    c->prev = b->chunk;
+    b->chunk = c;
+    b->data = c->payload;
+    b->capacity = c->capacity;
+    b->offset = 0;
+    b->reserved += c->capacity;
+}
+
+static void pop_chunk(bump_alloc_t *b)
+{
+    bump_chunk_t *c = b->chunk;
+    b->chunk = c->prev;
+    b->reserved -= c->capacity;
+    chunk_free(b->tag, c);
+    if (b->chunk) {
+        b->data = b->chunk->payload;
+        b->capacity = b->chunk->capacity;
+        b->offset = b->chunk->used;
+    } else {
+        b->data = NULL;
         b->capacity = 0;
         b->offset = 0;
-        return false;
     }
-    b->capacity = capacity;
-    b->offset = 0;
+}
+
+static void free_chunks(bump_alloc_t *b)
+{
+    while (b->chunk) pop_chunk(b);
+}
+
+static void note_high_water(bump_alloc_t *b)
+{
+    const size_t used = bump_used(b);
+    if (used > b->high_water) b->high_water = used;
+}
+
+bool bump_init(bump_alloc_t *b, size_t capacity)
+{
+    return bump_init_tagged(b, capacity, MEM_TAG_MISC);
+}
+
+bool bump_init_tagged(bump_alloc_t *b, size_t capacity, mem_tag_t tag)
+{
+    if (!b) return false;
+    bump_free(b);
+    b->tag = tag;
+    bump_chunk_t *c = chunk_new(tag, 0, capacity);
+    if (!c) return false;
+    push_chunk(b, c);
     return true;
 }
 
 void bump_reset(bump_alloc_t *b)
 {
-    if (!b) return;
+    if (!b || !b->chunk) return;
+    if (b->chunk->prev) {
+        // Swap the chain for one chunk that holds what the chain did; if that can't be had,
+        // fall back to the first chunk alone.
+        bump_chunk_t *merged = chunk_new(b->tag, 0, b->reserved);
+        if (merged) {
+            free_chunks(b);
+            push_chunk(b, merged);
+        } else {
+            while (b->chunk->prev) pop_chunk(b);
+        }
+    }
     b->offset = 0;
 }
 
 void bump_free(bump_alloc_t *b)
 {
     if (!b) return;
-    free(b->data);
-    b->data = NULL;
-    b->capacity = 0;
-    b->offset = 0;
+    free_chunks(b);
+    b->reserved = 0;
+    b->high_water = 0;
 }
 
-static size_t align_up(size_t x, size_t align)
+// Padding that puts b->data + from on an align boundary. Addresses rather than offsets, since
+// payloads are only guaranteed BUMP_CHUNK_ALIGN alignment.
+static size_t align_pad(const bump_alloc_t *b, size_t from, size_t align)
 {
-    size_t mask = align - 1;
-    return (x + mask) & ~mask;
+    const uintptr_t at = (uintptr_t)(b->data + from);
+    return (size_t)(align_up(at, align) - at);
 }
 
 void *bump_alloc_aligned(bump_alloc_t *b, size_t size, size_t align)
 {
-    if (!b || !b->data || align == 0) return NULL;
-    size_t start = align_up(b->offset, align);
-    size_t end = start + size;
-    if (end > b->capacity) return NULL;
+    if (!b || !b->chunk || align == 0 || (align & (align - 1)) != 0) return NULL;
+    // A fresh chunk's payload may need up to this much padding before the first allocation.
+    const size_t slack = align > BUMP_CHUNK_ALIGN ? align - BUMP_CHUNK_ALIGN : 0;
+    if (size > SIZE_MAX - slack) return NULL;
+
+    size_t start = b->offset + align_pad(b, b->offset, align);
+    if (start > b->capacity || size > b->capacity - start) {
+        // New chunks at least double, so a growing arena needs O(log n) of them.
+        size_t cap = b->capacity * 2;
+        if (cap < size + slack) cap = size + slack;
+        bump_chunk_t *c = chunk_new(b->tag, b->chunk->base + b->chunk->capacity, cap);
+        if (!c) return NULL;
+        push_chunk(b, c);
+        start = align_pad(b, 0, align);
+    }
     void *ptr = b->data + start;
-    b->offset = end;
+    b->offset = start + size;
+    note_high_water(b);
     return ptr;
 }
+
+bump_marker_t bump_save(const bump_alloc_t *b)
+{
+    return (bump_marker_t){ .used = bump_used(b) };
+}
+
+void bump_restore(bump_alloc_t *b, bump_marker_t m)
+{
+    if (!b || !b->chunk) return;
+    while (b->chunk->prev && b->chunk->base >= m.used) pop_chunk(b);
+    const size_t off = m.used > b->chunk->base ? m.used - b->chunk->base : 0;
+    if (off < b->offset) b->offset = off;
+}
+
+size_t bump_used(const bump_alloc_t *b)
+{
+    return (b && b->chunk) ? b->chunk->base + b->offset : 0;
+}
+
+size_t bump_high_water(const bump_alloc_t *b)
+{
+    return b ? b->high_water : 0;
+}
+
+size_t bump_offset_of(const bump_alloc_t *b, const void *p)
+{
+    const uint8_t *q = (const uint8_t *)p;
+    for (const bump_chunk_t *c = b ? b->chunk : NULL; c; c = c->prev) {
+        // <= so a zero-size allocation at the very end of a chunk still resolves.
+        if (q >= c->payload && q <= c->payload + c->capacity) return c->base + (size_t)(q - c->payload);
+    }
+    return SIZE_MAX;
+}
+
+void *bump_ptr_at(const bump_alloc_t *b, size_t offset)
+{
+    if (offset >= bump_used(b)) return NULL;
+    for (const bump_chunk_t *c = b->chunk; c; c = c->prev) {
+        if (offset >= c->base && offset - c->base < c->capacity) return c->payload + (offset - c->base);
+    }
+    return NULL;
+}
+
+void bump_flatten(const bump_alloc_t *b, uint8_t *dst)
+{
+    for (const bump_chunk_t *c = b ? b->chunk : NULL; c; c = c->prev) {
+        const size_t used = (c == b->chunk) ? b->offset : c->used;
+        memcpy(dst + c->base, c->payload, used);
+        if (c != b->chunk) memset(dst + c->base + used, 0, c->capacity - used);
+    }
+}
+
+bool bump_load(bump_alloc_t *b, const uint8_t *src, size_t size)
+{
+    if (!b) return false;
+    if (!b->chunk || b->chunk->prev || b->chunk->capacity < size) {
+        bump_chunk_t *c = chunk_new(b->tag, 0, size > b->reserved ? size : b->reserved);
+        if (!c) return false;
+        free_chunks(b);
+        push_chunk(b, c);
+    }
+    if (size > 0) memcpy(b->data, src, size);
+    b->offset = size;
+    note_high_water(b);
+    return true;
+}
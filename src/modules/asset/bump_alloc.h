@@ -4,16 +4,56 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "modules/common/mem_tag.h"
+
+// Chunked bump allocator. When the current chunk is full a new, larger chunk is chained on,
+// so allocations only fail when malloc does and never move once handed out. bump_reset
+// coalesces a multi-chunk arena into one chunk of the combined size, so an arena that keeps
+// seeing the same load settles into a single contiguous block.
+//
+// Every chunk occupies a fixed range of a logical address space (the first chunk starts at 0,
+// each later one where the previous chunk ends). bump_used, markers and bump_offset_of are in
+// those logical bytes, which is what lets the snapshot code store arena-relative offsets.
+// Alignments up to BUMP_CHUNK_ALIGN hold for logical offsets too; larger ones only for the
+// address handed out, so they don't carry over a bump_load into a new chunk.
+typedef struct bump_chunk bump_chunk_t;
+
 typedef struct {
-    uint8_t *data;
-    size_t   capacity;
-    size_t   offset;
+    uint8_t      *data;       // current (newest) chunk
+    size_t        capacity;   // of the current chunk
+    size_t        offset;     // into the current chunk
+    bump_chunk_t *chunk;      // newest chunk; older ones hang off chunk->prev
+    size_t        reserved;   // bytes across all chunks
+    size_t        high_water; // largest bump_used seen since init
+    mem_tag_t     tag;
 } bump_alloc_t;
 
-bool   bump_init(bump_alloc_t *b, size_t capacity);
+// Scoped temporary allocation: save a marker, allocate, restore to drop everything since.
+typedef struct {
+    size_t used;
+} bump_marker_t;
+
+bool   bump_init(bump_alloc_t *b, size_t capacity); // first chunk size; counted under MEM_TAG_MISC
+bool   bump_init_tagged(bump_alloc_t *b, size_t capacity, mem_tag_t tag);
 void   bump_reset(bump_alloc_t *b);
 void   bump_free(bump_alloc_t *b);
-void  *bump_alloc_aligned(bump_alloc_t *b, size_t size, size_t align);
+void  *bump_alloc_aligned(bump_alloc_t *b, size_t size, size_t align); // align: any power of two
+
+bump_marker_t bump_save(const bump_alloc_t *b);
+void          bump_restore(bump_alloc_t *b, bump_marker_t m); // frees chunks added since the save
+
+size_t bump_used(const bump_alloc_t *b);
+size_t bump_high_water(const bump_alloc_t *b);
+
+// Logical offset of p (which must come from b), and back; bump_ptr_at is NULL past bump_used.
+size_t bump_offset_of(const bump_alloc_t *b, const void *p);
+void  *bump_ptr_at(const bump_alloc_t *b, size_t offset);
+// Copy the logical range [0, bump_used) out (unused chunk tails read as zero), or replace the
+// arena's contents with such a copy; bump_load keeps one chunk, reusing it if it is big enough.
+void   bump_flatten(const bump_alloc_t *b, uint8_t *dst);
+bool   bump_load(bump_alloc_t *b, const uint8_t *src, size_t size);
+
+#define BUMP_CHUNK_ALIGN 64
 
 // Convenience for typed allocations
 #define bump_alloc_type(b, type, count) \
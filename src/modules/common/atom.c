@@ -0,0 +1,133 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#define DA_MEM_TAG MEM_TAG_MISC
+#include "modules/common/atom.h"
+#include "modules/asset/bump_alloc.h"
+#include "modules/common/dynarray.h"
+#include "modules/common/hashmap.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+#include <pthread.h>
+static pthread_mutex_t g_lock = PTHREAD_MUTEX_INITIALIZER;
+#define ATOM_LOCK()   pthread_mutex_lock(&g_lock)
+#define ATOM_UNLOCK() pthread_mutex_unlock(&g_lock)
+#else
+#define ATOM_LOCK()   ((void)0)
+#define ATOM_UNLOCK() ((void)0)
+#endif
+
+#define ATOM_TEXT_CHUNK_BYTES (16 * 1024)
+
+// The interned text sits in a chunked arena, so the pointers handed out (and used as the
+// index keys) never move.
+HM_DECLARE(atom_index, const char*, atom_t, hm_hash_str, hm_eq_str, MEM_TAG_MISC)
+static atom_index_t        g_index;
+static DA(const char*)     g_strings; // atom - 1 -> text
+static bump_alloc_t        g_text;
+
+static atom_t find_locked(const char* s)
+{
+    const atom_t* a = atom_index_get(&g_index, s);
+    return a ? *a : ATOM_NONE;
+}
+
+static atom_t intern_locked(const char* s)
+{
+    atom_t a = find_locked(s);
+    if (a != ATOM_NONE) return a;
+
+    const size_t n = strlen(s) + 1;
+    if (!g_text.data && !bump_init(&g_text, ATOM_TEXT_CHUNK_BYTES)) return ATOM_NONE;
+    char* copy = (char*)bump_alloc_aligned(&g_text, n, 1);
+    if (!copy) return ATOM_NONE;
+    memcpy(copy, s, n);
+
+    a = (atom_t)g_strings.size + 1u;
+    if (!atom_index_put(&g_index, copy, a)) return ATOM_NONE;
+    DA_APPEND(&g_strings, copy);
+    return a;
+}
+
+// Lowercased copy of a (plus sep and b when b is given) in buf, or on the heap if it doesn't
+// fit; the caller frees the result when it isn't buf.
+static char* fold_ci(const char* a, char sep, const char* b, char* buf, size_t cap)
+{
+    const size_t na = strlen(a);
+    const size_t nb = b ? strlen(b) : 0;
+    const size_t n = na + (b ? 1 + nb : 0);
+    char* out = (n < cap) ? buf : (char*)malloc(n + 1);
+    if (!out) return NULL;
+    for (size_t i = 0; i < na; ++i) out[i] = hm_lower_(a[i]);
+    if (b) {
+        out[na] = hm_lower_(sep);
+        for (size_t i = 0; i < nb; ++i) out[na + 1 + i] = hm_lower_(b[i]);
+    }
+    out[n] = '\0';
+    return out;
+}
+
+atom_t atom_intern(const char* s)
+{
+    if (!s) return ATOM_NONE;
+    ATOM_LOCK();
+    const atom_t a = intern_locked(s);
+    ATOM_UNLOCK();
+    return a;
+}
+
+atom_t atom_intern_ci(const char* s)
+{
+    if (!s) return ATOM_NONE;
+    char buf[128];
+    char* folded = fold_ci(s, 0, NULL, buf, sizeof(buf));
+    if (!folded) return ATOM_NONE;
+    const atom_t a = atom_intern(folded);
+    if (folded != buf) free(folded);
+    return a;
+}
+
+atom_t atom_find(const char* s)
+{
+    if (!s) return ATOM_NONE;
+    ATOM_LOCK();
+    const atom_t a = find_locked(s);
+    ATOM_UNLOCK();
+    return a;
+}
+
+atom_t atom_find_ci(const char* s)
+{
+    return atom_find_join_ci(s, 0, NULL);
+}
+
+atom_t atom_find_join_ci(const char* a, char sep, const char* b)
+{
+    if (!a) return ATOM_NONE;
+    char buf[128];
+    char* folded = fold_ci(a, sep, b, buf, sizeof(buf));
+    if (!folded) return ATOM_NONE;
+    const atom_t r = atom_find(folded);
+    if (folded != buf) free(folded);
+    return r;
+}
+
+const char* atom_str(atom_t a)
+{
+    ATOM_LOCK();
+    const char* s = (a != ATOM_NONE && a <= g_strings.size) ? g_strings.data[a - 1] : NULL;
+    ATOM_UNLOCK();
+    return s;
+}
+
+size_t atom_count(void)
+{
+    ATOM_LOCK();
+    const size_t n = g_strings.size;
+    ATOM_UNLOCK();
+    return n;
+}
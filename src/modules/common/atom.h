@@ -0,0 +1,27 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Global string interner. Equal strings get the same atom, so hot lookups compare integers
+// instead of strings. Atoms and the strings behind them live for the whole process and are
+// safe to use from any thread (map preloading parses on a worker). They are handed out in
+// first-seen order, so never persist them: store the string.
+//
+// The _ci variants fold ASCII case first, for names Tiled and the prefab files treat
+// case-insensitively; atom_str of such an atom gives the lowercase form.
+typedef uint32_t atom_t;
+
+#define ATOM_NONE 0u
+
+atom_t atom_intern(const char* s);    // ATOM_NONE for NULL
+atom_t atom_intern_ci(const char* s);
+
+// Lookup only: ATOM_NONE if the string was never interned, which also means no interned
+// name can match it.
+atom_t atom_find(const char* s);
+atom_t atom_find_ci(const char* s);
+atom_t atom_find_join_ci(const char* a, char sep, const char* b); // atom_find_ci("a<sep>b")
+
+const char* atom_str(atom_t a); // NULL for ATOM_NONE or an unknown atom
+size_t      atom_count(void);
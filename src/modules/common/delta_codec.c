@@ -0,0 +1,111 @@
+#include "modules/common/delta_codec.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Matches shorter than a block are cheaper as literals than as a copy op.
+#define DELTA_BLOCK 8
+
+static uint32_t block_hash(const uint8_t* p)
+{
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return (uint32_t)((v * 0x9E3779B97F4A7C15ull) >> 32);
+}
+
+static uint64_t zigzag(int64_t v)
+{
+    return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+static int64_t unzigzag(uint64_t v)
+{
+    return (int64_t)(v >> 1) ^ -(int64_t)(v & 1u);
+}
+
+static void emit_literal(snap_buf_t* out, const uint8_t* p, size_t n)
+{
+    snap_write_varint(out, n);
+    snap_write(out, p, n);
+}
+
+void delta_encode(snap_buf_t* out, const uint8_t* base, size_t base_size,
+                  const uint8_t* target, size_t target_size)
+{
+    // Index every aligned base block; target is scanned at every byte so any shift is found.
+    size_t cap = 64;
+    while (cap < (base_size / DELTA_BLOCK) * 2) cap <<= 1;
+    uint32_t* table = calloc(cap, sizeof(*table)); // base offset + 1, 0 = empty
+    if (!table) {
+        emit_literal(out, target, target_size);
+        if (target_size) snap_write_varint(out, 0);
+        return;
+    }
+    for (size_t p = 0; p + DELTA_BLOCK <= base_size; p += DELTA_BLOCK) {
+        table[block_hash(base + p) & (cap - 1)] = (uint32_t)p + 1;
+    }
+
+    size_t t = 0, lit = 0, expect = 0;
+    while (t + DELTA_BLOCK <= target_size) {
+        // Prefer the diagonal of the previous copy so small in-place edits resume cheaply.
+        size_t s = SIZE_MAX;
+        const size_t diag = expect + (t - lit);
+        if (diag + DELTA_BLOCK <= base_size && memcmp(base + diag, target + t, DELTA_BLOCK) == 0) {
+            s = diag;
+        } else {
+            uint32_t e = table[block_hash(target + t) & (cap - 1)];
+            if (e && memcmp(base + e - 1, target + t, DELTA_BLOCK) == 0) s = e - 1;
+        }
+        if (s == SIZE_MAX) {
+            t++;
+            continue;
+        }
+
+        while (t > lit && s > 0 && base[s - 1] == target[t - 1]) {
+            s--;
+            t--;
+        }
+        size_t len = DELTA_BLOCK;
+        while (t + len < target_size && s + len < base_size && base[s + len] == target[t + len]) len++;
+
+        emit_literal(out, target + lit, t - lit);
+        snap_write_varint(out, len);
+        snap_write_varint(out, zigzag((int64_t)s - (int64_t)expect));
+        t += len;
+        lit = t;
+        expect = s + len;
+    }
+    if (lit < target_size) {
+        emit_literal(out, target + lit, target_size - lit);
+        snap_write_varint(out, 0);
+    }
+    free(table);
+}
+
+bool delta_decode(snap_buf_t* out, const uint8_t* base, size_t base_size,
+                  snap_reader_t* r, size_t target_size)
+{
+    DA_RESERVE(out, out->size + target_size);
+    size_t left = target_size;
+    size_t expect = 0;
+    while (left > 0) {
+        uint64_t lit = 0, len = 0, off = 0;
+        if (!snap_read_varint(r, &lit) || lit > left) return false;
+        if (!snap_read(r, out->data + out->size, (size_t)lit)) return false;
+        out->size += (size_t)lit;
+        left -= (size_t)lit;
+
+        if (!snap_read_varint(r, &len)) return false;
+        if (len == 0) {
+            if (lit == 0) return false; // a no-op can only spin
+            continue;
+        }
+        if (len > left || !snap_read_varint(r, &off)) return false;
+        const int64_t s = (int64_t)expect + unzigzag(off);
+        if (s < 0 || (uint64_t)s > base_size || len > base_size - (uint64_t)s) return false;
+        snap_write(out, base + s, (size_t)len);
+        left -= (size_t)len;
+        expect = (size_t)s + (size_t)len;
+    }
+    return true;
+}
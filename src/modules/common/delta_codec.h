@@ -0,0 +1,17 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "modules/common/snapshot_io.h"
+
+// Binary delta of `target` against `base`: alternating literal runs and copies from base, with
+// varint lengths and copy offsets stored relative to where the previous copy ended. Spans that
+// are unchanged cost a few bytes wherever they moved to (e.g. entity records shifting after a
+// destroy), and in-place edits cost only the changed bytes.
+void delta_encode(snap_buf_t* out, const uint8_t* base, size_t base_size,
+                  const uint8_t* target, size_t target_size);
+
+// Appends exactly target_size bytes to out; false on a malformed or truncated stream.
+bool delta_decode(snap_buf_t* out, const uint8_t* base, size_t base_size,
+                  snap_reader_t* r, size_t target_size);
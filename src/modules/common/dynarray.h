@@ -10,6 +10,17 @@
 #define DA_INIT_CAP 8
 #endif
 
+// Define DA_MEM_TAG (a mem_tag_t) before the first include to count this file's arrays
+// under that tag; otherwise the macros use realloc/free directly.
+#ifdef DA_MEM_TAG
+#include "modules/common/mem_tag.h"
+#define DA_REALLOC_(p, old_bytes, new_bytes) mem_realloc(DA_MEM_TAG, (p), (old_bytes), (new_bytes))
+#define DA_FREE_(p, bytes)                   mem_free(DA_MEM_TAG, (p), (bytes))
+#else
+#define DA_REALLOC_(p, old_bytes, new_bytes) realloc((p), (new_bytes))
+#define DA_FREE_(p, bytes)                   free(p)
+#endif
+
 #define DA(type) \
     struct {     \
         type  *data;     \
@@ -19,16 +30,17 @@
 
 #define DA_CLEAR(da) do { (da)->size = 0; } while (0)
 
-#define DA_FREE(da) do {            \
-    free((da)->data);               \
-    (da)->data = NULL;              \
-    (da)->size = 0;                 \
-    (da)->capacity = 0;             \
+#define DA_FREE(da) do {                                                    \
+    DA_FREE_((da)->data, (da)->capacity * sizeof(*(da)->data));             \
+    (da)->data = NULL;                                                      \
+    (da)->size = 0;                                                         \
+    (da)->capacity = 0;                                                     \
 } while (0)
 
 #define DA_GROW(da) do {                                                    \
     size_t _new_cap = (da)->capacity ? (da)->capacity * 2 : DA_INIT_CAP;    \
-    void* _tmp = realloc((da)->data, _new_cap * sizeof(*(da)->data));       \
+    void* _tmp = DA_REALLOC_((da)->data, (da)->capacity * sizeof(*(da)->data),\
+                             _new_cap * sizeof(*(da)->data));               \
     assert(_tmp && "DA_GROW realloc failed");                               \
     (da)->data = _tmp;                                                      \
     (da)->capacity = _new_cap;                                              \
@@ -39,7 +51,9 @@
     if ((da)->capacity < _need) {                                           \
         size_t _cap = (da)->capacity ? (da)->capacity : DA_INIT_CAP;        \
         while (_cap < _need) _cap *= 2;                                     \
-        void* _tmp = realloc((da)->data, _cap * sizeof(*(da)->data));       \
+        void* _tmp = DA_REALLOC_((da)->data,                                \
+                                 (da)->capacity * sizeof(*(da)->data),      \
+                                 _cap * sizeof(*(da)->data));               \
         assert(_tmp && "DA_RESERVE realloc failed");                        \
         (da)->data = _tmp;                                                  \
         (da)->capacity = _cap;                                              \
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "modules/common/mem_tag.h"
+
+// Open-addressing hash map, Robin Hood probing with backward-shift deletion. HM_DECLARE
+// stamps out a typed map and its functions, in the spirit of DA():
+//
+//   HM_DECLARE(path_map, const char*, int, hm_hash_str, hm_eq_str, MEM_TAG_ASSET)
+//   static path_map_t paths = {0};
+//   path_map_put(&paths, s->path, idx);
+//   int* idx = path_map_get(&paths, path);   // NULL if absent
+//
+// hash_fn(key) returns a uint32_t and eq_fn(a, b) a bool; both take keys by value. Keys are
+// stored as given, so a string key must outlive its entry. Pointers returned by get/put are
+// invalidated by the next put or remove.
+//
+// Each slot keeps the key's hash (0 marks an empty slot), which lets a probe reject most
+// mismatches without calling eq_fn and gives the probe distance without rehashing.
+// Iterate with: for (size_t i = 0; i < m.capacity; ++i) if (HM_SLOT_USED(&m.slots[i])) ...
+
+#ifndef HM_INIT_CAP
+#define HM_INIT_CAP 16
+#endif
+
+#define HM_SLOT_USED(slot) ((slot)->hash != 0)
+
+// ---- key helpers ----
+
+static inline uint32_t hm_mix32(uint32_t x)
+{
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+}
+
+static inline uint32_t hm_hash_u32(uint32_t k) { return hm_mix32(k); }
+static inline uint32_t hm_hash_u64(uint64_t k) { return hm_mix32((uint32_t)k ^ hm_mix32((uint32_t)(k >> 32))); }
+static inline bool     hm_eq_u32(uint32_t a, uint32_t b) { return a == b; }
+static inline bool     hm_eq_u64(uint64_t a, uint64_t b) { return a == b; }
+
+// FNV-1a
+static inline uint32_t hm_hash_bytes(const void* p, size_t n)
+{
+    const uint8_t* s = (const uint8_t*)p;
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < n; ++i) h = (h ^ s[i]) * 16777619u;
+    return h;
+}
+
+static inline uint32_t hm_hash_str(const char* s)
+{
+    uint32_t h = 2166136261u;
+    while (*s) h = (h ^ (uint8_t)*s++) * 16777619u;
+    return h;
+}
+
+static inline bool hm_eq_str(const char* a, const char* b) { return strcmp(a, b) == 0; }
+
+// ASCII case-insensitive, matching tiled_str_ieq.
+static inline char hm_lower_(char c) { return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c; }
+
+static inline uint32_t hm_hash_str_ci(const char* s)
+{
+    uint32_t h = 2166136261u;
+    while (*s) h = (h ^ (uint8_t)hm_lower_(*s++)) * 16777619u;
+    return h;
+}
+
+static inline bool hm_eq_str_ci(const char* a, const char* b)
+{
+    while (*a && hm_lower_(*a) == hm_lower_(*b)) { ++a; ++b; }
+    return hm_lower_(*a) == hm_lower_(*b);
+}
+
+// ---- map ----
+
+#define HM_DECLARE(name, K, V, hash_fn, eq_fn, tag)                                          \
+    typedef struct {                                                                         \
+        uint32_t hash;                                                                       \
+        K        key;                                                                        \
+        V        value;                                                                      \
+    } name##_slot_t;                                                                         \
+                                                                                             \
+    typedef struct {                                                                         \
+        name##_slot_t* slots;                                                                \
+        size_t         size;                                                                 \
+        size_t         capacity; /* 0 or a power of two */                                   \
+    } name##_t;                                                                              \
+                                                                                             \
+    static inline uint32_t name##_hash_(K key)                                               \
+    {                                                                                        \
+        const uint32_t h = hash_fn(key);                                                     \
+        return h ? h : 1u;                                                                   \
+    }                                                                                        \
+                                                                                             \
+    /* Robin Hood insert of a key known to be absent; returns where it landed. */            \
+    static inline V* name##_insert_new_(name##_t* m, name##_slot_t cur)                      \
+    {                                                                                        \
+        const size_t mask = m->capacity - 1;                                                 \
+        size_t i = cur.hash & mask;                                                          \
+        V* placed = NULL;                                                                    \
+        for (size_t dist = 0;; ++dist, i = (i + 1) & mask) {                                 \
+            name##_slot_t* s = &m->slots[i];                                                 \
+            if (!s->hash) {                                                                  \
+                *s = cur;                                                                    \
+                m->size++;                                                                   \
+                return placed ? placed : &s->value;                                          \
+            }                                                                                \
+            const size_t s_dist = (i - s->hash) & mask;                                      \
+            if (s_dist < dist) {                                                             \
+                const name##_slot_t tmp = *s;                                                \
+                *s = cur;                                                                    \
+                cur = tmp;                                                                   \
+                if (!placed) placed = &s->value;                                             \
+                dist = s_dist;                                                               \
+            }                                                                                \
+        }                                                                                    \
+    }                                                                                        \
+                                                                                             \
+    static inline bool name##_reserve(name##_t* m, size_t n)                                 \
+    {                                                                                        \
+        size_t cap = m->capacity ? m->capacity : HM_INIT_CAP;                                \
+        while (n * 8 > cap * 7) cap *= 2; /* keep load <= 7/8 */                             \
+        if (cap == m->capacity) return true;                                                 \
+        name##_slot_t* slots = (name##_slot_t*)mem_calloc((tag), cap, sizeof(name##_slot_t)); \
+        if (!slots) return false;                                                            \
+        name##_t grown = { slots, 0, cap };                                                  \
+        for (size_t i = 0; i < m->capacity; ++i) {                                           \
+            if (m->slots[i].hash) name##_insert_new_(&grown, m->slots[i]);                   \
+        }                                                                                    \
+        mem_free((tag), m->slots, m->capacity * sizeof(name##_slot_t));                      \
+        *m = grown;                                                                          \
+        return true;                                                                         \
+    }                                                                                        \
+                                                                                             \
+    static inline size_t name##_find_(const name##_t* m, K key)                              \
+    {                                                                                        \
+        if (!m->size) return SIZE_MAX;                                                       \
+        const uint32_t h = name##_hash_(key);                                                \
+        const size_t mask = m->capacity - 1;                                                 \
+        size_t i = h & mask;                                                                 \
+        for (size_t dist = 0;; ++dist, i = (i + 1) & mask) {                                 \
+            const name##_slot_t* s = &m->slots[i];                                           \
+            if (!s->hash || ((i - s->hash) & mask) < dist) return SIZE_MAX;                  \
+            if (s->hash == h && eq_fn(s->key, key)) return i;                                \
+        }                                                                                    \
+    }                                                                                        \
+                                                                                             \
+    static inline V* name##_get(const name##_t* m, K key)                                    \
+    {                                                                                        \
+        const size_t i = name##_find_(m, key);                                               \
+        return i == SIZE_MAX ? NULL : &m->slots[i].value;                                    \
+    }                                                                                        \
+                                                                                             \
+    /* Insert or overwrite; NULL only if the table couldn't grow. */                         \
+    static inline V* name##_put(name##_t* m, K key, V value)                                 \
+    {                                                                                        \
+        const size_t i = name##_find_(m, key);                                               \
+        if (i != SIZE_MAX) {                                                                 \
+            m->slots[i].value = value;                                                       \
+            return &m->slots[i].value;                                                       \
+        }                                                                                    \
+        if (!name##_reserve(m, m->size + 1)) return NULL;                                    \
+        const name##_slot_t s = { name##_hash_(key), key, value };                           \
+        return name##_insert_new_(m, s);                                                     \
+    }                                                                                        \
+                                                                                             \
+    static inline bool name##_remove(name##_t* m, K key)                                     \
+    {                                                                                        \
+        size_t i = name##_find_(m, key);                                                     \
+        if (i == SIZE_MAX) return false;                                                     \
+        const size_t mask = m->capacity - 1;                                                 \
+        for (;;) { /* shift the rest of the cluster back one slot */                         \
+            const size_t next = (i + 1) & mask;                                              \
+            const name##_slot_t* n = &m->slots[next];                                        \
+            if (!n->hash || ((next - n->hash) & mask) == 0) break;                           \
+            m->slots[i] = *n;                                                                \
+            i = next;                                                                        \
+        }                                                                                    \
+        m->slots[i].hash = 0;                                                                \
+        m->size--;                                                                           \
+        return true;                                                                         \
+    }                                                                                        \
+                                                                                             \
+    static inline void name##_clear(name##_t* m)                                             \
+    {                                                                                        \
+        if (m->slots) memset(m->slots, 0, m->capacity * sizeof(name##_slot_t));              \
+        m->size = 0;                                                                         \
+    }                                                                                        \
+                                                                                             \
+    static inline void name##_free(name##_t* m)                                              \
+    {                                                                                        \
+        mem_free((tag), m->slots, m->capacity * sizeof(name##_slot_t));                      \
+        m->slots = NULL;                                                                     \
+        m->size = 0;                                                                         \
+        m->capacity = 0;                                                                     \
+    }
@@ -0,0 +1,125 @@
+#include "modules/common/mem_tag.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    int64_t  live_bytes; // signed so a mismatched free shows as a dip, not a wrap to 2^64
+    int64_t  peak_bytes;
+    int64_t  live_blocks;
+    uint64_t alloc_count;
+} tag_counters_t;
+
+static tag_counters_t g_tags[MEM_TAG_COUNT];
+
+static const char* k_tag_names[MEM_TAG_COUNT] = {
+    [MEM_TAG_MISC]   = "misc",
+    [MEM_TAG_TILED]  = "tiled",
+    [MEM_TAG_PREFAB] = "prefab",
+    [MEM_TAG_ECS]    = "ecs",
+    [MEM_TAG_WORLD]  = "world",
+    [MEM_TAG_RENDER] = "render",
+    [MEM_TAG_ASSET]  = "asset",
+};
+
+static tag_counters_t* counters(mem_tag_t tag)
+{
+    return &g_tags[(unsigned)tag < (unsigned)MEM_TAG_COUNT ? tag : MEM_TAG_MISC];
+}
+
+static void account(mem_tag_t tag, int64_t bytes, int64_t blocks, uint64_t allocs)
+{
+    tag_counters_t* c = counters(tag);
+    const int64_t live = __atomic_add_fetch(&c->live_bytes, bytes, __ATOMIC_RELAXED);
+    if (blocks) __atomic_add_fetch(&c->live_blocks, blocks, __ATOMIC_RELAXED);
+    if (allocs) __atomic_add_fetch(&c->alloc_count, allocs, __ATOMIC_RELAXED);
+
+    int64_t peak = __atomic_load_n(&c->peak_bytes, __ATOMIC_RELAXED);
+    while (live > peak &&
+           !__atomic_compare_exchange_n(&c->peak_bytes, &peak, live, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+void* mem_alloc(mem_tag_t tag, size_t size)
+{
+    void* p = malloc(size);
+    if (p) account(tag, (int64_t)size, 1, 1);
+    return p;
+}
+
+void* mem_calloc(mem_tag_t tag, size_t count, size_t size)
+{
+    void* p = calloc(count, size);
+    if (p) account(tag, (int64_t)(count * size), 1, 1);
+    return p;
+}
+
+void* mem_realloc(mem_tag_t tag, void* p, size_t old_size, size_t new_size)
+{
+    if (new_size == 0) {
+        mem_free(tag, p, old_size);
+        return NULL;
+    }
+    void* q = realloc(p, new_size);
+    if (!q) return NULL;
+    if (!p) old_size = 0;
+    account(tag, (int64_t)new_size - (int64_t)old_size, p ? 0 : 1, 1);
+    return q;
+}
+
+void mem_free(mem_tag_t tag, void* p, size_t size)
+{
+    if (!p) return;
+    free(p);
+    account(tag, -(int64_t)size, -1, 0);
+}
+
+char* mem_strdup(mem_tag_t tag, const char* s)
+{
+    if (!s) return NULL;
+    const size_t n = strlen(s) + 1;
+    char* p = (char*)mem_alloc(tag, n);
+    if (p) memcpy(p, s, n);
+    return p;
+}
+
+void mem_free_str(mem_tag_t tag, char* s)
+{
+    if (s) mem_free(tag, s, strlen(s) + 1);
+}
+
+void mem_track_alloc(mem_tag_t tag, size_t size)
+{
+    account(tag, (int64_t)size, 1, 1);
+}
+
+void mem_track_free(mem_tag_t tag, size_t size)
+{
+    account(tag, -(int64_t)size, -1, 0);
+}
+
+const char* mem_tag_name(mem_tag_t tag)
+{
+    return (unsigned)tag < (unsigned)MEM_TAG_COUNT ? k_tag_names[tag] : "?";
+}
+
+void mem_tag_stats(mem_tag_t tag, mem_tag_stats_t* out)
+{
+    if (!out) return;
+    const tag_counters_t* c = counters(tag);
+    const int64_t live = __atomic_load_n(&c->live_bytes, __ATOMIC_RELAXED);
+    const int64_t peak = __atomic_load_n(&c->peak_bytes, __ATOMIC_RELAXED);
+    const int64_t blocks = __atomic_load_n(&c->live_blocks, __ATOMIC_RELAXED);
+    out->live_bytes = live > 0 ? (size_t)live : 0;
+    out->peak_bytes = peak > 0 ? (size_t)peak : 0;
+    out->live_blocks = blocks > 0 ? (uint64_t)blocks : 0;
+    out->alloc_count = __atomic_load_n(&c->alloc_count, __ATOMIC_RELAXED);
+}
+
+void mem_tag_reset_peaks(void)
+{
+    for (int i = 0; i < MEM_TAG_COUNT; ++i) {
+        __atomic_store_n(&g_tags[i].peak_bytes, __atomic_load_n(&g_tags[i].live_bytes, __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Per-subsystem allocation accounting. Subsystems allocate through their tag and pass the
+// block size back when freeing, so the memory itself stays plain malloc memory: a block freed
+// with free() (or through the wrong tag) only skews the numbers, it never corrupts the heap.
+// Counters are atomics, so map preloading on a worker thread is counted too.
+//
+// Dynamic arrays opt in per translation unit: #define DA_MEM_TAG MEM_TAG_WORLD before the
+// first #include and every DA_* macro in that file goes through mem_realloc/mem_free.
+typedef enum {
+    MEM_TAG_MISC = 0,
+    MEM_TAG_TILED,
+    MEM_TAG_PREFAB,
+    MEM_TAG_ECS,
+    MEM_TAG_WORLD,
+    MEM_TAG_RENDER,
+    MEM_TAG_ASSET,
+    MEM_TAG_COUNT
+} mem_tag_t;
+
+typedef struct {
+    size_t   live_bytes;
+    size_t   peak_bytes;
+    uint64_t live_blocks;
+    uint64_t alloc_count;  // every successful alloc/calloc/realloc
+} mem_tag_stats_t;
+
+void* mem_alloc(mem_tag_t tag, size_t size);
+void* mem_calloc(mem_tag_t tag, size_t count, size_t size);
+// old_size is what the block was allocated with (0 when p is NULL); new_size 0 frees it.
+void* mem_realloc(mem_tag_t tag, void* p, size_t old_size, size_t new_size);
+void  mem_free(mem_tag_t tag, void* p, size_t size);
+char* mem_strdup(mem_tag_t tag, const char* s);
+void  mem_free_str(mem_tag_t tag, char* s); // size taken from strlen, so don't shorten it in place
+
+// Record memory a subsystem owns but didn't get from mem_* (bump arenas, texture pixels).
+void mem_track_alloc(mem_tag_t tag, size_t size);
+void mem_track_free(mem_tag_t tag, size_t size);
+
+const char* mem_tag_name(mem_tag_t tag);
+void mem_tag_stats(mem_tag_t tag, mem_tag_stats_t* out);
+void mem_tag_reset_peaks(void); // peak := live, e.g. before measuring a map load
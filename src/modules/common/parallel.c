@@ -0,0 +1,76 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "modules/common/parallel.h"
+
+#if !defined(_WIN32)
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#define PARALLEL_MAX_THREADS 16
+
+static size_t g_max_workers = 0;
+
+typedef struct {
+    parallel_fn fn;
+    void*       user;
+    size_t      count;
+    size_t      next; // claimed with an atomic add
+} parallel_job_t;
+
+static void run_items(parallel_job_t* job)
+{
+    for (;;) {
+        const size_t i = __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED);
+        if (i >= job->count) return;
+        job->fn(job->user, i);
+    }
+}
+
+#if !defined(_WIN32)
+static void* worker_main(void* arg)
+{
+    run_items((parallel_job_t*)arg);
+    return NULL;
+}
+#endif
+
+size_t parallel_worker_count(void)
+{
+    size_t n = 1;
+#if !defined(_WIN32)
+    const long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores > 1) n = (size_t)cores;
+#endif
+    if (g_max_workers > 0 && n > g_max_workers) n = g_max_workers;
+    return n > PARALLEL_MAX_THREADS ? PARALLEL_MAX_THREADS : n;
+}
+
+void parallel_set_max_workers(size_t n)
+{
+    g_max_workers = n;
+}
+
+void parallel_for(size_t count, parallel_fn fn, void* user)
+{
+    if (!fn || count == 0) return;
+    parallel_job_t job = { fn, user, count, 0 };
+
+    size_t workers = parallel_worker_count();
+    if (workers > count) workers = count;
+#if !defined(_WIN32)
+    // A thread that fails to start just leaves its share to the others.
+    pthread_t threads[PARALLEL_MAX_THREADS];
+    size_t started = 0;
+    for (size_t t = 1; t < workers; ++t) {
+        if (pthread_create(&threads[started], NULL, worker_main, &job) == 0) started++;
+    }
+    run_items(&job);
+    for (size_t t = 0; t < started; ++t) pthread_join(threads[t], NULL);
+#else
+    (void)workers;
+    run_items(&job);
+#endif
+}
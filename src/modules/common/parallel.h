@@ -0,0 +1,18 @@
+#pragma once
+
+#include <stddef.h>
+
+// Fork-join helper for load-time work (map parsing, collision builds). parallel_for runs
+// fn(user, i) for every i in [0, count) across up to parallel_worker_count() threads, the
+// calling thread included, and returns once all calls have finished. Indices are handed out
+// one at a time, so uneven items balance out; fn must only touch state owned by its i.
+//
+// Threads are started per call, which is cheap next to a map load but not meant for per-tick
+// work. Without pthreads (or with one worker) everything runs inline, in index order.
+typedef void (*parallel_fn)(void* user, size_t i);
+
+void   parallel_for(size_t count, parallel_fn fn, void* user);
+size_t parallel_worker_count(void);
+
+// 0 (the default) uses every online core; 1 keeps all work on the calling thread.
+void   parallel_set_max_workers(size_t n);
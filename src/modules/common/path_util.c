@@ -0,0 +1,62 @@
+#include "modules/common/path_util.h"
+
+#include <string.h>
+
+#define PATH_UTIL_MAX 512
+
+bool path_normalize(const char* path, char* out, size_t out_cap)
+{
+    if (!path || !out || out_cap == 0) return false;
+
+    size_t seg_start[PATH_UTIL_MAX / 2];
+    size_t depth = 0;
+    size_t n = 0;
+    const bool absolute = path[0] == '/' || path[0] == '\\';
+    if (absolute) {
+        if (out_cap < 2) return false;
+        out[n++] = '/';
+    }
+
+    const char* p = path;
+    while (*p) {
+        while (*p == '/' || *p == '\\') p++;
+        if (!*p) break;
+        const char* seg = p;
+        while (*p && *p != '/' && *p != '\\') p++;
+        const size_t len = (size_t)(p - seg);
+
+        if (len == 1 && seg[0] == '.') continue;
+        if (len == 2 && seg[0] == '.' && seg[1] == '.') {
+            const bool top_is_up = depth > 0 && n - seg_start[depth - 1] == 2 &&
+                                   strncmp(out + seg_start[depth - 1], "..", 2) == 0;
+            if (depth > 0 && !top_is_up) {
+                n = seg_start[--depth];
+                if (n > (absolute ? 1u : 0u)) n--; // drop the separator before it
+                continue;
+            }
+            if (absolute) continue;
+        }
+
+        if (depth >= sizeof(seg_start) / sizeof(seg_start[0])) return false;
+        const size_t sep = (n > (absolute ? 1u : 0u)) ? 1 : 0;
+        if (n + sep + len + 1 > out_cap) return false;
+        if (sep) out[n++] = '/';
+        seg_start[depth++] = n;
+        memcpy(out + n, seg, len);
+        n += len;
+    }
+
+    if (n == 0) {
+        if (out_cap < 2) return false;
+        out[n++] = '.';
+    }
+    out[n] = '\0';
+    return true;
+}
+
+bool path_same(const char* a, const char* b)
+{
+    char na[PATH_UTIL_MAX], nb[PATH_UTIL_MAX];
+    if (!path_normalize(a, na, sizeof(na)) || !path_normalize(b, nb, sizeof(nb))) return false;
+    return strcmp(na, nb) == 0;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Lexical normalisation: '\\' -> '/', drops "." and empty segments, folds "dir/.." pairs.
+// "assets/maps/../prefabs/coin.ent" -> "assets/prefabs/coin.ent". No filesystem access.
+bool path_normalize(const char* path, char* out, size_t out_cap);
+
+// True when both paths name the same file after normalisation.
+bool path_same(const char* a, const char* b);
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "modules/common/dynarray.h"
+
+// Byte stream used by the simulation snapshot (see modules/core/snapshot.h). Each owning
+// module writes a tagged section of raw native-layout data; the blob is only meant to be
+// read back by the same build, which the snapshot header checks.
+typedef DA(uint8_t) snap_buf_t;
+
+typedef struct {
+    const uint8_t* data;
+    size_t size;
+    size_t pos;
+    bool   failed;
+} snap_reader_t;
+
+#define SNAP_TAG(a, b, c, d) \
+    ((uint32_t)(a) | ((uint32_t)(b) << 8) | ((uint32_t)(c) << 16) | ((uint32_t)(d) << 24))
+
+// Appends n uninitialised bytes and returns them, for sections the owner fills in place.
+static inline uint8_t* snap_write_reserve(snap_buf_t* b, size_t n)
+{
+    // Grown by hand rather than DA_RESERVE: this inline body is compiled into files with
+    // different DA_MEM_TAGs, but the blob is always released with plain free().
+    if (b->capacity < b->size + n) {
+        size_t cap = b->capacity ? b->capacity : DA_INIT_CAP;
+        while (cap < b->size + n) cap *= 2;
+        uint8_t* grown = (uint8_t*)realloc(b->data, cap);
+        assert(grown && "snap_write realloc failed");
+        b->data = grown;
+        b->capacity = cap;
+    }
+    uint8_t* dst = b->data + b->size;
+    b->size += n;
+    return dst;
+}
+
+static inline void snap_write(snap_buf_t* b, const void* src, size_t n)
+{
+    if (n == 0) return;
+    memcpy(snap_write_reserve(b, n), src, n);
+}
+
+static inline bool snap_read(snap_reader_t* r, void* dst, size_t n)
+{
+    if (r->failed || n > r->size - r->pos) {
+        r->failed = true;
+        return false;
+    }
+    if (n > 0) memcpy(dst, r->data + r->pos, n);
+    r->pos += n;
+    return true;
+}
+
+#define SNAP_WRITE_VAL(b, v) snap_write((b), &(v), sizeof(v))
+#define SNAP_READ_VAL(r, v)  snap_read((r), &(v), sizeof(v))
+
+static inline void snap_write_tag(snap_buf_t* b, uint32_t tag)
+{
+    SNAP_WRITE_VAL(b, tag);
+}
+
+static inline bool snap_expect_tag(snap_reader_t* r, uint32_t tag)
+{
+    uint32_t got = 0;
+    if (!SNAP_READ_VAL(r, got) || got != tag) {
+        r->failed = true;
+        return false;
+    }
+    return true;
+}
+
+// LEB128 varints for the compact encodings layered on top (save games).
+static inline void snap_write_varint(snap_buf_t* b, uint64_t v)
+{
+    uint8_t tmp[10];
+    size_t n = 0;
+    do {
+        uint8_t byte = (uint8_t)(v & 0x7Fu);
+        v >>= 7;
+        tmp[n++] = byte | (v ? 0x80u : 0u);
+    } while (v);
+    snap_write(b, tmp, n);
+}
+
+static inline bool snap_read_varint(snap_reader_t* r, uint64_t* out)
+{
+    uint64_t v = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        uint8_t byte = 0;
+        if (!SNAP_READ_VAL(r, byte)) return false;
+        v |= (uint64_t)(byte & 0x7Fu) << shift;
+        if (!(byte & 0x80u)) {
+            *out = v;
+            return true;
+        }
+    }
+    r->failed = true;
+    return false;
+}
@@ -16,3 +16,24 @@
 #ifndef DEBUG_FPS
 #define DEBUG_FPS DEBUG_BUILD
 #endif
+
+// Trace markers (modules/core/trace.h); compiled out of release builds.
+#ifndef ENGINE_TRACE
+#define ENGINE_TRACE DEBUG_BUILD
+#endif
+
+// Default fixed simulation rate (Hz); render rate is independent and interpolated.
+#ifndef SIM_HZ
+#define SIM_HZ 60
+#endif
+
+// Autosave interval (seconds of simulated time) when SAVE_GAME=<file> is set.
+#ifndef AUTOSAVE_SECONDS
+#define AUTOSAVE_SECONDS 5
+#endif
+
+// Maps with at least this many tiles are streamed in chunks instead of loaded whole
+// (modules/world/world_stream.h). 512x512 keeps every shipped map dense.
+#ifndef WORLD_STREAM_MIN_TILES
+#define WORLD_STREAM_MIN_TILES (512 * 512)
+#endif
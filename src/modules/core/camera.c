@@ -54,6 +54,15 @@ camera_config_t camera_get_config(void) {
     return g_camera.config;
 }
 
+void camera_snapshot_write(snap_buf_t* b) {
+    snap_write_tag(b, SNAP_TAG('C','A','M','0'));
+    SNAP_WRITE_VAL(b, g_camera);
+}
+
+bool camera_snapshot_read(snap_reader_t* r) {
+    return snap_expect_tag(r, SNAP_TAG('C','A','M','0')) && SNAP_READ_VAL(r, g_camera);
+}
+
 void camera_set_config(const camera_config_t* cfg) {
     if (!cfg) return;
     g_camera.config = *cfg;
@@ -68,7 +77,7 @@ void camera_set_config(const camera_config_t* cfg) {
 static v2f camera_target_position(void) {
     v2f desired = g_camera.config.position;
     v2f entity_pos;
-    if (!ecs_get_position(g_camera.config.target, &entity_pos)) {
+    if (!ecs_get_render_position(g_camera.config.target, &entity_pos)) {
         return desired;
     }
 
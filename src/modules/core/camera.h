@@ -1,6 +1,7 @@
 #pragma once
 #include "modules/core/engine_types.h"
 #include "modules/ecs/ecs.h"
+#include "modules/common/snapshot_io.h"
 
 typedef struct {
     ecs_entity_t target;
@@ -25,3 +26,7 @@ camera_config_t camera_get_config(void);
 void camera_set_config(const camera_config_t* cfg);
 void camera_tick(float dt);
 camera_view_t camera_get_view(void);
+
+// Snapshot section: config plus the smoothed current position.
+void camera_snapshot_write(snap_buf_t* b);
+bool camera_snapshot_read(snap_reader_t* r);
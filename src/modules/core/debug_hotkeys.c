@@ -10,8 +10,11 @@
 #include "modules/core/logger.h"
 #include "modules/core/cmp_print.h"
 #include "modules/core/debug_hotkeys.h"
+#include "modules/core/trace.h"
 #include "modules/ecs/ecs_internal.h"
 #include "modules/ecs/ecs_game.h"
+#include "modules/ecs/ecs_physics.h"
+#include "modules/ecs/ecs_proximity.h"
 #include "modules/core/engine.h"
 #include "modules/world/world.h"
 #include "modules/systems/systems_registration.h"
@@ -19,6 +22,34 @@
 #include <math.h>
 #include <stdio.h>
 
+// Write the trace buffers to traces/trace_#####.json (next free index).
+static void debug_dump_trace(void)
+{
+    const char* dir = "traces";
+    if (!DirectoryExists(dir) && !MakeDirectory(dir)) {
+        ui_toast(2.0f, "Trace failed: can't create '%s'", dir);
+        return;
+    }
+
+    static int s_next = 0;
+    char path[512];
+    for (int attempt = 0; attempt < 10000; ++attempt) {
+        int idx = s_next + attempt;
+        snprintf(path, sizeof(path), "%s/trace_%05d.json", dir, idx);
+        if (FileExists(path)) continue;
+
+        s_next = idx + 1;
+        if (trace_write_json(path)) {
+            ui_toast(2.0f, "Saved trace: %s", path);
+        } else {
+            ui_toast(2.0f, "Trace failed: %s", path);
+        }
+        return;
+    }
+
+    ui_toast(2.0f, "Trace failed: no free filename");
+}
+
 void sys_debug_binds(const input_t* in)
 {
     if (input_pressed(in, BTN_ASSET_DEBUG_PRINT)) {
@@ -54,6 +85,11 @@ void sys_debug_binds(const input_t* in)
         ui_toast(1.0f, "TMX reload: %s (%dx%d tiles)", ok ? "ok" : "failed", w, h);
     }
 
+    if (input_pressed(in, BTN_DEBUG_RESTART)) {
+        bool ok = engine_restart_level();
+        ui_toast(1.0f, "Level restart: %s", ok ? "ok" : "failed");
+    }
+
     static bool s_inspect_mode = false;
     if (input_pressed(in, BTN_DEBUG_INSPECT)) {
         s_inspect_mode = !s_inspect_mode;
@@ -166,6 +202,22 @@ void sys_debug_binds(const input_t* in)
         bool on = renderer_toggle_fps_overlay();
         ui_toast(1.0f, "FPS overlay: %s", on ? "on" : "off");
     }
+
+    if (input_pressed(in, BTN_DEBUG_PROFILER)) {
+        bool on = renderer_toggle_profiler_overlay();
+        ui_toast(1.0f, "Profiler overlay: %s", on ? "on" : "off");
+    }
+
+    if (input_pressed(in, BTN_DEBUG_TRACE)) {
+        debug_dump_trace();
+    }
+
+    if (input_pressed(in, BTN_DEBUG_BROADPHASE)) {
+        ecs_broadphase_kind_t next = (ecs_broadphase_kind_t)((ecs_physics_broadphase() + 1) % ECS_BROADPHASE_COUNT);
+        ecs_physics_set_broadphase(next);
+        ecs_proximity_set_broadphase(next);
+        ui_toast(1.0f, "Broadphase: %s", ecs_broadphase_kind_name(next));
+    }
 }
 
 void debug_post_frame(void)
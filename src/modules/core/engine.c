@@ -2,6 +2,7 @@
 #include "modules/core/logger.h"
 #include "modules/core/logger_raylib_adapter.h"
 #include "modules/core/input.h"
+#include "modules/core/input_record.h"
 #include "modules/asset/asset.h"
 #include "modules/ecs/ecs.h"
 #include "modules/ecs/ecs_game.h"
@@ -10,19 +11,58 @@
 #include "modules/renderer/renderer.h"
 #include "modules/core/camera.h"
 #include "modules/world/world.h"
+#include "modules/world/world_renderer.h"
 #include "modules/systems/systems.h"
 #include "modules/systems/systems_registration.h"
 #include "modules/core/platform.h"
 #include "modules/core/time.h"
+#include "modules/core/build_config.h"
+#include "modules/core/trace.h"
+#include "modules/core/snapshot.h"
+#include "modules/core/savegame.h"
+#include "modules/core/hot_reload.h"
+#include "modules/core/map_manager.h"
+#include "modules/core/frame_alloc.h"
+#include "modules/core/metrics.h"
+#include "modules/ecs/ecs_prefab_loading.h"
+#include "modules/prefab/prefab_cmp.h"
 
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <math.h>
 
 static char g_current_tmx_path[256] = "assets/maps/start.tmx";
+static int g_sim_hz = SIM_HZ;
+static snapshot_t g_restart_snapshot; // state right after the current map was loaded
+static snapshot_t g_map_baseline;     // fresh spawn of the current map; save games delta against it
+static char g_current_spawn[64];      // spawn object the player arrived at; "" = map default
+static const char* g_autosave_path;   // SAVE_GAME env; NULL = no autosave
+static char g_pending_map[MAP_MANAGER_PATH_MAX]; // engine_change_map target; "" = none
+static char g_pending_spawn[64];
+static bool g_links_armed; // false after arriving on a link until the player steps off it
+
+// Gauges sampled once per tick (counters/histograms live in their modules).
+static metric_t* g_m_live_entities;
+static metric_t* g_m_texture_slots;
+static metric_t* g_m_tick_arena_bytes;
+static metric_t* g_m_tick_arena_peak;
+
+void engine_set_sim_hz(int hz)
+{
+    if (hz < ENGINE_SIM_HZ_MIN) hz = ENGINE_SIM_HZ_MIN;
+    if (hz > ENGINE_SIM_HZ_MAX) hz = ENGINE_SIM_HZ_MAX;
+    g_sim_hz = hz;
+}
+
+int engine_sim_hz(void)
+{
+    return g_sim_hz;
+}
 
 static void remember_tmx_path(const char* path)
 {
-    if (!path) return;
+    if (!path || path == g_current_tmx_path) return;
     strncpy(g_current_tmx_path, path, sizeof(g_current_tmx_path));
     g_current_tmx_path[sizeof(g_current_tmx_path) - 1] = '\0';
 }
@@ -48,6 +88,48 @@ static void sync_camera_to_world(bool snap_to_center)
     camera_set_config(&cam_cfg);
 }
 
+// Move the player to the centre of the object named spawn_name in the current map.
+static void place_player_at_spawn(const char* spawn_name)
+{
+    const world_map_t* map = world_get_map();
+    ecs_entity_t player = ecs_find_player();
+    if (!map || !spawn_name || !spawn_name[0] || !ecs_get_position(player, NULL)) return;
+
+    for (size_t i = 0; i < map->object_count; ++i) {
+        const tiled_object_t* obj = &map->objects[i];
+        if (!obj->name || strcmp(obj->name, spawn_name) != 0) continue;
+        const v2f at = prefab_object_position_default(obj);
+        cmp_add_position(player, at.x, at.y);
+        return;
+    }
+    LOGC(LOGCAT_MAIN, LOG_LVL_WARN, "map change: no spawn object '%s'", spawn_name);
+}
+
+// Spawns the current map's entities into an emptied ECS. g_map_baseline is taken before the
+// player moves to spawn_name, so it holds the same bytes a fresh launch of this map does and
+// saves made here load from any other map; g_restart_snapshot is the state on arrival.
+static void spawn_map_entities(const ecs_prefab_templates_t* templates, const char* spawn_name)
+{
+    ecs_prefab_use_templates(templates);
+    init_entities(g_current_tmx_path);
+    ecs_prefab_use_templates(NULL);
+    sync_camera_to_world(true);
+    snapshot_capture(&g_map_baseline);
+
+    place_player_at_spawn(spawn_name);
+    ecs_store_prev_positions(); // don't interpolate from the old map's positions
+    float px, py;
+    if (ecs_get_player_position(&px, &py)) {
+        camera_config_t cam_cfg = camera_get_config();
+        cam_cfg.position = v2f_make(px, py);
+        camera_set_config(&cam_cfg);
+    }
+    snapshot_capture(&g_restart_snapshot);
+    if (spawn_name != g_current_spawn) {
+        snprintf(g_current_spawn, sizeof(g_current_spawn), "%s", spawn_name ? spawn_name : "");
+    }
+}
+
 static bool reload_world_from_path(const char* tmx_path)
 {
     if (!tmx_path) tmx_path = g_current_tmx_path;
@@ -72,7 +154,50 @@ static bool reload_world_from_path(const char* tmx_path)
     }
 
     sync_camera_to_world(false);
+    const bool same_map = strcmp(previous_path, tmx_path) == 0;
     remember_tmx_path(tmx_path);
+
+    // Play carries on across the reload, but the restart state and save baseline come from a
+    // fresh spawn on the new tiles, as the next launch would make them.
+    snapshot_t live = {0};
+    if (snapshot_capture(&live)) {
+        ecs_destroy_all();
+        spawn_map_entities(NULL, same_map ? g_current_spawn : NULL);
+        if (!snapshot_restore(&live)) {
+            LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "reload: couldn't put play back on '%s'; restarted it", tmx_path);
+        }
+    }
+    snapshot_free(&live);
+    map_manager_set_current(world_get_map(), g_current_tmx_path);
+    return true;
+}
+
+// The swap itself: everything slow (parse, collision, prefab files) was done by the map
+// manager's thread, leaving the ECS respawn and the renderer bind.
+static bool change_map_now(const char* tmx_path, const char* spawn_name)
+{
+    TRACE_BEGIN("map_change");
+    map_preload_t next;
+    if (!map_manager_take(tmx_path, &next)) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "map change: can't load '%s'", tmx_path);
+        TRACE_END();
+        return false;
+    }
+
+    ecs_destroy_all();
+    world_install_prepared(next.world);
+    next.world = NULL;
+    if (!renderer_bind_world_map()) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "map change: renderer can't bind '%s'", tmx_path);
+    }
+    remember_tmx_path(tmx_path);
+
+    spawn_map_entities(next.templates, spawn_name);
+    map_preload_free(&next);
+    map_manager_set_current(world_get_map(), g_current_tmx_path);
+    g_links_armed = false;
+    LOGC(LOGCAT_MAIN, LOG_LVL_INFO, "map change: now in '%s'", g_current_tmx_path);
+    TRACE_END();
     return true;
 }
 
@@ -81,10 +206,21 @@ static bool engine_init_subsystems(const char *title)
     platform_init();
     logger_use_raylib();
     log_set_min_level(LOG_LVL_DEBUG);
+    // LOG_LEVELS="RENDER=error,ECS=trace" quiets or opens up categories without a rebuild.
+    const char* log_levels = getenv("LOG_LEVELS");
+    if (log_levels && *log_levels && !log_configure(log_levels)) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_WARN, "LOG_LEVELS: ignored bad entries in '%s'", log_levels);
+    }
+    log_set_async(true); // sinks run on the log thread; the loop never waits on stdout
 
     ui_toast_init();
 
     input_init_defaults();
+    // INPUT_RECORD=<file> saves every tick's input; INPUT_REPLAY=<file> feeds it back (headless).
+    const char* record_path = getenv("INPUT_RECORD");
+    if (record_path && *record_path) input_record_open(record_path);
+    const char* replay_path = getenv("INPUT_REPLAY");
+    if (replay_path && *replay_path) input_replay_open(replay_path);
     asset_init();
     ecs_init();
     systems_registration_init();
@@ -118,9 +254,40 @@ static bool engine_init_subsystems(const char *title)
     cam_cfg.deadzone_y = 16.0f;
     camera_set_config(&cam_cfg);
 
+    snapshot_capture(&g_map_baseline);
+    snapshot_capture(&g_restart_snapshot);
+    g_current_spawn[0] = '\0';
+    g_pending_map[0] = '\0';
+    g_links_armed = false;
+    map_manager_set_current(world_get_map(), g_current_tmx_path);
+    hot_reload_init("assets");
+
+    g_m_live_entities    = metrics_gauge("ecs_live_entities", "Entities alive", NULL);
+    g_m_texture_slots    = metrics_gauge("asset_texture_slots_used", "Texture slots in use", NULL);
+    g_m_tick_arena_bytes = metrics_gauge("frame_arena_tick_bytes", "Tick arena bytes used by the last tick", NULL);
+    g_m_tick_arena_peak  = metrics_gauge("frame_arena_tick_high_water_bytes", "Most tick arena bytes any tick has used", NULL);
+    // METRICS_ADDR=9100 | localhost:9100 | unix:/tmp/game.sock serves Prometheus text on loopback.
+    const char* metrics_addr = getenv("METRICS_ADDR");
+    if (metrics_addr && *metrics_addr) metrics_serve(metrics_addr);
+
+    // SAVE_GAME=<file> resumes from that save if it exists and autosaves to it while running.
+    const char* save_path = getenv("SAVE_GAME");
+    if (save_path && *save_path) {
+        g_autosave_path = save_path;
+        // A save that exists but won't load turns autosave off (see engine_load_game).
+        if (!engine_load_game(save_path) && g_autosave_path) {
+            LOGC(LOGCAT_MAIN, LOG_LVL_INFO, "savegame: starting '%s' fresh; autosaving to '%s'",
+                 g_current_tmx_path, save_path);
+        }
+    }
     return true;
 }
 
+void engine_set_start_map(const char* tmx_path)
+{
+    remember_tmx_path(tmx_path);
+}
+
 bool engine_init(const char *title)
 {
     if (!engine_init_subsystems(title)) {
@@ -136,35 +303,71 @@ bool engine_init(const char *title)
 
 int engine_run(void)
 {
-    const float FIXED_DT = 1.0f / 60.0f;
     float acc = 0.0f;
+    int ticks_since_save = 0;
 
+    TRACE_BEGIN("engine_run");
     while (!platform_should_close()) {
+        TRACE_BEGIN("frame");
         input_begin_frame();
 
+        // Read per frame so a rate change takes effect on the next tick.
+        const float FIXED_DT = 1.0f / (float)g_sim_hz;
         float frame = time_frame_dt();
         if (frame > 0.25f) frame = 0.25f;  // avoid spiral of death
         acc += frame;
 
         while (acc >= FIXED_DT) {
             input_t in = input_for_tick();
+            ecs_store_prev_positions();
             systems_tick(FIXED_DT, &in);
+            engine_after_tick();
             acc -= FIXED_DT;
+            if (g_autosave_path && ++ticks_since_save >= g_sim_hz * AUTOSAVE_SECONDS) {
+                engine_save_game(g_autosave_path);
+                ticks_since_save = 0;
+            }
         }
+        // Draw the fraction of the way from the previous tick's state to the current one.
+        ecs_set_render_alpha(acc / FIXED_DT);
         systems_present(frame);
+        TRACE_END();
     }
+    TRACE_END();
 
     return 0;
 }
 
 void engine_shutdown(void)
 {
+#if ENGINE_TRACE
+    const char* trace_path = getenv("ENGINE_TRACE_JSON");
+    if (trace_path && *trace_path) trace_write_json(trace_path);
+#endif
+    const char* csv = getenv("HEADLESS_PROFILE_CSV");
+    if (csv && *csv && systems_profile_write_csv(csv)) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_INFO, "profile: wrote %s", csv);
+    }
+    input_record_close();
+    input_replay_close();
+    if (g_autosave_path) engine_save_game(g_autosave_path);
+    g_autosave_path = NULL;
+    savegame_shutdown();
+    hot_reload_shutdown();
+    map_manager_shutdown();
+    ecs_prefab_loading_shutdown();
+    metrics_shutdown();
+    snapshot_free(&g_restart_snapshot);
+    snapshot_free(&g_map_baseline);
     ecs_phys_destroy_all();
     ecs_shutdown();
     asset_shutdown();
     renderer_shutdown();
     camera_shutdown();
     world_shutdown();
+    frame_alloc_shutdown();
+    trace_shutdown(); // exported above; the preload thread is joined by now
+    log_set_async(false);
 }
 
 bool engine_reload_world(void)
@@ -173,8 +376,128 @@ bool engine_reload_world(void)
     return reload_world_from_path(g_current_tmx_path);
 }
 
+const char* engine_current_map(void)
+{
+    return g_current_tmx_path;
+}
+
 bool engine_reload_world_from_path(const char* tmx_path)
 {
     // When reloading a specific TMX (e.g. hot reload), avoid snapping to spawn.
     return reload_world_from_path(tmx_path);
 }
+
+bool engine_restart_level(void)
+{
+    return snapshot_restore(&g_restart_snapshot);
+}
+
+bool engine_save_game(const char* path)
+{
+    snapshot_t now = {0};
+    snap_buf_t save = {0};
+    bool ok = snapshot_capture(&now) && savegame_encode(&save, &g_map_baseline, &now, g_current_tmx_path);
+    snapshot_free(&now);
+    if (ok) savegame_write_async(path, &save);
+    DA_FREE(&save);
+    return ok;
+}
+
+// Applies a save read from disk, switching maps first when it was made on another one. If it
+// fails, play is back where it was.
+static bool apply_save(const snap_buf_t* save)
+{
+    char map_path[sizeof(g_current_tmx_path)];
+    if (!savegame_map_path(save->data, save->size, map_path, sizeof(map_path))) return false;
+
+    char previous_map[sizeof(g_current_tmx_path)];
+    char previous_spawn[sizeof(g_current_spawn)];
+    memcpy(previous_map, g_current_tmx_path, sizeof(previous_map));
+    memcpy(previous_spawn, g_current_spawn, sizeof(previous_spawn));
+
+    // The save is a delta against its map's fresh spawn, so another map's save needs the whole
+    // map change, respawn included, before it decodes.
+    const bool other_map = strcmp(map_path, g_current_tmx_path) != 0;
+    snapshot_t before = {0};
+    const bool have_before = other_map && snapshot_capture(&before);
+    bool ok = !other_map || change_map_now(map_path, NULL);
+
+    // snapshot_restore is all-or-nothing, so a bad save for the current map leaves play as it was.
+    snapshot_t snap = {0};
+    ok = ok && savegame_decode(&snap, &g_map_baseline, save->data, save->size) && snapshot_restore(&snap);
+    snapshot_free(&snap);
+
+    if (!ok && strcmp(previous_map, g_current_tmx_path) != 0) {
+        // Don't strand the player on a fresh copy of the save's map.
+        const size_t body = snapshot_body_offset();
+        snapshot_t back = {0};
+        if (!change_map_now(previous_map, previous_spawn)) {
+            LOGC(LOGCAT_MAIN, LOG_LVL_FATAL, "savegame: failed to return to '%s'", previous_map);
+        } else if (have_before && !(snapshot_wrap_body(&back, before.data + body, before.size - body) &&
+                                    snapshot_restore(&back))) {
+            LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "savegame: back in '%s' but play restarted from its spawn", previous_map);
+        }
+        snapshot_free(&back);
+    }
+    snapshot_free(&before);
+    return ok;
+}
+
+bool engine_load_game(const char* path)
+{
+    snap_buf_t save = {0};
+    if (!savegame_read_file(path, &save)) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_WARN, "savegame: can't read '%s'", path ? path : "");
+        DA_FREE(&save);
+        return false;
+    }
+
+    const bool ok = apply_save(&save);
+    if (ok) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_INFO, "savegame: loaded '%s' (%zu bytes)", path, save.size);
+    } else {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "savegame: couldn't load '%s'", path);
+        // Autosaving now would overwrite the player's real progress with whatever this is.
+        if (g_autosave_path && strcmp(g_autosave_path, path) == 0) {
+            LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "savegame: not autosaving over '%s' this session", path);
+            g_autosave_path = NULL;
+        }
+    }
+    DA_FREE(&save);
+    return ok;
+}
+
+bool engine_change_map(const char* tmx_path, const char* spawn_name)
+{
+    if (!tmx_path || strlen(tmx_path) >= sizeof(g_pending_map)) return false;
+    snprintf(g_pending_map, sizeof(g_pending_map), "%s", tmx_path);
+    snprintf(g_pending_spawn, sizeof(g_pending_spawn), "%s", spawn_name ? spawn_name : "");
+    map_manager_preload(tmx_path); // usually already there via the current map's links
+    return true;
+}
+
+void engine_after_tick(void)
+{
+    metrics_set(g_m_live_entities, (double)ecs_live_count());
+    metrics_set(g_m_texture_slots, (double)asset_texture_slots_used());
+    metrics_set(g_m_tick_arena_bytes, (double)frame_alloc_used(FRAME_ARENA_TICK));
+    metrics_set(g_m_tick_arena_peak, (double)frame_alloc_high_water(FRAME_ARENA_TICK));
+
+    float px, py;
+    if (ecs_get_player_position(&px, &py)) {
+        const map_link_t* link = map_manager_link_at(px, py);
+        if (!link) {
+            g_links_armed = true;
+        } else if (g_links_armed && !g_pending_map[0]) {
+            engine_change_map(link->target_map, link->target_spawn);
+        }
+    }
+
+    if (!g_pending_map[0]) return;
+    char path[sizeof(g_pending_map)];
+    char spawn[sizeof(g_pending_spawn)];
+    memcpy(path, g_pending_map, sizeof(path));
+    memcpy(spawn, g_pending_spawn, sizeof(spawn));
+    g_pending_map[0] = '\0';
+    change_map_now(path, spawn);
+}
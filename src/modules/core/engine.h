@@ -1,9 +1,32 @@
 #pragma once
 #include <stdbool.h>
 
+// Map loaded by engine_init (default assets/maps/start.tmx); call before engine_init.
+void engine_set_start_map(const char* tmx_path);
 bool engine_init(const char *title);
 // returns process exit code (0 OK, non-zero error)
 int engine_run(void);
 void engine_shutdown(void);
 bool engine_reload_world(void);
+const char* engine_current_map(void); // TMX path of the loaded map
 bool engine_reload_world_from_path(const char* tmx_path);
+// Go to another map at the next tick boundary, arriving at the object named spawn_name (NULL or
+// "" = the map's own player spawn). Maps linked from the current one (map_manager.h) are already
+// preloaded, and walking into a link calls this.
+bool engine_change_map(const char* tmx_path, const char* spawn_name);
+void engine_after_tick(void); // map links + queued map change; call after every systems_tick
+// Restore the snapshot taken when the current map finished loading (no TMX parse or respawn).
+bool engine_restart_level(void);
+// Save = delta of the live state against the map's fresh spawn (before the player is moved to
+// the arrival spawn); writing happens on a background thread.
+bool engine_save_game(const char* path);
+// Changes to the saved map first if it isn't the current one. A save that exists but won't load
+// leaves play as it was and stops autosaving over that file.
+bool engine_load_game(const char* path);
+
+// Fixed simulation rate; rendering interpolates between ticks so this can sit below the display rate.
+void engine_set_sim_hz(int hz); // clamped to [ENGINE_SIM_HZ_MIN, ENGINE_SIM_HZ_MAX]
+int engine_sim_hz(void);
+
+#define ENGINE_SIM_HZ_MIN 10
+#define ENGINE_SIM_HZ_MAX 240
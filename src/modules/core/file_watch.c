@@ -0,0 +1,170 @@
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE
+#endif
+
+#include "modules/core/file_watch.h"
+#include "modules/core/logger.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__linux__)
+
+#include <dirent.h>
+#include <errno.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define FILE_WATCH_MAX_DIRS 256
+#define FILE_WATCH_MAX_BATCH 64
+
+typedef struct {
+    int  wd;
+    char path[FILE_WATCH_PATH_MAX];
+} watch_dir_t;
+
+static int         g_fd = -1;
+static watch_dir_t g_dirs[FILE_WATCH_MAX_DIRS];
+static size_t      g_dir_count;
+
+static const watch_dir_t* dir_for_wd(int wd)
+{
+    for (size_t i = 0; i < g_dir_count; ++i) {
+        if (g_dirs[i].wd == wd) return &g_dirs[i];
+    }
+    return NULL;
+}
+
+static void add_dir_recursive(const char* path)
+{
+    if (g_dir_count >= FILE_WATCH_MAX_DIRS) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_WARN, "file_watch: directory limit (%d) reached, '%s' not watched",
+             FILE_WATCH_MAX_DIRS, path);
+        return;
+    }
+    const int wd = inotify_add_watch(g_fd, path, IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+    if (wd < 0) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_WARN, "file_watch: can't watch '%s' (%s)", path, strerror(errno));
+        return;
+    }
+    if (!dir_for_wd(wd)) {
+        watch_dir_t* d = &g_dirs[g_dir_count++];
+        d->wd = wd;
+        snprintf(d->path, sizeof(d->path), "%s", path);
+    }
+
+    DIR* dir = opendir(path);
+    if (!dir) return;
+    struct dirent* ent;
+    while ((ent = readdir(dir)) != NULL) {
+        if (ent->d_name[0] == '.') continue;
+        char child[FILE_WATCH_PATH_MAX];
+        if (snprintf(child, sizeof(child), "%s/%s", path, ent->d_name) >= (int)sizeof(child)) continue;
+        struct stat st;
+        if (stat(child, &st) == 0 && S_ISDIR(st.st_mode)) add_dir_recursive(child);
+    }
+    closedir(dir);
+}
+
+bool file_watch_open(const char* root_dir)
+{
+    file_watch_close();
+    if (!root_dir) return false;
+
+    g_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (g_fd < 0) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_WARN, "file_watch: inotify unavailable (%s)", strerror(errno));
+        return false;
+    }
+    add_dir_recursive(root_dir);
+    if (g_dir_count == 0) {
+        file_watch_close();
+        return false;
+    }
+    LOGC(LOGCAT_MAIN, LOG_LVL_INFO, "file_watch: watching '%s' (%zu dirs)", root_dir, g_dir_count);
+    return true;
+}
+
+void file_watch_close(void)
+{
+    if (g_fd >= 0) close(g_fd);
+    g_fd = -1;
+    g_dir_count = 0;
+}
+
+bool file_watch_active(void)
+{
+    return g_fd >= 0;
+}
+
+size_t file_watch_poll(file_watch_fn fn, void* user)
+{
+    if (g_fd < 0) return 0;
+
+    // Collect a batch first so repeated events for one file (write, then close) report once.
+    static char batch[FILE_WATCH_MAX_BATCH][FILE_WATCH_PATH_MAX];
+    size_t count = 0;
+
+    union {
+        struct inotify_event ev; // alignment
+        char bytes[4096];
+    } buf;
+    for (;;) {
+        const ssize_t n = read(g_fd, buf.bytes, sizeof(buf.bytes));
+        if (n <= 0) break;
+
+        for (char* p = buf.bytes; p < buf.bytes + n; ) {
+            const struct inotify_event* ev = (const struct inotify_event*)p;
+            p += sizeof(*ev) + ev->len;
+
+            const watch_dir_t* dir = dir_for_wd(ev->wd);
+            if (!dir || ev->len == 0 || ev->name[0] == '.') continue;
+
+            char path[FILE_WATCH_PATH_MAX];
+            if (snprintf(path, sizeof(path), "%s/%s", dir->path, ev->name) >= (int)sizeof(path)) continue;
+
+            if (ev->mask & IN_ISDIR) {
+                if (ev->mask & (IN_CREATE | IN_MOVED_TO)) add_dir_recursive(path);
+                continue;
+            }
+            if (!(ev->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))) continue;
+
+            bool seen = false;
+            for (size_t i = 0; i < count && !seen; ++i) seen = strcmp(batch[i], path) == 0;
+            if (!seen && count < FILE_WATCH_MAX_BATCH) {
+                memcpy(batch[count++], path, sizeof(path));
+            }
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (fn) fn(batch[i], user);
+    }
+    return count;
+}
+
+#else
+
+bool file_watch_open(const char* root_dir)
+{
+    (void)root_dir;
+    LOGC(LOGCAT_MAIN, LOG_LVL_INFO, "file_watch: not supported on this platform");
+    return false;
+}
+
+void file_watch_close(void) {}
+
+bool file_watch_active(void)
+{
+    return false;
+}
+
+size_t file_watch_poll(file_watch_fn fn, void* user)
+{
+    (void)fn;
+    (void)user;
+    return 0;
+}
+
+#endif
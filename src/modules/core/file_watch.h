@@ -0,0 +1,20 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+  Recursive directory watcher for hot reload. On Linux this is inotify (one watch per
+  directory, new subdirectories are picked up as they appear); elsewhere open fails and
+  poll reports nothing.
+
+  poll is non-blocking and reports each file written or renamed into place since the last
+  call once, even when an editor produced several events for it.
+*/
+#define FILE_WATCH_PATH_MAX 512
+
+typedef void (*file_watch_fn)(const char* path, void* user);
+
+bool   file_watch_open(const char* root_dir);
+void   file_watch_close(void);
+bool   file_watch_active(void);
+size_t file_watch_poll(file_watch_fn fn, void* user); // returns files reported
@@ -0,0 +1,83 @@
+#include "modules/core/frame_alloc.h"
+#include "modules/asset/bump_alloc.h"
+#include "modules/core/logger.h"
+
+#if defined(__GNUC__)
+#define FRAME_ALLOC_TLS __thread
+#else
+// No TLS: worker arenas fall back to one shared arena (single-threaded builds only).
+#define FRAME_ALLOC_TLS
+#endif
+
+static bump_alloc_t g_arenas[FRAME_ARENA_COUNT];
+static FRAME_ALLOC_TLS bump_alloc_t g_thread_arena;
+
+static void* arena_alloc(bump_alloc_t* a, size_t size, size_t align)
+{
+    if (align == 0 || (align & (align - 1)) != 0) return NULL;
+    if (!a->data && !bump_init(a, FRAME_ALLOC_INITIAL_BYTES)) return NULL;
+    return bump_alloc_aligned(a, size, align);
+}
+
+static void arena_reset(bump_alloc_t* a)
+{
+    const size_t before = a->capacity;
+    bump_reset(a);
+    if (a->capacity != before) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_DEBUG, "frame_alloc: arena coalesced into one %zu byte chunk", a->capacity);
+    }
+}
+
+void* frame_alloc(frame_arena_t arena, size_t size, size_t align)
+{
+    if ((unsigned)arena >= (unsigned)FRAME_ARENA_COUNT) return NULL;
+    return arena_alloc(&g_arenas[arena], size, align);
+}
+
+void frame_alloc_begin_tick(void)
+{
+    arena_reset(&g_arenas[FRAME_ARENA_TICK]);
+}
+
+void frame_alloc_begin_frame(void)
+{
+    arena_reset(&g_arenas[FRAME_ARENA_FRAME]);
+}
+
+void* frame_alloc_thread(size_t size, size_t align)
+{
+    return arena_alloc(&g_thread_arena, size, align);
+}
+
+void frame_alloc_thread_reset(void)
+{
+    arena_reset(&g_thread_arena);
+}
+
+void frame_alloc_thread_release(void)
+{
+    bump_free(&g_thread_arena);
+}
+
+size_t frame_alloc_used(frame_arena_t arena)
+{
+    if ((unsigned)arena >= (unsigned)FRAME_ARENA_COUNT) return 0;
+    return bump_used(&g_arenas[arena]);
+}
+
+size_t frame_alloc_capacity(frame_arena_t arena)
+{
+    if ((unsigned)arena >= (unsigned)FRAME_ARENA_COUNT) return 0;
+    return g_arenas[arena].reserved;
+}
+
+size_t frame_alloc_high_water(frame_arena_t arena)
+{
+    if ((unsigned)arena >= (unsigned)FRAME_ARENA_COUNT) return 0;
+    return bump_high_water(&g_arenas[arena]);
+}
+
+void frame_alloc_shutdown(void)
+{
+    for (int i = 0; i < FRAME_ARENA_COUNT; ++i) bump_free(&g_arenas[i]);
+}
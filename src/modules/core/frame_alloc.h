@@ -0,0 +1,43 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+
+// Linear arenas for data that only lives for one tick or one rendered frame. Allocation is a
+// pointer bump; systems_tick()/systems_present() reset the arena at the start of each tick/frame,
+// so nothing is freed individually.
+//
+//   bool* seen = frame_alloc_array(FRAME_ARENA_TICK, bool, ECS_MAX_ENTITIES);
+//
+// An arena that runs out chains another chunk for the rest of the tick and is coalesced into one
+// chunk on the next reset (see bump_alloc.h), so allocations only fail when malloc does.
+//
+// The tick/frame arenas belong to the main thread. Worker threads use frame_alloc_thread(),
+// a per-thread arena they reset themselves at the end of a job.
+
+#ifndef FRAME_ALLOC_INITIAL_BYTES
+#define FRAME_ALLOC_INITIAL_BYTES (64 * 1024)
+#endif
+
+typedef enum {
+    FRAME_ARENA_TICK = 0,  // reset by frame_alloc_begin_tick (start of systems_tick)
+    FRAME_ARENA_FRAME,     // reset by frame_alloc_begin_frame (start of systems_present)
+    FRAME_ARENA_COUNT
+} frame_arena_t;
+
+void* frame_alloc(frame_arena_t arena, size_t size, size_t align);
+void  frame_alloc_begin_tick(void);
+void  frame_alloc_begin_frame(void);
+
+// Calling thread's own arena.
+void* frame_alloc_thread(size_t size, size_t align);
+void  frame_alloc_thread_reset(void);
+void  frame_alloc_thread_release(void); // free this thread's arena (thread exit)
+
+size_t frame_alloc_used(frame_arena_t arena);
+size_t frame_alloc_capacity(frame_arena_t arena);
+size_t frame_alloc_high_water(frame_arena_t arena); // most bytes a tick/frame has needed
+void   frame_alloc_shutdown(void); // free the tick/frame arenas
+
+// Uninitialised storage for count elements of type.
+#define frame_alloc_array(arena, type, count) \
+    ((type*)frame_alloc((arena), (size_t)(count) * sizeof(type), __alignof__(type)))
@@ -0,0 +1,103 @@
+#include "modules/core/hot_reload.h"
+#include "modules/common/path_util.h"
+
+#include <string.h>
+#include <strings.h>
+
+hot_reload_kind_t hot_reload_classify(const char* path)
+{
+    const char* dot = path ? strrchr(path, '.') : NULL;
+    if (!dot || strchr(dot, '/')) return HOT_RELOAD_NONE;
+    if (strcasecmp(dot, ".png") == 0) return HOT_RELOAD_TEXTURE;
+    if (strcasecmp(dot, ".tsx") == 0) return HOT_RELOAD_TILESET;
+    if (strcasecmp(dot, ".ent") == 0) return HOT_RELOAD_PREFAB;
+    if (strcasecmp(dot, ".tmx") == 0) return HOT_RELOAD_MAP;
+    return HOT_RELOAD_NONE;
+}
+
+#if DEBUG_BUILD
+
+#include "modules/asset/asset.h"
+#include "modules/core/camera.h"
+#include "modules/core/engine.h"
+#include "modules/core/file_watch.h"
+#include "modules/core/logger.h"
+#include "modules/core/map_manager.h"
+#include "modules/core/toast.h"
+#include "modules/ecs/ecs.h"
+#include "modules/ecs/ecs_prefab_loading.h"
+#include "modules/systems/systems_registration.h"
+#include "modules/world/world.h"
+#include "modules/world/world_renderer.h"
+
+bool hot_reload_init(const char* root_dir)
+{
+    return file_watch_open(root_dir);
+}
+
+void hot_reload_shutdown(void)
+{
+    file_watch_close();
+}
+
+static bool reload_prefab(const char* path)
+{
+    size_t n = ecs_prefab_respawn(world_get_map(), path);
+    if (n == 0) return false;
+
+    // The player may have been one of them; keep the camera on the live handle.
+    camera_config_t cfg = camera_get_config();
+    cfg.target = ecs_find_player();
+    camera_set_config(&cfg);
+    ui_toast(1.0f, "Prefab reloaded: %s (%zu entities)", path, n);
+    return true;
+}
+
+bool hot_reload_apply(const char* path)
+{
+    const hot_reload_kind_t kind = hot_reload_classify(path);
+    // Preloaded neighbour maps and their prefab templates were built from the old files.
+    if (kind == HOT_RELOAD_MAP || kind == HOT_RELOAD_TILESET || kind == HOT_RELOAD_PREFAB) {
+        map_manager_invalidate();
+    }
+
+    bool ok = false;
+    switch (kind) {
+    case HOT_RELOAD_TEXTURE:
+        ok = asset_reload_texture_path(path);
+        if (ok) ui_toast(1.0f, "Texture reloaded: %s", path);
+        break;
+    case HOT_RELOAD_TILESET:
+        ok = world_reload_tileset(path);
+        if (ok) ui_toast(1.0f, "Tileset reloaded: %s", path);
+        break;
+    case HOT_RELOAD_PREFAB:
+        ok = reload_prefab(path);
+        break;
+    case HOT_RELOAD_MAP:
+        if (path_same(path, engine_current_map())) {
+            ok = engine_reload_world();
+            ui_toast(1.0f, "TMX reload: %s", ok ? "ok" : "failed");
+        }
+        break;
+    case HOT_RELOAD_NONE:
+        break;
+    }
+    if (ok) LOGC(LOGCAT_MAIN, LOG_LVL_INFO, "hot_reload: %s", path);
+    return ok;
+}
+
+static void on_file_changed(const char* path, void* user)
+{
+    (void)user;
+    hot_reload_apply(path);
+}
+
+void hot_reload_poll(void)
+{
+    file_watch_poll(on_file_changed, NULL);
+}
+
+SYSTEMS_ADAPT_VOID(sys_hot_reload_adapt, hot_reload_poll)
+
+#endif // DEBUG_BUILD
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <stdbool.h>
+#include "modules/core/build_config.h"
+
+/*
+  Debug-build hot reload: watches assets/ (file_watch.h) and reloads only what a changed
+  file feeds:
+    .png  the texture slot loaded from it
+    .tsx  that tileset's collider masks, then the collision cells using it
+    .ent  the entities spawned from that prefab (respawned in place)
+    .tmx  the world, if it is the current map
+  Polled once per frame from PHASE_DEBUG.
+*/
+typedef enum {
+    HOT_RELOAD_NONE = 0,
+    HOT_RELOAD_TEXTURE,
+    HOT_RELOAD_TILESET,
+    HOT_RELOAD_PREFAB,
+    HOT_RELOAD_MAP,
+} hot_reload_kind_t;
+
+hot_reload_kind_t hot_reload_classify(const char* path);
+
+#if DEBUG_BUILD
+bool hot_reload_init(const char* root_dir);
+void hot_reload_shutdown(void);
+bool hot_reload_apply(const char* path); // true if something was reloaded
+void hot_reload_poll(void);
+#else
+static inline bool hot_reload_init(const char* root_dir) { (void)root_dir; return false; }
+static inline void hot_reload_shutdown(void) { }
+#endif
@@ -1,4 +1,5 @@
 #include "modules/core/input.h"
+#include "modules/core/input_record.h"
 #include "raylib.h"
 #include <string.h>
 #include <math.h>
@@ -74,6 +75,10 @@ void input_init_defaults(void){
     bind_add(BTN_DEBUG_INSPECT,          KEY_FIVE);
     bind_add(BTN_DEBUG_RELOAD_TMX,       KEY_R);
     bind_add(BTN_DEBUG_FPS,              KEY_GRAVE);
+    bind_add(BTN_DEBUG_BROADPHASE,       KEY_SIX);
+    bind_add(BTN_DEBUG_PROFILER,         KEY_SEVEN);
+    bind_add(BTN_DEBUG_TRACE,            KEY_EIGHT);
+    bind_add(BTN_DEBUG_RESTART,          KEY_NINE);
 #endif
 }
 
@@ -171,5 +176,7 @@ input_t input_for_tick(void){
     s_edges_available = false;
     s_latched_pressed = 0;
     s_latched_wheel   = 0.0f;
+
+    input_record_write(&out); // no-op unless a recording is open
     return out;
 }
@@ -30,6 +30,10 @@ typedef enum {
     BTN_DEBUG_INSPECT,
     BTN_DEBUG_RELOAD_TMX,
     BTN_DEBUG_FPS,
+    BTN_DEBUG_BROADPHASE,
+    BTN_DEBUG_PROFILER,
+    BTN_DEBUG_TRACE,
+    BTN_DEBUG_RESTART,
 #endif
     BTN_COUNT               // <- Must be last as used to loop over enum until this point
 } button_t;
@@ -0,0 +1,205 @@
+#include "modules/core/input_record.h"
+#include "modules/core/logger.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static const char k_magic[4] = { 'I', 'N', 'P', 'R' };
+
+static FILE*   g_rec_file;
+static input_t g_rec_prev;
+
+static FILE*   g_replay_file;
+static input_t g_replay_prev;
+static bool    g_replay_done;
+static int     g_replay_ticks;
+
+static void put_u16(FILE* f, uint16_t v)
+{
+    uint8_t b[2] = { (uint8_t)v, (uint8_t)(v >> 8) };
+    fwrite(b, 1, sizeof(b), f);
+}
+
+static void put_u64(FILE* f, uint64_t v)
+{
+    uint8_t b[8];
+    for (int i = 0; i < 8; ++i) b[i] = (uint8_t)(v >> (8 * i));
+    fwrite(b, 1, sizeof(b), f);
+}
+
+static void put_f32(FILE* f, float v)
+{
+    uint32_t u;
+    memcpy(&u, &v, sizeof(u));
+    uint8_t b[4] = { (uint8_t)u, (uint8_t)(u >> 8), (uint8_t)(u >> 16), (uint8_t)(u >> 24) };
+    fwrite(b, 1, sizeof(b), f);
+}
+
+static bool get_u16(FILE* f, uint16_t* out)
+{
+    uint8_t b[2];
+    if (fread(b, 1, sizeof(b), f) != sizeof(b)) return false;
+    *out = (uint16_t)(b[0] | (b[1] << 8));
+    return true;
+}
+
+static bool get_u64(FILE* f, uint64_t* out)
+{
+    uint8_t b[8];
+    if (fread(b, 1, sizeof(b), f) != sizeof(b)) return false;
+    uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) v |= (uint64_t)b[i] << (8 * i);
+    *out = v;
+    return true;
+}
+
+static bool get_f32(FILE* f, float* out)
+{
+    uint8_t b[4];
+    if (fread(b, 1, sizeof(b), f) != sizeof(b)) return false;
+    uint32_t u = (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+    memcpy(out, &u, sizeof(*out));
+    return true;
+}
+
+bool input_record_open(const char* path)
+{
+    input_record_close();
+    g_rec_file = path ? fopen(path, "wb") : NULL;
+    if (!g_rec_file) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "input: can't record to '%s'", path ? path : "(null)");
+        return false;
+    }
+    fwrite(k_magic, 1, sizeof(k_magic), g_rec_file);
+    put_u16(g_rec_file, INPUT_REC_VERSION);
+    put_u16(g_rec_file, (uint16_t)BTN_COUNT);
+    g_rec_prev = (input_t){0};
+    LOGC(LOGCAT_MAIN, LOG_LVL_INFO, "input: recording to '%s'", path);
+    return true;
+}
+
+void input_record_write(const input_t* in)
+{
+    if (!g_rec_file || !in) return;
+
+    uint8_t flags = 0;
+    if (in->down != g_rec_prev.down) flags |= INPUT_REC_DOWN;
+    if (in->pressed != 0) flags |= INPUT_REC_PRESSED;
+    if (in->moveX != g_rec_prev.moveX || in->moveY != g_rec_prev.moveY) flags |= INPUT_REC_MOVE;
+    if (in->mouse.x != g_rec_prev.mouse.x || in->mouse.y != g_rec_prev.mouse.y) flags |= INPUT_REC_MOUSE;
+    if (in->mouse_wheel != 0.0f) flags |= INPUT_REC_WHEEL;
+
+    fputc(flags, g_rec_file);
+    if (flags & INPUT_REC_DOWN) put_u64(g_rec_file, in->down);
+    if (flags & INPUT_REC_PRESSED) put_u64(g_rec_file, in->pressed);
+    if (flags & INPUT_REC_MOVE) { put_f32(g_rec_file, in->moveX); put_f32(g_rec_file, in->moveY); }
+    if (flags & INPUT_REC_MOUSE) { put_f32(g_rec_file, in->mouse.x); put_f32(g_rec_file, in->mouse.y); }
+    if (flags & INPUT_REC_WHEEL) put_f32(g_rec_file, in->mouse_wheel);
+
+    g_rec_prev = *in;
+}
+
+void input_record_close(void)
+{
+    if (!g_rec_file) return;
+    fclose(g_rec_file);
+    g_rec_file = NULL;
+}
+
+bool input_recording(void)
+{
+    return g_rec_file != NULL;
+}
+
+bool input_replay_open(const char* path)
+{
+    input_replay_close();
+    FILE* f = path ? fopen(path, "rb") : NULL;
+    if (!f) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "input: can't open replay '%s'", path ? path : "(null)");
+        return false;
+    }
+
+    char magic[4];
+    uint16_t version = 0, buttons = 0;
+    if (fread(magic, 1, sizeof(magic), f) != sizeof(magic) || memcmp(magic, k_magic, sizeof(magic)) != 0 ||
+        !get_u16(f, &version) || !get_u16(f, &buttons)) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "input: '%s' is not an input recording", path);
+        fclose(f);
+        return false;
+    }
+    if (version != INPUT_REC_VERSION) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "input: '%s' has version %u, expected %u", path, version, INPUT_REC_VERSION);
+        fclose(f);
+        return false;
+    }
+    if (buttons != BTN_COUNT) {
+        // Gameplay buttons come first in button_t, so only debug bindings differ between builds.
+        LOGC(LOGCAT_MAIN, LOG_LVL_WARN, "input: '%s' recorded with %u buttons, this build has %d", path, buttons, (int)BTN_COUNT);
+    }
+
+    g_replay_file = f;
+    g_replay_prev = (input_t){0};
+    g_replay_done = false;
+    g_replay_ticks = 0;
+    LOGC(LOGCAT_MAIN, LOG_LVL_INFO, "input: replaying '%s'", path);
+    return true;
+}
+
+bool input_replay_next(input_t* out)
+{
+    if (out) *out = (input_t){0};
+    if (!g_replay_file || g_replay_done) return false;
+
+    int c = fgetc(g_replay_file);
+    if (c == EOF) {
+        g_replay_done = true;
+        LOGC(LOGCAT_MAIN, LOG_LVL_INFO, "input: replay finished after %d ticks", g_replay_ticks);
+        return false;
+    }
+
+    const uint8_t flags = (uint8_t)c;
+    input_t in = g_replay_prev;
+    in.pressed = 0;
+    in.mouse_wheel = 0.0f;
+
+    bool ok = true;
+    if (flags & INPUT_REC_DOWN) ok = ok && get_u64(g_replay_file, &in.down);
+    if (flags & INPUT_REC_PRESSED) ok = ok && get_u64(g_replay_file, &in.pressed);
+    if (flags & INPUT_REC_MOVE) ok = ok && get_f32(g_replay_file, &in.moveX) && get_f32(g_replay_file, &in.moveY);
+    if (flags & INPUT_REC_MOUSE) ok = ok && get_f32(g_replay_file, &in.mouse.x) && get_f32(g_replay_file, &in.mouse.y);
+    if (flags & INPUT_REC_WHEEL) ok = ok && get_f32(g_replay_file, &in.mouse_wheel);
+    if (!ok) {
+        g_replay_done = true;
+        LOGC(LOGCAT_MAIN, LOG_LVL_WARN, "input: replay truncated after %d ticks", g_replay_ticks);
+        return false;
+    }
+
+    g_replay_prev = in;
+    g_replay_ticks++;
+    if (out) *out = in;
+    return true;
+}
+
+void input_replay_close(void)
+{
+    if (!g_replay_file) return;
+    fclose(g_replay_file);
+    g_replay_file = NULL;
+    g_replay_done = false;
+}
+
+bool input_replaying(void)
+{
+    return g_replay_file != NULL && !g_replay_done;
+}
+
+bool input_replay_finished(void)
+{
+    return g_replay_file != NULL && g_replay_done;
+}
+
+int input_replay_ticks(void)
+{
+    return g_replay_ticks;
+}
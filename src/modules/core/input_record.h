@@ -0,0 +1,40 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "modules/core/input.h"
+
+/*
+  Per-tick input_t stream on disk, so a session played with a window can be replayed headless.
+
+  File: "INPR" magic, u16 version, u16 button count, then one record per fixed tick:
+    u8 flags, followed only by the fields the flags name (all little-endian):
+      INPUT_REC_DOWN    u64 down       (held bits changed since the previous tick)
+      INPUT_REC_PRESSED u64 pressed    (any rising edges this tick)
+      INPUT_REC_MOVE    f32 x, f32 y   (move axis changed)
+      INPUT_REC_MOUSE   f32 x, f32 y   (mouse moved)
+      INPUT_REC_WHEEL   f32 wheel      (non-zero wheel delta)
+  An idle tick costs one byte.
+*/
+#define INPUT_REC_VERSION 1
+
+enum {
+    INPUT_REC_DOWN    = 1 << 0,
+    INPUT_REC_PRESSED = 1 << 1,
+    INPUT_REC_MOVE    = 1 << 2,
+    INPUT_REC_MOUSE   = 1 << 3,
+    INPUT_REC_WHEEL   = 1 << 4,
+};
+
+// Recording: input_for_tick() appends every tick it hands out while a recording is open.
+bool input_record_open(const char* path);
+void input_record_write(const input_t* in);
+void input_record_close(void);
+bool input_recording(void);
+
+// Replay: the headless input_for_tick() reads ticks back in order.
+bool input_replay_open(const char* path);
+bool input_replay_next(input_t* out);   // false (and a zeroed input) once the stream is exhausted
+void input_replay_close(void);
+bool input_replaying(void);             // a replay is open and not yet exhausted
+bool input_replay_finished(void);       // a replay was open and has run out
+int  input_replay_ticks(void);          // ticks replayed so far
@@ -1,9 +1,34 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "modules/core/logger.h"
 #include <stdio.h>
 #include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#if !defined(_WIN32) && defined(__GNUC__)
+#include <pthread.h>
+#define LOGGER_ASYNC 1
+#else
+#define LOGGER_ASYNC 0
+#endif
 
 static log_sink_fn g_sink = NULL;
 static log_level_t g_min  = LOG_LVL_TRACE;
+static log_level_t g_gate = LOG_LVL_TRACE; // lowest of g_min and every category level
+
+typedef struct {
+    char        name[16];
+    log_level_t lvl;
+} cat_level_t;
+
+static cat_level_t g_cat_levels[LOG_MAX_CATEGORY_LEVELS];
+static int         g_cat_level_count;
+static double    (*g_clock)(void);
 
 static void default_sink(log_level_t lvl, const log_cat_t* cat, const char* fmt, va_list ap){
     static const char* N[]={"TRACE","DEBUG","INFO","WARN","ERROR","FATAL"};
@@ -15,12 +40,310 @@ static void default_sink(log_level_t lvl, const log_cat_t* cat, const char* fmt,
     fputc('\n', stderr);
 }
 
-void log_set_sink(log_sink_fn sink){ g_sink = sink; }
-void log_set_min_level(log_level_t lvl){ g_min = lvl; }
-bool log_would_log(log_level_t lvl){ return lvl >= g_min; }
+static void sink_call(log_level_t lvl, const log_cat_t* cat, const char* fmt, va_list ap){
+#if LOGGER_ASYNC
+    log_sink_fn sink = __atomic_load_n(&g_sink, __ATOMIC_ACQUIRE);
+#else
+    log_sink_fn sink = g_sink;
+#endif
+    (sink ? sink : default_sink)(lvl, cat, fmt, ap);
+}
+
+// Varargs shim so already-formatted text can go through the va_list sink signature.
+static void sink_printf(log_level_t lvl, const log_cat_t* cat, const char* fmt, ...){
+    va_list ap; va_start(ap, fmt);
+    sink_call(lvl, cat, fmt, ap);
+    va_end(ap);
+}
+
+#if LOGGER_ASYNC
+
+// ---- bounded MPSC ring (per-cell sequence numbers; producers claim slots with a CAS) ----
+typedef struct {
+    size_t  seq;       // == pos: free for the producer claiming pos; == pos+1: holds pos's record
+    uint8_t lvl;
+    bool    has_cat;
+    char    cat[14];
+    char    msg[LOG_ASYNC_MSG_MAX];
+} log_record_t;
+
+static log_record_t  g_ring[LOG_ASYNC_RING];
+static size_t        g_head;     // next slot producers claim
+static size_t        g_tail;     // next slot the writer thread consumes (written by it only)
+static unsigned long g_dropped;
+static unsigned long g_dropped_reported; // writer thread only once it runs
+static bool          g_async;
+static bool          g_stop;
+static size_t        g_producers; // log_msg calls between their g_async check and their push
+static pthread_t     g_thread;
+static pthread_mutex_t g_toggle_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// The writer sleeps on g_wake once the ring is empty; producers only take the lock to signal it
+// when g_writer_idle says it may be waiting.
+static pthread_mutex_t g_wake_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  g_wake = PTHREAD_COND_INITIALIZER;
+static bool            g_writer_idle;
+
+static bool ring_push(log_level_t lvl, const log_cat_t* cat, const char* fmt, va_list ap){
+    size_t pos = __atomic_load_n(&g_head, __ATOMIC_RELAXED);
+    log_record_t* r;
+    for (;;) {
+        r = &g_ring[pos & (LOG_ASYNC_RING - 1)];
+        const size_t seq = __atomic_load_n(&r->seq, __ATOMIC_ACQUIRE);
+        const intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&g_head, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) break;
+        } else if (diff < 0) {
+            return false; // full: the writer hasn't freed this slot yet
+        } else {
+            pos = __atomic_load_n(&g_head, __ATOMIC_RELAXED);
+        }
+    }
+    r->lvl = (uint8_t)lvl;
+    r->has_cat = cat && cat->name;
+    if (r->has_cat) snprintf(r->cat, sizeof(r->cat), "%s", cat->name);
+    vsnprintf(r->msg, sizeof(r->msg), fmt, ap);
+    __atomic_store_n(&r->seq, pos + 1, __ATOMIC_SEQ_CST); // ordered before wake_writer's idle check
+    return true;
+}
+
+// Writer side only. True when the record at g_tail has been published.
+static bool ring_ready(void){
+    const log_record_t* r = &g_ring[g_tail & (LOG_ASYNC_RING - 1)];
+    return __atomic_load_n(&r->seq, __ATOMIC_SEQ_CST) == g_tail + 1;
+}
+
+// Writer side only. Returns false when the next record isn't published yet.
+static bool ring_pop_and_write(void){
+    if (!ring_ready()) return false;
+    log_record_t* r = &g_ring[g_tail & (LOG_ASYNC_RING - 1)];
+    const log_cat_t cat = { r->cat };
+    sink_printf((log_level_t)r->lvl, r->has_cat ? &cat : NULL, "%s", r->msg);
+    __atomic_store_n(&r->seq, g_tail + LOG_ASYNC_RING, __ATOMIC_RELEASE);
+    __atomic_store_n(&g_tail, g_tail + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+static void nap_us(long us){
+    const struct timespec ts = { 0, us * 1000L };
+    nanosleep(&ts, NULL);
+}
+
+static void report_drops(void){
+    const unsigned long dropped = __atomic_load_n(&g_dropped, __ATOMIC_RELAXED);
+    if (dropped == g_dropped_reported) return;
+    sink_printf(LOG_LVL_WARN, NULL, "logger: ring full, dropped %lu message(s)", dropped - g_dropped_reported);
+    g_dropped_reported = dropped;
+}
+
+// Producer side, after publishing. Pairs with writer_wait (all seq_cst): either the writer's
+// recheck sees the record, or this sees g_writer_idle and signals.
+static void wake_writer(void){
+    if (!__atomic_load_n(&g_writer_idle, __ATOMIC_SEQ_CST)) return;
+    pthread_mutex_lock(&g_wake_lock);
+    pthread_cond_signal(&g_wake);
+    pthread_mutex_unlock(&g_wake_lock);
+}
+
+static void writer_wait(void){
+    pthread_mutex_lock(&g_wake_lock);
+    __atomic_store_n(&g_writer_idle, true, __ATOMIC_SEQ_CST);
+    while (!ring_ready() && !__atomic_load_n(&g_stop, __ATOMIC_ACQUIRE)) pthread_cond_wait(&g_wake, &g_wake_lock);
+    __atomic_store_n(&g_writer_idle, false, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&g_wake_lock);
+}
+
+static void* writer_main(void* arg){
+    (void)arg;
+    for (;;) {
+        while (ring_pop_and_write()) {}
+        report_drops();
+        if (__atomic_load_n(&g_stop, __ATOMIC_ACQUIRE) &&
+            __atomic_load_n(&g_head, __ATOMIC_ACQUIRE) == g_tail) break;
+        writer_wait();
+    }
+    return NULL;
+}
+
+bool log_set_async(bool enabled){
+    pthread_mutex_lock(&g_toggle_lock);
+    bool ok = true;
+    if (enabled && !g_async) {
+        for (size_t i = 0; i < LOG_ASYNC_RING; ++i) g_ring[i].seq = i;
+        g_head = g_tail = 0;
+        g_dropped_reported = g_dropped;
+        __atomic_store_n(&g_stop, false, __ATOMIC_RELAXED);
+        ok = pthread_create(&g_thread, NULL, writer_main, NULL) == 0;
+        if (ok) __atomic_store_n(&g_async, true, __ATOMIC_RELEASE);
+    } else if (!enabled && g_async) {
+        // New callers now log synchronously; wait out the ones already committed to the ring so
+        // nothing lands after the final drain.
+        __atomic_store_n(&g_async, false, __ATOMIC_SEQ_CST);
+        while (__atomic_load_n(&g_producers, __ATOMIC_SEQ_CST) != 0) nap_us(50);
+        pthread_mutex_lock(&g_wake_lock);
+        __atomic_store_n(&g_stop, true, __ATOMIC_RELEASE);
+        pthread_cond_signal(&g_wake);
+        pthread_mutex_unlock(&g_wake_lock);
+        pthread_join(g_thread, NULL);
+        while (ring_pop_and_write()) {}
+        report_drops();
+    }
+    pthread_mutex_unlock(&g_toggle_lock);
+    return ok;
+}
+
+bool log_async_enabled(void){ return __atomic_load_n(&g_async, __ATOMIC_ACQUIRE); }
+
+void log_flush(void){
+    if (!log_async_enabled()) return;
+    const size_t target = __atomic_load_n(&g_head, __ATOMIC_ACQUIRE);
+    while (log_async_enabled() && (intptr_t)(__atomic_load_n(&g_tail, __ATOMIC_ACQUIRE) - target) < 0) nap_us(100);
+}
+
+unsigned long log_dropped_count(void){ return __atomic_load_n(&g_dropped, __ATOMIC_RELAXED); }
+
+#else
+
+bool          log_set_async(bool enabled){ return !enabled; }
+bool          log_async_enabled(void){ return false; }
+void          log_flush(void){}
+unsigned long log_dropped_count(void){ return 0; }
+
+#endif
+
+void log_set_sink(log_sink_fn sink){
+    // Queued records belong to the sink that was current when they were logged.
+    log_flush();
+#if LOGGER_ASYNC
+    __atomic_store_n(&g_sink, sink, __ATOMIC_RELEASE);
+#else
+    g_sink = sink;
+#endif
+}
+static void update_gate(void){
+    g_gate = g_min;
+    for (int i = 0; i < g_cat_level_count; ++i) {
+        if (g_cat_levels[i].lvl < g_gate) g_gate = g_cat_levels[i].lvl;
+    }
+}
+
+void log_set_min_level(log_level_t lvl){ g_min = lvl; update_gate(); }
+bool log_would_log(log_level_t lvl){ return lvl >= g_gate; }
+
+static cat_level_t* find_cat_level(const char* name){
+    for (int i = 0; i < g_cat_level_count; ++i) {
+        if (strcmp(g_cat_levels[i].name, name) == 0) return &g_cat_levels[i];
+    }
+    return NULL;
+}
+
+bool log_set_category_level(const char* name, log_level_t lvl){
+    if (!name || !name[0] || strlen(name) >= sizeof(g_cat_levels[0].name)) return false;
+    cat_level_t* c = find_cat_level(name);
+    if (!c) {
+        if (g_cat_level_count == LOG_MAX_CATEGORY_LEVELS) return false;
+        c = &g_cat_levels[g_cat_level_count++];
+        snprintf(c->name, sizeof(c->name), "%s", name);
+    }
+    c->lvl = lvl;
+    update_gate();
+    return true;
+}
+
+void log_clear_category_levels(void){ g_cat_level_count = 0; update_gate(); }
+
+bool log_category_would_log(const log_cat_t* cat, log_level_t lvl){
+    if (g_cat_level_count == 0) return lvl >= g_min;
+    const cat_level_t* c = (cat && cat->name) ? find_cat_level(cat->name) : NULL;
+    return lvl >= (c ? c->lvl : g_min);
+}
+
+static bool parse_level(const char* s, size_t n, log_level_t* out){
+    static const char* N[]={"trace","debug","info","warn","error","fatal"};
+    for (int i = 0; i < 6; ++i) {
+        if (strlen(N[i]) != n) continue;
+        size_t k = 0;
+        while (k < n && (s[k] | 0x20) == N[i][k]) ++k;
+        if (k == n) { *out = (log_level_t)i; return true; }
+    }
+    return false;
+}
+
+bool log_configure(const char* spec){
+    bool ok = true;
+    for (const char* p = spec; p && *p; ) {
+        const char* end = strchr(p, ',');
+        if (!end) end = p + strlen(p);
+        const char* eq = memchr(p, '=', (size_t)(end - p));
+        char name[sizeof(g_cat_levels[0].name)];
+        log_level_t lvl;
+        if (!eq || eq == p || (size_t)(eq - p) >= sizeof(name) || !parse_level(eq + 1, (size_t)(end - eq - 1), &lvl)) {
+            ok = false;
+        } else {
+            memcpy(name, p, (size_t)(eq - p));
+            name[eq - p] = '\0';
+            if (strcmp(name, "*") == 0) log_set_min_level(lvl);
+            else ok = log_set_category_level(name, lvl) && ok;
+        }
+        p = *end ? end + 1 : end;
+    }
+    return ok;
+}
+
+static double default_clock(void){
+#if defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#else
+    return (double)clock() / (double)CLOCKS_PER_SEC;
+#endif
+}
+
+void log_set_clock(double (*now_seconds)(void)){ g_clock = now_seconds; }
+
+bool log_site_allow(log_site_t* site, log_level_t lvl, const log_cat_t* cat){
+    if (!site) return true;
+    if (!log_category_would_log(cat, lvl)) return false;
+    const double now = g_clock ? g_clock() : default_clock();
+    if (site->last < 0.0) {
+        site->tokens = LOG_SITE_BURST;
+    } else {
+        site->tokens += (now - site->last) * LOG_SITE_PER_SEC;
+        if (site->tokens > LOG_SITE_BURST) site->tokens = LOG_SITE_BURST;
+    }
+    site->last = now;
+    if (site->tokens < 1.0) {
+        site->suppressed++;
+        return false;
+    }
+    site->tokens -= 1.0;
+    if (site->suppressed > 0) {
+        const unsigned n = site->suppressed;
+        site->suppressed = 0;
+        log_msg(lvl, cat, "(%u similar message(s) suppressed)", n);
+    }
+    return true;
+}
 
 void log_msg(log_level_t lvl, const log_cat_t* cat, const char* fmt, ...){
+    if (g_cat_level_count > 0 && !log_category_would_log(cat, lvl)) return;
     va_list ap; va_start(ap, fmt);
-    (g_sink ? g_sink : default_sink)(lvl, cat, fmt, ap);
+#if LOGGER_ASYNC
+    if (lvl != LOG_LVL_FATAL && log_async_enabled()) {
+        // Re-checked once counted, so log_set_async(false) either sees us or we see it.
+        __atomic_add_fetch(&g_producers, 1, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&g_async, __ATOMIC_SEQ_CST)) {
+            if (ring_push(lvl, cat, fmt, ap)) wake_writer();
+            else __atomic_fetch_add(&g_dropped, 1, __ATOMIC_RELAXED);
+            __atomic_sub_fetch(&g_producers, 1, __ATOMIC_RELEASE);
+            va_end(ap);
+            return;
+        }
+        __atomic_sub_fetch(&g_producers, 1, __ATOMIC_RELEASE);
+    }
+    if (lvl == LOG_LVL_FATAL) log_flush(); // keep FATAL after everything logged before it
+#endif
+    sink_call(lvl, cat, fmt, ap);
     va_end(ap);
 }
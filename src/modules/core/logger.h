@@ -24,8 +24,44 @@ void log_set_min_level(log_level_t lvl);
 bool log_would_log(log_level_t lvl);
 void log_msg(log_level_t lvl, const log_cat_t* cat, const char* fmt, ...);
 
+// Async mode: log_msg formats into a fixed-size record on the calling thread and pushes it onto a
+// lock-free ring; a background thread hands records to the sink, so slow sinks never stall the
+// caller. A full ring drops the message and counts it. FATAL drains the ring and goes out
+// synchronously. Off by default (sinks run on the caller); no-op without threads.
+#define LOG_ASYNC_RING    1024 // records; power of two
+#define LOG_ASYNC_MSG_MAX 232  // formatted message bytes per record, longer ones are truncated
+bool          log_set_async(bool enabled); // disabling drains and joins the thread
+bool          log_async_enabled(void);
+void          log_flush(void);             // wait until every queued record reached the sink
+unsigned long log_dropped_count(void);
+
+// Per-category levels, by name; override the global min level in both directions.
+// log_would_log() passes anything some category could want; log_msg() applies the category's
+// own level before formatting, so filtered messages are never formatted.
+#define LOG_MAX_CATEGORY_LEVELS 32
+bool log_set_category_level(const char* name, log_level_t lvl);
+void log_clear_category_levels(void);
+bool log_category_would_log(const log_cat_t* cat, log_level_t lvl);
+// "RENDER=error,ECS=debug" (names are categories, "*" sets the global min); false on a bad entry.
+bool log_configure(const char* spec);
+
+// Per-call-site rate limit (token bucket) for LOGC_LIMITED. Suppressed messages are counted,
+// never formatted, and summarised on the site's next message that gets through.
+#define LOG_SITE_BURST   5    // messages a quiet site can log back to back
+#define LOG_SITE_PER_SEC 1.0  // refill rate
+typedef struct {
+    double   tokens;
+    double   last;     // clock time of the last refill; < 0 = unused
+    unsigned suppressed;
+} log_site_t;
+#define LOG_SITE_INIT { 0.0, -1.0, 0u }
+bool log_site_allow(log_site_t* site, log_level_t lvl, const log_cat_t* cat);
+void log_set_clock(double (*now_seconds)(void)); // NULL = monotonic clock; for tests
+
 // Convenience
 #define LOGC(cat, lvl, fmt, ...) do { if (log_would_log(lvl)) { log_cat_t _cat_tmp_ = (cat); log_msg((lvl), &_cat_tmp_, fmt, ##__VA_ARGS__); } } while (0)
+// LOGC for hot paths that can fire every frame (overflows, exhausted pools).
+#define LOGC_LIMITED(cat, lvl, fmt, ...) do { static log_site_t _site_ = LOG_SITE_INIT; if (log_would_log(lvl)) { log_cat_t _cat_tmp_ = (cat); if (log_site_allow(&_site_, (lvl), &_cat_tmp_)) log_msg((lvl), &_cat_tmp_, fmt, ##__VA_ARGS__); } } while (0)
 #define LOG(lvl, fmt, ...)       do{ static const log_cat_t _anon = { NULL }; if(log_would_log(lvl)) log_msg((lvl), &_anon, fmt, ##__VA_ARGS__); }while(0)
 
 // Common categories
@@ -0,0 +1,309 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "modules/core/map_manager.h"
+#include "modules/core/logger.h"
+#include "modules/core/trace.h"
+#include "modules/common/path_util.h"
+#include "modules/tiled/tiled.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+#include <pthread.h>
+#define MAP_MANAGER_THREADED 1
+#else
+#define MAP_MANAGER_THREADED 0
+#endif
+
+#define MAP_MANAGER_COLLISION_LAYER "walls"
+
+typedef enum {
+    PRELOAD_FREE = 0,
+    PRELOAD_QUEUED,
+    PRELOAD_LOADING,
+    PRELOAD_READY,
+    PRELOAD_FAILED,
+} preload_state_t;
+
+typedef struct {
+    preload_state_t state;
+    bool            dropped; // unlinked while the thread had it; freed when the thread is done
+    char            path[MAP_MANAGER_PATH_MAX]; // normalised
+    map_preload_t   result;
+} preload_entry_t;
+
+static preload_entry_t g_entries[MAP_MANAGER_MAX_MAPS];
+static map_link_t      g_links[MAP_MANAGER_MAX_LINKS];
+static size_t          g_link_count;
+
+#if MAP_MANAGER_THREADED
+static pthread_mutex_t g_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  g_cond = PTHREAD_COND_INITIALIZER;
+static pthread_t       g_thread;
+static bool            g_thread_started;
+static bool            g_stop;
+#define MM_LOCK()   pthread_mutex_lock(&g_lock)
+#define MM_UNLOCK() pthread_mutex_unlock(&g_lock)
+#else
+#define MM_LOCK()   ((void)0)
+#define MM_UNLOCK() ((void)0)
+#endif
+
+static void preload_run(const char* path, map_preload_t* out)
+{
+    TRACE_BEGIN("map_preload");
+    out->world = world_prepare_tmx(path, MAP_MANAGER_COLLISION_LAYER);
+    out->templates = out->world ? ecs_prefab_templates_build(world_prepared_map(out->world), path) : NULL;
+    TRACE_END();
+}
+
+void map_preload_free(map_preload_t* preload)
+{
+    if (!preload) return;
+    world_prepared_free(preload->world);
+    ecs_prefab_templates_free(preload->templates);
+    *preload = (map_preload_t){0};
+}
+
+static preload_entry_t* find_entry(const char* norm_path)
+{
+    for (int i = 0; i < MAP_MANAGER_MAX_MAPS; ++i) {
+        preload_entry_t* e = &g_entries[i];
+        if (e->state != PRELOAD_FREE && !e->dropped && strcmp(e->path, norm_path) == 0) return e;
+    }
+    return NULL;
+}
+
+static void release_entry(preload_entry_t* e)
+{
+    map_preload_free(&e->result);
+    e->state = PRELOAD_FREE;
+    e->dropped = false;
+}
+
+#if MAP_MANAGER_THREADED
+
+static void* preload_main(void* arg)
+{
+    (void)arg;
+    MM_LOCK();
+    for (;;) {
+        preload_entry_t* job = NULL;
+        while (!g_stop) {
+            for (int i = 0; i < MAP_MANAGER_MAX_MAPS && !job; ++i) {
+                if (g_entries[i].state == PRELOAD_QUEUED && !g_entries[i].dropped) job = &g_entries[i];
+            }
+            if (job) break;
+            pthread_cond_wait(&g_cond, &g_lock);
+        }
+        if (!job) break;
+
+        char path[MAP_MANAGER_PATH_MAX];
+        memcpy(path, job->path, sizeof(path));
+        job->state = PRELOAD_LOADING;
+        MM_UNLOCK();
+
+        map_preload_t result = {0};
+        preload_run(path, &result);
+
+        MM_LOCK();
+        job->result = result;
+        job->state = result.world ? PRELOAD_READY : PRELOAD_FAILED;
+        if (job->dropped) release_entry(job);
+        pthread_cond_broadcast(&g_cond);
+    }
+    MM_UNLOCK();
+    return NULL;
+}
+
+static void ensure_thread(void)
+{
+    if (g_thread_started) return;
+    g_stop = false;
+    g_thread_started = pthread_create(&g_thread, NULL, preload_main, NULL) == 0;
+    if (!g_thread_started) LOGC(LOGCAT_MAIN, LOG_LVL_WARN, "map_manager: no preload thread; maps load on demand");
+}
+
+#endif
+
+bool map_manager_preload(const char* tmx_path)
+{
+    char norm[MAP_MANAGER_PATH_MAX];
+    if (!tmx_path || !path_normalize(tmx_path, norm, sizeof(norm))) return false;
+
+#if MAP_MANAGER_THREADED
+    MM_LOCK();
+    ensure_thread();
+    if (!g_thread_started) {
+        MM_UNLOCK();
+        return false;
+    }
+    if (find_entry(norm)) {
+        MM_UNLOCK();
+        return true;
+    }
+    preload_entry_t* slot = NULL;
+    for (int i = 0; i < MAP_MANAGER_MAX_MAPS && !slot; ++i) {
+        if (g_entries[i].state == PRELOAD_FREE) slot = &g_entries[i];
+    }
+    if (slot) {
+        *slot = (preload_entry_t){ .state = PRELOAD_QUEUED };
+        memcpy(slot->path, norm, sizeof(norm));
+        pthread_cond_broadcast(&g_cond);
+    } else {
+        LOGC(LOGCAT_MAIN, LOG_LVL_WARN, "map_manager: preload slots full, '%s' will load on demand", norm);
+    }
+    MM_UNLOCK();
+    return slot != NULL;
+#else
+    return false; // no thread: map_manager_take loads inline
+#endif
+}
+
+bool map_manager_is_ready(const char* tmx_path)
+{
+    char norm[MAP_MANAGER_PATH_MAX];
+    if (!tmx_path || !path_normalize(tmx_path, norm, sizeof(norm))) return false;
+    MM_LOCK();
+    const preload_entry_t* e = find_entry(norm);
+    const bool ready = e && e->state == PRELOAD_READY;
+    MM_UNLOCK();
+    return ready;
+}
+
+bool map_manager_take(const char* tmx_path, map_preload_t* out)
+{
+    if (!out) return false;
+    *out = (map_preload_t){0};
+    char norm[MAP_MANAGER_PATH_MAX];
+    if (!tmx_path || !path_normalize(tmx_path, norm, sizeof(norm))) return false;
+
+    MM_LOCK();
+    preload_entry_t* e = find_entry(norm);
+#if MAP_MANAGER_THREADED
+    while (e && (e->state == PRELOAD_QUEUED || e->state == PRELOAD_LOADING)) {
+        pthread_cond_wait(&g_cond, &g_lock);
+    }
+#endif
+    if (e) {
+        *out = e->result;
+        e->result = (map_preload_t){0};
+        release_entry(e);
+    }
+    MM_UNLOCK();
+
+    if (!out->world) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_DEBUG, "map_manager: '%s' wasn't preloaded, loading now", norm);
+        preload_run(norm, out);
+    }
+    if (!out->world) {
+        map_preload_free(out);
+        return false;
+    }
+    return true;
+}
+
+static bool join_map_relative(const char* base_path, const char* rel, char* out, size_t out_cap)
+{
+    char joined[MAP_MANAGER_PATH_MAX * 2];
+    const char* slash = base_path ? strrchr(base_path, '/') : NULL;
+    if (rel[0] == '/' || !slash) {
+        snprintf(joined, sizeof(joined), "%s", rel);
+    } else {
+        snprintf(joined, sizeof(joined), "%.*s%s", (int)(slash - base_path + 1), base_path, rel);
+    }
+    return path_normalize(joined, out, out_cap);
+}
+
+void map_manager_set_current(const world_map_t* map, const char* tmx_path)
+{
+    g_link_count = 0;
+    for (size_t i = 0; map && i < map->object_count; ++i) {
+        const tiled_object_t* obj = &map->objects[i];
+        const char* target = tiled_object_get_property_value(obj, "target_map");
+        if (!target || !target[0]) continue;
+        if (g_link_count == MAP_MANAGER_MAX_LINKS) {
+            LOGC(LOGCAT_MAIN, LOG_LVL_WARN, "map_manager: more than %d map links in '%s'", MAP_MANAGER_MAX_LINKS, tmx_path);
+            break;
+        }
+
+        map_link_t* link = &g_links[g_link_count];
+        if (!join_map_relative(tmx_path, target, link->target_map, sizeof(link->target_map))) continue;
+        const char* spawn = tiled_object_get_property_value(obj, "target_spawn");
+        snprintf(link->target_spawn, sizeof(link->target_spawn), "%s", spawn ? spawn : "");
+        // Tile objects are anchored at their bottom-left corner.
+        link->x = obj->x;
+        link->y = obj->gid != 0 ? obj->y - obj->h : obj->y;
+        link->w = obj->w;
+        link->h = obj->h;
+        g_link_count++;
+    }
+
+    // Drop preloads the new map can't reach; in-flight ones are freed by the thread.
+    MM_LOCK();
+    for (int i = 0; i < MAP_MANAGER_MAX_MAPS; ++i) {
+        preload_entry_t* e = &g_entries[i];
+        if (e->state == PRELOAD_FREE || e->dropped) continue;
+        bool linked = false;
+        for (size_t l = 0; l < g_link_count && !linked; ++l) linked = strcmp(g_links[l].target_map, e->path) == 0;
+        if (linked) continue;
+        if (e->state == PRELOAD_LOADING) e->dropped = true;
+        else                             release_entry(e);
+    }
+    MM_UNLOCK();
+
+    for (size_t l = 0; l < g_link_count; ++l) map_manager_preload(g_links[l].target_map);
+}
+
+void map_manager_invalidate(void)
+{
+    MM_LOCK();
+    for (int i = 0; i < MAP_MANAGER_MAX_MAPS; ++i) {
+        preload_entry_t* e = &g_entries[i];
+        if (e->state == PRELOAD_FREE || e->dropped) continue;
+        if (e->state == PRELOAD_LOADING) e->dropped = true;
+        else                             release_entry(e);
+    }
+    MM_UNLOCK();
+
+    for (size_t l = 0; l < g_link_count; ++l) map_manager_preload(g_links[l].target_map);
+}
+
+size_t map_manager_link_count(void)
+{
+    return g_link_count;
+}
+
+const map_link_t* map_manager_link(size_t i)
+{
+    return i < g_link_count ? &g_links[i] : NULL;
+}
+
+const map_link_t* map_manager_link_at(float x, float y)
+{
+    for (size_t i = 0; i < g_link_count; ++i) {
+        const map_link_t* l = &g_links[i];
+        if (x >= l->x && x < l->x + l->w && y >= l->y && y < l->y + l->h) return l;
+    }
+    return NULL;
+}
+
+void map_manager_shutdown(void)
+{
+#if MAP_MANAGER_THREADED
+    MM_LOCK();
+    const bool started = g_thread_started;
+    g_stop = true;
+    pthread_cond_broadcast(&g_cond);
+    MM_UNLOCK();
+    if (started) pthread_join(g_thread, NULL);
+    g_thread_started = false;
+#endif
+    for (int i = 0; i < MAP_MANAGER_MAX_MAPS; ++i) {
+        if (g_entries[i].state != PRELOAD_FREE) release_entry(&g_entries[i]);
+    }
+    g_link_count = 0;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include "modules/world/world_map.h"
+#include "modules/ecs/ecs_prefab_loading.h"
+
+/*
+  Map manager: keeps every map linked from the current one parsed and ready, so walking through a
+  door swaps maps without a load hitch.
+
+  A link is a TMX object with a `target_map` property (TMX path, relative to the map it's in) and
+  optionally `target_spawn` (name of the object in the target map the player arrives at). When a
+  map becomes current its links are queued for a background thread, which runs the blocking part
+  of a load: world_prepare_tmx (TMX/TSX parse + collision build) and ecs_prefab_templates_build.
+  Prepared maps the new current map doesn't link to are dropped.
+
+  map_manager_take hands a map over: right away if the thread already has it, after waiting if
+  it's in flight, or loaded inline if it was never queued. Installing it and spawning its
+  entities stays with the caller (engine, at a tick boundary).
+*/
+#define MAP_MANAGER_MAX_MAPS 8
+#define MAP_MANAGER_MAX_LINKS 32
+#define MAP_MANAGER_PATH_MAX 256
+
+typedef struct {
+    float x, y, w, h; // trigger rect (px)
+    char  target_map[MAP_MANAGER_PATH_MAX]; // resolved against the linking map's path
+    char  target_spawn[64];                 // "" = keep the target map's own player spawn
+} map_link_t;
+
+typedef struct {
+    world_prepared_map_t*   world;
+    ecs_prefab_templates_t* templates;
+} map_preload_t;
+
+// New current map: rebuild the link table, queue the linked maps, drop unlinked preloads.
+void map_manager_set_current(const world_map_t* map, const char* tmx_path);
+size_t map_manager_link_count(void);
+const map_link_t* map_manager_link(size_t i);
+const map_link_t* map_manager_link_at(float x, float y); // NULL when the point is in no link
+
+bool map_manager_preload(const char* tmx_path); // queue; no-op if already cached or queued
+bool map_manager_is_ready(const char* tmx_path);
+bool map_manager_take(const char* tmx_path, map_preload_t* out); // caller owns out on success
+void map_preload_free(map_preload_t* preload);
+// An asset changed on disk (hot reload): drop every preload, since any of them may have been
+// built from it, and queue the current map's links again.
+void map_manager_invalidate(void);
+
+void map_manager_shutdown(void); // joins the thread and frees every preload
@@ -0,0 +1,415 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "modules/core/metrics.h"
+#include "modules/core/logger.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+#include <errno.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define METRICS_SERVER 1
+#else
+#define METRICS_SERVER 0
+#endif
+
+typedef enum {
+    METRIC_COUNTER = 1,
+    METRIC_GAUGE,
+    METRIC_HISTOGRAM,
+} metric_kind_t;
+
+struct metric {
+    metric_kind_t kind;
+    char          name[METRICS_NAME_MAX];
+    char          labels[METRICS_LABELS_MAX];
+    const char*   help; // by pointer: pass literals
+    uint64_t      value;                   // counter count, or gauge double bits
+    double        bounds[METRICS_MAX_BUCKETS];
+    int           bound_count;
+    uint64_t      buckets[METRICS_MAX_BUCKETS + 1]; // per bucket (not cumulative); last = +Inf
+    uint64_t      sum_bits;                // double bits
+    uint64_t      count;
+};
+
+const double metrics_seconds_buckets[] = {
+    0.00005, 0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.0167, 0.025, 0.05, 0.1,
+};
+const int metrics_seconds_bucket_count = (int)(sizeof(metrics_seconds_buckets) / sizeof(metrics_seconds_buckets[0]));
+
+static struct metric g_metrics[METRICS_MAX];
+static int           g_metric_count; // published with release once the slot is filled in
+
+#if METRICS_SERVER
+static pthread_mutex_t g_register_lock = PTHREAD_MUTEX_INITIALIZER;
+#define REGISTER_LOCK()   pthread_mutex_lock(&g_register_lock)
+#define REGISTER_UNLOCK() pthread_mutex_unlock(&g_register_lock)
+#else
+#define REGISTER_LOCK()   ((void)0)
+#define REGISTER_UNLOCK() ((void)0)
+#endif
+
+static uint64_t double_bits(double v)
+{
+    uint64_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+
+static double bits_double(uint64_t bits)
+{
+    double v;
+    memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+static metric_t* register_metric(metric_kind_t kind, const char* name, const char* help, const char* labels,
+                                 const double* bounds, int bound_count)
+{
+    if (!name || !name[0] || strlen(name) >= METRICS_NAME_MAX) return NULL;
+    if (!labels) labels = "";
+    if (strlen(labels) >= METRICS_LABELS_MAX) return NULL;
+
+    REGISTER_LOCK();
+    metric_t* m = NULL;
+    for (int i = 0; i < g_metric_count && !m; ++i) {
+        if (strcmp(g_metrics[i].name, name) == 0 && strcmp(g_metrics[i].labels, labels) == 0) m = &g_metrics[i];
+    }
+    if (m && m->kind != kind) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_WARN, "metrics: '%s' already registered as another type", name);
+        m = NULL;
+    } else if (!m && g_metric_count == METRICS_MAX) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_WARN, "metrics: registry full (%d), dropping '%s'", METRICS_MAX, name);
+    } else if (!m) {
+        m = &g_metrics[g_metric_count];
+        memset(m, 0, sizeof(*m));
+        m->kind = kind;
+        snprintf(m->name, sizeof(m->name), "%s", name);
+        snprintf(m->labels, sizeof(m->labels), "%s", labels);
+        m->help = help;
+        if (kind == METRIC_HISTOGRAM) {
+            if (!bounds) {
+                bounds = metrics_seconds_buckets;
+                bound_count = metrics_seconds_bucket_count;
+            }
+            if (bound_count > METRICS_MAX_BUCKETS) bound_count = METRICS_MAX_BUCKETS;
+            for (int b = 0; b < bound_count; ++b) m->bounds[b] = bounds[b];
+            m->bound_count = bound_count < 0 ? 0 : bound_count;
+        }
+        __atomic_store_n(&g_metric_count, g_metric_count + 1, __ATOMIC_RELEASE);
+    }
+    REGISTER_UNLOCK();
+    return m;
+}
+
+metric_t* metrics_counter(const char* name, const char* help, const char* labels)
+{
+    return register_metric(METRIC_COUNTER, name, help, labels, NULL, 0);
+}
+
+metric_t* metrics_gauge(const char* name, const char* help, const char* labels)
+{
+    return register_metric(METRIC_GAUGE, name, help, labels, NULL, 0);
+}
+
+metric_t* metrics_histogram(const char* name, const char* help, const char* labels, const double* bounds, int bound_count)
+{
+    return register_metric(METRIC_HISTOGRAM, name, help, labels, bounds, bound_count);
+}
+
+void metrics_add(metric_t* counter, uint64_t n)
+{
+    if (!counter) return;
+    __atomic_fetch_add(&counter->value, n, __ATOMIC_RELAXED);
+}
+
+void metrics_set(metric_t* gauge, double v)
+{
+    if (!gauge) return;
+    __atomic_store_n(&gauge->value, double_bits(v), __ATOMIC_RELAXED);
+}
+
+void metrics_observe(metric_t* h, double v)
+{
+    if (!h) return;
+    int b = 0;
+    while (b < h->bound_count && v > h->bounds[b]) ++b;
+    __atomic_fetch_add(&h->buckets[b], 1, __ATOMIC_RELAXED);
+
+    uint64_t old_bits = __atomic_load_n(&h->sum_bits, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&h->sum_bits, &old_bits, double_bits(bits_double(old_bits) + v),
+                                        true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+    __atomic_fetch_add(&h->count, 1, __ATOMIC_RELAXED);
+}
+
+uint64_t metrics_counter_value(const metric_t* counter)
+{
+    return counter ? __atomic_load_n(&counter->value, __ATOMIC_RELAXED) : 0;
+}
+
+double metrics_gauge_value(const metric_t* gauge)
+{
+    return gauge ? bits_double(__atomic_load_n(&gauge->value, __ATOMIC_RELAXED)) : 0.0;
+}
+
+uint64_t metrics_histogram_count(const metric_t* histogram)
+{
+    return histogram ? __atomic_load_n(&histogram->count, __ATOMIC_RELAXED) : 0;
+}
+
+// ---- exposition ----
+typedef struct {
+    char*  buf;
+    size_t cap;
+    size_t len; // full length, may exceed cap
+} out_t;
+
+static void out_printf(out_t* o, const char* fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    const size_t room = o->len < o->cap ? o->cap - o->len : 0;
+    const int n = vsnprintf(room ? o->buf + o->len : NULL, room, fmt, ap);
+    va_end(ap);
+    if (n > 0) o->len += (size_t)n;
+}
+
+static const char* kind_name(metric_kind_t kind)
+{
+    switch (kind) {
+        case METRIC_COUNTER:   return "counter";
+        case METRIC_GAUGE:     return "gauge";
+        case METRIC_HISTOGRAM: return "histogram";
+    }
+    return "untyped";
+}
+
+// "{labels}" / "{labels,extra}" / "{extra}" / "".
+static void out_labels(out_t* o, const char* labels, const char* extra)
+{
+    const bool has = labels[0] != '\0';
+    if (!has && !extra) return;
+    out_printf(o, "{%s%s%s}", labels, (has && extra) ? "," : "", extra ? extra : "");
+}
+
+static void render_series(out_t* o, const metric_t* m)
+{
+    if (m->kind == METRIC_COUNTER) {
+        out_printf(o, "%s", m->name);
+        out_labels(o, m->labels, NULL);
+        out_printf(o, " %llu\n", (unsigned long long)metrics_counter_value(m));
+        return;
+    }
+    if (m->kind == METRIC_GAUGE) {
+        out_printf(o, "%s", m->name);
+        out_labels(o, m->labels, NULL);
+        out_printf(o, " %.17g\n", metrics_gauge_value(m));
+        return;
+    }
+
+    uint64_t cumulative = 0;
+    char le[48];
+    for (int b = 0; b <= m->bound_count; ++b) {
+        cumulative += __atomic_load_n(&m->buckets[b], __ATOMIC_RELAXED);
+        if (b < m->bound_count) snprintf(le, sizeof(le), "le=\"%.9g\"", m->bounds[b]);
+        else                    snprintf(le, sizeof(le), "le=\"+Inf\"");
+        out_printf(o, "%s_bucket", m->name);
+        out_labels(o, m->labels, le);
+        out_printf(o, " %llu\n", (unsigned long long)cumulative);
+    }
+    out_printf(o, "%s_sum", m->name);
+    out_labels(o, m->labels, NULL);
+    out_printf(o, " %.17g\n", bits_double(__atomic_load_n(&m->sum_bits, __ATOMIC_RELAXED)));
+    out_printf(o, "%s_count", m->name);
+    out_labels(o, m->labels, NULL);
+    // Buckets and count are separate atomics; report the bucket total so they agree.
+    out_printf(o, " %llu\n", (unsigned long long)cumulative);
+}
+
+size_t metrics_render(char* buf, size_t cap)
+{
+    out_t o = { buf, cap, 0 };
+    if (buf && cap) buf[0] = '\0';
+    const int count = __atomic_load_n(&g_metric_count, __ATOMIC_ACQUIRE);
+    // The format wants each family (one name, any labels) in one block under its HELP/TYPE.
+    for (int i = 0; i < count; ++i) {
+        const metric_t* m = &g_metrics[i];
+        bool seen = false;
+        for (int j = 0; j < i && !seen; ++j) seen = strcmp(g_metrics[j].name, m->name) == 0;
+        if (seen) continue;
+
+        if (m->help) out_printf(&o, "# HELP %s %s\n", m->name, m->help);
+        out_printf(&o, "# TYPE %s %s\n", m->name, kind_name(m->kind));
+        for (int j = i; j < count; ++j) {
+            if (strcmp(g_metrics[j].name, m->name) == 0) render_series(&o, &g_metrics[j]);
+        }
+    }
+    return o.len;
+}
+
+// ---- server ----
+#if METRICS_SERVER
+
+static int       g_listen_fd = -1;
+static char      g_unix_path[108];
+static pthread_t g_server_thread;
+static bool      g_server_running;
+static bool      g_server_stop;
+
+static void write_all(int fd, const char* p, size_t n)
+{
+    while (n > 0) {
+        const ssize_t w = write(fd, p, n);
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) return;
+        p += w;
+        n -= (size_t)w;
+    }
+}
+
+static void serve_client(int fd)
+{
+    // The request itself doesn't matter (every path is /metrics); read it so the client sees a
+    // clean close, but don't wait on slow clients.
+    const struct timeval tv = { 0, 200000 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    char req[1024];
+    (void)read(fd, req, sizeof(req));
+
+    size_t need = metrics_render(NULL, 0) + 1;
+    char* body = (char*)malloc(need);
+    if (!body) return;
+    size_t len = metrics_render(body, need);
+    if (len >= need) len = need - 1; // registered more while rendering; serve what fit
+
+    char header[160];
+    const int hn = snprintf(header, sizeof(header),
+        "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: %zu\r\nConnection: close\r\n\r\n", len);
+    write_all(fd, header, (size_t)hn);
+    write_all(fd, body, len);
+    free(body);
+}
+
+static void* server_main(void* arg)
+{
+    (void)arg;
+    struct pollfd pfd = { g_listen_fd, POLLIN, 0 };
+    while (!__atomic_load_n(&g_server_stop, __ATOMIC_ACQUIRE)) {
+        if (poll(&pfd, 1, 100) <= 0) continue;
+        const int fd = accept(g_listen_fd, NULL, NULL);
+        if (fd < 0) continue;
+        serve_client(fd);
+        close(fd);
+    }
+    return NULL;
+}
+
+static int listen_tcp(int port)
+{
+    const int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    const int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    struct sockaddr_in sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sin_family = AF_INET;
+    sa.sin_port = htons((uint16_t)port);
+    sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK); // never reachable off the machine
+    if (bind(fd, (struct sockaddr*)&sa, sizeof(sa)) != 0 || listen(fd, 8) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static int listen_unix(const char* path)
+{
+    struct sockaddr_un sa;
+    if (strlen(path) >= sizeof(sa.sun_path)) return -1;
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    memset(&sa, 0, sizeof(sa));
+    sa.sun_family = AF_UNIX;
+    snprintf(sa.sun_path, sizeof(sa.sun_path), "%s", path);
+    unlink(path); // stale socket from an earlier run
+    if (bind(fd, (struct sockaddr*)&sa, sizeof(sa)) != 0 || listen(fd, 8) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool metrics_serve(const char* addr)
+{
+    if (!addr || !addr[0] || g_server_running) return false;
+
+    g_unix_path[0] = '\0';
+    int fd = -1;
+    if (strncmp(addr, "unix:", 5) == 0) {
+        fd = listen_unix(addr + 5);
+        if (fd >= 0) snprintf(g_unix_path, sizeof(g_unix_path), "%s", addr + 5);
+    } else {
+        const char* port_str = addr;
+        if (strncmp(addr, "localhost:", 10) == 0) port_str = addr + 10;
+        else if (strncmp(addr, "127.0.0.1:", 10) == 0) port_str = addr + 10;
+        char* end = NULL;
+        const long port = strtol(port_str, &end, 10);
+        if (end == port_str || *end != '\0' || port < 0 || port > 65535) {
+            LOGC(LOGCAT_MAIN, LOG_LVL_WARN, "metrics: bad address '%s' (want <port>, localhost:<port> or unix:<path>)", addr);
+            return false;
+        }
+        fd = listen_tcp((int)port);
+    }
+    if (fd < 0) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_WARN, "metrics: can't listen on '%s'", addr);
+        return false;
+    }
+
+    g_listen_fd = fd;
+    __atomic_store_n(&g_server_stop, false, __ATOMIC_RELEASE);
+    if (pthread_create(&g_server_thread, NULL, server_main, NULL) != 0) {
+        close(fd);
+        g_listen_fd = -1;
+        if (g_unix_path[0]) unlink(g_unix_path);
+        return false;
+    }
+    g_server_running = true;
+    LOGC(LOGCAT_MAIN, LOG_LVL_INFO, "metrics: serving on '%s'", addr);
+    return true;
+}
+
+void metrics_shutdown(void)
+{
+    if (!g_server_running) return;
+    __atomic_store_n(&g_server_stop, true, __ATOMIC_RELEASE);
+    pthread_join(g_server_thread, NULL);
+    close(g_listen_fd);
+    g_listen_fd = -1;
+    if (g_unix_path[0]) unlink(g_unix_path);
+    g_server_running = false;
+}
+
+#else
+
+bool metrics_serve(const char* addr)
+{
+    (void)addr;
+    LOGC(LOGCAT_MAIN, LOG_LVL_WARN, "metrics: no metrics server on this platform");
+    return false;
+}
+
+void metrics_shutdown(void) {}
+
+#endif
@@ -0,0 +1,47 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Process metrics in Prometheus text format. Counters, gauges and histograms are registered once
+// (registration takes a lock, returns the existing metric for a repeated name+labels) and then
+// updated with plain atomics, so hot paths never block. A NULL metric is a no-op everywhere, so
+// modules can update metrics that were never registered (e.g. in unit tests).
+//
+//   static metric_t* m_dropped;
+//   m_dropped = metrics_counter("painter_items_dropped_total", "Sprites dropped by a full painter queue", NULL);
+//   metrics_add(m_dropped, n);
+//
+// metrics_serve() answers HTTP GETs with the exposition from a background thread, on a loopback
+// TCP port or a Unix socket (curl --unix-socket <path> http://localhost/metrics).
+
+#define METRICS_MAX             128
+#define METRICS_MAX_BUCKETS     16
+#define METRICS_NAME_MAX        64
+#define METRICS_LABELS_MAX      64
+
+typedef struct metric metric_t;
+
+// labels: Prometheus label list without braces, e.g. "system=\"physics\"", or NULL.
+metric_t* metrics_counter(const char* name, const char* help, const char* labels);
+metric_t* metrics_gauge(const char* name, const char* help, const char* labels);
+// bounds: ascending upper bounds (the +Inf bucket is implicit); NULL = metrics_seconds_buckets.
+metric_t* metrics_histogram(const char* name, const char* help, const char* labels, const double* bounds, int bound_count);
+
+void metrics_add(metric_t* counter, uint64_t n);
+void metrics_set(metric_t* gauge, double v);
+void metrics_observe(metric_t* histogram, double v);
+
+uint64_t metrics_counter_value(const metric_t* counter);
+double   metrics_gauge_value(const metric_t* gauge);
+uint64_t metrics_histogram_count(const metric_t* histogram);
+
+// Writes the exposition into buf (NUL-terminated if cap > 0); returns the full length like snprintf.
+size_t metrics_render(char* buf, size_t cap);
+
+// addr: "<port>" / "localhost:<port>" (binds 127.0.0.1) or "unix:<path>". false if it can't listen.
+bool metrics_serve(const char* addr);
+void metrics_shutdown(void); // stops the server; metrics (and handles to them) stay valid
+
+extern const double metrics_seconds_buckets[];
+extern const int    metrics_seconds_bucket_count;
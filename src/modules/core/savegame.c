@@ -0,0 +1,278 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "modules/core/savegame.h"
+#include "modules/core/logger.h"
+#include "modules/common/delta_codec.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+#include <pthread.h>
+#define SAVEGAME_THREADED 1
+#else
+#define SAVEGAME_THREADED 0
+#endif
+
+#define SAVEGAME_MAGIC SNAP_TAG('S','A','V','E')
+#define SAVEGAME_MAX_PATH 512
+
+typedef struct {
+    uint64_t    base_size;
+    uint64_t    target_size;
+    char        map_path[SAVEGAME_MAX_PATH];
+    uint32_t    base_hash;
+    uint32_t    target_hash;
+} savegame_header_t;
+
+static uint32_t fnv1a(const uint8_t* p, size_t n)
+{
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < n; ++i) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static bool snapshot_body(const snapshot_t* snap, const uint8_t** out, size_t* out_size)
+{
+    const size_t off = snapshot_body_offset();
+    if (!snap || !snap->data || snap->size < off) return false;
+    *out = snap->data + off;
+    *out_size = snap->size - off;
+    return true;
+}
+
+bool savegame_encode(snap_buf_t* out, const snapshot_t* baseline, const snapshot_t* current, const char* map_path)
+{
+    const uint8_t *base, *target;
+    size_t base_size, target_size;
+    if (!out || !map_path || !snapshot_body(baseline, &base, &base_size) ||
+        !snapshot_body(current, &target, &target_size)) {
+        return false;
+    }
+
+    const size_t path_len = strlen(map_path);
+    if (path_len >= SAVEGAME_MAX_PATH) return false;
+
+    const uint32_t magic = SAVEGAME_MAGIC;
+    const uint32_t base_hash = fnv1a(base, base_size);
+    const uint32_t target_hash = fnv1a(target, target_size);
+    SNAP_WRITE_VAL(out, magic);
+    snap_write_varint(out, SAVEGAME_VERSION);
+    snap_write_varint(out, base_size);
+    snap_write_varint(out, target_size);
+    snap_write_varint(out, path_len);
+    snap_write(out, map_path, path_len);
+    SNAP_WRITE_VAL(out, base_hash);
+    SNAP_WRITE_VAL(out, target_hash);
+    delta_encode(out, base, base_size, target, target_size);
+    return true;
+}
+
+static bool read_header(snap_reader_t* r, savegame_header_t* hdr)
+{
+    uint32_t magic = 0;
+    uint64_t version = 0, path_len = 0;
+    if (!SNAP_READ_VAL(r, magic) || magic != SAVEGAME_MAGIC) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "savegame: not a save file");
+        return false;
+    }
+    if (!snap_read_varint(r, &version) || version != SAVEGAME_VERSION) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "savegame: unsupported version %llu", (unsigned long long)version);
+        return false;
+    }
+    bool ok = snap_read_varint(r, &hdr->base_size) &&
+              snap_read_varint(r, &hdr->target_size) &&
+              snap_read_varint(r, &path_len) &&
+              path_len < sizeof(hdr->map_path) &&
+              snap_read(r, hdr->map_path, (size_t)path_len) &&
+              SNAP_READ_VAL(r, hdr->base_hash) &&
+              SNAP_READ_VAL(r, hdr->target_hash);
+    if (!ok) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "savegame: truncated header");
+        return false;
+    }
+    hdr->map_path[path_len] = '\0';
+    return true;
+}
+
+bool savegame_map_path(const uint8_t* data, size_t size, char* out, size_t out_cap)
+{
+    snap_reader_t r = { .data = data, .size = size };
+    savegame_header_t hdr;
+    if (!out || out_cap == 0 || !read_header(&r, &hdr)) return false;
+    if (strlen(hdr.map_path) >= out_cap) return false;
+    memcpy(out, hdr.map_path, strlen(hdr.map_path) + 1);
+    return true;
+}
+
+bool savegame_decode(snapshot_t* out, const snapshot_t* baseline, const uint8_t* data, size_t size)
+{
+    const uint8_t* base;
+    size_t base_size;
+    if (!out || !snapshot_body(baseline, &base, &base_size)) return false;
+
+    snap_reader_t r = { .data = data, .size = size };
+    savegame_header_t hdr;
+    if (!read_header(&r, &hdr)) return false;
+    if (hdr.base_size != base_size || hdr.base_hash != fnv1a(base, base_size)) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "savegame: '%s' has changed since this save was made", hdr.map_path);
+        return false;
+    }
+
+    snap_buf_t body = {0};
+    bool ok = delta_decode(&body, base, base_size, &r, (size_t)hdr.target_size) && r.pos == r.size;
+    if (!ok) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "savegame: corrupt delta at byte %zu of %zu", r.pos, r.size);
+    } else if (fnv1a(body.data, body.size) != hdr.target_hash) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "savegame: decoded state doesn't match the saved checksum");
+        ok = false;
+    } else {
+        ok = snapshot_wrap_body(out, body.data, body.size);
+    }
+    DA_FREE(&body);
+    return ok;
+}
+
+bool savegame_read_file(const char* path, snap_buf_t* out)
+{
+    FILE* f = path ? fopen(path, "rb") : NULL;
+    if (!f) return false;
+
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+        snap_write(out, chunk, n);
+    }
+    const bool ok = !ferror(f);
+    fclose(f);
+    return ok;
+}
+
+bool savegame_write_file(const char* path, const uint8_t* data, size_t size)
+{
+    char tmp[SAVEGAME_MAX_PATH + 8];
+    if (!path || snprintf(tmp, sizeof(tmp), "%s.tmp", path) >= (int)sizeof(tmp)) return false;
+
+    FILE* f = fopen(tmp, "wb");
+    if (!f) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "savegame: can't write '%s'", tmp);
+        return false;
+    }
+    bool ok = fwrite(data, 1, size, f) == size;
+    ok = (fclose(f) == 0) && ok;
+    if (ok && rename(tmp, path) != 0) {
+        // Windows rename() won't replace an existing file.
+        remove(path);
+        ok = rename(tmp, path) == 0;
+    }
+    if (!ok) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "savegame: failed writing '%s'", path);
+        remove(tmp);
+    }
+    return ok;
+}
+
+#if SAVEGAME_THREADED
+
+static pthread_mutex_t g_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  g_cond = PTHREAD_COND_INITIALIZER;
+static pthread_t       g_thread;
+static bool            g_thread_started;
+static bool            g_stop;
+static bool            g_busy;
+static bool            g_has_pending;
+static snap_buf_t      g_pending;
+static char            g_pending_path[SAVEGAME_MAX_PATH];
+
+static void* savegame_writer(void* arg)
+{
+    (void)arg;
+    pthread_mutex_lock(&g_lock);
+    for (;;) {
+        while (!g_has_pending && !g_stop) pthread_cond_wait(&g_cond, &g_lock);
+        if (!g_has_pending) break;
+
+        snap_buf_t save = g_pending;
+        char path[SAVEGAME_MAX_PATH];
+        memcpy(path, g_pending_path, sizeof(path));
+        g_pending = (snap_buf_t){0};
+        g_has_pending = false;
+        g_busy = true;
+        pthread_mutex_unlock(&g_lock);
+
+        savegame_write_file(path, save.data, save.size);
+        DA_FREE(&save);
+
+        pthread_mutex_lock(&g_lock);
+        g_busy = false;
+        pthread_cond_broadcast(&g_cond);
+    }
+    pthread_mutex_unlock(&g_lock);
+    return NULL;
+}
+
+void savegame_write_async(const char* path, snap_buf_t* save)
+{
+    if (!path || !save || strlen(path) >= SAVEGAME_MAX_PATH) return;
+
+    pthread_mutex_lock(&g_lock);
+    if (!g_thread_started) {
+        g_stop = false;
+        g_thread_started = pthread_create(&g_thread, NULL, savegame_writer, NULL) == 0;
+    }
+    if (!g_thread_started) {
+        pthread_mutex_unlock(&g_lock);
+        savegame_write_file(path, save->data, save->size);
+        DA_FREE(save);
+        return;
+    }
+    DA_FREE(&g_pending);
+    g_pending = *save;
+    *save = (snap_buf_t){0};
+    memcpy(g_pending_path, path, strlen(path) + 1);
+    g_has_pending = true;
+    pthread_cond_broadcast(&g_cond);
+    pthread_mutex_unlock(&g_lock);
+}
+
+void savegame_flush(void)
+{
+    pthread_mutex_lock(&g_lock);
+    while (g_thread_started && (g_has_pending || g_busy)) pthread_cond_wait(&g_cond, &g_lock);
+    pthread_mutex_unlock(&g_lock);
+}
+
+void savegame_shutdown(void)
+{
+    pthread_mutex_lock(&g_lock);
+    if (!g_thread_started) {
+        pthread_mutex_unlock(&g_lock);
+        return;
+    }
+    g_stop = true;
+    pthread_cond_broadcast(&g_cond);
+    pthread_mutex_unlock(&g_lock);
+
+    pthread_join(g_thread, NULL);
+    g_thread_started = false;
+}
+
+#else
+
+void savegame_write_async(const char* path, snap_buf_t* save)
+{
+    if (!path || !save) return;
+    savegame_write_file(path, save->data, save->size);
+    DA_FREE(save);
+}
+
+void savegame_flush(void) {}
+void savegame_shutdown(void) {}
+
+#endif
@@ -0,0 +1,34 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "modules/common/snapshot_io.h"
+#include "modules/core/snapshot.h"
+
+/*
+  Save games: the live snapshot body (see snapshot.h) delta-encoded against the baseline
+  snapshot taken right after the map's entities spawned, so a save only carries what play changed:
+  destroyed or spawned entities, changed components, tile edits, storage counts.
+
+  File: "SAVE" magic, then varints: version, baseline body size, target body size, map path
+  length + bytes, u32 FNV-1a checksums of the baseline and target bodies, then the delta_codec
+  stream. Loading rebuilds the snapshot from the same freshly loaded map; the baseline checksum
+  rejects saves taken against a different TMX or prefab set, the target one a damaged delta.
+
+  Encoding is done by the caller (it reads the simulation); the background writer only does
+  the file I/O, writing to "<path>.tmp" and renaming over the old save.
+*/
+#define SAVEGAME_VERSION 2
+
+bool savegame_encode(snap_buf_t* out, const snapshot_t* baseline, const snapshot_t* current, const char* map_path);
+bool savegame_map_path(const uint8_t* data, size_t size, char* out, size_t out_cap);
+bool savegame_decode(snapshot_t* out, const snapshot_t* baseline, const uint8_t* data, size_t size);
+
+bool savegame_read_file(const char* path, snap_buf_t* out);
+bool savegame_write_file(const char* path, const uint8_t* data, size_t size);
+
+// Queues a write on the background thread and takes ownership of save->data (left empty).
+// A newer save replaces one still waiting; the thread starts on first use.
+void savegame_write_async(const char* path, snap_buf_t* save);
+void savegame_flush(void);    // blocks until queued writes are on disk
+void savegame_shutdown(void); // flushes and joins the thread
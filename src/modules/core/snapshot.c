@@ -0,0 +1,147 @@
+#include "modules/core/snapshot.h"
+#include "modules/core/camera.h"
+#include "modules/core/logger.h"
+#include "modules/common/snapshot_io.h"
+#include "modules/ecs/ecs_internal.h"
+#include "modules/world/world_map.h"
+#include "modules/world/world_door.h"
+#include "modules/world/world_stream.h"
+
+#include <stdlib.h>
+
+// Header guards against restoring into a different build or map.
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t max_entities;
+    uint32_t layout;        // sum of component struct sizes; catches struct changes between builds
+    uint32_t map_gen;
+    uint32_t size;          // whole blob, header included
+} snapshot_header_t;
+
+#define SNAPSHOT_MAGIC SNAP_TAG('S','N','A','P')
+
+static uint32_t snapshot_layout(void)
+{
+    return (uint32_t)(sizeof(cmp_position_t) + sizeof(cmp_velocity_t) + sizeof(cmp_follow_t) +
+                      sizeof(cmp_anim_t) + sizeof(cmp_sprite_t) + sizeof(cmp_collider_t) +
+                      sizeof(cmp_trigger_t) + sizeof(cmp_billboard_t) + sizeof(cmp_phys_body_t) +
+                      sizeof(cmp_grav_gun_t) + sizeof(cmp_door_t));
+}
+
+static snapshot_header_t snapshot_header_now(void)
+{
+    return (snapshot_header_t){
+        .magic = SNAPSHOT_MAGIC,
+        .version = SNAPSHOT_VERSION,
+        .max_entities = ECS_MAX_ENTITIES,
+        .layout = snapshot_layout(),
+        .map_gen = world_map_generation(),
+    };
+}
+
+bool snapshot_capture(snapshot_t* out)
+{
+    if (!out) return false;
+    snapshot_free(out);
+    if (world_stream_active()) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_WARN, "snapshot: streamed maps can't be captured");
+        return false;
+    }
+
+    snap_buf_t b = {0};
+    snapshot_header_t hdr = snapshot_header_now();
+    SNAP_WRITE_VAL(&b, hdr);
+
+    ecs_snapshot_write(&b);
+    world_snapshot_write(&b);
+    world_door_snapshot_write(&b);
+    camera_snapshot_write(&b);
+
+    hdr.size = (uint32_t)b.size;
+    memcpy(b.data, &hdr, sizeof(hdr));
+
+    out->data = b.data;
+    out->size = b.size;
+    return true;
+}
+
+static bool apply_sections(snap_reader_t* r)
+{
+    const bool ok = ecs_snapshot_read(r) &&
+                    world_snapshot_read(r) &&
+                    world_door_snapshot_read(r) &&
+                    camera_snapshot_read(r);
+    return ok && r->pos == r->size;
+}
+
+bool snapshot_restore(const snapshot_t* snap)
+{
+    if (!snap || !snap->data) return false;
+
+    snap_reader_t r = { .data = snap->data, .size = snap->size };
+    snapshot_header_t hdr;
+    if (!SNAP_READ_VAL(&r, hdr) || hdr.magic != SNAPSHOT_MAGIC || hdr.size != snap->size) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "snapshot: not a snapshot blob");
+        return false;
+    }
+    if (hdr.version != SNAPSHOT_VERSION || hdr.max_entities != ECS_MAX_ENTITIES || hdr.layout != snapshot_layout()) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "snapshot: blob is from an incompatible build (version %u)", hdr.version);
+        return false;
+    }
+    if (hdr.map_gen != world_map_generation()) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "snapshot: map was reloaded since capture (gen %u, now %u)",
+             hdr.map_gen, world_map_generation());
+        return false;
+    }
+
+    if (world_stream_active()) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "snapshot: streamed maps can't be restored");
+        return false;
+    }
+
+    // Sections apply as they parse, so a blob that goes bad halfway would leave a mix of old
+    // and new state. Keep the current state and put it back if anything fails.
+    snapshot_t backup = {0};
+    if (!snapshot_capture(&backup)) return false;
+
+    const bool ok = apply_sections(&r);
+    if (!ok) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "snapshot: restore failed at byte %zu of %zu", r.pos, r.size);
+        snap_reader_t back = { .data = backup.data, .size = backup.size, .pos = sizeof(snapshot_header_t) };
+        if (!apply_sections(&back)) {
+            LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "snapshot: rollback failed; simulation state is inconsistent");
+        }
+    }
+    snapshot_free(&backup);
+    return ok;
+}
+
+void snapshot_free(snapshot_t* snap)
+{
+    if (!snap) return;
+    free(snap->data);
+    snap->data = NULL;
+    snap->size = 0;
+}
+
+size_t snapshot_body_offset(void)
+{
+    return sizeof(snapshot_header_t);
+}
+
+bool snapshot_wrap_body(snapshot_t* out, const uint8_t* body, size_t body_size)
+{
+    if (!out || (!body && body_size)) return false;
+    snapshot_free(out);
+
+    snap_buf_t b = {0};
+    snapshot_header_t hdr = snapshot_header_now();
+    hdr.size = (uint32_t)(sizeof(hdr) + body_size);
+    SNAP_WRITE_VAL(&b, hdr);
+    snap_write(&b, body, body_size);
+
+    out->data = b.data;
+    out->size = b.size;
+    return true;
+}
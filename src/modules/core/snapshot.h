@@ -0,0 +1,29 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+  Whole-simulation snapshot: ECS storage (masks, generations, free list, components, game
+  storage, proximity views, animation arena), world tile state + queued edits, door records
+  and the camera, packed into one versioned blob.
+
+  Restore is a straight copy back (no TMX parse, no prefab spawns) and only accepts a blob
+  captured by this build against the currently loaded map. Use it for instant restarts,
+  rollback experiments and test fixtures.
+*/
+#define SNAPSHOT_VERSION 1
+
+typedef struct {
+    uint8_t* data;
+    size_t   size;
+} snapshot_t;
+
+bool snapshot_capture(snapshot_t* out);        // out: zeroed or a previous capture (freed first)
+bool snapshot_restore(const snapshot_t* snap);
+void snapshot_free(snapshot_t* snap);
+
+// The body is everything after the fixed header. Save games store bodies only and re-wrap them
+// with a header for the current build and map before restoring.
+size_t snapshot_body_offset(void);
+bool snapshot_wrap_body(snapshot_t* out, const uint8_t* body, size_t body_size);
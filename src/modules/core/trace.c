@@ -0,0 +1,189 @@
+#include "modules/core/trace.h"
+
+#if ENGINE_TRACE
+
+#include "modules/core/logger.h"
+#include "modules/core/time.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(__GNUC__)
+#define TRACE_TLS __thread
+#define TRACE_CLAIM_SLOT(p) __atomic_fetch_add((p), 1, __ATOMIC_RELAXED)
+#else
+// No TLS: single-threaded fallback.
+#define TRACE_TLS
+#define TRACE_CLAIM_SLOT(p) ((*(p))++)
+#endif
+
+typedef struct {
+    const char* name;
+    double start_us;
+    double dur_us;
+} trace_event_t;
+
+typedef struct {
+    trace_event_t* events;        // ring of TRACE_MAX_EVENTS
+    size_t         head;          // total events recorded; ring index = head % TRACE_MAX_EVENTS
+    const char*    open_name[TRACE_MAX_DEPTH];
+    double         open_start[TRACE_MAX_DEPTH];
+    int            depth;
+    int            tid;
+} trace_buffer_t;
+
+static trace_buffer_t g_buffers[TRACE_MAX_THREADS];
+static int            g_buffer_count = 0;
+static double         g_epoch = -1.0;
+static TRACE_TLS trace_buffer_t* t_buf = NULL;
+static TRACE_TLS bool t_no_slot = false;
+
+// Set by the first event on any thread; the map preload thread can get there first.
+static double trace_epoch(double now)
+{
+#if defined(__GNUC__)
+    double epoch;
+    __atomic_load(&g_epoch, &epoch, __ATOMIC_ACQUIRE);
+    if (epoch >= 0.0) return epoch;
+    epoch = -1.0;
+    // On a lost race epoch comes back holding the winner's value.
+    if (__atomic_compare_exchange(&g_epoch, &epoch, &now, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) return now;
+    return epoch;
+#else
+    if (g_epoch < 0.0) g_epoch = now;
+    return g_epoch;
+#endif
+}
+
+static double trace_now_us(void)
+{
+    const double now = time_now();
+    return (now - trace_epoch(now)) * 1e6;
+}
+
+static trace_buffer_t* thread_buffer(void)
+{
+    if (t_buf || t_no_slot) return t_buf;
+
+    const int slot = TRACE_CLAIM_SLOT(&g_buffer_count);
+    if (slot >= TRACE_MAX_THREADS) {
+        t_no_slot = true;
+        return NULL;
+    }
+    trace_buffer_t* b = &g_buffers[slot];
+    b->events = (trace_event_t*)malloc(sizeof(trace_event_t) * TRACE_MAX_EVENTS);
+    if (!b->events) {
+        t_no_slot = true;
+        return NULL;
+    }
+    b->head = 0;
+    b->depth = 0;
+    b->tid = slot + 1;
+    t_buf = b;
+    return b;
+}
+
+void trace_begin(const char* name)
+{
+    trace_buffer_t* b = thread_buffer();
+    if (!b) return;
+    if (b->depth < TRACE_MAX_DEPTH) {
+        b->open_name[b->depth] = name ? name : "?";
+        b->open_start[b->depth] = trace_now_us();
+    }
+    b->depth++;
+}
+
+void trace_end(void)
+{
+    trace_buffer_t* b = t_buf;
+    if (!b || b->depth <= 0) return;
+    b->depth--;
+    if (b->depth >= TRACE_MAX_DEPTH) return;
+
+    const double end = trace_now_us();
+    trace_event_t* e = &b->events[b->head % TRACE_MAX_EVENTS];
+    e->name = b->open_name[b->depth];
+    e->start_us = b->open_start[b->depth];
+    e->dur_us = end - e->start_us;
+    b->head++;
+}
+
+static int claimed_buffers(void)
+{
+    return g_buffer_count < TRACE_MAX_THREADS ? g_buffer_count : TRACE_MAX_THREADS;
+}
+
+size_t trace_event_count(void)
+{
+    size_t n = 0;
+    for (int i = 0; i < claimed_buffers(); ++i) {
+        const size_t h = g_buffers[i].head;
+        n += (h < TRACE_MAX_EVENTS) ? h : TRACE_MAX_EVENTS;
+    }
+    return n;
+}
+
+void trace_reset(void)
+{
+    for (int i = 0; i < claimed_buffers(); ++i) {
+        g_buffers[i].head = 0;
+    }
+}
+
+void trace_shutdown(void)
+{
+    for (int i = 0; i < claimed_buffers(); ++i) {
+        free(g_buffers[i].events);
+        g_buffers[i] = (trace_buffer_t){0};
+    }
+    g_buffer_count = 0;
+    t_buf = NULL;
+    t_no_slot = false;
+}
+
+static void write_json_string(FILE* f, const char* s)
+{
+    fputc('"', f);
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') fputc('\\', f);
+        if ((unsigned char)*s < 0x20) continue;
+        fputc(*s, f);
+    }
+    fputc('"', f);
+}
+
+bool trace_write_json(const char* path)
+{
+    if (!path) return false;
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "trace: can't open '%s'", path);
+        return false;
+    }
+
+    size_t written = 0;
+    size_t overwritten = 0;
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", f);
+    for (int t = 0; t < claimed_buffers(); ++t) {
+        const trace_buffer_t* b = &g_buffers[t];
+        const size_t n = (b->head < TRACE_MAX_EVENTS) ? b->head : TRACE_MAX_EVENTS;
+        const size_t first = b->head - n;
+        overwritten += first;
+        for (size_t k = first; k < b->head; ++k) {
+            const trace_event_t* e = &b->events[k % TRACE_MAX_EVENTS];
+            fputs(written ? ",\n" : "\n", f);
+            fputs("{\"name\":", f);
+            write_json_string(f, e->name);
+            fprintf(f, ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", b->tid, e->start_us, e->dur_us);
+            ++written;
+        }
+    }
+    fputs("\n]}\n", f);
+    fclose(f);
+
+    LOGC(LOGCAT_MAIN, LOG_LVL_INFO, "trace: wrote %zu events to %s (%zu overwritten)", written, path, overwritten);
+    return true;
+}
+
+#endif // ENGINE_TRACE
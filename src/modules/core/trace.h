@@ -0,0 +1,41 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include "modules/core/build_config.h"
+
+// Scoped trace markers for frame timelines. Each thread records into its own buffer (no locks);
+// trace_write_json() exports Chrome trace JSON that chrome://tracing and ui.perfetto.dev open.
+// Compiled out entirely unless ENGINE_TRACE (on in debug builds).
+//
+//   TRACE_BEGIN("tiled_load_map");
+//   ...
+//   TRACE_END();
+//
+// Names are stored by pointer, so pass string literals or names that outlive the trace.
+
+#define TRACE_MAX_EVENTS  65536 // per thread; oldest events are overwritten once full
+#define TRACE_MAX_DEPTH   32
+#define TRACE_MAX_THREADS 8
+
+#if ENGINE_TRACE
+void   trace_begin(const char* name);
+void   trace_end(void);
+// Write every thread's events. Call with other threads idle (exit, or between frames).
+bool   trace_write_json(const char* path);
+void   trace_reset(void);
+size_t trace_event_count(void);
+// Free every thread's buffer. Call once the other threads have been joined; tracing after it
+// starts from empty buffers.
+void   trace_shutdown(void);
+
+#define TRACE_BEGIN(name) trace_begin(name)
+#define TRACE_END()       trace_end()
+#else
+static inline bool   trace_write_json(const char* path) { (void)path; return false; }
+static inline void   trace_reset(void) {}
+static inline void   trace_shutdown(void) {}
+static inline size_t trace_event_count(void) { return 0; }
+
+#define TRACE_BEGIN(name) ((void)0)
+#define TRACE_END()       ((void)0)
+#endif
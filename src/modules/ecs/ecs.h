@@ -72,12 +72,21 @@ bool ecs_get_player_position(float* out_x, float* out_y);
 bool ecs_get_position(ecs_entity_t e, v2f* out_pos);
 ecs_entity_t ecs_find_player(void);
 
+// Render interpolation: positions are snapshotted before each fixed tick and render views
+// blend snapshot -> current by alpha (accumulator / fixed dt), so render rate is free of sim rate.
+void ecs_store_prev_positions(void);
+void ecs_set_render_alpha(float alpha); // clamped to [0, 1]; 1 = draw current positions
+float ecs_render_alpha(void);
+bool ecs_get_render_position(ecs_entity_t e, v2f* out_pos);
+
 // ====== Entity / components ======
 ecs_entity_t ecs_create(void);
 void         ecs_destroy(ecs_entity_t e);
 void         ecs_mark_destroy(ecs_entity_t e);
 void         ecs_cleanup_marked(void);
 void         ecs_destroy_marked(void);
+void         ecs_destroy_all(void); // map change: every entity, cleanup hooks included
+int          ecs_live_count(void);
 
 void cmp_add_position (ecs_entity_t e, float x, float y);
 void cmp_add_velocity(ecs_entity_t e, float x, float y, facing_t direction);
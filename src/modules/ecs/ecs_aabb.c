@@ -0,0 +1,112 @@
+#include "modules/ecs/ecs_aabb.h"
+#include <math.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AABB_HAVE_SSE2 1
+#else
+#define AABB_HAVE_SSE2 0
+#endif
+
+static int batch_lanes(const aabb_batch_t* batch, int first)
+{
+    if (!batch || first < 0 || first >= batch->count) return 0;
+    int n = batch->count - first;
+    return (n > AABB_BATCH_MAX) ? AABB_BATCH_MAX : n;
+}
+
+static uint32_t overlap_scalar_range(float cx, float cy, float hx, float hy,
+                                     const aabb_batch_t* batch, int first, int from, int to, bool inclusive)
+{
+    uint32_t mask = 0u;
+    for (int i = from; i < to; ++i) {
+        const int k = first + i;
+        const float dx = fabsf(batch->cx[k] - cx);
+        const float dy = fabsf(batch->cy[k] - cy);
+        const float sx = hx + batch->hx[k];
+        const float sy = hy + batch->hy[k];
+        const bool hit = inclusive ? (dx <= sx && dy <= sy) : (dx < sx && dy < sy);
+        if (hit) mask |= (1u << i);
+    }
+    return mask;
+}
+
+uint32_t aabb_overlap_mask_scalar(float cx, float cy, float hx, float hy,
+                                  const aabb_batch_t* batch, int first, bool inclusive)
+{
+    const int n = batch_lanes(batch, first);
+    return overlap_scalar_range(cx, cy, hx, hy, batch, first, 0, n, inclusive);
+}
+
+uint32_t aabb_overlap_mask(float cx, float cy, float hx, float hy,
+                           const aabb_batch_t* batch, int first, bool inclusive)
+{
+    const int n = batch_lanes(batch, first);
+    uint32_t mask = 0u;
+    int i = 0;
+
+#if defined(__AVX2__)
+    {
+        const __m256 sign = _mm256_set1_ps(-0.0f);
+        const __m256 bcx = _mm256_set1_ps(cx);
+        const __m256 bcy = _mm256_set1_ps(cy);
+        const __m256 bhx = _mm256_set1_ps(hx);
+        const __m256 bhy = _mm256_set1_ps(hy);
+        for (; i + 8 <= n; i += 8) {
+            const int k = first + i;
+            __m256 dx = _mm256_andnot_ps(sign, _mm256_sub_ps(_mm256_loadu_ps(batch->cx + k), bcx));
+            __m256 dy = _mm256_andnot_ps(sign, _mm256_sub_ps(_mm256_loadu_ps(batch->cy + k), bcy));
+            __m256 sx = _mm256_add_ps(bhx, _mm256_loadu_ps(batch->hx + k));
+            __m256 sy = _mm256_add_ps(bhy, _mm256_loadu_ps(batch->hy + k));
+            __m256 hit;
+            // _mm256_cmp_ps needs an immediate predicate.
+            if (inclusive) {
+                hit = _mm256_and_ps(_mm256_cmp_ps(dx, sx, _CMP_LE_OQ), _mm256_cmp_ps(dy, sy, _CMP_LE_OQ));
+            } else {
+                hit = _mm256_and_ps(_mm256_cmp_ps(dx, sx, _CMP_LT_OQ), _mm256_cmp_ps(dy, sy, _CMP_LT_OQ));
+            }
+            mask |= (uint32_t)_mm256_movemask_ps(hit) << i;
+        }
+    }
+#endif
+
+#if AABB_HAVE_SSE2
+    {
+        const __m128 sign = _mm_set1_ps(-0.0f);
+        const __m128 bcx = _mm_set1_ps(cx);
+        const __m128 bcy = _mm_set1_ps(cy);
+        const __m128 bhx = _mm_set1_ps(hx);
+        const __m128 bhy = _mm_set1_ps(hy);
+        for (; i + 4 <= n; i += 4) {
+            const int k = first + i;
+            __m128 dx = _mm_andnot_ps(sign, _mm_sub_ps(_mm_loadu_ps(batch->cx + k), bcx));
+            __m128 dy = _mm_andnot_ps(sign, _mm_sub_ps(_mm_loadu_ps(batch->cy + k), bcy));
+            __m128 sx = _mm_add_ps(bhx, _mm_loadu_ps(batch->hx + k));
+            __m128 sy = _mm_add_ps(bhy, _mm_loadu_ps(batch->hy + k));
+            __m128 hit = inclusive
+                ? _mm_and_ps(_mm_cmple_ps(dx, sx), _mm_cmple_ps(dy, sy))
+                : _mm_and_ps(_mm_cmplt_ps(dx, sx), _mm_cmplt_ps(dy, sy));
+            mask |= (uint32_t)_mm_movemask_ps(hit) << i;
+        }
+    }
+#endif
+
+    if (i < n) {
+        mask |= overlap_scalar_range(cx, cy, hx, hy, batch, first, i, n, inclusive);
+    }
+    return mask;
+}
+
+const char* aabb_overlap_kernel_name(void)
+{
+#if defined(__AVX2__)
+    return "avx2";
+#elif AABB_HAVE_SSE2
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
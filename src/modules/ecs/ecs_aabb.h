@@ -0,0 +1,41 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+
+// Max boxes tested per call (one bit per box in the returned mask).
+#define AABB_BATCH_MAX 32
+
+// Packed SoA batch of center/half-extent boxes.
+typedef struct {
+    const float* cx;
+    const float* cy;
+    const float* hx;
+    const float* hy;
+    int count;
+} aabb_batch_t;
+
+// Test one box against up to AABB_BATCH_MAX boxes of a batch, starting at `first`.
+// Bit i of the result is set when box (first + i) overlaps. With inclusive=false,
+// touching edges do not count (physics); with inclusive=true they do (triggers, picking).
+uint32_t aabb_overlap_mask(float cx, float cy, float hx, float hy,
+                           const aabb_batch_t* batch, int first, bool inclusive);
+
+// Reference implementation; always compiled so benchmarks/tests can compare.
+uint32_t aabb_overlap_mask_scalar(float cx, float cy, float hx, float hy,
+                                  const aabb_batch_t* batch, int first, bool inclusive);
+
+// Pop the lowest set bit of *mask and return its lane index (mask must be non-zero).
+static inline int aabb_mask_pop(uint32_t* mask)
+{
+#if defined(__GNUC__)
+    const int lane = __builtin_ctz(*mask);
+#else
+    int lane = 0;
+    while (((*mask >> lane) & 1u) == 0u) ++lane;
+#endif
+    *mask &= *mask - 1u;
+    return lane;
+}
+
+// Name of the path aabb_overlap_mask was compiled with ("avx2", "sse2" or "scalar").
+const char* aabb_overlap_kernel_name(void);
@@ -2,13 +2,16 @@
 #include "modules/core/input.h"
 #include "modules/core/logger.h"
 #include "modules/asset/bump_alloc.h"
+#include "modules/common/hashmap.h"
+#include "modules/common/mem_tag.h"
 #include "modules/systems/systems_registration.h"
 #include <string.h>
 #include <stdlib.h>
 #include <stdint.h>
 
 // Animation data is flattened into a bump allocator so the per-frame systems
-// touch a single contiguous memory region.
+// touch a single contiguous memory region. This is the first chunk; big content
+// sets chain more and are coalesced back into one on the next reset.
 #ifndef ECS_ANIM_ARENA_BYTES
 #define ECS_ANIM_ARENA_BYTES (128 * 1024)
 #endif
@@ -25,12 +28,17 @@ typedef struct {
     const int* frames_per_anim;
     const int* anim_offsets;
     const anim_frame_coord_t* frames;
+    int next_same_hash; // older def with the same 64-bit hash, or -1
 } anim_def_entry_t;
 
 static anim_def_entry_t* g_anim_defs = NULL;
 static size_t g_anim_defs_count = 0;
 static size_t g_anim_defs_cap = 0;
 
+// Content hash -> newest def with that hash; collisions chain through next_same_hash.
+HM_DECLARE(anim_def_index, uint64_t, int, hm_hash_u64, hm_eq_u64, MEM_TAG_ECS)
+static anim_def_index_t g_anim_def_index;
+
 static uint64_t fnv1a64_update(uint64_t h, const void* data, size_t len)
 {
     const uint8_t* p = (const uint8_t*)data;
@@ -111,23 +119,32 @@ static bool anim_def_equals(
     return true;
 }
 
+static bool anim_arena_ensure(void)
+{
+    return g_anim_arena.data || bump_init_tagged(&g_anim_arena, ANIM_ARENA_BYTES, MEM_TAG_ECS);
+}
+
 void ecs_anim_reset_allocator(void)
 {
-    if (!g_anim_arena.data) {
-        bump_init(&g_anim_arena, ANIM_ARENA_BYTES);
-    }
+    anim_arena_ensure();
     bump_reset(&g_anim_arena);
     // Any cached pointers into the arena are invalid after reset.
     g_anim_defs_count = 0;
+    anim_def_index_clear(&g_anim_def_index);
 }
 
 void ecs_anim_shutdown_allocator(void)
 {
+    if (g_anim_arena.data) {
+        LOGC(LOGCAT_ECS, LOG_LVL_DEBUG, "anim: arena high-water %zu of %zu bytes",
+             bump_high_water(&g_anim_arena), g_anim_arena.reserved);
+    }
     bump_free(&g_anim_arena);
-    free(g_anim_defs);
+    mem_free(MEM_TAG_ECS, g_anim_defs, g_anim_defs_cap * sizeof(*g_anim_defs));
     g_anim_defs = NULL;
     g_anim_defs_count = 0;
     g_anim_defs_cap = 0;
+    anim_def_index_free(&g_anim_def_index);
 }
 
 void cmp_add_anim(
@@ -140,11 +157,9 @@ void cmp_add_anim(
     int frame_buffer_width,
     float fps)
 {
-    if (!g_anim_arena.data) {
-        if (!bump_init(&g_anim_arena, ANIM_ARENA_BYTES)) {
-            LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "anim: failed to init arena");
-            return;
-        }
+    if (!anim_arena_ensure()) {
+        LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "anim: failed to init arena");
+        return;
     }
 
     int i = ent_index_checked(e);
@@ -170,9 +185,10 @@ void cmp_add_anim(
     uint32_t fps_bits = 0;
     memcpy(&fps_bits, &fps, sizeof(fps_bits));
     const uint64_t h = anim_def_hash(frame_w, frame_h, use_anims, fps_bits, frames_per_anim, frames, frame_buffer_width);
-    for (size_t di = 0; di < g_anim_defs_count; ++di) {
+    const int* newest = anim_def_index_get(&g_anim_def_index, h);
+    const int same_hash = newest ? *newest : -1;
+    for (int di = same_hash; di >= 0; di = g_anim_defs[di].next_same_hash) {
         const anim_def_entry_t* def = &g_anim_defs[di];
-        if (def->hash != h) continue;
         if (!anim_def_equals(def, frame_w, frame_h, use_anims, fps_bits, total_frames, frames_per_anim, frames, frame_buffer_width)) continue;
 
         a->frame_w         = frame_w;
@@ -189,15 +205,17 @@ void cmp_add_anim(
         return;
     }
 
+    const bump_marker_t mark = bump_save(&g_anim_arena);
     int* fp = bump_alloc_type(&g_anim_arena, int, (size_t)use_anims);
     int* offs = bump_alloc_type(&g_anim_arena, int, (size_t)use_anims);
     anim_frame_coord_t* flat = bump_alloc_type(&g_anim_arena, anim_frame_coord_t, (size_t)total_frames);
-    if (!fp || !offs || (total_frames > 0 && !flat)) {
-        LOGC(LOGCAT_ECS, LOG_LVL_ERROR,
-             "anim: arena out of space for %d anims (%d frames), capacity=%zu bytes",
+    if (!fp || !offs || !flat) {
+        bump_restore(&g_anim_arena, mark); // don't strand the parts that did fit
+        LOGC_LIMITED(LOGCAT_ECS, LOG_LVL_ERROR,
+             "anim: out of memory for %d anims (%d frames), arena=%zu bytes",
              use_anims,
              total_frames,
-             ANIM_ARENA_BYTES);
+             g_anim_arena.reserved);
         return;
     }
 
@@ -234,13 +252,17 @@ void cmp_add_anim(
     // Cache definition for future reuse (best-effort).
     if (g_anim_defs_count == g_anim_defs_cap) {
         size_t new_cap = g_anim_defs_cap ? (g_anim_defs_cap * 2) : 32;
-        anim_def_entry_t* tmp = (anim_def_entry_t*)realloc(g_anim_defs, new_cap * sizeof(*g_anim_defs));
+        anim_def_entry_t* tmp = (anim_def_entry_t*)mem_realloc(MEM_TAG_ECS, g_anim_defs,
+                                                               g_anim_defs_cap * sizeof(*g_anim_defs),
+                                                               new_cap * sizeof(*g_anim_defs));
         if (tmp) {
             g_anim_defs = tmp;
             g_anim_defs_cap = new_cap;
         }
     }
     if (g_anim_defs_count < g_anim_defs_cap) {
+        const int di = (int)g_anim_defs_count;
+        if (!anim_def_index_put(&g_anim_def_index, h, di)) return;
         g_anim_defs[g_anim_defs_count++] = (anim_def_entry_t){
             .hash = h,
             .frame_w = frame_w,
@@ -251,10 +273,55 @@ void cmp_add_anim(
             .frames_per_anim = fp,
             .anim_offsets = offs,
             .frames = flat,
+            .next_same_hash = same_hash,
         };
     }
 }
 
+uint32_t ecs_anim_arena_offset(const void* p)
+{
+    if (!p || !g_anim_arena.data) return 0;
+    const size_t off = bump_offset_of(&g_anim_arena, p);
+    return off == SIZE_MAX ? 0 : (uint32_t)off + 1u;
+}
+
+const void* ecs_anim_arena_ptr(uint32_t offset)
+{
+    if (offset == 0) return NULL;
+    return bump_ptr_at(&g_anim_arena, offset - 1u);
+}
+
+// Written in the arena's logical layout, so the offsets above stay valid however many chunks
+// the reader's arena ends up with.
+void ecs_anim_snapshot_write(snap_buf_t* b)
+{
+    snap_write_tag(b, SNAP_TAG('A','N','I','M'));
+    uint32_t used = (uint32_t)bump_used(&g_anim_arena);
+    SNAP_WRITE_VAL(b, used);
+    if (used > 0) bump_flatten(&g_anim_arena, snap_write_reserve(b, used));
+}
+
+bool ecs_anim_snapshot_read(snap_reader_t* r)
+{
+    uint32_t used = 0;
+    if (!snap_expect_tag(r, SNAP_TAG('A','N','I','M')) || !SNAP_READ_VAL(r, used)) return false;
+    if (!anim_arena_ensure()) return false;
+    if (used > r->size - r->pos) {
+        r->failed = true;
+        return false;
+    }
+    if (!bump_load(&g_anim_arena, r->data + r->pos, used)) {
+        r->failed = true;
+        return false;
+    }
+    r->pos += used;
+
+    // The dedupe cache may point at bytes the restore just replaced.
+    g_anim_defs_count = 0;
+    anim_def_index_clear(&g_anim_def_index);
+    return true;
+}
+
 static void sys_anim_controller_impl(void)
 {
     ecs_entity_t player = find_player_handle();
@@ -283,7 +350,7 @@ static void sys_anim_controller_impl(void)
     }
 
     if(new_anim >= MAX_ANIMS) {
-        LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "New animation: %i outside of max animation %i", new_anim, MAX_ANIMS);
+        LOGC_LIMITED(LOGCAT_ECS, LOG_LVL_ERROR, "New animation: %i outside of max animation %i", new_anim, MAX_ANIMS);
         return;
     }
     if (new_anim != a->current_anim) {
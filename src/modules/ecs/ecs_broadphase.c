@@ -0,0 +1,264 @@
+#define DA_MEM_TAG MEM_TAG_ECS
+#include "modules/ecs/ecs_broadphase.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Boxes are widened by this much so float rounding at touching edges can't drop a pair.
+#define BP_SKIN 0.01f
+#define BP_DEFAULT_CELL 32.0f
+
+static bool boxes_touch(const aabb_batch_t* b, int i, int j)
+{
+    return fabsf(b->cx[j] - b->cx[i]) <= (b->hx[i] + b->hx[j]) &&
+           fabsf(b->cy[j] - b->cy[i]) <= (b->hy[i] + b->hy[j]);
+}
+
+static void push_pair(ecs_broadphase_t* bp, int i, int j)
+{
+    ecs_bp_pair_t p = { i < j ? i : j, i < j ? j : i };
+    DA_APPEND(&bp->pairs, p);
+}
+
+static int cmp_pair(const void* pa, const void* pb)
+{
+    const ecs_bp_pair_t* a = (const ecs_bp_pair_t*)pa;
+    const ecs_bp_pair_t* b = (const ecs_bp_pair_t*)pb;
+    if (a->a != b->a) return (a->a < b->a) ? -1 : 1;
+    if (a->b != b->b) return (a->b < b->b) ? -1 : 1;
+    return 0;
+}
+
+// ---- all pairs ----
+static void all_pairs_update(ecs_broadphase_t* bp, const aabb_batch_t* boxes)
+{
+    for (int a = 0; a < boxes->count; ++a) {
+        for (int first = a + 1; first < boxes->count; first += AABB_BATCH_MAX) {
+            uint32_t hits = aabb_overlap_mask(boxes->cx[a], boxes->cy[a], boxes->hx[a], boxes->hy[a],
+                                              boxes, first, true);
+            while (hits) {
+                push_pair(bp, a, first + aabb_mask_pop(&hits));
+            }
+        }
+    }
+}
+
+// ---- sweep-and-prune ----
+static bool endpoint_less(const ecs_bp_endpoint_t* a, const ecs_bp_endpoint_t* b)
+{
+    if (a->value != b->value) return a->value < b->value;
+    // Mins sort before maxes so touching boxes are reported.
+    return !a->is_max && b->is_max;
+}
+
+static void sap_update(ecs_broadphase_t* bp, const aabb_batch_t* boxes, const int* ids)
+{
+    if (++bp->stamp == 0u) {
+        memset(bp->slot_stamp, 0, sizeof(bp->slot_stamp));
+        memset(bp->ep_stamp, 0, sizeof(bp->ep_stamp));
+        bp->stamp = 1u;
+    }
+    const uint32_t stamp = bp->stamp;
+
+    for (int i = 0; i < boxes->count; ++i) {
+        bp->slot_of[ids[i]] = i;
+        bp->slot_stamp[ids[i]] = stamp;
+    }
+
+    // Drop endpoints of ids that left the batch and refresh the rest in place.
+    size_t w = 0;
+    for (size_t k = 0; k < bp->endpoints.size; ++k) {
+        ecs_bp_endpoint_t ep = bp->endpoints.data[k];
+        if (bp->slot_stamp[ep.id] != stamp) continue;
+        const int s = bp->slot_of[ep.id];
+        ep.value = ep.is_max ? (boxes->cx[s] + boxes->hx[s] + BP_SKIN) : (boxes->cx[s] - boxes->hx[s] - BP_SKIN);
+        bp->ep_stamp[ep.id] = stamp;
+        bp->endpoints.data[w++] = ep;
+    }
+    bp->endpoints.size = w;
+
+    for (int i = 0; i < boxes->count; ++i) {
+        if (bp->ep_stamp[ids[i]] == stamp) continue;
+        ecs_bp_endpoint_t lo = { boxes->cx[i] - boxes->hx[i] - BP_SKIN, ids[i], false };
+        ecs_bp_endpoint_t hi = { boxes->cx[i] + boxes->hx[i] + BP_SKIN, ids[i], true };
+        DA_APPEND(&bp->endpoints, lo);
+        DA_APPEND(&bp->endpoints, hi);
+        bp->ep_stamp[ids[i]] = stamp;
+    }
+
+    // Insertion sort: near O(n) when little moved since the last update.
+    ecs_bp_endpoint_t* eps = bp->endpoints.data;
+    for (size_t k = 1; k < bp->endpoints.size; ++k) {
+        ecs_bp_endpoint_t key = eps[k];
+        size_t j = k;
+        while (j > 0 && endpoint_less(&key, &eps[j - 1])) {
+            eps[j] = eps[j - 1];
+            --j;
+        }
+        eps[j] = key;
+    }
+
+    DA_CLEAR(&bp->active);
+    for (size_t k = 0; k < bp->endpoints.size; ++k) {
+        const int s = bp->slot_of[eps[k].id];
+        if (!eps[k].is_max) {
+            for (size_t a = 0; a < bp->active.size; ++a) {
+                const int o = bp->active.data[a];
+                if (boxes_touch(boxes, s, o)) push_pair(bp, s, o);
+            }
+            DA_APPEND(&bp->active, s);
+        } else {
+            for (size_t a = 0; a < bp->active.size; ++a) {
+                if (bp->active.data[a] != s) continue;
+                bp->active.data[a] = bp->active.data[bp->active.size - 1];
+                bp->active.size--;
+                break;
+            }
+        }
+    }
+}
+
+// ---- uniform grid ----
+typedef struct {
+    float min_x, min_y;
+    float cell;
+    int   w, h;
+} grid_dims_t;
+
+static int grid_cell_x(const grid_dims_t* g, float x)
+{
+    int c = (int)((x - g->min_x) / g->cell);
+    return c < 0 ? 0 : (c >= g->w ? g->w - 1 : c);
+}
+
+static int grid_cell_y(const grid_dims_t* g, float y)
+{
+    int c = (int)((y - g->min_y) / g->cell);
+    return c < 0 ? 0 : (c >= g->h ? g->h - 1 : c);
+}
+
+static void grid_update(ecs_broadphase_t* bp, const aabb_batch_t* boxes)
+{
+    const int n = boxes->count;
+    float min_x = boxes->cx[0] - boxes->hx[0], max_x = boxes->cx[0] + boxes->hx[0];
+    float min_y = boxes->cy[0] - boxes->hy[0], max_y = boxes->cy[0] + boxes->hy[0];
+    for (int i = 1; i < n; ++i) {
+        min_x = fminf(min_x, boxes->cx[i] - boxes->hx[i]);
+        max_x = fmaxf(max_x, boxes->cx[i] + boxes->hx[i]);
+        min_y = fminf(min_y, boxes->cy[i] - boxes->hy[i]);
+        max_y = fmaxf(max_y, boxes->cy[i] + boxes->hy[i]);
+    }
+
+    grid_dims_t g = { min_x - BP_SKIN, min_y - BP_SKIN, (bp->cell_size > 0.0f) ? bp->cell_size : BP_DEFAULT_CELL, 1, 1 };
+    // Keep the cell count proportional to the body count on sparse or huge layouts.
+    const long max_cells = 4L * n + 64L;
+    for (;;) {
+        g.w = (int)((max_x - min_x + 2.0f * BP_SKIN) / g.cell) + 1;
+        g.h = (int)((max_y - min_y + 2.0f * BP_SKIN) / g.cell) + 1;
+        if ((long)g.w * (long)g.h <= max_cells) break;
+        g.cell *= 2.0f;
+    }
+    const int cells = g.w * g.h;
+
+    DA_RESERVE(&bp->cell_start, (size_t)cells + 1);
+    memset(bp->cell_start.data, 0, sizeof(int) * ((size_t)cells + 1));
+    bp->cell_start.size = (size_t)cells + 1;
+    int* start = bp->cell_start.data;
+
+    for (int i = 0; i < n; ++i) {
+        const int x0 = grid_cell_x(&g, boxes->cx[i] - boxes->hx[i] - BP_SKIN);
+        const int x1 = grid_cell_x(&g, boxes->cx[i] + boxes->hx[i] + BP_SKIN);
+        const int y0 = grid_cell_y(&g, boxes->cy[i] - boxes->hy[i] - BP_SKIN);
+        const int y1 = grid_cell_y(&g, boxes->cy[i] + boxes->hy[i] + BP_SKIN);
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) start[y * g.w + x + 1]++;
+        }
+    }
+    for (int c = 0; c < cells; ++c) start[c + 1] += start[c];
+
+    DA_RESERVE(&bp->cell_items, (size_t)start[cells]);
+    bp->cell_items.size = (size_t)start[cells];
+    int* items = bp->cell_items.data;
+    // Fill from the back of each bucket so buckets end up in slot order.
+    for (int i = n - 1; i >= 0; --i) {
+        const int x0 = grid_cell_x(&g, boxes->cx[i] - boxes->hx[i] - BP_SKIN);
+        const int x1 = grid_cell_x(&g, boxes->cx[i] + boxes->hx[i] + BP_SKIN);
+        const int y0 = grid_cell_y(&g, boxes->cy[i] - boxes->hy[i] - BP_SKIN);
+        const int y1 = grid_cell_y(&g, boxes->cy[i] + boxes->hy[i] + BP_SKIN);
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) items[--start[y * g.w + x + 1]] = i;
+        }
+    }
+    // start[c + 1] now holds the beginning of bucket c; shift back to start[c].
+    for (int c = 0; c < cells; ++c) start[c] = start[c + 1];
+    start[cells] = (int)bp->cell_items.size;
+
+    for (int c = 0; c < cells; ++c) {
+        const int cx = c % g.w;
+        const int cy = c / g.w;
+        for (int p = start[c]; p < start[c + 1]; ++p) {
+            const int i = items[p];
+            for (int q = p + 1; q < start[c + 1]; ++q) {
+                const int j = items[q];
+                if (!boxes_touch(boxes, i, j)) continue;
+                // Pairs sharing several cells are emitted once, by the cell holding their overlap's min corner.
+                const float ox = fmaxf(boxes->cx[i] - boxes->hx[i], boxes->cx[j] - boxes->hx[j]) - BP_SKIN;
+                const float oy = fmaxf(boxes->cy[i] - boxes->hy[i], boxes->cy[j] - boxes->hy[j]) - BP_SKIN;
+                if (grid_cell_x(&g, ox) != cx || grid_cell_y(&g, oy) != cy) continue;
+                push_pair(bp, i, j);
+            }
+        }
+    }
+}
+
+void ecs_broadphase_update(ecs_broadphase_t* bp, const aabb_batch_t* boxes, const int* ids)
+{
+    if (!bp) return;
+    DA_CLEAR(&bp->pairs);
+    if (!boxes || boxes->count < 2) {
+        // Still let SAP forget departed ids.
+        if (bp->kind == ECS_BROADPHASE_SAP && boxes && ids) sap_update(bp, boxes, ids);
+        return;
+    }
+
+    switch (bp->kind) {
+        case ECS_BROADPHASE_GRID:
+            grid_update(bp, boxes);
+            break;
+        case ECS_BROADPHASE_SAP:
+            if (!ids) return;
+            sap_update(bp, boxes, ids);
+            break;
+        case ECS_BROADPHASE_ALL_PAIRS:
+        default:
+            all_pairs_update(bp, boxes);
+            return; // already in (a, b) order
+    }
+
+    if (bp->pairs.size > 1) {
+        qsort(bp->pairs.data, bp->pairs.size, sizeof(bp->pairs.data[0]), cmp_pair);
+    }
+}
+
+void ecs_broadphase_free(ecs_broadphase_t* bp)
+{
+    if (!bp) return;
+    DA_FREE(&bp->pairs);
+    DA_FREE(&bp->endpoints);
+    DA_FREE(&bp->active);
+    DA_FREE(&bp->cell_start);
+    DA_FREE(&bp->cell_items);
+    bp->stamp = 0u;
+    memset(bp->slot_stamp, 0, sizeof(bp->slot_stamp));
+    memset(bp->ep_stamp, 0, sizeof(bp->ep_stamp));
+}
+
+const char* ecs_broadphase_kind_name(ecs_broadphase_kind_t kind)
+{
+    switch (kind) {
+        case ECS_BROADPHASE_ALL_PAIRS: return "all-pairs";
+        case ECS_BROADPHASE_GRID:      return "grid";
+        case ECS_BROADPHASE_SAP:       return "sap";
+        default:                       return "?";
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "modules/ecs/ecs.h"
+#include "modules/ecs/ecs_aabb.h"
+#include "modules/common/dynarray.h"
+
+typedef enum {
+    ECS_BROADPHASE_ALL_PAIRS = 0, // batched all-pairs sweep (default)
+    ECS_BROADPHASE_GRID,          // uniform grid, rebuilt every update
+    ECS_BROADPHASE_SAP,           // sweep-and-prune over persistent sorted X endpoints
+    ECS_BROADPHASE_COUNT
+} ecs_broadphase_kind_t;
+
+// Candidate pair of batch slots (a < b) whose boxes overlap or touch.
+typedef struct { int a, b; } ecs_bp_pair_t;
+
+typedef struct {
+    float value;
+    int   id;
+    bool  is_max;
+} ecs_bp_endpoint_t;
+
+typedef struct {
+    ecs_broadphase_kind_t kind;
+    DA(ecs_bp_pair_t) pairs;       // sorted by (a, b) after each update
+
+    // Sweep-and-prune: endpoints keep their order between updates so insertion sort stays cheap.
+    DA(ecs_bp_endpoint_t) endpoints;
+    DA(int) active;
+    int      slot_of[ECS_MAX_ENTITIES];
+    uint32_t slot_stamp[ECS_MAX_ENTITIES]; // == stamp when the id is in the current batch
+    uint32_t ep_stamp[ECS_MAX_ENTITIES];   // == stamp once the id's endpoints were refreshed
+    uint32_t stamp;
+
+    // Grid scratch.
+    DA(int) cell_start;
+    DA(int) cell_items;
+    float cell_size;               // 0 = default
+} ecs_broadphase_t;
+
+// Rebuild bp->pairs for the batch. ids[i] is the stable id (entity index) of slot i.
+void ecs_broadphase_update(ecs_broadphase_t* bp, const aabb_batch_t* boxes, const int* ids);
+void ecs_broadphase_free(ecs_broadphase_t* bp);
+
+const char* ecs_broadphase_kind_name(ecs_broadphase_kind_t kind);
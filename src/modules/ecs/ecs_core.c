@@ -1,5 +1,6 @@
 #include "modules/ecs/ecs_internal.h"
 #include "modules/core/logger.h"
+#include "modules/core/metrics.h"
 #include <math.h>
 #include <string.h>
 
@@ -8,6 +9,7 @@ uint32_t        ecs_mask[ECS_MAX_ENTITIES];
 uint32_t        ecs_gen[ECS_MAX_ENTITIES];
 uint32_t        ecs_next_gen[ECS_MAX_ENTITIES];
 cmp_position_t  cmp_pos[ECS_MAX_ENTITIES];
+cmp_position_t  cmp_pos_prev[ECS_MAX_ENTITIES];
 cmp_velocity_t  cmp_vel[ECS_MAX_ENTITIES];
 cmp_follow_t    cmp_follow[ECS_MAX_ENTITIES];
 cmp_anim_t      cmp_anim[ECS_MAX_ENTITIES];
@@ -23,6 +25,7 @@ cmp_door_t      cmp_door[ECS_MAX_ENTITIES];
 static int free_stack[ECS_MAX_ENTITIES];
 static int free_top = 0;
 static uint8_t ecs_destroy_state[ECS_MAX_ENTITIES];
+static metric_t* g_m_created;
 
 enum {
     ECS_DESTROY_NONE = 0,
@@ -55,6 +58,8 @@ float clampf(float v, float a, float b){
 
 static void set_position_sync_body(int i, float x, float y){
     cmp_pos[i] = (cmp_position_t){ x, y };
+    // Placement is a teleport: don't interpolate from wherever the slot was before.
+    cmp_pos_prev[i] = cmp_pos[i];
 }
 
 ecs_entity_t find_player_handle(void){
@@ -99,26 +104,48 @@ static void try_create_phys_body(int i){
     }
 }
 
-// forward
-// =============== Public: lifecycle ========
-void ecs_init(void){
+static void ecs_reset_slots(void)
+{
     memset(ecs_mask, 0, sizeof(ecs_mask));
     memset(ecs_gen,  0, sizeof(ecs_gen));
     memset(ecs_next_gen, 0, sizeof(ecs_next_gen));
     memset(ecs_destroy_state, 0, sizeof(ecs_destroy_state));
     free_top = 0;
-    ecs_init_destroy_table();
-    ecs_anim_reset_allocator();
     for (int i = ECS_MAX_ENTITIES - 1; i >= 0; --i) {
         free_stack[free_top++] = i;
     }
+}
 
+// forward
+// =============== Public: lifecycle ========
+void ecs_init(void){
+    ecs_reset_slots();
+    ecs_init_destroy_table();
+    ecs_anim_reset_allocator();
+    g_m_created = metrics_counter("ecs_entities_created_total", "Entities created", NULL);
 }
 
 void ecs_shutdown(void){
     ecs_anim_shutdown_allocator();
 }
 
+void ecs_core_snapshot_write(snap_buf_t* b){
+    snap_write_tag(b, SNAP_TAG('E','C','O','R'));
+    SNAP_WRITE_VAL(b, free_top);
+    snap_write(b, free_stack, (size_t)free_top * sizeof(free_stack[0]));
+    SNAP_WRITE_VAL(b, ecs_destroy_state);
+}
+
+bool ecs_core_snapshot_read(snap_reader_t* r){
+    int top = 0;
+    if (!snap_expect_tag(r, SNAP_TAG('E','C','O','R')) || !SNAP_READ_VAL(r, top)) return false;
+    if (top < 0 || top > ECS_MAX_ENTITIES) return false;
+    free_top = top;
+    snap_read(r, free_stack, (size_t)top * sizeof(free_stack[0]));
+    SNAP_READ_VAL(r, ecs_destroy_state);
+    return !r->failed;
+}
+
 bool ecs_get_player_position(float* out_x, float* out_y){
     ecs_entity_t player = find_player_handle();
     int idx = ent_index_checked(player);
@@ -142,6 +169,10 @@ ecs_entity_t ecs_find_player(void){
     return find_player_handle();
 }
 
+void ecs_store_prev_positions(void){
+    memcpy(cmp_pos_prev, cmp_pos, sizeof(cmp_pos_prev));
+}
+
 static void ecs_cleanup_entity(int idx)
 {
     uint32_t mask = ecs_mask[idx];
@@ -175,9 +206,15 @@ ecs_entity_t ecs_create(void)
     if (g == 0) g = 1;
     ecs_gen[idx] = g;
     ecs_mask[idx] = 0;
+    metrics_add(g_m_created, 1);
     return (ecs_entity_t){ (uint32_t)idx, g };
 }
 
+int ecs_live_count(void)
+{
+    return ECS_MAX_ENTITIES - free_top;
+}
+
 void ecs_destroy(ecs_entity_t e)
 {
     int idx = ent_index_checked(e);
@@ -224,6 +261,19 @@ void ecs_destroy_marked(void)
     }
 }
 
+void ecs_destroy_all(void)
+{
+    for (int i = ECS_MAX_ENTITIES - 1; i >= 0; --i) {
+        if (!ecs_alive_idx(i)) continue;
+        ecs_cleanup_entity(i);
+    }
+    // Generations and the free list start over as after ecs_init, so the next map spawns into
+    // the same slots and handles whatever was played before; save games checksum that state.
+    ecs_reset_slots();
+    ecs_anim_reset_allocator(); // nothing references the anim frames any more
+    ecs_proximity_reset();      // views name handles that could now be reissued
+}
+
 // =============== Public: adders ===========
 void cmp_add_position(ecs_entity_t e, float x, float y)
 {
@@ -2,12 +2,15 @@
 
 #include "modules/ecs/ecs_internal.h"
 #include "modules/ecs/ecs_proximity.h"
+#include "modules/core/frame_alloc.h"
 #include "modules/core/input.h"
 #include "modules/systems/systems.h"
 #include "modules/systems/systems_registration.h"
 #include "modules/world/world.h"
 #include "modules/world/world_door.h"
 
+#include <string.h>
+
 static void sys_doors_tick(float dt);
 
 SYSTEMS_ADAPT_DT(sys_doors_tick_adapt, sys_doors_tick)
@@ -17,7 +20,9 @@ static void sys_doors_tick(float dt)
     if (!world_has_map()) return;
 
     // Build intent from proximity stay/enter
-    bool door_should_open[ECS_MAX_ENTITIES] = {0};
+    bool* door_should_open = frame_alloc_array(FRAME_ARENA_TICK, bool, ECS_MAX_ENTITIES);
+    if (!door_should_open) return;
+    memset(door_should_open, 0, ECS_MAX_ENTITIES * sizeof(*door_should_open));
     ecs_prox_iter_t stay_it = ecs_prox_stay_begin();
     ecs_prox_view_t v;
     while (ecs_prox_stay_next(&stay_it, &v)) {
@@ -11,8 +11,10 @@
 #include "modules/ecs/ecs_prefab_loading.h"
 #include "modules/world/world.h"
 #include "modules/world/world_renderer.h"
+#include "modules/world/world_stream.h"
 #include "modules/ecs/ecs_door_systems.h"
 #include <stdio.h>
+#include <string.h>
 
 bool init_entities(const char* tmx_path)
 {
@@ -22,7 +24,11 @@ bool init_entities(const char* tmx_path)
         return false;
     }
 
-    ecs_prefab_spawn_from_map(map, tmx_path);
+    if (world_stream_active()) {
+        ecs_prefab_stream_begin(map, tmx_path);
+    } else {
+        ecs_prefab_spawn_from_map(map, tmx_path);
+    }
     return true;
 }
 
@@ -53,6 +59,27 @@ void cmp_add_storage(ecs_entity_t e, int capacity)
     }
 }
 
+void ecs_game_snapshot_write(snap_buf_t* b)
+{
+    snap_write_tag(b, SNAP_TAG('G','A','M','E'));
+    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
+        if (!ecs_alive_idx(i) || !(ecs_mask[i] & CMP_STORAGE)) continue;
+        snap_write(b, &g_storage[i], sizeof(g_storage[i]));
+    }
+}
+
+// Runs after the ECS masks are restored, so it visits the same slots the writer did.
+bool ecs_game_snapshot_read(snap_reader_t* r)
+{
+    if (!snap_expect_tag(r, SNAP_TAG('G','A','M','E'))) return false;
+    memset(g_storage, 0, sizeof(g_storage));
+    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
+        if (!ecs_alive_idx(i) || !(ecs_mask[i] & CMP_STORAGE)) continue;
+        if (!snap_read(r, &g_storage[i], sizeof(g_storage[i]))) return false;
+    }
+    return true;
+}
+
 // ===== Gameplay helpers =====
 bool game_get_tardas_storage(int* out_plastic, int* out_capacity)
 {
@@ -1,4 +1,5 @@
 #include "modules/ecs/ecs_internal.h"
+#include "modules/ecs/ecs_aabb.h"
 #include "modules/core/input.h"
 #include "modules/systems/systems_registration.h"
 #include "modules/core/effects.h"
@@ -26,31 +27,21 @@ static int find_held_index(ecs_entity_t holder)
     return -1;
 }
 
-static bool grav_gun_hit_test(int idx, float mx, float my, float pad)
-{
-    if ((ecs_mask[idx] & CMP_POS) == 0) return false;
-    const float cx = cmp_pos[idx].x;
-    const float cy = cmp_pos[idx].y;
-
-    if (ecs_mask[idx] & CMP_COL) {
-        float hx = cmp_col[idx].hx + pad;
-        float hy = cmp_col[idx].hy + pad;
-        return (mx >= cx - hx && mx <= cx + hx && my >= cy - hy && my <= cy + hy);
-    }
-
-    const float dx = mx - cx;
-    const float dy = my - cy;
-    return (dx * dx + dy * dy) <= (pad * pad);
-}
+// Packed grab candidates (index order); collider lanes are padded by the pickup radius.
+static int   g_grab_idx[ECS_MAX_ENTITIES];
+static bool  g_grab_has_col[ECS_MAX_ENTITIES];
+static float g_grab_pad[ECS_MAX_ENTITIES];
+static float g_grab_cx[ECS_MAX_ENTITIES];
+static float g_grab_cy[ECS_MAX_ENTITIES];
+static float g_grab_hx[ECS_MAX_ENTITIES];
+static float g_grab_hy[ECS_MAX_ENTITIES];
 
 static int find_grab_candidate(int player_idx, v2f mouse_world)
 {
     const float px = cmp_pos[player_idx].x;
     const float py = cmp_pos[player_idx].y;
 
-    float best_d2 = FLT_MAX;
-    int best_idx = -1;
-
+    int n = 0;
     for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
         if (i == player_idx) continue;
         if (!ecs_alive_idx(i)) continue;
@@ -67,14 +58,40 @@ static int find_grab_candidate(int player_idx, v2f mouse_world)
         if ((dxp * dxp + dyp * dyp) > (pickup_dist * pickup_dist)) continue;
 
         const float pad = (g->pickup_radius > 0.0f) ? g->pickup_radius : 8.0f;
-        if (!grav_gun_hit_test(i, mouse_world.x, mouse_world.y, pad)) continue;
-
-        const float dxm = cmp_pos[i].x - mouse_world.x;
-        const float dym = cmp_pos[i].y - mouse_world.y;
-        const float d2 = dxm * dxm + dym * dym;
-        if (d2 < best_d2) {
-            best_d2 = d2;
-            best_idx = i;
+        const bool has_col = (ecs_mask[i] & CMP_COL) != 0;
+        g_grab_idx[n] = i;
+        g_grab_has_col[n] = has_col;
+        g_grab_pad[n] = pad;
+        g_grab_cx[n] = cmp_pos[i].x;
+        g_grab_cy[n] = cmp_pos[i].y;
+        g_grab_hx[n] = has_col ? cmp_col[i].hx + pad : 0.0f;
+        g_grab_hy[n] = has_col ? cmp_col[i].hy + pad : 0.0f;
+        ++n;
+    }
+
+    const aabb_batch_t batch = { g_grab_cx, g_grab_cy, g_grab_hx, g_grab_hy, n };
+    float best_d2 = FLT_MAX;
+    int best_idx = -1;
+
+    for (int first = 0; first < n; first += AABB_BATCH_MAX) {
+        // Mouse is a zero-extent box; collider hits come from the mask.
+        const uint32_t hits = aabb_overlap_mask(mouse_world.x, mouse_world.y, 0.0f, 0.0f, &batch, first, true);
+        const int lanes = (n - first < AABB_BATCH_MAX) ? (n - first) : AABB_BATCH_MAX;
+        for (int lane = 0; lane < lanes; ++lane) {
+            const int k = first + lane;
+            const float dxm = g_grab_cx[k] - mouse_world.x;
+            const float dym = g_grab_cy[k] - mouse_world.y;
+            const float d2 = dxm * dxm + dym * dym;
+
+            // Entities without a collider fall back to a circle of radius pad.
+            const bool hit = g_grab_has_col[k] ? ((hits >> lane) & 1u) != 0u
+                                               : d2 <= (g_grab_pad[k] * g_grab_pad[k]);
+            if (!hit) continue;
+
+            if (d2 < best_d2) {
+                best_d2 = d2;
+                best_idx = g_grab_idx[k];
+            }
         }
     }
 
@@ -114,6 +131,9 @@ static void begin_hold(int idx, ecs_entity_t holder, v2f mouse_world)
     g->grab_offset_y = cmp_pos[idx].y - mouse_world.y;
     g->hold_vel_x = 0.0f;
     g->hold_vel_y = 0.0f;
+    if (ecs_mask[idx] & CMP_PHYS_BODY) {
+        phys_body_wake(&cmp_phys_body[idx]);
+    }
 
     if ((ecs_mask[idx] & CMP_VEL) == 0) {
         cmp_add_velocity(handle_from_index(idx), 0.0f, 0.0f, DIR_SOUTH);
@@ -4,6 +4,7 @@
 #include "modules/ecs/ecs.h"
 #include "modules/ecs/ecs_physics_types.h"
 #include "modules/common/resource_handles.h"
+#include "modules/common/snapshot_io.h"
 
 // ===== Internal component storage types =====
 typedef struct { float x, y; } cmp_position_t;
@@ -93,6 +94,7 @@ extern uint32_t        ecs_mask[ECS_MAX_ENTITIES];
 extern uint32_t        ecs_gen[ECS_MAX_ENTITIES];
 extern uint32_t        ecs_next_gen[ECS_MAX_ENTITIES];
 extern cmp_position_t  cmp_pos[ECS_MAX_ENTITIES];
+extern cmp_position_t  cmp_pos_prev[ECS_MAX_ENTITIES]; // cmp_pos at the start of the last tick
 extern cmp_velocity_t  cmp_vel[ECS_MAX_ENTITIES];
 extern cmp_follow_t    cmp_follow[ECS_MAX_ENTITIES];
 extern cmp_anim_t      cmp_anim[ECS_MAX_ENTITIES];
@@ -128,3 +130,19 @@ void ecs_register_phys_body_create_hook(ecs_component_hook_fn fn);
 void ecs_register_render_component_hooks(void);
 void ecs_register_physics_component_hooks(void);
 void ecs_register_door_component_hooks(void);
+
+// Snapshot sections (driven by modules/core/snapshot.c). ecs_snapshot_* covers the component
+// arrays and calls the per-module helpers below for state kept private to those files.
+void ecs_snapshot_write(snap_buf_t* b);
+bool ecs_snapshot_read(snap_reader_t* r);
+void ecs_core_snapshot_write(snap_buf_t* b);      // free list + deferred-destroy states
+bool ecs_core_snapshot_read(snap_reader_t* r);
+void ecs_anim_snapshot_write(snap_buf_t* b);      // used part of the animation arena
+bool ecs_anim_snapshot_read(snap_reader_t* r);
+uint32_t    ecs_anim_arena_offset(const void* p); // 0 for NULL, else byte offset + 1
+const void* ecs_anim_arena_ptr(uint32_t offset);
+void ecs_game_snapshot_write(snap_buf_t* b);      // storage component
+bool ecs_game_snapshot_read(snap_reader_t* r);
+void ecs_proximity_snapshot_write(snap_buf_t* b); // current/previous proximity views
+bool ecs_proximity_snapshot_read(snap_reader_t* r);
+void ecs_proximity_reset(void);                   // drops both view lists (ecs_destroy_all)
@@ -6,6 +6,38 @@
 #include <stdio.h>
 #include <string.h>
 
+static float g_render_alpha = 1.0f;
+
+void ecs_set_render_alpha(float alpha)
+{
+    g_render_alpha = clampf(alpha, 0.0f, 1.0f);
+}
+
+float ecs_render_alpha(void)
+{
+    return g_render_alpha;
+}
+
+static cmp_position_t render_pos(int i)
+{
+    const float a = g_render_alpha;
+    return (cmp_position_t){
+        cmp_pos_prev[i].x * (1.0f - a) + cmp_pos[i].x * a,
+        cmp_pos_prev[i].y * (1.0f - a) + cmp_pos[i].y * a,
+    };
+}
+
+bool ecs_get_render_position(ecs_entity_t e, v2f* out_pos)
+{
+    int idx = ent_index_checked(e);
+    if (idx < 0 || !(ecs_mask[idx] & CMP_POS)) return false;
+    if (out_pos) {
+        const cmp_position_t p = render_pos(idx);
+        *out_pos = v2f_make(p.x, p.y);
+    }
+    return true;
+}
+
 // --- SPRITES ---
 ecs_sprite_iter_t ecs_sprites_begin(void) { return (ecs_sprite_iter_t){ .i = -1 }; }
 
@@ -16,12 +48,13 @@ bool ecs_sprites_next(ecs_sprite_iter_t* it, ecs_sprite_view_t* out)
         if ((ecs_mask[i] & (CMP_POS | CMP_SPR)) != (CMP_POS | CMP_SPR)) continue;
 
         it->i = i;
+        const cmp_position_t p = render_pos(i);
 
         *out = (ecs_sprite_view_t){
             .tex = cmp_spr[i].tex,
             .src = cmp_spr[i].src,
-            .x   = cmp_pos[i].x,
-            .y   = cmp_pos[i].y,
+            .x   = p.x,
+            .y   = p.y,
             .ox  = cmp_spr[i].ox,
             .oy  = cmp_spr[i].oy,
             .highlighted = cmp_spr[i].fx.highlighted,
@@ -44,10 +77,12 @@ bool ecs_colliders_next(ecs_collider_iter_t* it, ecs_collider_view_t* out)
 
         it->i = i;
         bool has_phys = ((ecs_mask[i] & CMP_PHYS_BODY) && cmp_phys_body[i].created);
-        float ecs_x = cmp_pos[i].x;
-        float ecs_y = cmp_pos[i].y;
-        float phys_x = ecs_x;
-        float phys_y = ecs_y;
+        // ECS box follows the drawn (interpolated) sprite; the physics box is the last tick's result.
+        const cmp_position_t p = render_pos(i);
+        float ecs_x = p.x;
+        float ecs_y = p.y;
+        float phys_x = cmp_pos[i].x;
+        float phys_y = cmp_pos[i].y;
         *out = (ecs_collider_view_t){
             .ecs_x = ecs_x,
             .ecs_y = ecs_y,
@@ -110,9 +145,10 @@ bool ecs_billboards_next(ecs_billboard_iter_t* it, ecs_billboard_view_t* out)
             a = clampf(cmp_billboard[i].timer / cmp_billboard[i].linger, 0.0f, 1.0f);
         }
 
+        const cmp_position_t p = render_pos(i);
         *out = (ecs_billboard_view_t){
-            .x        = cmp_pos[i].x,
-            .y        = cmp_pos[i].y,
+            .x        = p.x,
+            .y        = p.y,
             .y_offset = cmp_billboard[i].y_offset,
             .alpha    = a,
             .text     = cmp_billboard[i].text
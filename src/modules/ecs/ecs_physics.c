@@ -14,6 +14,9 @@ void ecs_phys_body_create_for_entity(int idx)
     if (pb->created) return;
 
     pb->created = true;
+    pb->rest_x = cmp_pos[idx].x;
+    pb->rest_y = cmp_pos[idx].y;
+    phys_body_wake(pb);
 }
 
 void ecs_phys_body_destroy_for_entity(int idx)
@@ -1,7 +1,31 @@
 #pragma once
 #include "modules/ecs/ecs_physics_types.h"
+#include "modules/ecs/ecs_broadphase.h"
 
 // Internal helpers (component indices)
 void ecs_phys_body_create_for_entity(int idx);
 void ecs_phys_body_destroy_for_entity(int idx);
 void ecs_phys_destroy_all(void);
+// world_tile_edit_fn: wakes sleeping bodies overlapping tile (tx,ty) so the next tick pushes
+// them out of whatever the edit made solid.
+void ecs_phys_wake_bodies_on_tile(void* user, int tx, int ty);
+
+// Broadphase used by the physics pair solver (runtime selectable).
+void ecs_physics_set_broadphase(ecs_broadphase_kind_t kind);
+ecs_broadphase_kind_t ecs_physics_broadphase(void);
+
+// Positional solver: runs up to the configured number of iterations per tick and stops early
+// once the largest correction in an iteration is below a small epsilon.
+#define PHYS_SOLVER_DEFAULT_ITERATIONS 4
+#define PHYS_SOLVER_MAX_ITERATIONS 16
+
+typedef struct {
+    int   iterations;     // iterations run last tick
+    int   contacts;       // pairs resolved in iteration 0 (the only pairs later iterations revisit)
+    int   pair_resolves;  // pair corrections across all iterations
+    float max_correction; // largest correction in the final iteration (px)
+} ecs_phys_solver_stats_t;
+
+void ecs_physics_set_solver_iterations(int max_iterations); // clamped to [1, PHYS_SOLVER_MAX_ITERATIONS]
+int ecs_physics_solver_iterations(void);
+ecs_phys_solver_stats_t ecs_physics_solver_stats(void);
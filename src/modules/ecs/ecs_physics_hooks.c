@@ -1,8 +1,10 @@
 #include "modules/ecs/ecs_internal.h"
 #include "modules/ecs/ecs_physics.h"
+#include "modules/world/world_map.h"
 
 void ecs_register_physics_component_hooks(void)
 {
     ecs_register_component_destroy_hook(ENUM_PHYS_BODY, ecs_phys_body_destroy_for_entity);
     ecs_register_phys_body_create_hook(ecs_phys_body_create_for_entity);
+    world_set_tile_edit_listener(ecs_phys_wake_bodies_on_tile, NULL);
 }
@@ -1,26 +1,222 @@
+#define DA_MEM_TAG MEM_TAG_ECS
 #include "modules/ecs/ecs_internal.h"
 #include "modules/ecs/ecs_physics.h"
+#include "modules/ecs/ecs_aabb.h"
+#include "modules/ecs/ecs_broadphase.h"
+#include "modules/core/frame_alloc.h"
 #include "modules/world/world.h"
 #include "modules/systems/systems_registration.h"
 #include <math.h>
+#include <string.h>
 
-static void resolve_tile_penetration(int i)
+// Solver stops early once no correction in an iteration exceeds this (px).
+#define PHYS_SOLVER_EPSILON 0.01f
+
+static int g_phys_max_iterations = PHYS_SOLVER_DEFAULT_ITERATIONS;
+static ecs_phys_solver_stats_t g_phys_stats;
+static float g_phys_iter_correction;
+
+// Returns the correction applied (px).
+static float resolve_tile_penetration(int i)
 {
     const uint32_t req = (CMP_POS | CMP_COL | CMP_PHYS_BODY);
-    if ((ecs_mask[i] & req) != req) return;
-    if (!cmp_phys_body[i].created) return;
+    if ((ecs_mask[i] & req) != req) return 0.0f;
+    if (!cmp_phys_body[i].created) return 0.0f;
+    if (cmp_phys_body[i].sleeping) return 0.0f;
 
     float hx = cmp_col[i].hx;
     float hy = cmp_col[i].hy;
-    if (hx <= 0.0f || hy <= 0.0f) return;
+    if (hx <= 0.0f || hy <= 0.0f) return 0.0f;
 
     float cx = cmp_pos[i].x;
     float cy = cmp_pos[i].y;
     // Resolve after entity/entity overlap so tile response doesn't push sideways.
     if (world_resolve_rect_mtv_px(&cx, &cy, hx, hy)) {
+        const float moved = fmaxf(fabsf(cx - cmp_pos[i].x), fabsf(cy - cmp_pos[i].y));
         cmp_pos[i].x = cx;
         cmp_pos[i].y = cy;
+        return moved;
+    }
+    return 0.0f;
+}
+
+void ecs_phys_wake_bodies_on_tile(void* user, int tx, int ty)
+{
+    (void)user;
+    const float ts = (float)world_tile_size();
+    const float x0 = (float)tx * ts, y0 = (float)ty * ts;
+    const uint32_t req = (CMP_POS | CMP_COL | CMP_PHYS_BODY);
+    for (int e = 0; e < ECS_MAX_ENTITIES; ++e) {
+        if (!ecs_alive_idx(e) || (ecs_mask[e] & req) != req) continue;
+        cmp_phys_body_t* pb = &cmp_phys_body[e];
+        if (!pb->created || !pb->sleeping) continue;
+        const float cx = cmp_pos[e].x, cy = cmp_pos[e].y;
+        if (cx + cmp_col[e].hx <= x0 || cx - cmp_col[e].hx >= x0 + ts) continue;
+        if (cy + cmp_col[e].hy <= y0 || cy - cmp_col[e].hy >= y0 + ts) continue;
+        phys_body_wake(pb);
+    }
+}
+
+// Packed physics bodies (index order) for the batched pair test, rebuilt each solver iteration.
+static int   g_phys_idx[ECS_MAX_ENTITIES];
+static float g_phys_cx[ECS_MAX_ENTITIES];
+static float g_phys_cy[ECS_MAX_ENTITIES];
+static float g_phys_hx[ECS_MAX_ENTITIES];
+static float g_phys_hy[ECS_MAX_ENTITIES];
+static uint32_t g_phys_awake_bits[(ECS_MAX_ENTITIES + AABB_BATCH_MAX - 1) / AABB_BATCH_MAX];
+
+static bool phys_slot_awake(int k)
+{
+    return ((g_phys_awake_bits[k / AABB_BATCH_MAX] >> (k % AABB_BATCH_MAX)) & 1u) != 0u;
+}
+
+static void phys_slot_wake(int k)
+{
+    g_phys_awake_bits[k / AABB_BATCH_MAX] |= 1u << (k % AABB_BATCH_MAX);
+    phys_body_wake(&cmp_phys_body[g_phys_idx[k]]);
+}
+
+// Awake lanes of the chunk at `first` up to and including slot ka (already handled by their own row).
+static uint32_t phys_done_lanes(int ka, int first)
+{
+    const int last = ka - first;
+    if (last < 0) return 0u;
+    const uint32_t upto = (last >= AABB_BATCH_MAX - 1) ? 0xFFFFFFFFu : ((2u << last) - 1u);
+    return g_phys_awake_bits[first / AABB_BATCH_MAX] & upto;
+}
+
+static aabb_batch_t phys_pack_bodies(void)
+{
+    int n = 0;
+    memset(g_phys_awake_bits, 0, sizeof(g_phys_awake_bits));
+    for (int e = 0; e < ECS_MAX_ENTITIES; ++e) {
+        if (!ecs_alive_idx(e)) continue;
+        const uint32_t req = (CMP_POS | CMP_COL | CMP_PHYS_BODY);
+        if ((ecs_mask[e] & req) != req) continue;
+        if (!cmp_phys_body[e].created) continue;
+        if (!cmp_phys_body[e].sleeping) {
+            g_phys_awake_bits[n / AABB_BATCH_MAX] |= 1u << (n % AABB_BATCH_MAX);
+        }
+        g_phys_idx[n] = e;
+        g_phys_cx[n] = cmp_pos[e].x;
+        g_phys_cy[n] = cmp_pos[e].y;
+        g_phys_hx[n] = cmp_col[e].hx;
+        g_phys_hy[n] = cmp_col[e].hy;
+        ++n;
+    }
+    return (aabb_batch_t){ g_phys_cx, g_phys_cy, g_phys_hx, g_phys_hy, n };
+}
+
+static ecs_broadphase_t g_phys_bp;
+// Pairs resolved in iteration 0; later iterations only revisit these.
+static DA(ecs_bp_pair_t) g_phys_contacts;
+
+void ecs_physics_set_broadphase(ecs_broadphase_kind_t kind)
+{
+    if ((unsigned)kind >= (unsigned)ECS_BROADPHASE_COUNT) return;
+    g_phys_bp.kind = kind;
+}
+
+ecs_broadphase_kind_t ecs_physics_broadphase(void)
+{
+    return g_phys_bp.kind;
+}
+
+void ecs_physics_set_solver_iterations(int max_iterations)
+{
+    if (max_iterations < 1) max_iterations = 1;
+    if (max_iterations > PHYS_SOLVER_MAX_ITERATIONS) max_iterations = PHYS_SOLVER_MAX_ITERATIONS;
+    g_phys_max_iterations = max_iterations;
+}
+
+int ecs_physics_solver_iterations(void)
+{
+    return g_phys_max_iterations;
+}
+
+ecs_phys_solver_stats_t ecs_physics_solver_stats(void)
+{
+    return g_phys_stats;
+}
+
+// Separate a pair of packed bodies. Returns false if it is filtered out or no longer overlaps.
+static bool resolve_body_pair(int ka, int kb, const bool* has_intent)
+{
+    const int a = g_phys_idx[ka];
+    const int b = g_phys_idx[kb];
+    const cmp_phys_body_t* pa = &cmp_phys_body[a];
+    const cmp_phys_body_t* pb = &cmp_phys_body[b];
+
+    // Optional collision filtering (only if configured on either body).
+    if (pa->category_bits || pa->mask_bits || pb->category_bits || pb->mask_bits) {
+        const unsigned int catA = pa->category_bits ? pa->category_bits : 0xFFFFFFFFu;
+        const unsigned int mskA = pa->mask_bits ? pa->mask_bits : 0xFFFFFFFFu;
+        const unsigned int catB = pb->category_bits ? pb->category_bits : 0xFFFFFFFFu;
+        const unsigned int mskB = pb->mask_bits ? pb->mask_bits : 0xFFFFFFFFu;
+        if (((catA & mskB) == 0u) || ((catB & mskA) == 0u)) return false;
+    }
+
+    if (pa->type == PHYS_STATIC && pb->type == PHYS_STATIC) return false;
+    if (!phys_slot_awake(ka) && !phys_slot_awake(kb)) return false;
+
+    const float dx = g_phys_cx[kb] - g_phys_cx[ka];
+    const float dy = g_phys_cy[kb] - g_phys_cy[ka];
+    const float px = (g_phys_hx[ka] + g_phys_hx[kb]) - fabsf(dx);
+    const float py = (g_phys_hy[ka] + g_phys_hy[kb]) - fabsf(dy);
+    if (px <= 0.0f || py <= 0.0f) return false;
+
+    const bool resolve_x = (px < py);
+    const float overlap = resolve_x ? px : py;
+    const float sign = resolve_x ? (dx >= 0.0f ? 1.0f : -1.0f) : (dy >= 0.0f ? 1.0f : -1.0f);
+
+    float wA = pa->inv_mass;
+    float wB = pb->inv_mass;
+    if (has_intent[a]) wA *= 2.0f;
+    if (has_intent[b]) wB *= 2.0f;
+
+    if (pa->type == PHYS_STATIC) wA = 0.0f;
+    if (pb->type == PHYS_STATIC) wB = 0.0f;
+
+    float sum = wA + wB;
+    float a_amt = 0.0f;
+    float b_amt = 0.0f;
+    if (sum > 0.0f) {
+        a_amt = overlap * (wA / sum);
+        b_amt = overlap * (wB / sum);
+    } else {
+        // Fallback: split evenly.
+        a_amt = overlap * 0.5f;
+        b_amt = overlap * 0.5f;
     }
+
+    // Contact with an awake body wakes a sleeper.
+    phys_slot_wake(ka);
+    phys_slot_wake(kb);
+
+    // Separate along chosen axis.
+    if (resolve_x) {
+        cmp_pos[a].x -= sign * a_amt;
+        cmp_pos[b].x += sign * b_amt;
+        g_phys_cx[ka] = cmp_pos[a].x;
+        g_phys_cx[kb] = cmp_pos[b].x;
+    } else {
+        cmp_pos[a].y -= sign * a_amt;
+        cmp_pos[b].y += sign * b_amt;
+        g_phys_cy[ka] = cmp_pos[a].y;
+        g_phys_cy[kb] = cmp_pos[b].y;
+    }
+    g_phys_iter_correction = fmaxf(g_phys_iter_correction, fmaxf(a_amt, b_amt));
+    g_phys_stats.pair_resolves++;
+    return true;
+}
+
+// Resolve a pair found by the iteration-0 search and remember it for later iterations.
+static bool resolve_new_contact(int ka, int kb, const bool* has_intent)
+{
+    if (!resolve_body_pair(ka, kb, has_intent)) return false;
+    ecs_bp_pair_t p = { ka, kb };
+    DA_APPEND(&g_phys_contacts, p);
+    return true;
 }
 
 void sys_physics_integrate_impl(float dt)
@@ -37,11 +233,20 @@ void sys_physics_integrate_impl(float dt)
         }
     }
 
-    bool  has_intent[ECS_MAX_ENTITIES];
+    // Anything that moved a sleeping body since the last tick (teleport, grab) wakes it.
     for (int e = 0; e < ECS_MAX_ENTITIES; ++e) {
-        has_intent[e] = false;
+        if (!ecs_alive_idx(e) || (ecs_mask[e] & CMP_POS) == 0) continue;
+        cmp_phys_body_t* pb = &cmp_phys_body[e];
+        if (!(ecs_mask[e] & CMP_PHYS_BODY) || !pb->created || !pb->sleeping) continue;
+        if (cmp_pos[e].x != pb->rest_x || cmp_pos[e].y != pb->rest_y) {
+            phys_body_wake(pb);
+        }
     }
 
+    bool* has_intent = frame_alloc_array(FRAME_ARENA_TICK, bool, ECS_MAX_ENTITIES);
+    if (!has_intent) return;
+    memset(has_intent, 0, ECS_MAX_ENTITIES * sizeof(*has_intent));
+
     // Apply intent velocities to positions (physics-lite).
     for (int e = 0; e < ECS_MAX_ENTITIES; ++e) {
         if (!ecs_alive_idx(e)) continue;
@@ -57,6 +262,7 @@ void sys_physics_integrate_impl(float dt)
             case PHYS_KINEMATIC:
                 if (v->x != 0.0f || v->y != 0.0f) {
                     has_intent[e] = true;
+                    phys_body_wake(pb);
                 }
                 {
                     float dx = v->x * dt;
@@ -94,87 +300,74 @@ void sys_physics_integrate_impl(float dt)
         v->y = 0.0f;
     }
 
-    for (int iter = 0; iter < 4; ++iter) {
-        for (int a = 0; a < ECS_MAX_ENTITIES; ++a) {
-            if (!ecs_alive_idx(a)) continue;
-            const uint32_t reqA = (CMP_POS | CMP_COL | CMP_PHYS_BODY);
-            if ((ecs_mask[a] & reqA) != reqA) continue;
-            if (!cmp_phys_body[a].created) continue;
-
-            for (int b = a + 1; b < ECS_MAX_ENTITIES; ++b) {
-                if (!ecs_alive_idx(b)) continue;
-                const uint32_t reqB = (CMP_POS | CMP_COL | CMP_PHYS_BODY);
-                if ((ecs_mask[b] & reqB) != reqB) continue;
-                if (!cmp_phys_body[b].created) continue;
-
-                const cmp_phys_body_t* pa = &cmp_phys_body[a];
-                const cmp_phys_body_t* pb = &cmp_phys_body[b];
-
-                // Optional collision filtering (only if configured on either body).
-                if (pa->category_bits || pa->mask_bits || pb->category_bits || pb->mask_bits) {
-                    const unsigned int catA = pa->category_bits ? pa->category_bits : 0xFFFFFFFFu;
-                    const unsigned int mskA = pa->mask_bits ? pa->mask_bits : 0xFFFFFFFFu;
-                    const unsigned int catB = pb->category_bits ? pb->category_bits : 0xFFFFFFFFu;
-                    const unsigned int mskB = pb->mask_bits ? pb->mask_bits : 0xFFFFFFFFu;
-                    if (((catA & mskB) == 0u) || ((catB & mskA) == 0u)) continue;
-                }
+    g_phys_stats = (ecs_phys_solver_stats_t){0};
+    DA_CLEAR(&g_phys_contacts);
 
-                if (pa->type == PHYS_STATIC && pb->type == PHYS_STATIC) continue;
-
-                const float ax = cmp_pos[a].x;
-                const float ay = cmp_pos[a].y;
-                const float bx = cmp_pos[b].x;
-                const float by = cmp_pos[b].y;
-                const float ahx = cmp_col[a].hx;
-                const float ahy = cmp_col[a].hy;
-                const float bhx = cmp_col[b].hx;
-                const float bhy = cmp_col[b].hy;
-
-                const float dx = bx - ax;
-                const float dy = by - ay;
-                const float px = (ahx + bhx) - fabsf(dx);
-                const float py = (ahy + bhy) - fabsf(dy);
-                if (px <= 0.0f || py <= 0.0f) continue;
-
-                const bool resolve_x = (px < py);
-                const float overlap = resolve_x ? px : py;
-                const float sign = resolve_x ? (dx >= 0.0f ? 1.0f : -1.0f) : (dy >= 0.0f ? 1.0f : -1.0f);
-
-                float wA = pa->inv_mass;
-                float wB = pb->inv_mass;
-                if (has_intent[a]) wA *= 2.0f;
-                if (has_intent[b]) wB *= 2.0f;
-
-                if (pa->type == PHYS_STATIC) wA = 0.0f;
-                if (pb->type == PHYS_STATIC) wB = 0.0f;
-
-                float sum = wA + wB;
-                float a_amt = 0.0f;
-                float b_amt = 0.0f;
-                if (sum > 0.0f) {
-                    a_amt = overlap * (wA / sum);
-                    b_amt = overlap * (wB / sum);
-                } else {
-                    // Fallback: split evenly.
-                    a_amt = overlap * 0.5f;
-                    b_amt = overlap * 0.5f;
-                }
+    for (int iter = 0; iter < g_phys_max_iterations; ++iter) {
+        const aabb_batch_t batch = phys_pack_bodies();
+        g_phys_iter_correction = 0.0f;
 
-                // Separate along chosen axis.
-                if (resolve_x) {
-                    cmp_pos[a].x -= sign * a_amt;
-                    cmp_pos[b].x += sign * b_amt;
-                } else {
-                    cmp_pos[a].y -= sign * a_amt;
-                    cmp_pos[b].y += sign * b_amt;
+        if (iter > 0) {
+            // Slots are stable within a tick, so the cached contacts still index the same bodies.
+            for (size_t p = 0; p < g_phys_contacts.size; ++p) {
+                resolve_body_pair(g_phys_contacts.data[p].a, g_phys_contacts.data[p].b, has_intent);
+            }
+        } else if (g_phys_bp.kind != ECS_BROADPHASE_ALL_PAIRS) {
+            // Pairs come back in (a, b) order, same as the all-pairs sweep below.
+            ecs_broadphase_update(&g_phys_bp, &batch, g_phys_idx);
+            for (size_t p = 0; p < g_phys_bp.pairs.size; ++p) {
+                resolve_new_contact(g_phys_bp.pairs.data[p].a, g_phys_bp.pairs.data[p].b, has_intent);
+            }
+        } else {
+            // Only awake bodies get a row; they test every lane, skipping awake lanes whose row already ran.
+            // With everything awake this visits pairs in the same (a, b) order as a plain a < b sweep.
+            for (int ka = 0; ka < batch.count; ++ka) {
+                if (!phys_slot_awake(ka)) continue;
+                for (int first = 0; first < batch.count; first += AABB_BATCH_MAX) {
+                    uint32_t hits = aabb_overlap_mask(g_phys_cx[ka], g_phys_cy[ka], g_phys_hx[ka], g_phys_hy[ka],
+                                                      &batch, first, false) & ~phys_done_lanes(ka, first);
+                    while (hits) {
+                        const int lane = aabb_mask_pop(&hits);
+                        const int kb = first + lane;
+                        const bool moved = (kb < ka) ? resolve_new_contact(kb, ka, has_intent)
+                                                     : resolve_new_contact(ka, kb, has_intent);
+                        if (!moved) continue;
+                        // A moved: retest the lanes after this one against its new position.
+                        hits = aabb_overlap_mask(g_phys_cx[ka], g_phys_cy[ka], g_phys_hx[ka], g_phys_hy[ka],
+                                                 &batch, first, false)
+                             & ~phys_done_lanes(ka, first) & ~((2u << lane) - 1u);
+                    }
                 }
             }
         }
 
         for (int e = 0; e < ECS_MAX_ENTITIES; ++e) {
             if (!ecs_alive_idx(e)) continue;
-            resolve_tile_penetration(e);
+            g_phys_iter_correction = fmaxf(g_phys_iter_correction, resolve_tile_penetration(e));
+        }
+
+        g_phys_stats.iterations = iter + 1;
+        g_phys_stats.max_correction = g_phys_iter_correction;
+        if (g_phys_iter_correction < PHYS_SOLVER_EPSILON) break;
+    }
+    g_phys_stats.contacts = (int)g_phys_contacts.size;
+
+    // Bodies that ended the tick where they started, with no intent, count towards sleep.
+    for (int e = 0; e < ECS_MAX_ENTITIES; ++e) {
+        if (!ecs_alive_idx(e)) continue;
+        const uint32_t req = (CMP_POS | CMP_PHYS_BODY);
+        if ((ecs_mask[e] & req) != req) continue;
+        cmp_phys_body_t* pb = &cmp_phys_body[e];
+        if (!pb->created) continue;
+
+        const bool quiet = !has_intent[e] && cmp_pos[e].x == pb->rest_x && cmp_pos[e].y == pb->rest_y;
+        if (!quiet) {
+            phys_body_wake(pb);
+        } else if (!pb->sleeping && ++pb->quiet_ticks >= PHYS_SLEEP_TICKS) {
+            pb->sleeping = true;
         }
+        pb->rest_x = cmp_pos[e].x;
+        pb->rest_y = cmp_pos[e].y;
     }
 }
 
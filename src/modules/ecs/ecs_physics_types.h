@@ -22,8 +22,22 @@ typedef struct {
     // Runtime flag: becomes true once the entity has the required components (POS+COL+PHYS_BODY)
     // and is participating in the physics-lite step.
     bool created;
+
+    // Sleep state: bodies that stay put with no intent for PHYS_SLEEP_TICKS ticks are
+    // skipped by the solver and tile resolution until something touches or moves them.
+    bool  sleeping;
+    int   quiet_ticks;
+    float rest_x, rest_y;   // position at the end of the last physics tick
 } cmp_phys_body_t;
 
+#define PHYS_SLEEP_TICKS 30
+
+static inline void phys_body_wake(cmp_phys_body_t* pb)
+{
+    pb->sleeping = false;
+    pb->quiet_ticks = 0;
+}
+
 enum {
     PHYS_CAT_PLAYER = 1u << 0,
     PHYS_CAT_TARDAS = 1u << 1
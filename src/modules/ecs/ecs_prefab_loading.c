@@ -1,3 +1,4 @@
+#define DA_MEM_TAG MEM_TAG_PREFAB
 #include "modules/ecs/ecs_prefab_loading.h"
 
 #include "modules/ecs/ecs_internal.h"
@@ -5,6 +6,9 @@
 #include "modules/ecs/ecs_doors.h"
 #include "modules/ecs/ecs_game.h"
 #include "modules/core/logger.h"
+#include "modules/common/dynarray.h"
+#include "modules/common/mem_tag.h"
+#include "modules/common/path_util.h"
 #include "modules/prefab/prefab_cmp.h"
 
 #include <stdio.h>
@@ -23,11 +27,7 @@ static char* xstrdup_local(const char* s)
 static const char* object_prop_only(const tiled_object_t* obj, const char* comp_name, const char* field)
 {
     if (!obj || !field || !comp_name) return NULL;
-    char key[128];
-    snprintf(key, sizeof(key), "%s.%s", comp_name, field);
-    const char* v = tiled_object_get_property_value(obj, key);
-    if (v) return v;
-    return tiled_object_get_property_value(obj, field);
+    return tiled_object_get_scoped_value(obj, comp_name, field);
 }
 
 typedef struct prefab_built_entity_t {
@@ -266,6 +266,109 @@ static char* join_relative_path(const char* base_path, const char* rel)
     return buf;
 }
 
+// Map-spawned entities remember the prefab file and TMX object they came from, so a prefab
+// edit can respawn just those entities. The generation guards against reused slots.
+typedef struct {
+    uint32_t gen;          // 0 = not spawned from a map object
+    int      path_id;      // index into g_origin_paths
+    int      object_index;
+} prefab_origin_t;
+
+static prefab_origin_t g_origins[ECS_MAX_ENTITIES];
+static DA(char*) g_origin_paths;  // normalised prefab paths
+
+static int origin_path_id(const char* path)
+{
+    char norm[512];
+    if (!path_normalize(path, norm, sizeof(norm))) return -1;
+    for (size_t i = 0; i < g_origin_paths.size; ++i) {
+        if (strcmp(g_origin_paths.data[i], norm) == 0) return (int)i;
+    }
+    char* copy = xstrdup_local(norm);
+    if (!copy) return -1;
+    DA_APPEND(&g_origin_paths, copy);
+    return (int)g_origin_paths.size - 1;
+}
+
+typedef struct {
+    char*    path; // normalised
+    prefab_t prefab;
+} prefab_template_t;
+
+struct ecs_prefab_templates {
+    DA(prefab_template_t) items;
+};
+
+static const ecs_prefab_templates_t* g_templates; // set around a preloaded map's spawn
+
+static const prefab_t* template_find(const ecs_prefab_templates_t* t, const char* norm_path)
+{
+    if (!t) return NULL;
+    for (size_t i = 0; i < t->items.size; ++i) {
+        if (strcmp(t->items.data[i].path, norm_path) == 0) return &t->items.data[i].prefab;
+    }
+    return NULL;
+}
+
+ecs_prefab_templates_t* ecs_prefab_templates_build(const world_map_t* map, const char* tmx_path)
+{
+    if (!map) return NULL;
+    ecs_prefab_templates_t* t = (ecs_prefab_templates_t*)mem_calloc(MEM_TAG_PREFAB, 1, sizeof(*t));
+    if (!t) return NULL;
+
+    for (size_t i = 0; i < map->object_count; ++i) {
+        const char* prefab_rel = tiled_object_get_property_value(&map->objects[i], "entityprefab");
+        if (!prefab_rel) continue;
+
+        char* resolved = join_relative_path(tmx_path, prefab_rel);
+        char norm[512];
+        const bool have_norm = path_normalize(resolved ? resolved : prefab_rel, norm, sizeof(norm));
+        free(resolved);
+        if (!have_norm || template_find(t, norm)) continue;
+
+        prefab_template_t tmpl = { xstrdup_local(norm), {0} };
+        if (!tmpl.path || !prefab_load(norm, &tmpl.prefab)) {
+            free(tmpl.path); // spawn falls back to reading (and reporting) it
+            continue;
+        }
+        DA_APPEND(&t->items, tmpl);
+    }
+    return t;
+}
+
+void ecs_prefab_templates_free(ecs_prefab_templates_t* t)
+{
+    if (!t) return;
+    if (g_templates == t) g_templates = NULL;
+    for (size_t i = 0; i < t->items.size; ++i) {
+        free(t->items.data[i].path);
+        prefab_free(&t->items.data[i].prefab);
+    }
+    DA_FREE(&t->items);
+    mem_free(MEM_TAG_PREFAB, t, sizeof(*t));
+}
+
+void ecs_prefab_use_templates(const ecs_prefab_templates_t* t)
+{
+    g_templates = t;
+}
+
+static ecs_entity_t spawn_map_object(const char* path, const world_map_t* map, size_t object_index)
+{
+    const prefab_t* tmpl = NULL;
+    char norm[512];
+    if (g_templates && path_normalize(path, norm, sizeof(norm))) tmpl = template_find(g_templates, norm);
+
+    ecs_entity_t e = tmpl
+        ? ecs_prefab_spawn_entity(tmpl, &map->objects[object_index])
+        : ecs_prefab_spawn_entity_from_path(path, &map->objects[object_index]);
+    int idx = ent_index_checked(e);
+    if (idx >= 0) {
+        g_origins[idx] = (prefab_origin_t){ e.gen, origin_path_id(path), (int)object_index };
+    }
+    return e;
+}
+
 size_t ecs_prefab_spawn_from_map(const world_map_t* map, const char* tmx_path)
 {
     if (!map) return 0;
@@ -278,7 +381,7 @@ size_t ecs_prefab_spawn_from_map(const world_map_t* map, const char* tmx_path)
 
         char* resolved = join_relative_path(tmx_path, prefab_rel);
         const char* path = resolved ? resolved : prefab_rel;
-        ecs_entity_t e = ecs_prefab_spawn_entity_from_path(path, obj);
+        ecs_entity_t e = spawn_map_object(path, map, i);
         if (resolved) free(resolved);
         int idx = ent_index_checked(e);
         if (idx >= 0) spawned++;
@@ -286,3 +389,152 @@ size_t ecs_prefab_spawn_from_map(const world_map_t* map, const char* tmx_path)
 
     return spawned;
 }
+
+// Streamed maps: paging state of every TMX object (parallel to map->objects).
+typedef enum {
+    OBJ_PAGE_NONE = 0, // not an entity object
+    OBJ_PAGE_PARKED,   // waiting for its chunk to turn active
+    OBJ_PAGE_LIVE,
+    OBJ_PAGE_GONE,     // destroyed by gameplay; never respawned
+    OBJ_PAGE_PINNED,   // player: spawned up front, never paged
+} obj_page_state_t;
+
+typedef struct {
+    uint8_t      state;
+    bool         has_pos; // parked after living: restore this position on respawn
+    int          path_id;
+    ecs_entity_t e;
+    float        x, y;    // paging key: object position, then wherever it was parked
+} obj_page_t;
+
+static DA(obj_page_t) g_obj_pages;
+static DA(int8_t) g_path_pinned; // per origin path: -1 unknown, else prefab has a player component
+
+static bool path_is_pinned(int path_id)
+{
+    while (g_path_pinned.size < g_origin_paths.size) DA_APPEND(&g_path_pinned, (int8_t)-1);
+    if (g_path_pinned.data[path_id] < 0) {
+        prefab_t prefab;
+        bool player = false;
+        if (prefab_load(g_origin_paths.data[path_id], &prefab)) {
+            for (size_t c = 0; c < prefab.component_count && !player; ++c) {
+                player = prefab.components[c].id == ENUM_PLAYER;
+            }
+            prefab_free(&prefab);
+        }
+        g_path_pinned.data[path_id] = player ? 1 : 0;
+    }
+    return g_path_pinned.data[path_id] == 1;
+}
+
+size_t ecs_prefab_stream_begin(const world_map_t* map, const char* tmx_path)
+{
+    DA_CLEAR(&g_obj_pages);
+    if (!map) return 0;
+
+    size_t spawned = 0;
+    for (size_t i = 0; i < map->object_count; ++i) {
+        const tiled_object_t* obj = &map->objects[i];
+        obj_page_t page = { .state = OBJ_PAGE_NONE, .path_id = -1, .x = obj->x, .y = obj->y };
+
+        const char* prefab_rel = tiled_object_get_property_value(obj, "entityprefab");
+        char* resolved = prefab_rel ? join_relative_path(tmx_path, prefab_rel) : NULL;
+        if (prefab_rel) page.path_id = origin_path_id(resolved ? resolved : prefab_rel);
+        free(resolved);
+
+        if (page.path_id >= 0 && path_is_pinned(page.path_id)) {
+            page.e = spawn_map_object(g_origin_paths.data[page.path_id], map, i);
+            page.state = OBJ_PAGE_PINNED;
+            if (ent_index_checked(page.e) >= 0) spawned++;
+        } else if (page.path_id >= 0) {
+            page.state = OBJ_PAGE_PARKED;
+        }
+        DA_APPEND(&g_obj_pages, page);
+    }
+    return spawned;
+}
+
+size_t ecs_prefab_stream_rect(const world_map_t* map, float x0, float y0, float x1, float y1, bool active)
+{
+    if (!map) return 0;
+
+    size_t changed = 0;
+    const size_t count = g_obj_pages.size < map->object_count ? g_obj_pages.size : map->object_count;
+    for (size_t i = 0; i < count; ++i) {
+        obj_page_t* page = &g_obj_pages.data[i];
+
+        if (active && page->state == OBJ_PAGE_PARKED) {
+            if (page->x < x0 || page->x >= x1 || page->y < y0 || page->y >= y1) continue;
+            page->e = spawn_map_object(g_origin_paths.data[page->path_id], map, i);
+            const int idx = ent_index_checked(page->e);
+            if (idx < 0) continue; // out of entity slots; try again next time the chunk turns active
+            if (page->has_pos && (ecs_mask[idx] & CMP_POS)) cmp_pos[idx] = (cmp_position_t){ page->x, page->y };
+            page->state = OBJ_PAGE_LIVE;
+            changed++;
+        } else if (!active && page->state == OBJ_PAGE_LIVE) {
+            const int idx = ent_index_checked(page->e);
+            if (idx < 0) {
+                page->state = OBJ_PAGE_GONE;
+                continue;
+            }
+            const bool has_pos = (ecs_mask[idx] & CMP_POS) != 0;
+            const float px = has_pos ? cmp_pos[idx].x : page->x;
+            const float py = has_pos ? cmp_pos[idx].y : page->y;
+            if (px < x0 || px >= x1 || py < y0 || py >= y1) continue;
+            ecs_destroy(page->e);
+            g_origins[idx].gen = 0;
+            *page = (obj_page_t){ OBJ_PAGE_PARKED, has_pos, page->path_id, ecs_null(), px, py };
+            changed++;
+        }
+    }
+    return changed;
+}
+
+size_t ecs_prefab_respawn(const world_map_t* map, const char* prefab_path)
+{
+    if (!map || !prefab_path) return 0;
+
+    int path_id = -1;
+    for (size_t i = 0; i < g_origin_paths.size && path_id < 0; ++i) {
+        if (path_same(g_origin_paths.data[i], prefab_path)) path_id = (int)i;
+    }
+    if (path_id < 0) return 0;
+
+    // Collect first: a respawned entity may land in a slot the scan hasn't reached yet.
+    static int victims[ECS_MAX_ENTITIES];
+    size_t count = 0;
+    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
+        const prefab_origin_t* o = &g_origins[i];
+        if (o->gen == 0 || o->path_id != path_id) continue;
+        if (ent_index_checked((ecs_entity_t){ (uint32_t)i, o->gen }) < 0) continue;
+        if ((size_t)o->object_index >= map->object_count) continue;
+        victims[count++] = i;
+    }
+
+    for (size_t k = 0; k < count; ++k) {
+        const int i = victims[k];
+        const prefab_origin_t o = g_origins[i];
+        const bool had_pos = (ecs_mask[i] & CMP_POS) != 0;
+        const cmp_position_t pos = cmp_pos[i];
+
+        ecs_destroy((ecs_entity_t){ (uint32_t)i, o.gen });
+        g_origins[i].gen = 0;
+
+        ecs_entity_t e = spawn_map_object(g_origin_paths.data[o.path_id], map, (size_t)o.object_index);
+        int idx = ent_index_checked(e);
+        if (idx >= 0 && had_pos && (ecs_mask[idx] & CMP_POS)) cmp_pos[idx] = pos;
+        if ((size_t)o.object_index < g_obj_pages.size) g_obj_pages.data[o.object_index].e = e;
+    }
+
+    LOGC(LOGCAT_PREFAB, LOG_LVL_INFO, "ecs_prefab: respawned %zu entities from %s", count, g_origin_paths.data[path_id]);
+    return count;
+}
+
+void ecs_prefab_loading_shutdown(void)
+{
+    for (size_t i = 0; i < g_origin_paths.size; ++i) free(g_origin_paths.data[i]);
+    DA_FREE(&g_origin_paths);
+    DA_FREE(&g_path_pinned);
+    DA_FREE(&g_obj_pages);
+    memset(g_origins, 0, sizeof(g_origins));
+}
@@ -9,3 +9,23 @@ ecs_entity_t ecs_prefab_spawn_entity(const prefab_t* prefab, const tiled_object_
 ecs_entity_t ecs_prefab_spawn_entity_from_path(const char* prefab_path, const tiled_object_t* obj);
 size_t ecs_prefab_spawn_from_map(const world_map_t* map, const char* tmx_path);
 
+// Map preloading: parse every prefab the map's objects name up front (no ECS access, so any
+// thread). While a set is in use, map spawns take their prefabs from it instead of the disk.
+typedef struct ecs_prefab_templates ecs_prefab_templates_t;
+ecs_prefab_templates_t* ecs_prefab_templates_build(const world_map_t* map, const char* tmx_path);
+void ecs_prefab_templates_free(ecs_prefab_templates_t* templates);
+void ecs_prefab_use_templates(const ecs_prefab_templates_t* templates); // NULL = back to the disk
+
+// Frees the map-spawn bookkeeping (origin prefab paths, stream paging state); engine shutdown.
+void ecs_prefab_loading_shutdown(void);
+
+// Hot reload: destroy the live entities ecs_prefab_spawn_from_map spawned from prefab_path and
+// spawn them again from the same map objects, keeping their current positions.
+size_t ecs_prefab_respawn(const world_map_t* map, const char* prefab_path);
+
+
+// Streamed maps (world_stream.h): begin spawns only player objects; every other entity object is
+// spawned when a chunk holding it turns active and parked (destroyed, position kept) when the
+// chunk holding the entity leaves the active set. Entities that died while live stay gone.
+size_t ecs_prefab_stream_begin(const world_map_t* map, const char* tmx_path);
+size_t ecs_prefab_stream_rect(const world_map_t* map, float x0, float y0, float x1, float y1, bool active);
@@ -1,21 +1,35 @@
+#define DA_MEM_TAG MEM_TAG_ECS
 #include "modules/ecs/ecs_internal.h"
 #include "modules/core/input.h"
 #include "modules/systems/systems_registration.h"
 #include "modules/ecs/ecs_proximity.h"
+#include "modules/ecs/ecs_aabb.h"
+#include "modules/ecs/ecs_broadphase.h"
 #include "modules/common/dynarray.h"
+#include "modules/common/hashmap.h"
 #include <math.h>
+#include <stdlib.h>
 #include <string.h>
 
 // =============== Proximity View (transient each tick) =============
 static DA(ecs_prox_view_t) prox_curr = {0};
 static DA(ecs_prox_view_t) prox_prev = {0};
 
-static bool prox_contains(const ecs_prox_view_t* arr, int n, ecs_prox_view_t p){
-    for (int i = 0; i < n; ++i){
-        if (arr[i].trigger_owner.idx==p.trigger_owner.idx && arr[i].trigger_owner.gen==p.trigger_owner.gen &&
-            arr[i].matched_entity.idx==p.matched_entity.idx && arr[i].matched_entity.gen==p.matched_entity.gen) return true;
-    }
-    return false;
+static uint32_t prox_view_hash(ecs_prox_view_t v){ return hm_hash_bytes(&v, sizeof(v)); }
+static bool prox_view_eq(ecs_prox_view_t a, ecs_prox_view_t b){ return memcmp(&a, &b, sizeof(a)) == 0; }
+
+// Membership sets mirroring prox_curr/prox_prev, so enter/exit are O(1) per pair.
+HM_DECLARE(prox_set, ecs_prox_view_t, bool, prox_view_hash, prox_view_eq, MEM_TAG_ECS)
+static prox_set_t prox_curr_set = {0};
+static prox_set_t prox_prev_set = {0};
+
+static void prox_index(prox_set_t* set, const ecs_prox_view_t* arr, size_t n){
+    prox_set_clear(set);
+    for (size_t i = 0; i < n; ++i) prox_set_put(set, arr[i], true);
+}
+
+static bool prox_contains(const prox_set_t* set, ecs_prox_view_t p){
+    return prox_set_get(set, p) != NULL;
 }
 
 // public iterators
@@ -39,10 +53,9 @@ ecs_prox_iter_t ecs_prox_enter_begin(void){ return (ecs_prox_iter_t){ .i = -1 };
 
 bool ecs_prox_enter_next(ecs_prox_iter_t* it, ecs_prox_view_t* out){
     int curr_count = (int)prox_curr.size;
-    int prev_count = (int)prox_prev.size;
     for (int i = it->i + 1; i < curr_count; ++i){
         if (!ecs_alive_handle(prox_curr.data[i].trigger_owner) || !ecs_alive_handle(prox_curr.data[i].matched_entity)) continue;
-        if (!prox_contains(prox_prev.data, prev_count, prox_curr.data[i])){
+        if (!prox_contains(&prox_prev_set, prox_curr.data[i])){
             it->i = i;
             *out = prox_curr.data[i];
             return true;
@@ -55,10 +68,9 @@ ecs_prox_iter_t ecs_prox_exit_begin(void){ return (ecs_prox_iter_t){ .i = -1 };
 
 bool ecs_prox_exit_next(ecs_prox_iter_t* it, ecs_prox_view_t* out){
     int prev_count = (int)prox_prev.size;
-    int curr_count = (int)prox_curr.size;
     for (int i = it->i + 1; i < prev_count; ++i){
         if (!ecs_alive_handle(prox_prev.data[i].trigger_owner) || !ecs_alive_handle(prox_prev.data[i].matched_entity)) continue;
-        if (!prox_contains(prox_curr.data, curr_count, prox_prev.data[i])){
+        if (!prox_contains(&prox_curr_set, prox_prev.data[i])){
             it->i = i;
             *out = prox_prev.data[i];
             return true;
@@ -67,40 +79,163 @@ bool ecs_prox_exit_next(ecs_prox_iter_t* it, ecs_prox_view_t* out){
     return false;
 }
 
-static bool col_overlap_padded_idx(int a, int b, float pad){
-    float ax = cmp_pos[a].x, ay = cmp_pos[a].y;
-    float bx = cmp_pos[b].x, by = cmp_pos[b].y;
+// Packed POS|COL candidates for the batched overlap test, rebuilt each tick.
+static int   prox_cand_idx[ECS_MAX_ENTITIES];
+static float prox_cand_cx[ECS_MAX_ENTITIES];
+static float prox_cand_cy[ECS_MAX_ENTITIES];
+static float prox_cand_hx[ECS_MAX_ENTITIES];
+static float prox_cand_hy[ECS_MAX_ENTITIES];
+
+static aabb_batch_t prox_pack_candidates(void)
+{
+    int n = 0;
+    for (int b = 0; b < ECS_MAX_ENTITIES; ++b) {
+        if (!ecs_alive_idx(b)) continue;
+        if ((ecs_mask[b] & (CMP_POS|CMP_COL)) != (CMP_POS|CMP_COL)) continue;
+        prox_cand_idx[n] = b;
+        prox_cand_cx[n] = cmp_pos[b].x;
+        prox_cand_cy[n] = cmp_pos[b].y;
+        prox_cand_hx[n] = cmp_col[b].hx;
+        prox_cand_hy[n] = cmp_col[b].hy;
+        ++n;
+    }
+    return (aabb_batch_t){ prox_cand_cx, prox_cand_cy, prox_cand_hx, prox_cand_hy, n };
+}
 
-    float ahx = (ecs_mask[a] & CMP_COL) ? (cmp_col[a].hx + pad) : pad;
-    float ahy = (ecs_mask[a] & CMP_COL) ? (cmp_col[a].hy + pad) : pad;
-    float bhx = (ecs_mask[b] & CMP_COL) ?  cmp_col[b].hx : 0.f;
-    float bhy = (ecs_mask[b] & CMP_COL) ?  cmp_col[b].hy : 0.f;
+static ecs_broadphase_t prox_bp;
+static DA(ecs_prox_view_t) prox_hits = {0};
+// Candidate boxes grown by their trigger pad, so broadphase pairs cover every padded hit.
+static float prox_bp_hx[ECS_MAX_ENTITIES];
+static float prox_bp_hy[ECS_MAX_ENTITIES];
 
-    return fabsf(ax - bx) <= (ahx + bhx) && fabsf(ay - by) <= (ahy + bhy);
+static void prox_write_list(snap_buf_t* b, const ecs_prox_view_t* data, size_t n)
+{
+    uint32_t count = (uint32_t)n;
+    SNAP_WRITE_VAL(b, count);
+    snap_write(b, data, n * sizeof(*data));
 }
 
-// ---- systems ----
-static void sys_proximity_build_view_impl(void)
+void ecs_proximity_snapshot_write(snap_buf_t* b)
+{
+    snap_write_tag(b, SNAP_TAG('P','R','O','X'));
+    prox_write_list(b, prox_curr.data, prox_curr.size);
+    prox_write_list(b, prox_prev.data, prox_prev.size);
+}
+
+bool ecs_proximity_snapshot_read(snap_reader_t* r)
+{
+    if (!snap_expect_tag(r, SNAP_TAG('P','R','O','X'))) return false;
+
+    uint32_t count = 0;
+    if (!SNAP_READ_VAL(r, count) || count > (uint32_t)(r->size - r->pos) / sizeof(ecs_prox_view_t)) return false;
+    DA_RESERVE(&prox_curr, count);
+    prox_curr.size = count;
+    if (!snap_read(r, prox_curr.data, count * sizeof(ecs_prox_view_t))) return false;
+
+    if (!SNAP_READ_VAL(r, count) || count > (uint32_t)(r->size - r->pos) / sizeof(ecs_prox_view_t)) return false;
+    DA_RESERVE(&prox_prev, count);
+    prox_prev.size = count;
+    if (!snap_read(r, prox_prev.data, count * sizeof(ecs_prox_view_t))) return false;
+
+    prox_index(&prox_curr_set, prox_curr.data, prox_curr.size);
+    prox_index(&prox_prev_set, prox_prev.data, prox_prev.size);
+    return true;
+}
+
+void ecs_proximity_reset(void)
 {
-    if (prox_curr.size > 0) {
-        DA_RESERVE(&prox_prev, prox_curr.size);
-        memcpy(prox_prev.data, prox_curr.data, sizeof(ecs_prox_view_t) * prox_curr.size);
-    }
-    prox_prev.size = prox_curr.size;
     DA_CLEAR(&prox_curr);
+    DA_CLEAR(&prox_prev);
+    prox_set_clear(&prox_curr_set);
+    prox_set_clear(&prox_prev_set);
+}
+
+void ecs_proximity_set_broadphase(ecs_broadphase_kind_t kind)
+{
+    if ((unsigned)kind >= (unsigned)ECS_BROADPHASE_COUNT) return;
+    prox_bp.kind = kind;
+}
 
+ecs_broadphase_kind_t ecs_proximity_broadphase(void)
+{
+    return prox_bp.kind;
+}
+
+static bool is_trigger_owner(int idx)
+{
+    return (ecs_mask[idx] & (CMP_POS|CMP_COL|CMP_TRIGGER)) == (CMP_POS|CMP_COL|CMP_TRIGGER);
+}
+
+// Directed test: slot `ka` as a padded trigger against slot `kb` (same math as the batched kernel).
+static void prox_test_directed(const aabb_batch_t* cand, int ka, int kb)
+{
+    const int a = prox_cand_idx[ka];
+    const int b = prox_cand_idx[kb];
+    if (!is_trigger_owner(a)) return;
+    const cmp_trigger_t* tr = &cmp_trigger[a];
+    if ((ecs_mask[b] & tr->target_mask) != tr->target_mask) return;
+
+    const float ahx = cmp_col[a].hx + tr->pad;
+    const float ahy = cmp_col[a].hy + tr->pad;
+    if (fabsf(cand->cx[kb] - cand->cx[ka]) <= (ahx + cand->hx[kb]) &&
+        fabsf(cand->cy[kb] - cand->cy[ka]) <= (ahy + cand->hy[kb])) {
+        ecs_prox_view_t v = { handle_from_index(a), handle_from_index(b) };
+        DA_APPEND(&prox_hits, v);
+    }
+}
+
+static int cmp_prox_view(const void* pa, const void* pb)
+{
+    const ecs_prox_view_t* a = (const ecs_prox_view_t*)pa;
+    const ecs_prox_view_t* b = (const ecs_prox_view_t*)pb;
+    if (a->trigger_owner.idx != b->trigger_owner.idx) return (a->trigger_owner.idx < b->trigger_owner.idx) ? -1 : 1;
+    if (a->matched_entity.idx != b->matched_entity.idx) return (a->matched_entity.idx < b->matched_entity.idx) ? -1 : 1;
+    return 0;
+}
+
+static void prox_build_from_broadphase(const aabb_batch_t* cand)
+{
+    for (int k = 0; k < cand->count; ++k) {
+        const int e = prox_cand_idx[k];
+        const float pad = is_trigger_owner(e) ? fmaxf(cmp_trigger[e].pad, 0.0f) : 0.0f;
+        prox_bp_hx[k] = cand->hx[k] + pad;
+        prox_bp_hy[k] = cand->hy[k] + pad;
+    }
+    const aabb_batch_t grown = { cand->cx, cand->cy, prox_bp_hx, prox_bp_hy, cand->count };
+    ecs_broadphase_update(&prox_bp, &grown, prox_cand_idx);
+
+    DA_CLEAR(&prox_hits);
+    for (size_t p = 0; p < prox_bp.pairs.size; ++p) {
+        const ecs_bp_pair_t pair = prox_bp.pairs.data[p];
+        prox_test_directed(cand, pair.a, pair.b);
+        prox_test_directed(cand, pair.b, pair.a);
+    }
+    // Keep the all-pairs ordering (owner, then matched) so enter/exit iteration is stable.
+    if (prox_hits.size > 1) {
+        qsort(prox_hits.data, prox_hits.size, sizeof(prox_hits.data[0]), cmp_prox_view);
+    }
+    for (size_t i = 0; i < prox_hits.size; ++i) {
+        DA_APPEND(&prox_curr, prox_hits.data[i]);
+    }
+}
+
+static void prox_build_all_pairs(const aabb_batch_t* cand)
+{
     for (int a=0; a<ECS_MAX_ENTITIES; ++a){
         if(!ecs_alive_idx(a)) continue;
         if ((ecs_mask[a] & (CMP_POS|CMP_COL|CMP_TRIGGER)) != (CMP_POS|CMP_COL|CMP_TRIGGER)) continue;
 
         const cmp_trigger_t* tr = &cmp_trigger[a];
+        const float ahx = cmp_col[a].hx + tr->pad;
+        const float ahy = cmp_col[a].hy + tr->pad;
 
-        for (int b=0; b<ECS_MAX_ENTITIES; ++b) {
-            if (b==a || !ecs_alive_idx(b)) continue;
-            if ((ecs_mask[b] & tr->target_mask) != tr->target_mask) continue;
-            if ((ecs_mask[b] & (CMP_POS|CMP_COL)) != (CMP_POS|CMP_COL)) continue;
+        for (int first = 0; first < cand->count; first += AABB_BATCH_MAX) {
+            uint32_t hits = aabb_overlap_mask(cmp_pos[a].x, cmp_pos[a].y, ahx, ahy, cand, first, true);
+            while (hits) {
+                const int b = prox_cand_idx[first + aabb_mask_pop(&hits)];
+                if (b == a) continue;
+                if ((ecs_mask[b] & tr->target_mask) != tr->target_mask) continue;
 
-            if (col_overlap_padded_idx(a, b, tr->pad)){
                 ecs_prox_view_t v = { handle_from_index(a), handle_from_index(b) };
                 DA_APPEND(&prox_curr, v);
             }
@@ -108,6 +243,28 @@ static void sys_proximity_build_view_impl(void)
     }
 }
 
+// ---- systems ----
+static void sys_proximity_build_view_impl(void)
+{
+    if (prox_curr.size > 0) {
+        DA_RESERVE(&prox_prev, prox_curr.size);
+        memcpy(prox_prev.data, prox_curr.data, sizeof(ecs_prox_view_t) * prox_curr.size);
+    }
+    prox_prev.size = prox_curr.size;
+    DA_CLEAR(&prox_curr);
+    const prox_set_t swap = prox_prev_set;
+    prox_prev_set = prox_curr_set;
+    prox_curr_set = swap;
+
+    const aabb_batch_t cand = prox_pack_candidates();
+    if (prox_bp.kind != ECS_BROADPHASE_ALL_PAIRS) {
+        prox_build_from_broadphase(&cand);
+    } else {
+        prox_build_all_pairs(&cand);
+    }
+    prox_index(&prox_curr_set, prox_curr.data, prox_curr.size);
+}
+
 static bool plastic_held_for_storage(int idx)
 {
     if ((ecs_mask[idx] & (CMP_PLASTIC | CMP_GRAV_GUN)) != (CMP_PLASTIC | CMP_GRAV_GUN)) return false;
@@ -1,6 +1,7 @@
 #pragma once
 #include <stdbool.h>
 #include "modules/ecs/ecs.h"
+#include "modules/ecs/ecs_broadphase.h"
 
 // View of a proximity pair (trigger-owner, target)
 typedef struct {
@@ -18,3 +19,7 @@ bool            ecs_prox_enter_next(ecs_prox_iter_t* it, ecs_prox_view_t* out);
 
 ecs_prox_iter_t ecs_prox_exit_begin(void);
 bool            ecs_prox_exit_next(ecs_prox_iter_t* it, ecs_prox_view_t* out);
+
+// Broadphase used to build the proximity view (runtime selectable).
+void                  ecs_proximity_set_broadphase(ecs_broadphase_kind_t kind);
+ecs_broadphase_kind_t ecs_proximity_broadphase(void);
@@ -0,0 +1,161 @@
+#include "modules/ecs/ecs_internal.h"
+#include "modules/asset/asset.h"
+#include "modules/core/logger.h"
+
+#include <string.h>
+
+// Component arrays are written per live entity and only for the components in its mask, so a
+// snapshot of a typical map is tens of KB rather than the full ECS_MAX_ENTITIES-wide storage.
+// Animation tables point into the anim arena; they travel as arena offsets and are relocated
+// on restore. Sprite textures travel as asset paths so refcounts stay balanced.
+
+typedef struct {
+    cmp_anim_t anim;          // pointer fields cleared
+    uint32_t   frames_per_anim;
+    uint32_t   anim_offsets;
+    uint32_t   frames;
+} snap_anim_t;
+
+#define SNAP_CMP(mask_bit, arr) { (mask_bit), (arr), sizeof((arr)[0]) }
+
+typedef struct {
+    uint32_t mask_bit;        // 0 = every live entity
+    void*    base;
+    size_t   stride;
+} snap_cmp_array_t;
+
+static const snap_cmp_array_t k_arrays[] = {
+    SNAP_CMP(0,              cmp_pos),
+    SNAP_CMP(0,              cmp_pos_prev),
+    SNAP_CMP(CMP_VEL,        cmp_vel),
+    SNAP_CMP(CMP_FOLLOW,     cmp_follow),
+    SNAP_CMP(CMP_COL,        cmp_col),
+    SNAP_CMP(CMP_TRIGGER,    cmp_trigger),
+    SNAP_CMP(CMP_BILLBOARD,  cmp_billboard),
+    SNAP_CMP(CMP_PHYS_BODY,  cmp_phys_body),
+    SNAP_CMP(CMP_GRAV_GUN,   cmp_grav_gun),
+    SNAP_CMP(CMP_DOOR,       cmp_door),
+};
+
+static tex_handle_t g_old_tex[ECS_MAX_ENTITIES];
+
+static void write_sprite(snap_buf_t* b, int i)
+{
+    cmp_sprite_t spr = cmp_spr[i];
+    spr.tex = (tex_handle_t){0, 0};
+    snap_write(b, &spr, sizeof(spr));
+
+    const char* path = asset_texture_valid(cmp_spr[i].tex) ? asset_texture_path(cmp_spr[i].tex) : NULL;
+    uint16_t len = path ? (uint16_t)strlen(path) : 0;
+    SNAP_WRITE_VAL(b, len);
+    snap_write(b, path, len);
+}
+
+static bool read_sprite(snap_reader_t* r, int i)
+{
+    char path[512];
+    uint16_t len = 0;
+    if (!snap_read(r, &cmp_spr[i], sizeof(cmp_spr[i])) || !SNAP_READ_VAL(r, len)) return false;
+    if (len >= sizeof(path) || !snap_read(r, path, len)) {
+        r->failed = true;
+        return false;
+    }
+    path[len] = '\0';
+    // Acquire before the old handles are released so shared textures never hit zero refs.
+    cmp_spr[i].tex = len ? asset_acquire_texture(path) : (tex_handle_t){0, 0};
+    return true;
+}
+
+static void write_anim(snap_buf_t* b, int i)
+{
+    const cmp_anim_t* a = &cmp_anim[i];
+    // memset/memcpy rather than an initializer so padding is deterministic; save games
+    // checksum and delta these bytes.
+    snap_anim_t s;
+    memset(&s, 0, sizeof(s));
+    memcpy(&s.anim, a, sizeof(s.anim));
+    s.frames_per_anim = ecs_anim_arena_offset(a->frames_per_anim);
+    s.anim_offsets = ecs_anim_arena_offset(a->anim_offsets);
+    s.frames = ecs_anim_arena_offset(a->frames);
+    s.anim.frames_per_anim = NULL;
+    s.anim.anim_offsets = NULL;
+    s.anim.frames = NULL;
+    SNAP_WRITE_VAL(b, s);
+}
+
+static bool read_anim(snap_reader_t* r, int i)
+{
+    snap_anim_t s;
+    if (!SNAP_READ_VAL(r, s)) return false;
+    cmp_anim[i] = s.anim;
+    cmp_anim[i].frames_per_anim = (const int*)ecs_anim_arena_ptr(s.frames_per_anim);
+    cmp_anim[i].anim_offsets = (const int*)ecs_anim_arena_ptr(s.anim_offsets);
+    cmp_anim[i].frames = (const anim_frame_coord_t*)ecs_anim_arena_ptr(s.frames);
+    return true;
+}
+
+void ecs_snapshot_write(snap_buf_t* b)
+{
+    snap_write_tag(b, SNAP_TAG('E','C','S','0'));
+    SNAP_WRITE_VAL(b, ecs_mask);
+    SNAP_WRITE_VAL(b, ecs_gen);
+    SNAP_WRITE_VAL(b, ecs_next_gen);
+    ecs_core_snapshot_write(b);
+    ecs_anim_snapshot_write(b);
+
+    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
+        if (!ecs_alive_idx(i)) continue;
+        const uint32_t mask = ecs_mask[i];
+        for (size_t k = 0; k < sizeof(k_arrays) / sizeof(k_arrays[0]); ++k) {
+            const snap_cmp_array_t* arr = &k_arrays[k];
+            if (arr->mask_bit && !(mask & arr->mask_bit)) continue;
+            snap_write(b, (const uint8_t*)arr->base + (size_t)i * arr->stride, arr->stride);
+        }
+        if (mask & CMP_ANIM) write_anim(b, i);
+        if (mask & CMP_SPR) write_sprite(b, i);
+    }
+
+    ecs_game_snapshot_write(b);
+    ecs_proximity_snapshot_write(b);
+}
+
+bool ecs_snapshot_read(snap_reader_t* r)
+{
+    if (!snap_expect_tag(r, SNAP_TAG('E','C','S','0'))) return false;
+
+    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
+        const bool has_tex = ecs_alive_idx(i) && (ecs_mask[i] & CMP_SPR);
+        g_old_tex[i] = has_tex ? cmp_spr[i].tex : (tex_handle_t){0, 0};
+    }
+
+    bool ok = SNAP_READ_VAL(r, ecs_mask) && SNAP_READ_VAL(r, ecs_gen) && SNAP_READ_VAL(r, ecs_next_gen);
+    ok = ok && ecs_core_snapshot_read(r) && ecs_anim_snapshot_read(r);
+
+    for (size_t k = 0; k < sizeof(k_arrays) / sizeof(k_arrays[0]); ++k) {
+        memset(k_arrays[k].base, 0, (size_t)ECS_MAX_ENTITIES * k_arrays[k].stride);
+    }
+    memset(cmp_anim, 0, sizeof(cmp_anim));
+    memset(cmp_spr, 0, sizeof(cmp_spr));
+
+    for (int i = 0; ok && i < ECS_MAX_ENTITIES; ++i) {
+        if (!ecs_alive_idx(i)) continue;
+        const uint32_t mask = ecs_mask[i];
+        for (size_t k = 0; ok && k < sizeof(k_arrays) / sizeof(k_arrays[0]); ++k) {
+            const snap_cmp_array_t* arr = &k_arrays[k];
+            if (arr->mask_bit && !(mask & arr->mask_bit)) continue;
+            ok = snap_read(r, (uint8_t*)arr->base + (size_t)i * arr->stride, arr->stride);
+        }
+        if (ok && (mask & CMP_ANIM)) ok = read_anim(r, i);
+        if (ok && (mask & CMP_SPR)) ok = read_sprite(r, i);
+    }
+
+    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
+        if (asset_texture_valid(g_old_tex[i])) asset_release_texture(g_old_tex[i]);
+    }
+
+    ok = ok && ecs_game_snapshot_read(r) && ecs_proximity_snapshot_read(r);
+    if (!ok) {
+        LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "snapshot: ECS section is truncated or malformed");
+    }
+    return ok;
+}
@@ -0,0 +1,35 @@
+#include "modules/ecs/ecs_internal.h"
+#include "modules/ecs/ecs_prefab_loading.h"
+#include "modules/core/camera.h"
+#include "modules/systems/systems_registration.h"
+#include "modules/world/world_renderer.h"
+#include "modules/world/world_stream.h"
+
+// Chunk activity from the world stream pages map-spawned entities in and out.
+static void on_stream_chunk(void* user, int tx0, int ty0, int tx1, int ty1, bool active)
+{
+    (void)user;
+    const world_map_t* map = world_get_map();
+    if (!map) return;
+    const float tw = (float)map->tilewidth;
+    const float th = (float)map->tileheight;
+    ecs_prefab_stream_rect(map, (float)tx0 * tw, (float)ty0 * th, (float)tx1 * tw, (float)ty1 * th, active);
+}
+
+// Streams around the player (the camera follows it); the camera only stands in when there is no
+// player, so which chunks are active never depends on render timing.
+static void sys_world_stream(void)
+{
+    if (!world_stream_active()) return;
+
+    v2f focus;
+    const int idx = ent_index_checked(ecs_find_player());
+    if (idx >= 0 && (ecs_mask[idx] & CMP_POS)) {
+        focus = v2f_make(cmp_pos[idx].x, cmp_pos[idx].y);
+    } else {
+        focus = camera_get_view().center;
+    }
+    world_stream_update(&focus, 1, on_stream_chunk, NULL);
+}
+
+SYSTEMS_ADAPT_VOID(sys_world_stream_adapt, sys_world_stream)
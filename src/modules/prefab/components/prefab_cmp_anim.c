@@ -1,12 +1,15 @@
 #include "modules/prefab/prefab_cmp.h"
+#include "modules/common/mem_tag.h"
 #include <stdlib.h>
 #include <string.h>
 
 void prefab_cmp_anim_free(prefab_cmp_anim_t* anim)
 {
     if (!anim) return;
-    free(anim->frames_per_anim);
-    free(anim->frames);
+    const size_t anims = anim->anim_count > 0 ? (size_t)anim->anim_count : 0;
+    const size_t width = anim->frame_buffer_width > 0 ? (size_t)anim->frame_buffer_width : 0;
+    mem_free(MEM_TAG_PREFAB, anim->frames_per_anim, anims * sizeof(int));
+    mem_free(MEM_TAG_PREFAB, anim->frames, anims * width * sizeof(anim_frame_coord_t));
     memset(anim, 0, sizeof(*anim));
 }
 
@@ -38,7 +41,7 @@ bool prefab_cmp_anim_build(const prefab_component_t* comp, const tiled_object_t*
         return true;
     }
 
-    int* counts = (int*)malloc((size_t)anim_count * sizeof(int));
+    int* counts = (int*)mem_alloc(MEM_TAG_PREFAB, (size_t)anim_count * sizeof(int));
     if (!counts) return false;
     out_anim->frames_per_anim = counts;
 
@@ -55,7 +58,7 @@ bool prefab_cmp_anim_build(const prefab_component_t* comp, const tiled_object_t*
 
     size_t total_slots = (size_t)anim_count * (size_t)max_frames;
     if (total_slots > 0) {
-        anim_frame_coord_t* frames = (anim_frame_coord_t*)malloc(total_slots * sizeof(anim_frame_coord_t));
+        anim_frame_coord_t* frames = (anim_frame_coord_t*)mem_alloc(MEM_TAG_PREFAB, total_slots * sizeof(anim_frame_coord_t));
         if (!frames) {
             prefab_cmp_anim_free(out_anim);
             return false;
@@ -1,3 +1,4 @@
+#define DA_MEM_TAG MEM_TAG_PREFAB
 #include "modules/prefab/prefab_cmp.h"
 
 #include "modules/core/logger.h"
@@ -1,6 +1,7 @@
 #include "modules/prefab/prefab.h"
 #include "modules/ecs/components_meta.h"
 #include "modules/core/logger.h"
+#include "modules/common/mem_tag.h"
 #include "xml.h"
 
 #include <ctype.h>
@@ -134,7 +135,7 @@ static void add_prop(prefab_component_t* comp, char* name, char* value) {
         return;
     }
     size_t idx = comp->prop_count;
-    prefab_kv_t* tmp = (prefab_kv_t*)realloc(comp->props, (idx + 1) * sizeof(prefab_kv_t));
+    prefab_kv_t* tmp = (prefab_kv_t*)mem_realloc(MEM_TAG_PREFAB, comp->props, idx * sizeof(prefab_kv_t), (idx + 1) * sizeof(prefab_kv_t));
     if (!tmp) {
         free(name);
         free(value);
@@ -143,6 +144,7 @@ static void add_prop(prefab_component_t* comp, char* name, char* value) {
     comp->props = tmp;
     comp->props[idx].name = name;
     comp->props[idx].value = value ? value : pf_xstrdup("");
+    comp->props[idx].atom = atom_intern_ci(name);
     comp->prop_count = idx + 1;
 }
 
@@ -160,7 +162,7 @@ static bool parse_anim_sequence(struct xml_node* anim_node, prefab_anim_def_t* d
     }
 
     if (frame_count > 0) {
-        seq.frames = (anim_frame_coord_t*)malloc(frame_count * sizeof(anim_frame_coord_t));
+        seq.frames = (anim_frame_coord_t*)mem_alloc(MEM_TAG_PREFAB, frame_count * sizeof(anim_frame_coord_t));
         if (!seq.frames) {
             free(seq.name);
             return false;
@@ -180,9 +182,11 @@ static bool parse_anim_sequence(struct xml_node* anim_node, prefab_anim_def_t* d
     }
     seq.frame_count = fi;
 
-    prefab_anim_seq_t* dst = (prefab_anim_seq_t*)realloc(def->seqs, (def->seq_count + 1) * sizeof(prefab_anim_seq_t));
+    prefab_anim_seq_t* dst = (prefab_anim_seq_t*)mem_realloc(MEM_TAG_PREFAB, def->seqs,
+                                                             def->seq_count * sizeof(prefab_anim_seq_t),
+                                                             (def->seq_count + 1) * sizeof(prefab_anim_seq_t));
     if (!dst) {
-        free(seq.frames);
+        mem_free(MEM_TAG_PREFAB, seq.frames, seq.frame_count * sizeof(anim_frame_coord_t));
         free(seq.name);
         return false;
     }
@@ -194,7 +198,7 @@ static bool parse_anim_sequence(struct xml_node* anim_node, prefab_anim_def_t* d
 // Parse an animation component from an XML node
 static bool parse_anim_component(struct xml_node* node, prefab_component_t* out) {
     if (!out) return false;
-    prefab_anim_def_t* def = (prefab_anim_def_t*)calloc(1, sizeof(prefab_anim_def_t));
+    prefab_anim_def_t* def = (prefab_anim_def_t*)mem_calloc(MEM_TAG_PREFAB, 1, sizeof(prefab_anim_def_t));
     if (!def) return false;
     def->frame_w = 0;
     def->frame_h = 0;
@@ -212,8 +216,7 @@ static bool parse_anim_component(struct xml_node* node, prefab_component_t* out)
         struct xml_node* child = xml_node_child(node, i);
         if (node_name_is_local(child, "anim")) {
             if (!parse_anim_sequence(child, def)) {
-                free(def->seqs);
-                free(def);
+                out->anim = def; // free_component releases the sequences parsed so far
                 return false;
             }
         }
@@ -290,14 +293,14 @@ static void free_component(prefab_component_t* c) {
         free(c->props[p].name);
         free(c->props[p].value);
     }
-    free(c->props);
+    mem_free(MEM_TAG_PREFAB, c->props, c->prop_count * sizeof(prefab_kv_t));
     if (c->anim) {
         for (size_t a = 0; a < c->anim->seq_count; ++a) {
             free(c->anim->seqs[a].name);
-            free(c->anim->seqs[a].frames);
+            mem_free(MEM_TAG_PREFAB, c->anim->seqs[a].frames, c->anim->seqs[a].frame_count * sizeof(anim_frame_coord_t));
         }
-        free(c->anim->seqs);
-        free(c->anim);
+        mem_free(MEM_TAG_PREFAB, c->anim->seqs, c->anim->seq_count * sizeof(prefab_anim_seq_t));
+        mem_free(MEM_TAG_PREFAB, c->anim, sizeof(prefab_anim_def_t));
     }
     // dono why i have to do this
     *c = (prefab_component_t){0};
@@ -333,7 +336,9 @@ bool prefab_load(const char* path, prefab_t* out_prefab) {
             prefab_free(out_prefab);
             return false;
         }
-        prefab_component_t* tmp = (prefab_component_t*)realloc(out_prefab->components, (out_prefab->component_count + 1) * sizeof(prefab_component_t));
+        prefab_component_t* tmp = (prefab_component_t*)mem_realloc(MEM_TAG_PREFAB, out_prefab->components,
+                                                                   out_prefab->component_count * sizeof(prefab_component_t),
+                                                                   (out_prefab->component_count + 1) * sizeof(prefab_component_t));
         if (!tmp) {
             free_component(&comp);
             prefab_free(out_prefab);
@@ -358,6 +363,6 @@ void prefab_free(prefab_t* prefab) {
             free_component(&prefab->components[i]);
         }
     }
-    free(prefab->components);
+    mem_free(MEM_TAG_PREFAB, prefab->components, prefab->component_count * sizeof(prefab_component_t));
     *prefab = (prefab_t){0};
 }
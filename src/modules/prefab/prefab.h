@@ -3,10 +3,12 @@
 #include <stddef.h>
 #include <stdbool.h>
 #include "modules/ecs/ecs.h"
+#include "modules/common/atom.h"
 
 typedef struct {
     char* name;
     char* value;
+    atom_t atom; // atom_intern_ci(name)
 } prefab_kv_t;
 
 typedef struct {
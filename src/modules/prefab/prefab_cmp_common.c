@@ -76,9 +76,12 @@ facing_t prefab_parse_facing(const char* s, facing_t fallback)
 const char* prefab_find_prop(const prefab_component_t* comp, const char* field)
 {
     if (!comp || !field) return NULL;
+    const atom_t a = atom_find_ci(field);
     for (size_t i = 0; i < comp->prop_count; ++i) {
-        if (comp->props[i].name && strcasecmp(comp->props[i].name, field) == 0) {
-            return comp->props[i].value;
+        const prefab_kv_t* kv = &comp->props[i];
+        // Loaded props are interned; ones built in code may only have a name.
+        if (kv->atom != ATOM_NONE ? kv->atom == a : (kv->name && strcasecmp(kv->name, field) == 0)) {
+            return kv->value;
         }
     }
     return NULL;
@@ -87,14 +90,7 @@ const char* prefab_find_prop(const prefab_component_t* comp, const char* field)
 // Gets an overridden property value from a tiled object, considering the prefab component's type name.
 const char* prefab_override_value(const prefab_component_t* comp, const tiled_object_t* obj, const char* field)
 {
-    if (!obj || !field) return NULL;
-    char key[128];
-    if (comp && comp->type_name) {
-        snprintf(key, sizeof(key), "%s.%s", comp->type_name, field);
-        const char* v = tiled_object_get_property_value(obj, key);
-        if (v) return v;
-    }
-    return tiled_object_get_property_value(obj, field);
+    return tiled_object_get_scoped_value(obj, comp ? comp->type_name : NULL, field);
 }
 
 // Gets the combined property value, checking for overrides in the tiled object first.
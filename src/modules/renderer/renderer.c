@@ -1,3 +1,4 @@
+#define DA_MEM_TAG MEM_TAG_RENDER
 #include "modules/renderer/renderer.h"
 #include "modules/renderer/renderer_internal.h"
 #include "modules/core/logger.h"
@@ -42,6 +43,14 @@ bool renderer_bind_world_map(void)
         LOGC(LOGCAT_REND, LOG_LVL_ERROR, "tiled: renderer init failed (world map)");
         return false;
     }
+    tmx_object_index_t new_object_index = {0};
+    tile_anim_table_t new_tile_anims = {0};
+    if (!tmx_object_index_build(&new_object_index, map) || !tile_anim_table_build(&new_tile_anims, map)) {
+        LOGC(LOGCAT_REND, LOG_LVL_ERROR, "tiled: out of memory for the object index / tile animation table");
+        tmx_object_index_free(&new_object_index);
+        tiled_renderer_shutdown(&new_tiled_renderer);
+        return false;
+    }
 
     int world_w = 0, world_h = 0;
     world_size_tiles(&world_w, &world_h);
@@ -55,6 +64,8 @@ bool renderer_bind_world_map(void)
 
     renderer_unload_tiled_map();
     ctx->tiled = new_tiled_renderer;
+    ctx->object_index = new_object_index;
+    ctx->tile_anims = new_tile_anims;
     ctx->bound_gen = world_map_generation();
 
     LOGC(LOGCAT_REND, LOG_LVL_INFO, "tiled: bound world map (%dx%d @ %dx%d)", map->width, map->height, map->tilewidth, map->tileheight);
@@ -66,6 +77,8 @@ void renderer_unload_tiled_map(void)
     renderer_ctx_t* ctx = renderer_ctx_get();
     if (ctx->bound_gen == 0) return;
     tiled_renderer_shutdown(&ctx->tiled);
+    tmx_object_index_free(&ctx->object_index);
+    tile_anim_table_free(&ctx->tile_anims);
     ctx->bound_gen = 0;
 }
 
@@ -15,10 +15,12 @@ bool renderer_toggle_phys_colliders(void);
 bool renderer_toggle_static_colliders(void);
 bool renderer_toggle_triggers(void);
 bool renderer_toggle_fps_overlay(void);
+bool renderer_toggle_profiler_overlay(void);
 #else
 static inline bool renderer_toggle_ecs_colliders(void){ return false; }
 static inline bool renderer_toggle_phys_colliders(void){ return false; }
 static inline bool renderer_toggle_static_colliders(void){ return false; }
 static inline bool renderer_toggle_triggers(void){ return false; }
 static inline bool renderer_toggle_fps_overlay(void){ return false; }
+static inline bool renderer_toggle_profiler_overlay(void){ return false; }
 #endif
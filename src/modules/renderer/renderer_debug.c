@@ -1,7 +1,9 @@
 #include "modules/core/build_config.h"
+#include "modules/common/mem_tag.h"
 #include "modules/renderer/renderer.h"
 #include "modules/renderer/renderer_internal.h"
 #include "modules/world/world.h"
+#include "modules/systems/systems.h"
 
 #include <math.h>
 #include <stdio.h>
@@ -20,6 +22,7 @@ static bool g_draw_triggers = false;
 
 #if DEBUG_FPS
 static bool g_show_fps = false;
+static bool g_show_profiler = false;
 #endif
 
 #if DEBUG_COLLISION
@@ -62,8 +65,15 @@ bool renderer_toggle_fps_overlay(void)
     g_show_fps = !g_show_fps;
     return g_show_fps;
 }
+
+bool renderer_toggle_profiler_overlay(void)
+{
+    g_show_profiler = !g_show_profiler;
+    return g_show_profiler;
+}
 #else
 bool renderer_toggle_fps_overlay(void) { return false; }
+bool renderer_toggle_profiler_overlay(void) { return false; }
 #endif
 
 #endif
@@ -219,10 +229,62 @@ void draw_debug_trigger_overlays(const render_view_t* view)
 #endif
 }
 
+#if DEBUG_BUILD && DEBUG_FPS
+static void draw_profiler_overlay(void)
+{
+    systems_profile_stats_t stats[SYSTEMS_PROFILE_MAX];
+    size_t n = systems_profile_stats(stats, SYSTEMS_PROFILE_MAX);
+
+    const int fs = 10;
+    const int row_h = fs + 2;
+    const int x = 8;
+    int y = 8;
+    DrawRectangle(x - 4, y - 4, 360, (int)(n + 1) * row_h + 8, (Color){0,0,0,160});
+    DrawText("system                 min   mean    p99    max (ms)", x, y, fs, RAYWHITE);
+    y += row_h;
+
+    char buf[96];
+    for (size_t i = 0; i < n; ++i) {
+        snprintf(buf, sizeof(buf), "%-20.20s %6.3f %6.3f %6.3f %6.3f",
+                 stats[i].name, stats[i].min_ms, stats[i].mean_ms, stats[i].p99_ms, stats[i].max_ms);
+        // Flag systems whose tail eats over a quarter of a 60 Hz frame.
+        DrawText(buf, x, y, fs, stats[i].p99_ms > 4.0f ? ORANGE : RAYWHITE);
+        y += row_h;
+    }
+}
+
+// Per-subsystem heap accounting (modules/common/mem_tag.h), top right next to the profiler.
+static void draw_memory_overlay(void)
+{
+    const int fs = 10;
+    const int row_h = fs + 2;
+    const int w = 280;
+    const int x = GetScreenWidth() - w;
+    int y = 8;
+    DrawRectangle(x - 4, y - 4, w, (MEM_TAG_COUNT + 1) * row_h + 8, (Color){0,0,0,160});
+    DrawText("memory      live KB   peak KB    blocks", x, y, fs, RAYWHITE);
+    y += row_h;
+
+    char buf[96];
+    for (int t = 0; t < MEM_TAG_COUNT; ++t) {
+        mem_tag_stats_t st;
+        mem_tag_stats((mem_tag_t)t, &st);
+        snprintf(buf, sizeof(buf), "%-8s %10.1f %9.1f %9llu", mem_tag_name((mem_tag_t)t),
+                 st.live_bytes / 1024.0, st.peak_bytes / 1024.0, (unsigned long long)st.live_blocks);
+        DrawText(buf, x, y, fs, RAYWHITE);
+        y += row_h;
+    }
+}
+#endif
+
 void renderer_debug_draw_ui(const render_view_t* view)
 {
 #if DEBUG_BUILD && DEBUG_FPS
     (void)view;
+    if (g_show_profiler) {
+        draw_profiler_overlay();
+        draw_memory_overlay();
+    }
     if (!g_show_fps) return;
 
     int fps = GetFPS();
@@ -39,8 +39,45 @@ typedef struct {
     double now_ms;
 } render_world_cache_t;
 
+// Static culling index for the TMX object layers, built when a map is bound. Entity-layer and
+// gid-less objects are dropped up front; the rest are grouped by layer_z and bucketed on a
+// coarse grid by the top-left corner of their drawn rect, so a frame only visits nearby cells.
+typedef struct {
+    int       z;
+    float     max_w, max_h; // largest drawn size in the group; queries widen by this
+    uint32_t* cell_start;   // cell_count + 1 offsets into items
+    uint32_t* items;        // indices into map->objects, ascending within each cell
+    size_t    item_count;
+} tmx_object_group_t;
+
+typedef struct {
+    tmx_object_group_t* groups; // ascending z
+    size_t group_count;
+    int    cols, rows;
+    size_t cell_count;
+    float  cell_w, cell_h;
+    DA(uint32_t) visible;       // per-draw scratch
+} tmx_object_index_t;
+
+// Tile to draw right now for every tile of every tileset, refreshed once per frame (only the
+// animated ids change), so drawing a tile is one indexed read instead of a frame search.
+typedef struct {
+    int*      frame_of;    // tile_count entries, indexed by local tile id
+    uint32_t* animated;    // local ids that have an animation
+    size_t    animated_count;
+    size_t    tile_count;
+} tile_anim_lut_t;
+
+typedef struct {
+    tile_anim_lut_t* tilesets; // matches map->tilesets ordering
+    size_t count;
+    double now_ms;             // time the frames were last refreshed for
+} tile_anim_table_t;
+
 typedef struct {
     tiled_renderer_t tiled;
+    tmx_object_index_t object_index;
+    tile_anim_table_t tile_anims;
     uint32_t bound_gen;
     ItemArray painter_items;
     render_view_t frame_view;
@@ -76,6 +113,10 @@ void draw_tmx_stack(const world_map_t* map,
                     double now_ms,
                     painter_queue_ctx_t* painter_ctx);
 void draw_world_fallback_tiles(const render_view_t* view);
+bool tmx_object_index_build(tmx_object_index_t* idx, const world_map_t* map);
+void tmx_object_index_free(tmx_object_index_t* idx);
+bool tile_anim_table_build(tile_anim_table_t* t, const world_map_t* map);
+void tile_anim_table_free(tile_anim_table_t* t);
 void enqueue_ecs_sprites(const render_view_t* view, painter_queue_ctx_t* painter_ctx);
 void flush_painter_queue(painter_queue_ctx_t* painter_ctx);
 void renderer_painter_prepare(renderer_ctx_t* ctx, int max_items);
@@ -1,6 +1,9 @@
+#define DA_MEM_TAG MEM_TAG_RENDER
 #include "modules/renderer/renderer_internal.h"
 #include "modules/asset/asset_renderer_internal.h"
 #include "modules/core/logger.h"
+#include "modules/core/metrics.h"
+#include "modules/core/trace.h"
 
 #include <math.h>
 #include <stdlib.h>
@@ -75,8 +78,12 @@ static int cmp_item(const void* a, const void* b)
 void flush_painter_queue(painter_queue_ctx_t* painter_ctx)
 {
     if (!painter_ctx || !painter_ctx->queue) return;
+    TRACE_BEGIN("flush_painter_queue");
     if (painter_ctx->dropped > 0) {
-        LOGC(LOGCAT_REND, LOG_LVL_WARN, "painter queue overflow; dropped %d items", painter_ctx->dropped);
+        static metric_t* m_dropped;
+        if (!m_dropped) m_dropped = metrics_counter("renderer_painter_items_dropped_total", "Sprites dropped by a full painter queue", NULL);
+        metrics_add(m_dropped, (uint64_t)painter_ctx->dropped);
+        LOGC_LIMITED(LOGCAT_REND, LOG_LVL_WARN, "painter queue overflow; dropped %d items", painter_ctx->dropped);
     }
 
     qsort(painter_ctx->queue->data, painter_ctx->queue->size, sizeof(Item), cmp_item);
@@ -96,4 +103,5 @@ void flush_painter_queue(painter_queue_ctx_t* painter_ctx)
             draw_sprite_highlight(t, src, dst, origin, v.highlight_color);
         }
     }
+    TRACE_END();
 }
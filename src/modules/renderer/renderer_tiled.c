@@ -1,5 +1,6 @@
 #include "modules/tiled/tiled.h"
 #include "modules/asset/asset.h"
+#include "modules/common/mem_tag.h"
 
 #include <stdlib.h>
 
@@ -7,7 +8,7 @@ bool tiled_renderer_init(tiled_renderer_t *r, const world_map_t *map) {
     if (!r || !map || map->tileset_count == 0) return false;
     *r = (tiled_renderer_t){0};
     r->texture_count = map->tileset_count;
-    r->tilesets = (tex_handle_t *)calloc(r->texture_count, sizeof(tex_handle_t));
+    r->tilesets = (tex_handle_t *)mem_calloc(MEM_TAG_RENDER, r->texture_count, sizeof(tex_handle_t));
     if (!r->tilesets) return false;
 
     for (size_t i = 0; i < map->tileset_count; ++i) {
@@ -34,6 +35,6 @@ void tiled_renderer_shutdown(tiled_renderer_t *r) {
             }
         }
     }
-    free(r->tilesets);
+    mem_free(MEM_TAG_RENDER, r->tilesets, r->texture_count * sizeof(tex_handle_t));
     *r = (tiled_renderer_t){0};
 }
@@ -1,13 +1,18 @@
+#define DA_MEM_TAG MEM_TAG_RENDER
 #include "modules/renderer/renderer_internal.h"
 #include "modules/asset/asset_renderer_internal.h"
+#include "modules/core/logger.h"
 #include "modules/world/world.h"
 
 #include <limits.h>
 #include <math.h>
+#include <stdlib.h>
 #include <string.h>
 
 static const char* ENTITY_LAYER_NAME = "entities"; // TMX object layer used to spawn ECS entities (not rendered directly)
 
+#define OBJECT_CELL_TILES 8 // object index cell edge, in map tiles
+
 bool visible_tile_range(const world_map_t* map,
                         Rectangle padded_view,
                         int* out_startX, int* out_startY,
@@ -80,30 +85,89 @@ static const tiled_tileset_t* tileset_for_gid(const world_map_t* map, uint32_t g
     return ts;
 }
 
-static int animated_tile_index(const tiled_tileset_t *ts, int base_index, double now_ms)
+static size_t tileset_tile_count(const tiled_tileset_t* ts)
+{
+    return ts->tilecount > 0 ? (size_t)ts->tilecount : 0;
+}
+
+void tile_anim_table_free(tile_anim_table_t* t)
+{
+    if (!t) return;
+    for (size_t i = 0; i < t->count; ++i) {
+        tile_anim_lut_t* lut = &t->tilesets[i];
+        mem_free(MEM_TAG_RENDER, lut->frame_of, lut->tile_count * sizeof(int));
+        mem_free(MEM_TAG_RENDER, lut->animated, lut->animated_count * sizeof(uint32_t));
+    }
+    mem_free(MEM_TAG_RENDER, t->tilesets, t->count * sizeof(tile_anim_lut_t));
+    *t = (tile_anim_table_t){0};
+}
+
+bool tile_anim_table_build(tile_anim_table_t* t, const world_map_t* map)
+{
+    if (!t) return false;
+    tile_anim_table_free(t);
+    if (!map || map->tileset_count == 0) return true;
+
+    t->tilesets = (tile_anim_lut_t*)mem_calloc(MEM_TAG_RENDER, map->tileset_count, sizeof(tile_anim_lut_t));
+    if (!t->tilesets) return false;
+    t->count = map->tileset_count;
+    t->now_ms = -1.0; // forces the first refresh
+
+    for (size_t i = 0; i < map->tileset_count; ++i) {
+        const tiled_tileset_t* ts = &map->tilesets[i];
+        tile_anim_lut_t* lut = &t->tilesets[i];
+        const size_t n = tileset_tile_count(ts);
+        size_t animated = 0;
+        for (size_t id = 0; ts->anims && id < n; ++id) {
+            if (ts->anims[id].frame_count > 0 && ts->anims[id].total_duration_ms > 0) animated++;
+        }
+        if (animated == 0) continue; // nothing to remap; lookups fall through to the base id
+
+        lut->frame_of = (int*)mem_alloc(MEM_TAG_RENDER, n * sizeof(int));
+        lut->animated = (uint32_t*)mem_alloc(MEM_TAG_RENDER, animated * sizeof(uint32_t));
+        lut->tile_count = n;
+        lut->animated_count = animated;
+        if (!lut->frame_of || !lut->animated) {
+            tile_anim_table_free(t);
+            return false;
+        }
+        size_t k = 0;
+        for (size_t id = 0; id < n; ++id) {
+            lut->frame_of[id] = (int)id;
+            if (ts->anims[id].frame_count > 0 && ts->anims[id].total_duration_ms > 0) lut->animated[k++] = (uint32_t)id;
+        }
+    }
+    return true;
+}
+
+// The per-frame pass: one frame search per animated tile id, however many times it is drawn.
+static void tile_anim_table_update(tile_anim_table_t* t, const world_map_t* map, double now_ms)
 {
-    if (!ts || !ts->anims || base_index < 0 || base_index >= ts->tilecount) return base_index;
-    tiled_animation_t *anim = &ts->anims[base_index];
-    if (!anim || anim->frame_count == 0 || anim->total_duration_ms <= 0) return base_index;
-
-    double mod = fmod(now_ms, (double)anim->total_duration_ms);
-    int acc = 0;
-    for (size_t i = 0; i < anim->frame_count; ++i) {
-        acc += anim->frames[i].duration_ms;
-        if (mod < (double)acc) {
-            int idx = anim->frames[i].tile_id;
-            if (idx >= 0 && idx < ts->tilecount) return idx;
-            break;
+    if (!t || !map || t->now_ms == now_ms || t->count != map->tileset_count) return;
+    t->now_ms = now_ms;
+    for (size_t i = 0; i < t->count; ++i) {
+        const tiled_tileset_t* ts = &map->tilesets[i];
+        tile_anim_lut_t* lut = &t->tilesets[i];
+        for (size_t k = 0; k < lut->animated_count; ++k) {
+            const uint32_t id = lut->animated[k];
+            const tiled_animation_t* anim = &ts->anims[id];
+            const int tile = anim->frames[tiled_anim_frame_at(anim, fmod(now_ms, (double)anim->total_duration_ms))].tile_id;
+            lut->frame_of[id] = (tile >= 0 && tile < ts->tilecount) ? tile : (int)id;
         }
     }
-    return base_index;
+}
+
+static int animated_tile_index(const tile_anim_table_t* anims, size_t ts_idx, int base_index)
+{
+    if (!anims || ts_idx >= anims->count || base_index < 0) return base_index;
+    const tile_anim_lut_t* lut = &anims->tilesets[ts_idx];
+    return ((size_t)base_index < lut->tile_count) ? lut->frame_of[base_index] : base_index;
 }
 
 static bool resolve_gid_draw(const world_map_t* map,
                              const tiled_renderer_t* tr,
                              uint32_t raw_gid,
-                             bool allow_animation,
-                             double now_ms,
+                             const tile_anim_table_t* anims,
                              resolved_gid_t* out,
                              bool* out_flip_h,
                              bool* out_flip_v)
@@ -127,7 +191,7 @@ static bool resolve_gid_draw(const world_map_t* map,
     int local = (int)gid - ts->first_gid;
     if (local < 0 || local >= ts->tilecount) return false;
 
-    int draw_index = allow_animation ? animated_tile_index(ts, local, now_ms) : local;
+    int draw_index = anims ? animated_tile_index(anims, ts_idx, local) : local;
     int columns = ts->columns > 0 ? ts->columns : 1;
 
     int sx = (draw_index % columns) * ts->tilewidth;
@@ -182,11 +246,12 @@ static void draw_tile_layer(const world_map_t* map,
                             const tiled_renderer_t* tr,
                             const tiled_layer_t* layer,
                             int startX, int startY, int endX, int endY,
-                            double now_ms,
+                            const tile_anim_table_t* anims,
                             painter_queue_ctx_t* painter_ctx)
 {
     if (!map || !tr || !layer) return;
-    if (!layer->gids || layer->width <= 0 || layer->height <= 0) return;
+    if (layer->width <= 0 || layer->height <= 0) return;
+    const int layer_idx = (int)(layer - map->layers); // streamed layers have no gids; read resident chunks
     int tw = map->tilewidth;
     int th = map->tileheight;
     if (startX < 0) startX = 0;
@@ -199,9 +264,9 @@ static void draw_tile_layer(const world_map_t* map,
         size_t row_start = (size_t)y * (size_t)layer->width;
         for (int x = startX; x < endX; ++x) {
             size_t idx = row_start + (size_t)x;
-            uint32_t raw_gid = layer->gids[idx];
+            uint32_t raw_gid = layer->gids ? layer->gids[idx] : world_layer_gid(layer_idx, x, y);
             resolved_gid_t r;
-            if (!resolve_gid_draw(map, tr, raw_gid, true, now_ms, &r, NULL, NULL)) continue;
+            if (!resolve_gid_draw(map, tr, raw_gid, anims, &r, NULL, NULL)) continue;
 
             Rectangle dst = { (float)(x * tw), (float)(y * th), (float)tw, (float)th };
 
@@ -217,25 +282,178 @@ static void draw_tile_layer(const world_map_t* map,
     }
 }
 
-static size_t draw_object_layer_at_z(const world_map_t* map,
-                                     const tiled_renderer_t* tr,
-                                     const render_view_t* view,
-                                     painter_queue_ctx_t* painter_ctx,
-                                     size_t obj_start,
-                                     int target_z,
-                                     double now_ms)
+// Where an object is drawn, or false if it never is (entity layer, no gid, unknown tileset).
+// Must agree with the rect draw_object_group computes from the resolved tileset.
+static bool object_draw_rect(const world_map_t* map, const tiled_object_t* obj, Rectangle* out)
+{
+    if (obj->layer_name && strcmp(obj->layer_name, ENTITY_LAYER_NAME) == 0) return false;
+    if (obj->gid == 0) return false;
+    const uint32_t gid = tiled_gid_strip_flags((uint32_t)obj->gid, NULL, NULL, NULL);
+    const tiled_tileset_t* ts = tileset_for_gid(map, gid, NULL);
+    if (!ts) return false;
+    float w = (obj->w > 0.0f) ? obj->w : (float)ts->tilewidth;
+    float h = (obj->h > 0.0f) ? obj->h : (float)ts->tileheight;
+    *out = (Rectangle){ obj->x, obj->y - h, w, h }; // Tiled object y is bottom
+    return true;
+}
+
+// Clamped, so objects outside the map land in the edge cells and queries clamp the same way.
+static int object_cell_coord(float v, float cell, int n)
+{
+    if (!(v > 0.0f)) return 0;
+    const float c = v / cell;
+    return (c >= (float)(n - 1)) ? n - 1 : (int)c;
+}
+
+static size_t object_cell_of(const tmx_object_index_t* idx, Rectangle r)
+{
+    const int cx = object_cell_coord(r.x, idx->cell_w, idx->cols);
+    const int cy = object_cell_coord(r.y, idx->cell_h, idx->rows);
+    return (size_t)cy * (size_t)idx->cols + (size_t)cx;
+}
+
+void tmx_object_index_free(tmx_object_index_t* idx)
+{
+    if (!idx) return;
+    for (size_t g = 0; g < idx->group_count; ++g) {
+        tmx_object_group_t* grp = &idx->groups[g];
+        mem_free(MEM_TAG_RENDER, grp->cell_start, (idx->cell_count + 1) * sizeof(uint32_t));
+        mem_free(MEM_TAG_RENDER, grp->items, grp->item_count * sizeof(uint32_t));
+    }
+    mem_free(MEM_TAG_RENDER, idx->groups, idx->group_count * sizeof(tmx_object_group_t));
+    DA_FREE(&idx->visible);
+    *idx = (tmx_object_index_t){0};
+}
+
+static bool build_object_group(tmx_object_index_t* idx, tmx_object_group_t* grp, const world_map_t* map, size_t begin, size_t end)
+{
+    grp->cell_start = (uint32_t*)mem_calloc(MEM_TAG_RENDER, idx->cell_count + 1, sizeof(uint32_t));
+    grp->items = (uint32_t*)mem_alloc(MEM_TAG_RENDER, grp->item_count * sizeof(uint32_t));
+    if (!grp->cell_start || !grp->items) return false;
+
+    // Count into cell_start[c + 1], prefix-sum to starts, then fill using cell_start[c] as the
+    // cursor; that leaves each entry at the next cell's start, so shift back by one.
+    Rectangle r;
+    for (size_t i = begin; i < end; ++i) {
+        if (!object_draw_rect(map, &map->objects[i], &r)) continue;
+        grp->cell_start[object_cell_of(idx, r) + 1]++;
+        if (r.width > grp->max_w) grp->max_w = r.width;
+        if (r.height > grp->max_h) grp->max_h = r.height;
+    }
+    for (size_t c = 0; c < idx->cell_count; ++c) grp->cell_start[c + 1] += grp->cell_start[c];
+    for (size_t i = begin; i < end; ++i) {
+        if (!object_draw_rect(map, &map->objects[i], &r)) continue;
+        grp->items[grp->cell_start[object_cell_of(idx, r)]++] = (uint32_t)i;
+    }
+    memmove(grp->cell_start + 1, grp->cell_start, idx->cell_count * sizeof(uint32_t));
+    grp->cell_start[0] = 0;
+    return true;
+}
+
+static size_t object_run_end(const world_map_t* map, size_t begin)
+{
+    size_t end = begin + 1;
+    while (end < map->object_count && map->objects[end].layer_z == map->objects[begin].layer_z) end++;
+    return end;
+}
+
+static size_t object_run_drawn(const world_map_t* map, size_t begin, size_t end)
+{
+    size_t n = 0;
+    Rectangle r;
+    for (size_t i = begin; i < end; ++i) n += object_draw_rect(map, &map->objects[i], &r) ? 1u : 0u;
+    return n;
+}
+
+bool tmx_object_index_build(tmx_object_index_t* idx, const world_map_t* map)
+{
+    if (!idx) return false;
+    tmx_object_index_free(idx);
+    if (!map || map->object_count == 0) return true;
+
+    const int tw = map->tilewidth > 0 ? map->tilewidth : 1;
+    const int th = map->tileheight > 0 ? map->tileheight : 1;
+    idx->cell_w = (float)(tw * OBJECT_CELL_TILES);
+    idx->cell_h = (float)(th * OBJECT_CELL_TILES);
+    idx->cols = map->width > 0 ? (map->width + OBJECT_CELL_TILES - 1) / OBJECT_CELL_TILES : 1;
+    idx->rows = map->height > 0 ? (map->height + OBJECT_CELL_TILES - 1) / OBJECT_CELL_TILES : 1;
+    idx->cell_count = (size_t)idx->cols * (size_t)idx->rows;
+
+    // map->objects is in layer_z order, so each z is one contiguous run; runs with nothing to
+    // draw get no group.
+    size_t group_count = 0;
+    for (size_t begin = 0; begin < map->object_count;) {
+        const size_t end = object_run_end(map, begin);
+        if (object_run_drawn(map, begin, end) > 0) group_count++;
+        begin = end;
+    }
+    if (group_count == 0) return true;
+    idx->groups = (tmx_object_group_t*)mem_calloc(MEM_TAG_RENDER, group_count, sizeof(tmx_object_group_t));
+    if (!idx->groups) return false;
+    idx->group_count = group_count;
+
+    size_t g = 0, indexed = 0;
+    for (size_t begin = 0; begin < map->object_count;) {
+        const size_t end = object_run_end(map, begin);
+        const size_t drawn = object_run_drawn(map, begin, end);
+        if (drawn > 0) {
+            tmx_object_group_t* grp = &idx->groups[g++];
+            grp->z = map->objects[begin].layer_z;
+            grp->item_count = drawn;
+            if (!build_object_group(idx, grp, map, begin, end)) {
+                tmx_object_index_free(idx);
+                return false;
+            }
+            indexed += drawn;
+        }
+        begin = end;
+    }
+
+    LOGC(LOGCAT_REND, LOG_LVL_DEBUG, "tiled: indexed %zu of %zu objects in %zu layers (%dx%d cells)",
+         indexed, map->object_count, idx->group_count, idx->cols, idx->rows);
+    return true;
+}
+
+static int cmp_u32(const void* a, const void* b)
+{
+    const uint32_t x = *(const uint32_t*)a;
+    const uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+static void draw_object_group(const world_map_t* map,
+                              const tiled_renderer_t* tr,
+                              tmx_object_index_t* idx,
+                              const tmx_object_group_t* grp,
+                              const render_view_t* view,
+                              painter_queue_ctx_t* painter_ctx)
 {
-    if (!map || !tr || !view) return obj_start;
+    if (!map || !tr || !idx || !grp || !view) return;
+
+    // Objects are bucketed by top-left corner, so reach back by the group's largest size.
+    const Rectangle q = view->padded_view;
+    const int cx0 = object_cell_coord(q.x - grp->max_w, idx->cell_w, idx->cols);
+    const int cy0 = object_cell_coord(q.y - grp->max_h, idx->cell_h, idx->rows);
+    const int cx1 = object_cell_coord(q.x + q.width, idx->cell_w, idx->cols);
+    const int cy1 = object_cell_coord(q.y + q.height, idx->cell_h, idx->rows);
+
+    DA_CLEAR(&idx->visible);
+    for (int cy = cy0; cy <= cy1; ++cy) {
+        const size_t row = (size_t)cy * (size_t)idx->cols;
+        for (size_t c = row + (size_t)cx0; c <= row + (size_t)cx1; ++c) {
+            for (uint32_t k = grp->cell_start[c]; k < grp->cell_start[c + 1]; ++k) {
+                DA_APPEND(&idx->visible, grp->items[k]);
+            }
+        }
+    }
+    // Back to map order, which decides overlap for tiles drawn directly.
+    if (idx->visible.size > 1) qsort(idx->visible.data, idx->visible.size, sizeof(uint32_t), cmp_u32);
 
-    size_t i = obj_start;
-    for (; i < map->object_count; ++i) {
-        const tiled_object_t* obj = &map->objects[i];
-        if (obj->layer_z != target_z) break;
-        if (obj->layer_name && strcmp(obj->layer_name, ENTITY_LAYER_NAME) == 0) continue;
-        if (obj->gid == 0) continue;
+    for (size_t v = 0; v < idx->visible.size; ++v) {
+        const tiled_object_t* obj = &map->objects[idx->visible.data[v]];
 
         resolved_gid_t r;
-        if (!resolve_gid_draw(map, tr, (uint32_t)obj->gid, false, now_ms, &r, NULL, NULL)) continue;
+        if (!resolve_gid_draw(map, tr, (uint32_t)obj->gid, NULL, &r, NULL, NULL)) continue;
 
         float dst_w = (obj->w > 0.0f) ? obj->w : (float)r.ts->tilewidth;
         float dst_h = (obj->h > 0.0f) ? obj->h : (float)r.ts->tileheight;
@@ -252,7 +470,6 @@ static size_t draw_object_layer_at_z(const world_map_t* map,
         float key = dst.y + painter_off;
         draw_or_enqueue_resolved(&r, dst, key, painter_tile, painter_ctx);
     }
-    return i;
 }
 
 void draw_tmx_stack(const world_map_t* map,
@@ -265,24 +482,27 @@ void draw_tmx_stack(const world_map_t* map,
 
     renderer_ctx_t* ctx = renderer_ctx_get();
     const tiled_renderer_t* tr = &ctx->tiled;
+    tmx_object_index_t* objects = &ctx->object_index;
 
     size_t layer_i = 0;
-    size_t obj_i = 0;
+    size_t group_i = 0;
     if (!map) return;
-    while (layer_i < map->layer_count || obj_i < map->object_count) {
+    tile_anim_table_update(&ctx->tile_anims, map, now_ms);
+    while (layer_i < map->layer_count || group_i < objects->group_count) {
         int next_layer_z = (layer_i < map->layer_count) ? map->layers[layer_i].z_order : INT_MAX;
-        int next_obj_z   = (obj_i < map->object_count) ? map->objects[obj_i].layer_z : INT_MAX;
+        int next_obj_z   = (group_i < objects->group_count) ? objects->groups[group_i].z : INT_MAX;
         int z = (next_layer_z < next_obj_z) ? next_layer_z : next_obj_z;
 
         // Draw all tile layers at this z.
         while (layer_i < map->layer_count && map->layers[layer_i].z_order == z) {
-            draw_tile_layer(map, tr, &map->layers[layer_i], startX, startY, endX, endY, now_ms, painter_ctx);
+            draw_tile_layer(map, tr, &map->layers[layer_i], startX, startY, endX, endY, &ctx->tile_anims, painter_ctx);
             layer_i++;
         }
 
-        // Draw all objects at this z.
-        if (obj_i < map->object_count && map->objects[obj_i].layer_z == z) {
-            obj_i = draw_object_layer_at_z(map, tr, view, painter_ctx, obj_i, z, now_ms);
+        // Draw the visible objects at this z.
+        if (group_i < objects->group_count && objects->groups[group_i].z == z) {
+            draw_object_group(map, tr, objects, &objects->groups[group_i], view, painter_ctx);
+            group_i++;
         }
     }
 }
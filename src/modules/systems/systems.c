@@ -1,5 +1,11 @@
 #include "modules/systems/systems.h"
+#include "modules/core/frame_alloc.h"
 #include "modules/core/logger.h"
+#include "modules/core/metrics.h"
+#include "modules/core/time.h"
+#include "modules/core/trace.h"
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #ifndef ECS_MAX_SYSTEMS_PER_PHASE
@@ -14,18 +20,40 @@ typedef struct {
 
 static sys_rec_t g_systems[PHASE_COUNT][ECS_MAX_SYSTEMS_PER_PHASE];
 static size_t    g_counts[PHASE_COUNT];
+// Profile ring per record (-1 = pool full). Kept beside g_systems so systems_info_t stays a view of sys_rec_t.
+static int       g_prof_slot[PHASE_COUNT][ECS_MAX_SYSTEMS_PER_PHASE];
+
+// ---- profiler: last SYSTEMS_PROFILE_RING call timings per system ----
+typedef struct {
+    const char* name;
+    systems_phase_t phase;
+    float ms[SYSTEMS_PROFILE_RING];
+    int head;
+    int count;
+    double total_ms; // since the last reset, not just the ring
+    long   calls;
+    metric_t* hist;  // system_seconds{system="name"}
+} prof_ring_t;
+
+static prof_ring_t g_prof[SYSTEMS_PROFILE_MAX];
+static int         g_prof_count = 0;
+static bool        g_prof_enabled = true;
+static metric_t*   g_m_tick;
 
 static void sort_phase(systems_phase_t phase)
 {
     size_t n = g_counts[phase];
     for (size_t i = 1; i < n; ++i) {
         sys_rec_t key = g_systems[phase][i];
+        int key_slot = g_prof_slot[phase][i];
         size_t j = i;
         while (j > 0 && g_systems[phase][j-1].order > key.order) {
             g_systems[phase][j] = g_systems[phase][j-1];
+            g_prof_slot[phase][j] = g_prof_slot[phase][j-1];
             --j;
         }
         g_systems[phase][j] = key;
+        g_prof_slot[phase][j] = key_slot;
     }
 }
 
@@ -34,6 +62,8 @@ void systems_init(void)
     for (int p = 0; p < (int)PHASE_COUNT; ++p) {
         g_counts[p] = 0;
     }
+    g_prof_count = 0;
+    g_m_tick = metrics_histogram("engine_tick_seconds", "Time per simulation tick", NULL, NULL, 0);
 }
 
 void systems_register(systems_phase_t phase, int order, systems_fn fn, const char* name)
@@ -48,7 +78,17 @@ void systems_register(systems_phase_t phase, int order, systems_fn fn, const cha
         return;
     }
 
+    int slot = -1;
+    if (g_prof_count < SYSTEMS_PROFILE_MAX) {
+        slot = g_prof_count++;
+        g_prof[slot] = (prof_ring_t){ .name = name ? name : "(unnamed)", .phase = phase };
+        char labels[METRICS_LABELS_MAX];
+        snprintf(labels, sizeof(labels), "system=\"%s\"", g_prof[slot].name);
+        g_prof[slot].hist = metrics_histogram("system_seconds", "Time per system call", labels, NULL, 0);
+    }
+
     g_systems[phase][*cnt] = (sys_rec_t){ name, order, fn };
+    g_prof_slot[phase][*cnt] = slot;
     (*cnt)++;
     sort_phase(phase);
 }
@@ -59,7 +99,26 @@ void systems_run_phase(systems_phase_t phase, float dt, const input_t* in)
     size_t n = g_counts[phase];
     for (size_t i = 0; i < n; ++i) {
         systems_fn fn = g_systems[phase][i].fn;
-        if (fn) fn(dt, in);
+        if (!fn) continue;
+        const int slot = g_prof_slot[phase][i];
+        TRACE_BEGIN(g_systems[phase][i].name);
+        if (!g_prof_enabled || slot < 0) {
+            fn(dt, in);
+            TRACE_END();
+            continue;
+        }
+        const double t0 = time_now();
+        fn(dt, in);
+        const double t1 = time_now();
+        TRACE_END();
+
+        prof_ring_t* r = &g_prof[slot];
+        r->ms[r->head] = (float)((t1 - t0) * 1000.0);
+        r->total_ms += (t1 - t0) * 1000.0;
+        r->calls++;
+        metrics_observe(r->hist, t1 - t0);
+        r->head = (r->head + 1) % SYSTEMS_PROFILE_RING;
+        if (r->count < SYSTEMS_PROFILE_RING) r->count++;
     }
 }
 
@@ -75,15 +134,104 @@ size_t systems_get_phase_systems(systems_phase_t phase, const systems_info_t** o
 
 void systems_tick(float dt, const input_t* in)
 {
+    TRACE_BEGIN("systems_tick");
+    const double t0 = time_now();
+    frame_alloc_begin_tick();
     systems_run_phase(PHASE_INPUT,    dt, in);
     systems_run_phase(PHASE_SIM_PRE,  dt, in);
     systems_run_phase(PHASE_PHYSICS,  dt, in);
     systems_run_phase(PHASE_SIM_POST, dt, in);
     systems_run_phase(PHASE_DEBUG,    dt, in);
+    metrics_observe(g_m_tick, time_now() - t0);
+    TRACE_END();
 }
 
 void systems_present(float frame_dt)
 {
+    TRACE_BEGIN("systems_present");
+    frame_alloc_begin_frame();
     systems_run_phase(PHASE_PRESENT, frame_dt, NULL);
     systems_run_phase(PHASE_RENDER, frame_dt, NULL);
+    TRACE_END();
+}
+
+void systems_profile_set_enabled(bool enabled)
+{
+    g_prof_enabled = enabled;
+}
+
+bool systems_profile_enabled(void)
+{
+    return g_prof_enabled;
+}
+
+void systems_profile_reset(void)
+{
+    for (int i = 0; i < g_prof_count; ++i) {
+        g_prof[i].head = 0;
+        g_prof[i].count = 0;
+        g_prof[i].total_ms = 0.0;
+        g_prof[i].calls = 0;
+    }
+}
+
+static int cmp_float(const void* a, const void* b)
+{
+    const float fa = *(const float*)a;
+    const float fb = *(const float*)b;
+    return (fa > fb) - (fa < fb);
+}
+
+size_t systems_profile_stats(systems_profile_stats_t* out, size_t cap)
+{
+    if (!out) return (size_t)g_prof_count;
+
+    size_t n = 0;
+    for (int p = 0; p < (int)PHASE_COUNT; ++p) {
+        for (size_t i = 0; i < g_counts[p] && n < cap; ++i) {
+            const int slot = g_prof_slot[p][i];
+            if (slot < 0) continue;
+            const prof_ring_t* r = &g_prof[slot];
+
+            systems_profile_stats_t st = {
+                .name = r->name, .phase = r->phase, .samples = r->count,
+                .calls = r->calls, .total_ms = r->total_ms,
+            };
+            if (r->count > 0) {
+                float sorted[SYSTEMS_PROFILE_RING];
+                memcpy(sorted, r->ms, sizeof(float) * (size_t)r->count);
+                qsort(sorted, (size_t)r->count, sizeof(float), cmp_float);
+                double sum = 0.0;
+                for (int k = 0; k < r->count; ++k) sum += sorted[k];
+                // Nearest-rank p99.
+                int rank = (r->count * 99 + 99) / 100;
+                st.min_ms  = sorted[0];
+                st.mean_ms = (float)(sum / (double)r->count);
+                st.p99_ms  = sorted[rank - 1];
+                st.max_ms  = sorted[r->count - 1];
+            }
+            out[n++] = st;
+        }
+    }
+    return n;
+}
+
+bool systems_profile_write_csv(const char* path)
+{
+    if (!path) return false;
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        LOGC(LOGCAT("SYS"), LOG_LVL_ERROR, "systems: can't open profile csv '%s'", path);
+        return false;
+    }
+
+    systems_profile_stats_t stats[SYSTEMS_PROFILE_MAX];
+    size_t n = systems_profile_stats(stats, SYSTEMS_PROFILE_MAX);
+    fprintf(f, "phase,system,samples,min_ms,mean_ms,p99_ms,max_ms\n");
+    for (size_t i = 0; i < n; ++i) {
+        fprintf(f, "%d,%s,%d,%.4f,%.4f,%.4f,%.4f\n", (int)stats[i].phase, stats[i].name, stats[i].samples,
+                stats[i].min_ms, stats[i].mean_ms, stats[i].p99_ms, stats[i].max_ms);
+    }
+    fclose(f);
+    return true;
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 #include "modules/core/input.h"
 
 // Phase pipeline (conceptual):
@@ -46,3 +47,23 @@ size_t systems_get_phase_systems(systems_phase_t phase, const systems_info_t** o
 
 void systems_tick(float dt, const input_t* in);
 void systems_present(float frame_dt);
+
+// Per-system profiler: each system call is timed with time_now() into a ring of the last
+// SYSTEMS_PROFILE_RING calls. Stats come back in run order (phase, then order).
+#define SYSTEMS_PROFILE_RING 240
+#define SYSTEMS_PROFILE_MAX  64
+
+typedef struct {
+    const char* name;
+    systems_phase_t phase;
+    int   samples;
+    float min_ms, mean_ms, p99_ms, max_ms; // over the ring
+    long   calls;                          // since the last reset
+    double total_ms;
+} systems_profile_stats_t;
+
+void   systems_profile_set_enabled(bool enabled); // on by default
+bool   systems_profile_enabled(void);
+void   systems_profile_reset(void);
+size_t systems_profile_stats(systems_profile_stats_t* out, size_t cap); // out == NULL: profiled system count
+bool   systems_profile_write_csv(const char* path);
@@ -30,9 +30,11 @@ void sys_render_end_adapt(float dt, const input_t* in);
 void sys_toast_update_adapt(float dt, const input_t* in);
 void sys_camera_tick_adapt(float dt, const input_t* in);
 void sys_world_apply_edits_adapt(float dt, const input_t* in);
+void sys_world_stream_adapt(float dt, const input_t* in);
 void sys_asset_collect_adapt(float dt, const input_t* in);
 #if DEBUG_BUILD
 void sys_debug_binds_adapt(float dt, const input_t* in);
+void sys_hot_reload_adapt(float dt, const input_t* in);
 #endif
 
 void systems_registration_init(void)
@@ -46,6 +48,7 @@ void systems_registration_init(void)
     systems_register(PHASE_INPUT, 0, sys_input_adapt, "input");
     systems_register(PHASE_INPUT, 50, sys_grav_gun_input_adapt, "grav_gun_input");
 
+    systems_register(PHASE_SIM_PRE, 0, sys_world_stream_adapt, "world_stream");
     systems_register(PHASE_SIM_PRE, 100, sys_anim_controller_adapt, "animation_controller");
 
     systems_register(PHASE_PHYSICS, 50, sys_follow_adapt, "follow_ai");
@@ -73,6 +76,7 @@ void systems_registration_init(void)
     systems_register(PHASE_RENDER, 1000, sys_asset_collect_adapt, "asset_collect");
 
 #if DEBUG_BUILD
+    systems_register(PHASE_DEBUG, 90, sys_hot_reload_adapt, "hot_reload");
     systems_register(PHASE_DEBUG, 100, sys_debug_binds_adapt, "debug_binds");
 #endif
 
@@ -1,13 +1,14 @@
 #include "modules/tiled/tiled.h"
 #include "modules/tiled/tiled_internal.h"
+#include "modules/common/mem_tag.h"
 #include "modules/core/logger.h"
+#include "modules/core/trace.h"
 
 #include <stdlib.h>
 
-bool tiled_load_map(const char *tmx_path, world_map_t *out_map) {
+static bool tiled_load_map_impl(const char *tmx_path, world_map_t *out_map, const tiled_gid_sink_t *sink) {
     if (!out_map) return false;
     *out_map = (world_map_t){0};
-    tiled_reset_tile_anim_arena();
 
     struct xml_document *doc = tiled_load_xml_document(tmx_path);
     if (!doc) {
@@ -30,6 +31,8 @@ bool tiled_load_map(const char *tmx_path, world_map_t *out_map) {
         return false;
     }
 
+    if (sink && !sink->begin(sink->user, out_map->width, out_map->height)) sink = NULL;
+
     bool ok = tiled_parse_tilesets_from_root(root, tmx_path, out_map);
     if (!ok) {
         xml_document_free(doc, true);
@@ -38,7 +41,7 @@ bool tiled_load_map(const char *tmx_path, world_map_t *out_map) {
     }
 
     ok = tiled_parse_objects_from_root(root, out_map) && ok;
-    ok = tiled_parse_layers_from_root(root, out_map) && ok;
+    ok = tiled_parse_layers_from_root(root, out_map, sink) && ok;
 
     xml_document_free(doc, true);
 
@@ -49,27 +52,39 @@ bool tiled_load_map(const char *tmx_path, world_map_t *out_map) {
     return true;
 }
 
+bool tiled_load_map(const char *tmx_path, world_map_t *out_map) {
+    TRACE_BEGIN("tiled_load_map");
+    bool ok = tiled_load_map_impl(tmx_path, out_map, NULL);
+    TRACE_END();
+    return ok;
+}
+
+bool tiled_load_map_streamed(const char *tmx_path, world_map_t *out_map, const tiled_gid_sink_t *sink) {
+    TRACE_BEGIN("tiled_load_map");
+    bool ok = tiled_load_map_impl(tmx_path, out_map, sink);
+    TRACE_END();
+    return ok;
+}
+
 void tiled_free_map(world_map_t *map) {
     if (!map) return;
     for (size_t i = 0; i < map->layer_count; ++i) {
         tiled_layer_t *l = &map->layers[i];
         free(l->name);
-        free(l->gids);
+        mem_free(MEM_TAG_TILED, l->gids, (size_t)l->width * (size_t)l->height * sizeof(uint32_t));
     }
-    free(map->layers);
+    mem_free(MEM_TAG_TILED, map->layers, map->layer_count * sizeof(tiled_layer_t));
     if (map->tilesets) {
         for (size_t i = 0; i < map->tileset_count; ++i) {
             tiled_tileset_t *ts = &map->tilesets[i];
-            free(ts->colliders);
-            free(ts->no_merge_collider);
-            tiled_free_tileset_anims(ts);
-            free(ts->render_painters);
-            free(ts->painter_offset);
+            tiled_free_tile_arrays(ts);
             free(ts->image_path);
+            free(ts->source_path);
         }
     }
-    free(map->tilesets);
+    mem_free(MEM_TAG_TILED, map->tilesets, map->tileset_count * sizeof(tiled_tileset_t));
+    tiled_gid_index_free(&map->gid_tilesets);
     tiled_free_objects(map);
+    bump_free(&map->anim_arena);
     *map = (world_map_t){0};
-    tiled_reset_tile_anim_arena();
 }
@@ -5,7 +5,19 @@
 #include "modules/world/world_map.h"
 
 bool tiled_load_map(const char *tmx_path, world_map_t *out_map);
+
+// Streamed loading: once the map size is known, begin() decides whether tile layers go to rows()
+// (row segments, in document order) instead of being flattened into layer->gids, which stays NULL.
+typedef struct {
+    void *user;
+    bool (*begin)(void *user, int width, int height);
+    bool (*rows)(void *user, size_t layer_idx, int tx, int ty, const uint32_t *gids, size_t count);
+} tiled_gid_sink_t;
+
+bool tiled_load_map_streamed(const char *tmx_path, world_map_t *out_map, const tiled_gid_sink_t *sink);
 void tiled_free_map(world_map_t *map);
+// Re-parse an external tileset's TSX and swap in its collider masks (tile count must match).
+bool tiled_reload_tileset_colliders(tiled_tileset_t *ts);
 
 typedef struct {
     size_t texture_count;
@@ -15,5 +27,11 @@ typedef struct {
 bool tiled_renderer_init(tiled_renderer_t *r, const world_map_t *map);
 void tiled_renderer_shutdown(tiled_renderer_t *r);
 
+// Property names match case-insensitively. The _atom forms take atom_intern_ci/atom_find_ci
+// results, so a caller that looks the same name up often can resolve it once.
 const tiled_property_t* tiled_object_get_property(const tiled_object_t* obj, const char* name);
 const char* tiled_object_get_property_value(const tiled_object_t* obj, const char* name);
+const tiled_property_t* tiled_object_get_property_atom(const tiled_object_t* obj, atom_t name);
+const char* tiled_object_get_property_value_atom(const tiled_object_t* obj, atom_t name);
+// "<scope>.<field>" if the object has it, else plain "<field>" (prefab overrides).
+const char* tiled_object_get_scoped_value(const tiled_object_t* obj, const char* scope, const char* field);
@@ -5,6 +5,7 @@
 #include <stdint.h>
 
 #include "modules/tiled/tiled.h"
+#include "modules/asset/bump_alloc.h"
 #include "xml.h"
 
 char *tiled_xstrdup(const char *s);
@@ -19,12 +20,15 @@ char *tiled_scan_attr_in_file(const char *path, const char *tag, const char *att
 struct xml_document *tiled_load_xml_document(const char *path);
 char *tiled_join_relative(const char *base_path, const char *rel);
 bool tiled_parse_csv_gids(const char *csv, size_t expected, uint32_t *out);
+// Map data is counted under MEM_TAG_TILED; grown arrays are trimmed to count * elem once
+// parsed, so the free side only needs the count.
+void *tiled_shrink_array(void *p, size_t cap, size_t count, size_t elem);
 
 bool tiled_parse_tilesets_from_root(struct xml_node *root, const char *tmx_path, world_map_t *out_map);
 void tiled_free_tileset_anims(tiled_tileset_t *ts);
-void tiled_reset_tile_anim_arena(void);
+void tiled_free_tile_arrays(tiled_tileset_t *ts);
 
-bool tiled_parse_layers_from_root(struct xml_node *root, world_map_t *out_map);
+bool tiled_parse_layers_from_root(struct xml_node *root, world_map_t *out_map, const tiled_gid_sink_t *sink);
 
 bool tiled_parse_objects_from_root(struct xml_node *root, world_map_t *out_map);
 void tiled_free_objects(world_map_t *map);
@@ -1,12 +1,69 @@
 #include "modules/tiled/tiled_internal.h"
+#include "modules/common/mem_tag.h"
+#include "modules/common/parallel.h"
 #include "modules/core/logger.h"
 
+#include <ctype.h>
 #include <stdlib.h>
 #include <string.h>
 
-static bool parse_layer(struct xml_node *layer_node, tiled_layer_t *out_layer) {
+// Layer CSV is the largest transient buffer of a load, so it's counted too.
+static char *csv_dup(struct xml_string *xs) {
+    if (!xs) return NULL;
+    size_t len = xml_string_length(xs);
+    char *buf = (char *)mem_alloc(MEM_TAG_TILED, len + 1);
+    if (!buf) return NULL;
+    xml_string_copy(xs, (uint8_t *)buf, len);
+    buf[len] = '\0';
+    return buf;
+}
+
+// Streamed layers: hand the CSV to the sink one row at a time so no dense array is built.
+static bool stream_csv_rows(const char *csv, const tiled_layer_t *layer, const tiled_gid_sink_t *sink, size_t layer_idx) {
+    const size_t row_bytes = (size_t)layer->width * sizeof(uint32_t);
+    uint32_t *row = (uint32_t *)mem_alloc(MEM_TAG_TILED, row_bytes);
+    if (!row) return false;
+
+    int x = 0, y = 0;
+    bool ok = true;
+    const char *p = csv;
+    while (*p && y < layer->height) {
+        while (*p && (isspace((unsigned char)*p) || *p == ',')) p++;
+        if (!*p) break;
+        char *end = NULL;
+        long v = strtol(p, &end, 10);
+        if (p == end) break;
+        if (v < 0) v = 0;
+        row[x++] = (uint32_t)v;
+        p = end;
+        if (x == layer->width) {
+            if (!sink->rows(sink->user, layer_idx, 0, y, row, (size_t)layer->width)) { ok = false; break; }
+            x = 0;
+            y++;
+        }
+    }
+    mem_free(MEM_TAG_TILED, row, row_bytes);
+    return ok && y == layer->height && x == 0;
+}
+
+static bool stream_chunk_rows(const uint32_t *chunk_gids, int cx, int cy, int cw, int ch,
+                              const tiled_layer_t *layer, const tiled_gid_sink_t *sink, size_t layer_idx) {
+    int x0 = cx < 0 ? 0 : cx;
+    int x1 = cx + cw > layer->width ? layer->width : cx + cw;
+    if (x1 <= x0) return true;
+    for (int y = 0; y < ch; ++y) {
+        int ty = cy + y;
+        if (ty < 0 || ty >= layer->height) continue;
+        const uint32_t *src = chunk_gids + (size_t)y * (size_t)cw + (size_t)(x0 - cx);
+        if (!sink->rows(sink->user, layer_idx, x0, ty, src, (size_t)(x1 - x0))) return false;
+    }
+    return true;
+}
+
+static bool parse_layer(struct xml_node *layer_node, tiled_layer_t *out_layer, const tiled_gid_sink_t *sink, size_t layer_idx) {
     memset(out_layer, 0, sizeof(*out_layer));
     out_layer->name = tiled_node_attr_strdup(layer_node, "name");
+    out_layer->name_atom = atom_intern(out_layer->name);
     if (!tiled_node_attr_int(layer_node, "width", &out_layer->width) ||
         !tiled_node_attr_int(layer_node, "height", &out_layer->height)) {
         LOGC(LOGCAT_TILE, LOG_LVL_ERROR, "Layer missing width/height");
@@ -46,9 +103,11 @@ static bool parse_layer(struct xml_node *layer_node, tiled_layer_t *out_layer) {
     }
 
     size_t total = (size_t)out_layer->width * (size_t)out_layer->height;
-    out_layer->gids = (uint32_t *)calloc(total, sizeof(uint32_t));
-    if (!out_layer->gids) {
-        return false;
+    if (!sink) {
+        out_layer->gids = (uint32_t *)mem_calloc(MEM_TAG_TILED, total, sizeof(uint32_t));
+        if (!out_layer->gids) {
+            return false;
+        }
     }
 
     bool has_chunk = false;
@@ -77,7 +136,7 @@ static bool parse_layer(struct xml_node *layer_node, tiled_layer_t *out_layer) {
             }
 
             struct xml_string *chunk_str = xml_node_content(chunk);
-            char *csv = tiled_xml_string_dup(chunk_str);
+            char *csv = csv_dup(chunk_str);
             if (!csv) {
                 LOGC(LOGCAT_TILE, LOG_LVL_ERROR, "Failed to copy chunk CSV for layer '%s'", out_layer->name ? out_layer->name : "(unnamed)");
                 ok = false;
@@ -85,21 +144,28 @@ static bool parse_layer(struct xml_node *layer_node, tiled_layer_t *out_layer) {
             }
 
             size_t chunk_total = (size_t)cw * (size_t)ch;
-            uint32_t *chunk_gids = (uint32_t *)calloc(chunk_total, sizeof(uint32_t));
+            uint32_t *chunk_gids = (uint32_t *)mem_calloc(MEM_TAG_TILED, chunk_total, sizeof(uint32_t));
             if (!chunk_gids) {
-                free(csv);
+                mem_free_str(MEM_TAG_TILED, csv);
                 ok = false;
                 break;
             }
             bool parsed_chunk = tiled_parse_csv_gids(csv, chunk_total, chunk_gids);
-            free(csv);
+            mem_free_str(MEM_TAG_TILED, csv);
             if (!parsed_chunk) {
-                free(chunk_gids);
+                mem_free(MEM_TAG_TILED, chunk_gids, chunk_total * sizeof(uint32_t));
                 LOGC(LOGCAT_TILE, LOG_LVL_ERROR, "CSV parse mismatch for chunk in layer '%s'", out_layer->name ? out_layer->name : "(unnamed)");
                 ok = false;
                 break;
             }
 
+            if (sink) {
+                ok = stream_chunk_rows(chunk_gids, cx, cy, cw, ch, out_layer, sink, layer_idx);
+                mem_free(MEM_TAG_TILED, chunk_gids, chunk_total * sizeof(uint32_t));
+                if (!ok) break;
+                continue;
+            }
+
             for (int y = 0; y < ch; ++y) {
                 for (int x = 0; x < cw; ++x) {
                     size_t di = ((size_t)(cy + y) * (size_t)out_layer->width) + (size_t)(cx + x);
@@ -108,59 +174,90 @@ static bool parse_layer(struct xml_node *layer_node, tiled_layer_t *out_layer) {
                     out_layer->gids[di] = chunk_gids[si];
                 }
             }
-            free(chunk_gids);
+            mem_free(MEM_TAG_TILED, chunk_gids, chunk_total * sizeof(uint32_t));
         }
     } else {
         struct xml_string *data_str = xml_node_content(data_node);
-        char *csv = tiled_xml_string_dup(data_str);
+        char *csv = csv_dup(data_str);
         if (!csv) {
             LOGC(LOGCAT_TILE, LOG_LVL_ERROR, "Failed to copy layer CSV");
             ok = false;
         }
         if (ok) {
-            bool parsed = tiled_parse_csv_gids(csv, total, out_layer->gids);
-            free(csv);
+            bool parsed = sink
+                ? stream_csv_rows(csv, out_layer, sink, layer_idx)
+                : tiled_parse_csv_gids(csv, total, out_layer->gids);
+            mem_free_str(MEM_TAG_TILED, csv);
             if (!parsed) {
                 LOGC(LOGCAT_TILE, LOG_LVL_ERROR, "CSV parse mismatch for layer '%s'", out_layer->name ? out_layer->name : "(unnamed)");
                 ok = false;
             }
-        } else {
-            free(csv);
         }
     }
     if (!ok) {
-        free(out_layer->gids);
+        mem_free(MEM_TAG_TILED, out_layer->gids, total * sizeof(uint32_t));
         free(out_layer->name);
         *out_layer = (tiled_layer_t){0};
     }
     return ok;
 }
 
-bool tiled_parse_layers_from_root(struct xml_node *root, world_map_t *out_map) {
+typedef struct {
+    struct xml_node *node;
+    tiled_layer_t *layer;
+    int z_order;
+    bool ok;
+} layer_job_t;
+
+static void parse_layer_job(void *user, size_t i) {
+    layer_job_t *job = &((layer_job_t *)user)[i];
+    job->ok = parse_layer(job->node, job->layer, NULL, i);
+    job->layer->z_order = job->z_order;
+}
+
+bool tiled_parse_layers_from_root(struct xml_node *root, world_map_t *out_map, const tiled_gid_sink_t *sink) {
     size_t children = xml_node_children(root);
 
-    size_t layer_cap = 4;
-    out_map->layers = (tiled_layer_t *)calloc(layer_cap, sizeof(tiled_layer_t));
+    size_t count = 0;
+    for (size_t i = 0; i < children; ++i) {
+        if (tiled_node_name_is(xml_node_child(root, i), "layer")) count++;
+    }
+    if (count == 0) return true;
+
+    out_map->layers = (tiled_layer_t *)mem_calloc(MEM_TAG_TILED, count, sizeof(tiled_layer_t));
     if (!out_map->layers) {
         return false;
     }
+    out_map->layer_count = count;
 
     bool ok = true;
+    if (sink) {
+        // The sink takes rows in document order, so streamed layers stay on this thread.
+        size_t li = 0;
+        for (size_t i = 0; i < children; ++i) {
+            struct xml_node *child = xml_node_child(root, i);
+            if (!tiled_node_name_is(child, "layer")) continue;
+            if (!parse_layer(child, &out_map->layers[li], sink, li)) {
+                ok = false;
+                break;
+            }
+            out_map->layers[li++].z_order = (int)i;
+        }
+        return ok;
+    }
+
+    // Each layer decodes its own CSV into its own gid array, so layers parse in parallel.
+    layer_job_t *jobs = (layer_job_t *)calloc(count, sizeof(layer_job_t));
+    if (!jobs) return false;
+    size_t li = 0;
     for (size_t i = 0; i < children; ++i) {
         struct xml_node *child = xml_node_child(root, i);
         if (!tiled_node_name_is(child, "layer")) continue;
-        if (out_map->layer_count == layer_cap) {
-            layer_cap *= 2;
-            tiled_layer_t *tmp = (tiled_layer_t *)realloc(out_map->layers, layer_cap * sizeof(tiled_layer_t));
-            if (!tmp) { ok = false; break; }
-            out_map->layers = tmp;
-        }
-        if (!parse_layer(child, &out_map->layers[out_map->layer_count])) {
-            ok = false;
-            break;
-        }
-        out_map->layers[out_map->layer_count].z_order = (int)i;
-        out_map->layer_count++;
+        jobs[li] = (layer_job_t){ .node = child, .layer = &out_map->layers[li], .z_order = (int)i };
+        li++;
     }
+    parallel_for(count, parse_layer_job, jobs);
+    for (size_t j = 0; j < count; ++j) ok = ok && jobs[j].ok;
+    free(jobs);
     return ok;
 }
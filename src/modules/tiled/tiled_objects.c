@@ -1,4 +1,5 @@
 #include "modules/tiled/tiled_internal.h"
+#include "modules/common/mem_tag.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -12,7 +13,9 @@ static void add_object_property(tiled_object_t* obj, char* name, char* value, ch
         return;
     }
     size_t idx = obj->property_count;
-    tiled_property_t* tmp = (tiled_property_t*)realloc(obj->properties, (idx + 1) * sizeof(tiled_property_t));
+    tiled_property_t* tmp = (tiled_property_t*)mem_realloc(MEM_TAG_TILED, obj->properties,
+                                                           idx * sizeof(tiled_property_t),
+                                                           (idx + 1) * sizeof(tiled_property_t));
     if (!tmp) {
         free(name);
         free(value);
@@ -23,6 +26,7 @@ static void add_object_property(tiled_object_t* obj, char* name, char* value, ch
     obj->properties[idx].name = name;
     obj->properties[idx].type = type;
     obj->properties[idx].value = value ? value : tiled_xstrdup("");
+    obj->properties[idx].atom = atom_intern_ci(name);
     obj->property_count = idx + 1;
 }
 
@@ -40,13 +44,31 @@ void tiled_free_objects(world_map_t *map) {
                 free(o->properties[p].value);
             }
         }
-        free(o->properties);
+        mem_free(MEM_TAG_TILED, o->properties, o->property_count * sizeof(tiled_property_t));
+        mem_free(MEM_TAG_TILED, o->prop_keys, o->property_count * sizeof(tiled_prop_key_t));
     }
-    free(map->objects);
+    mem_free(MEM_TAG_TILED, map->objects, map->object_count * sizeof(tiled_object_t));
     map->objects = NULL;
     map->object_count = 0;
 }
 
+static int cmp_prop_key(const void *pa, const void *pb) {
+    const tiled_prop_key_t *a = (const tiled_prop_key_t *)pa;
+    const tiled_prop_key_t *b = (const tiled_prop_key_t *)pb;
+    if (a->atom != b->atom) return a->atom < b->atom ? -1 : 1;
+    return a->index < b->index ? -1 : (a->index > b->index);
+}
+
+static void build_prop_keys(tiled_object_t *obj) {
+    if (obj->property_count == 0) return;
+    obj->prop_keys = (tiled_prop_key_t *)mem_alloc(MEM_TAG_TILED, obj->property_count * sizeof(tiled_prop_key_t));
+    if (!obj->prop_keys) return; // lookups fall back to scanning the atoms
+    for (size_t i = 0; i < obj->property_count; ++i) {
+        obj->prop_keys[i] = (tiled_prop_key_t){ obj->properties[i].atom, (uint32_t)i };
+    }
+    qsort(obj->prop_keys, obj->property_count, sizeof(tiled_prop_key_t), cmp_prop_key);
+}
+
 static void parse_object(struct xml_node *obj_node, const char* layer_name, int layer_z, tiled_object_t *out) {
     memset(out, 0, sizeof(*out));
     tiled_node_attr_int(obj_node, "id", &out->id);
@@ -108,6 +130,8 @@ static void parse_object(struct xml_node *obj_node, const char* layer_name, int
             add_object_property(out, pname, pval, ptype);
         }
     }
+
+    build_prop_keys(out);
 }
 
 bool tiled_parse_objects_from_root(struct xml_node *root, world_map_t *out_map) {
@@ -126,7 +150,9 @@ bool tiled_parse_objects_from_root(struct xml_node *root, world_map_t *out_map)
             if (!tiled_node_name_is(obj, "object")) continue;
             if (out_map->object_count == obj_cap) {
                 obj_cap = obj_cap ? obj_cap * 2 : 8;
-                tiled_object_t *tmp = (tiled_object_t *)realloc(out_map->objects, obj_cap * sizeof(tiled_object_t));
+                tiled_object_t *tmp = (tiled_object_t *)mem_realloc(MEM_TAG_TILED, out_map->objects,
+                                                                    out_map->object_count * sizeof(tiled_object_t),
+                                                                    obj_cap * sizeof(tiled_object_t));
                 if (!tmp) { ok = false; break; }
                 out_map->objects = tmp;
             }
@@ -137,21 +163,66 @@ bool tiled_parse_objects_from_root(struct xml_node *root, world_map_t *out_map)
         }
         if (!ok) break;
     }
+    out_map->objects = (tiled_object_t *)tiled_shrink_array(out_map->objects, obj_cap, out_map->object_count, sizeof(tiled_object_t));
     return ok;
 }
 
-const tiled_property_t* tiled_object_get_property(const tiled_object_t* obj, const char* name) {
-    if (!obj || !name) return NULL;
+// Objects built by hand rather than parsed have no key array and may have no atoms either,
+// so those fall back to comparing names.
+static const tiled_property_t* scan_properties(const tiled_object_t* obj, atom_t atom, const char* name) {
     for (size_t i = 0; i < obj->property_count; ++i) {
         const tiled_property_t* p = &obj->properties[i];
-        if (p->name && tiled_str_ieq(p->name, name)) {
+        if (p->atom != ATOM_NONE ? p->atom == atom : (p->name && name && tiled_str_ieq(p->name, name))) {
             return p;
         }
     }
     return NULL;
 }
 
+const tiled_property_t* tiled_object_get_property_atom(const tiled_object_t* obj, atom_t name) {
+    if (!obj || name == ATOM_NONE) return NULL;
+    if (!obj->prop_keys) return scan_properties(obj, name, atom_str(name));
+    // Lower bound, so the first of duplicate names wins as it would in file order.
+    size_t lo = 0, hi = obj->property_count;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (obj->prop_keys[mid].atom < name) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo < obj->property_count && obj->prop_keys[lo].atom == name) {
+        return &obj->properties[obj->prop_keys[lo].index];
+    }
+    return NULL;
+}
+
+const tiled_property_t* tiled_object_get_property(const tiled_object_t* obj, const char* name) {
+    if (!obj || !name) return NULL;
+    if (!obj->prop_keys) return scan_properties(obj, atom_find_ci(name), name);
+    return tiled_object_get_property_atom(obj, atom_find_ci(name));
+}
+
 const char* tiled_object_get_property_value(const tiled_object_t* obj, const char* name) {
     const tiled_property_t* p = tiled_object_get_property(obj, name);
     return p ? p->value : NULL;
 }
+
+const char* tiled_object_get_property_value_atom(const tiled_object_t* obj, atom_t name) {
+    const tiled_property_t* p = tiled_object_get_property_atom(obj, name);
+    return p ? p->value : NULL;
+}
+
+const char* tiled_object_get_scoped_value(const tiled_object_t* obj, const char* scope, const char* field) {
+    if (!obj || !field) return NULL;
+    if (scope) {
+        const char* v = NULL;
+        if (obj->prop_keys) {
+            v = tiled_object_get_property_value_atom(obj, atom_find_join_ci(scope, '.', field));
+        } else {
+            char key[128];
+            snprintf(key, sizeof(key), "%s.%s", scope, field);
+            v = tiled_object_get_property_value(obj, key);
+        }
+        if (v) return v;
+    }
+    return tiled_object_get_property_value(obj, field);
+}
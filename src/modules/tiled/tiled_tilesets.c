@@ -1,24 +1,18 @@
 #include "modules/tiled/tiled_internal.h"
 #include "modules/asset/bump_alloc.h"
+#include "modules/common/mem_tag.h"
+#include "modules/common/parallel.h"
 #include "modules/core/logger.h"
 
 #include <stdlib.h>
 #include <string.h>
 #include <strings.h>
 
-static bump_alloc_t g_tile_anim_arena;
-static const size_t TILE_ANIM_ARENA_BYTES = 512 * 1024;
+// First chunk of a map's animation arena; maps with more animated tiles chain further chunks.
+static const size_t TILE_ANIM_ARENA_BYTES = 16 * 1024;
 
-static bool ensure_tile_anim_arena(void) {
-    if (g_tile_anim_arena.data) return true;
-    return bump_init(&g_tile_anim_arena, TILE_ANIM_ARENA_BYTES);
-}
-
-void tiled_reset_tile_anim_arena(void) {
-    if (!g_tile_anim_arena.data) {
-        if (!bump_init(&g_tile_anim_arena, TILE_ANIM_ARENA_BYTES)) return;
-    }
-    bump_reset(&g_tile_anim_arena);
+static bool ensure_tile_anim_arena(bump_alloc_t *arena) {
+    return arena->data || bump_init_tagged(arena, TILE_ANIM_ARENA_BYTES, MEM_TAG_TILED);
 }
 
 // Expects "[abcd],[efgh],[ijkl],[mnop]" where each char is 0/1; builds 4x4 bitmask row-major
@@ -47,13 +41,42 @@ static uint16_t parse_collider_mask(const char *s, bool *out_ok) {
     return mask;
 }
 
+static size_t tile_count_of(const tiled_tileset_t *ts) {
+    return ts->tilecount > 0 ? (size_t)ts->tilecount : 0;
+}
+
+// Per-tile lookup arrays, all indexed by local tile id.
+static bool alloc_tile_arrays(tiled_tileset_t *ts) {
+    const size_t n = tile_count_of(ts);
+    ts->colliders = (uint16_t *)mem_calloc(MEM_TAG_TILED, n, sizeof(uint16_t));
+    ts->no_merge_collider = (bool *)mem_calloc(MEM_TAG_TILED, n, sizeof(bool));
+    ts->anims = (tiled_animation_t *)mem_calloc(MEM_TAG_TILED, n, sizeof(tiled_animation_t));
+    ts->render_painters = (bool *)mem_calloc(MEM_TAG_TILED, n, sizeof(bool));
+    ts->painter_offset = (int *)mem_calloc(MEM_TAG_TILED, n, sizeof(int));
+    return ts->colliders && ts->no_merge_collider && ts->anims && ts->render_painters && ts->painter_offset;
+}
+
 void tiled_free_tileset_anims(tiled_tileset_t *ts) {
     if (!ts || !ts->anims) return;
-    free(ts->anims);
+    mem_free(MEM_TAG_TILED, ts->anims, tile_count_of(ts) * sizeof(tiled_animation_t));
     ts->anims = NULL;
 }
 
-static bool parse_tileset(const char *tsx_path, tiled_tileset_t *out_tileset) {
+void tiled_free_tile_arrays(tiled_tileset_t *ts) {
+    if (!ts) return;
+    const size_t n = tile_count_of(ts);
+    mem_free(MEM_TAG_TILED, ts->colliders, n * sizeof(uint16_t));
+    mem_free(MEM_TAG_TILED, ts->no_merge_collider, n * sizeof(bool));
+    tiled_free_tileset_anims(ts);
+    mem_free(MEM_TAG_TILED, ts->render_painters, n * sizeof(bool));
+    mem_free(MEM_TAG_TILED, ts->painter_offset, n * sizeof(int));
+    ts->colliders = NULL;
+    ts->no_merge_collider = NULL;
+    ts->render_painters = NULL;
+    ts->painter_offset = NULL;
+}
+
+static bool parse_tileset(const char *tsx_path, tiled_tileset_t *out_tileset, bump_alloc_t *arena) {
     memset(out_tileset, 0, sizeof(*out_tileset));
     struct xml_document *doc = tiled_load_xml_document(tsx_path);
     if (!doc) {
@@ -76,22 +99,13 @@ static bool parse_tileset(const char *tsx_path, tiled_tileset_t *out_tileset) {
         return false;
     }
 
-    if (!ensure_tile_anim_arena()) {
+    if (!ensure_tile_anim_arena(arena)) {
         xml_document_free(doc, true);
         return false;
     }
 
-    out_tileset->colliders = (uint16_t *)calloc((size_t)out_tileset->tilecount, sizeof(uint16_t));
-    out_tileset->no_merge_collider = (bool *)calloc((size_t)out_tileset->tilecount, sizeof(bool));
-    out_tileset->anims = (tiled_animation_t *)calloc((size_t)out_tileset->tilecount, sizeof(tiled_animation_t));
-    out_tileset->render_painters = (bool *)calloc((size_t)out_tileset->tilecount, sizeof(bool));
-    out_tileset->painter_offset = (int *)calloc((size_t)out_tileset->tilecount, sizeof(int));
-    if (!out_tileset->colliders || !out_tileset->anims || !out_tileset->no_merge_collider || !out_tileset->render_painters || !out_tileset->painter_offset) {
-        free(out_tileset->colliders);
-        free(out_tileset->no_merge_collider);
-        free(out_tileset->anims);
-        free(out_tileset->render_painters);
-        free(out_tileset->painter_offset);
+    if (!alloc_tile_arrays(out_tileset)) {
+        tiled_free_tile_arrays(out_tileset);
         xml_document_free(doc, true);
         return false;
     }
@@ -150,13 +164,9 @@ static bool parse_tileset(const char *tsx_path, tiled_tileset_t *out_tileset) {
                         if (tiled_node_name_is(xml_node_child(node_child, k), "frame")) frame_count++;
                     }
                     if (frame_count > 0) {
-                        tiled_anim_frame_t *frames = bump_alloc_type(&g_tile_anim_arena, tiled_anim_frame_t, frame_count);
+                        tiled_anim_frame_t *frames = bump_alloc_type(arena, tiled_anim_frame_t, frame_count);
                         if (!frames) {
-                            free(out_tileset->colliders);
-                            free(out_tileset->no_merge_collider);
-                            tiled_free_tileset_anims(out_tileset);
-                            free(out_tileset->render_painters);
-                            free(out_tileset->painter_offset);
+                            tiled_free_tile_arrays(out_tileset);
                             xml_document_free(doc, true);
                             return false;
                         }
@@ -170,6 +180,7 @@ static bool parse_tileset(const char *tsx_path, tiled_tileset_t *out_tileset) {
                             tiled_node_attr_int(frame, "duration", &frames[fi].duration_ms);
                             if (frames[fi].duration_ms < 0) frames[fi].duration_ms = 0;
                             total_ms += frames[fi].duration_ms;
+                            frames[fi].end_ms = total_ms;
                             fi++;
                         }
                         out_tileset->anims[tile_id].frames = frames;
@@ -203,11 +214,7 @@ static bool parse_tileset(const char *tsx_path, tiled_tileset_t *out_tileset) {
     }
     if (!image) {
         LOGC(LOGCAT_TILE, LOG_LVL_ERROR, "No <image> in TSX");
-        free(out_tileset->colliders);
-        free(out_tileset->no_merge_collider);
-        tiled_free_tileset_anims(out_tileset);
-        free(out_tileset->render_painters);
-        free(out_tileset->painter_offset);
+        tiled_free_tile_arrays(out_tileset);
         xml_document_free(doc, true);
         return false;
     }
@@ -223,17 +230,13 @@ static bool parse_tileset(const char *tsx_path, tiled_tileset_t *out_tileset) {
     }
     if (!out_tileset->image_path) {
         LOGC(LOGCAT_TILE, LOG_LVL_ERROR, "Tileset missing image source");
-        free(out_tileset->colliders);
-        free(out_tileset->no_merge_collider);
-        tiled_free_tileset_anims(out_tileset);
-        free(out_tileset->render_painters);
-        free(out_tileset->painter_offset);
+        tiled_free_tile_arrays(out_tileset);
         return false;
     }
     return true;
 }
 
-static bool parse_tileset_inline(struct xml_node *tileset_node, const char *tmx_path, tiled_tileset_t *out_tileset) {
+static bool parse_tileset_inline(struct xml_node *tileset_node, const char *tmx_path, tiled_tileset_t *out_tileset, bump_alloc_t *arena) {
     memset(out_tileset, 0, sizeof(*out_tileset));
     if (!tiled_node_attr_int(tileset_node, "tilewidth", &out_tileset->tilewidth) ||
         !tiled_node_attr_int(tileset_node, "tileheight", &out_tileset->tileheight) ||
@@ -243,21 +246,12 @@ static bool parse_tileset_inline(struct xml_node *tileset_node, const char *tmx_
         return false;
     }
 
-    if (!ensure_tile_anim_arena()) {
+    if (!ensure_tile_anim_arena(arena)) {
         return false;
     }
 
-    out_tileset->colliders = (uint16_t *)calloc((size_t)out_tileset->tilecount, sizeof(uint16_t));
-    out_tileset->no_merge_collider = (bool *)calloc((size_t)out_tileset->tilecount, sizeof(bool));
-    out_tileset->anims = (tiled_animation_t *)calloc((size_t)out_tileset->tilecount, sizeof(tiled_animation_t));
-    out_tileset->render_painters = (bool *)calloc((size_t)out_tileset->tilecount, sizeof(bool));
-    out_tileset->painter_offset = (int *)calloc((size_t)out_tileset->tilecount, sizeof(int));
-    if (!out_tileset->colliders || !out_tileset->anims || !out_tileset->no_merge_collider || !out_tileset->render_painters || !out_tileset->painter_offset) {
-        free(out_tileset->colliders);
-        free(out_tileset->no_merge_collider);
-        free(out_tileset->anims);
-        free(out_tileset->render_painters);
-        free(out_tileset->painter_offset);
+    if (!alloc_tile_arrays(out_tileset)) {
+        tiled_free_tile_arrays(out_tileset);
         return false;
     }
 
@@ -315,13 +309,9 @@ static bool parse_tileset_inline(struct xml_node *tileset_node, const char *tmx_
                         if (tiled_node_name_is(xml_node_child(node_child, k), "frame")) frame_count++;
                     }
                     if (frame_count > 0) {
-                        tiled_anim_frame_t *frames = bump_alloc_type(&g_tile_anim_arena, tiled_anim_frame_t, frame_count);
+                        tiled_anim_frame_t *frames = bump_alloc_type(arena, tiled_anim_frame_t, frame_count);
                         if (!frames) {
-                            free(out_tileset->colliders);
-                            free(out_tileset->no_merge_collider);
-                            tiled_free_tileset_anims(out_tileset);
-                            free(out_tileset->render_painters);
-                            free(out_tileset->painter_offset);
+                            tiled_free_tile_arrays(out_tileset);
                             return false;
                         }
                         memset(frames, 0, frame_count * sizeof(tiled_anim_frame_t));
@@ -334,6 +324,7 @@ static bool parse_tileset_inline(struct xml_node *tileset_node, const char *tmx_
                             tiled_node_attr_int(frame, "duration", &frames[fi].duration_ms);
                             if (frames[fi].duration_ms < 0) frames[fi].duration_ms = 0;
                             total_ms += frames[fi].duration_ms;
+                            frames[fi].end_ms = total_ms;
                             fi++;
                         }
                         out_tileset->anims[tile_id].frames = frames;
@@ -367,11 +358,7 @@ static bool parse_tileset_inline(struct xml_node *tileset_node, const char *tmx_
     }
     if (!image) {
         LOGC(LOGCAT_TILE, LOG_LVL_ERROR, "Inline tileset has no <image>");
-        free(out_tileset->colliders);
-        free(out_tileset->no_merge_collider);
-        tiled_free_tileset_anims(out_tileset);
-        free(out_tileset->render_painters);
-        free(out_tileset->painter_offset);
+        tiled_free_tile_arrays(out_tileset);
         return false;
     }
 
@@ -381,11 +368,7 @@ static bool parse_tileset_inline(struct xml_node *tileset_node, const char *tmx_
     }
     if (!img_rel) {
         LOGC(LOGCAT_TILE, LOG_LVL_ERROR, "Inline tileset image missing source");
-        free(out_tileset->colliders);
-        free(out_tileset->no_merge_collider);
-        tiled_free_tileset_anims(out_tileset);
-        free(out_tileset->render_painters);
-        free(out_tileset->painter_offset);
+        tiled_free_tile_arrays(out_tileset);
         return false;
     }
     out_tileset->image_path = tiled_join_relative(tmx_path, img_rel);
@@ -406,39 +389,112 @@ static bool parse_tileset_inline(struct xml_node *tileset_node, const char *tmx_
 
     if (!out_tileset->image_path) {
         LOGC(LOGCAT_TILE, LOG_LVL_ERROR, "Failed to resolve inline tileset image path");
-        free(out_tileset->colliders);
-        free(out_tileset->no_merge_collider);
-        tiled_free_tileset_anims(out_tileset);
-        free(out_tileset->render_painters);
-        free(out_tileset->painter_offset);
+        tiled_free_tile_arrays(out_tileset);
         return false;
     }
     return true;
 }
 
+// Later tilesets go in first so that, as with a front-to-back scan, the earliest tileset
+// covering a gid wins if ranges ever overlap.
+static bool build_gid_index(world_map_t *map) {
+    size_t total = 0;
+    for (size_t i = 0; i < map->tileset_count; ++i) total += tile_count_of(&map->tilesets[i]);
+    if (!tiled_gid_index_reserve(&map->gid_tilesets, total)) return false;
+    for (size_t i = map->tileset_count; i-- > 0;) {
+        const tiled_tileset_t *ts = &map->tilesets[i];
+        for (int local = 0; local < ts->tilecount; ++local) {
+            if (!tiled_gid_index_put(&map->gid_tilesets, (uint32_t)(ts->first_gid + local), (uint16_t)i)) return false;
+        }
+    }
+    return true;
+}
+
+// An external tileset, parsed on a worker. Its animation frames go to a private arena and are
+// copied into the map's once every worker is done.
+typedef struct {
+    tiled_tileset_t *ts;
+    char *tsx_path;
+    int first_gid;
+    bump_alloc_t arena;
+    bool ok;
+} tsx_job_t;
+
+static void parse_external_tileset(void *user, size_t i) {
+    tsx_job_t *job = &((tsx_job_t *)user)[i];
+    tiled_tileset_t *ts = job->ts;
+    const char *tsx_path = job->tsx_path;
+
+    if (parse_tileset(tsx_path, ts, &job->arena)) {
+        ts->first_gid = job->first_gid;
+        char *img_path = tiled_join_relative(tsx_path, ts->image_path);
+        free(ts->image_path);
+        ts->image_path = img_path;
+    } else {
+        char *img_rel = tiled_scan_attr_in_file(tsx_path, "<image", "source");
+        if (img_rel) {
+            ts->image_path = tiled_join_relative(tsx_path, img_rel);
+            free(img_rel);
+        }
+    }
+
+    if (!ts->image_path || !tiled_file_exists(ts->image_path)) {
+        free(ts->image_path);
+        ts->image_path = NULL;
+        char *img_rel = tiled_scan_attr_in_file(tsx_path, "<image", "source");
+        if (img_rel) {
+            ts->image_path = tiled_join_relative(tsx_path, img_rel);
+            free(img_rel);
+        }
+    }
+    job->ok = ts->image_path != NULL;
+    if (job->ok) {
+        ts->source_path = job->tsx_path; // kept for hot reload
+        job->tsx_path = NULL;
+    }
+}
+
+static bool adopt_tileset_frames(tiled_tileset_t *ts, bump_alloc_t *arena) {
+    for (size_t t = 0; ts->anims && t < tile_count_of(ts); ++t) {
+        tiled_animation_t *anim = &ts->anims[t];
+        if (anim->frame_count == 0) continue;
+        if (!ensure_tile_anim_arena(arena)) return false;
+        tiled_anim_frame_t *frames = bump_alloc_type(arena, tiled_anim_frame_t, anim->frame_count);
+        if (!frames) return false;
+        memcpy(frames, anim->frames, anim->frame_count * sizeof(tiled_anim_frame_t));
+        anim->frames = frames;
+    }
+    return true;
+}
+
 bool tiled_parse_tilesets_from_root(struct xml_node *root, const char *tmx_path, world_map_t *out_map) {
     size_t children = xml_node_children(root);
 
-    size_t ts_cap = 2;
-    out_map->tilesets = (tiled_tileset_t *)calloc(ts_cap, sizeof(tiled_tileset_t));
-    if (!out_map->tilesets) {
+    size_t count = 0;
+    for (size_t i = 0; i < children; ++i) {
+        if (tiled_node_name_is(xml_node_child(root, i), "tileset")) count++;
+    }
+    if (count == 0) return false;
+
+    // Every slot exists up front (zeroed), so a failure part way leaves nothing for
+    // tiled_free_map to trip over.
+    out_map->tilesets = (tiled_tileset_t *)mem_calloc(MEM_TAG_TILED, count, sizeof(tiled_tileset_t));
+    tsx_job_t *jobs = (tsx_job_t *)calloc(count, sizeof(tsx_job_t));
+    if (!out_map->tilesets || !jobs) {
+        free(jobs);
         return false;
     }
+    out_map->tileset_count = count;
 
+    // Inline tilesets live in the TMX document and are parsed here; external TSX files are
+    // independent documents, so they are parsed in parallel below.
     bool ok = true;
-    for (size_t i = 0; i < children; ++i) {
+    size_t job_count = 0;
+    size_t slot = 0;
+    for (size_t i = 0; i < children && ok; ++i) {
         struct xml_node *child = xml_node_child(root, i);
         if (!tiled_node_name_is(child, "tileset")) continue;
-
-        if (out_map->tileset_count == ts_cap) {
-            ts_cap *= 2;
-            tiled_tileset_t *tmp = (tiled_tileset_t *)realloc(out_map->tilesets, ts_cap * sizeof(tiled_tileset_t));
-            if (!tmp) { ok = false; break; }
-            out_map->tilesets = tmp;
-        }
-
-        tiled_tileset_t *ts = &out_map->tilesets[out_map->tileset_count];
-        memset(ts, 0, sizeof(*ts));
+        tiled_tileset_t *ts = &out_map->tilesets[slot++];
 
         int first_gid = 0;
         if (!tiled_node_attr_int(child, "firstgid", &first_gid)) {
@@ -448,55 +504,67 @@ bool tiled_parse_tilesets_from_root(struct xml_node *root, const char *tmx_path,
         }
 
         char *tsx_rel = tiled_node_attr_strdup(child, "source");
-        bool tileset_ok = false;
         if (tsx_rel && tsx_rel[0] != '\0') {
             char *tsx_path = tiled_join_relative(tmx_path, tsx_rel);
             free(tsx_rel);
             if (!tsx_path) {
                 LOGC(LOGCAT_TILE, LOG_LVL_ERROR, "Could not resolve TSX path");
-            } else {
-                if (parse_tileset(tsx_path, ts)) {
-                    ts->first_gid = first_gid;
-                    char *img_path = tiled_join_relative(tsx_path, ts->image_path);
-                    free(ts->image_path);
-                    ts->image_path = img_path;
-                } else {
-                    char *img_rel = tiled_scan_attr_in_file(tsx_path, "<image", "source");
-                    if (img_rel) {
-                        ts->image_path = tiled_join_relative(tsx_path, img_rel);
-                        free(img_rel);
-                    }
-                }
-
-                if (!ts->image_path || !tiled_file_exists(ts->image_path)) {
-                    free(ts->image_path);
-                    ts->image_path = NULL;
-                    char *img_rel = tiled_scan_attr_in_file(tsx_path, "<image", "source");
-                    if (img_rel) {
-                        ts->image_path = tiled_join_relative(tsx_path, img_rel);
-                        free(img_rel);
-                    }
-                }
-                tileset_ok = ts->image_path != NULL;
-                free(tsx_path);
+                ok = false;
+                break;
             }
+            jobs[job_count++] = (tsx_job_t){ .ts = ts, .tsx_path = tsx_path, .first_gid = first_gid };
         } else {
             free(tsx_rel);
-            tileset_ok = parse_tileset_inline(child, tmx_path, ts);
-            if (tileset_ok) {
+            ok = parse_tileset_inline(child, tmx_path, ts, &out_map->anim_arena);
+            if (ok) {
                 ts->first_gid = first_gid;
             }
         }
+    }
 
-        if (!tileset_ok) {
-            ok = false;
-            break;
-        }
-        out_map->tileset_count++;
+    if (ok) parallel_for(job_count, parse_external_tileset, jobs);
+
+    for (size_t j = 0; j < job_count; ++j) {
+        tsx_job_t *job = &jobs[j];
+        if (ok && !job->ok) ok = false;
+        if (ok && !adopt_tileset_frames(job->ts, &out_map->anim_arena)) ok = false;
+        free(job->tsx_path);
+        bump_free(&job->arena);
     }
+    free(jobs);
 
-    if (!ok || out_map->tileset_count == 0) {
+    if (!ok) {
         return false;
     }
-    return true;
+    return build_gid_index(out_map);
+}
+
+bool tiled_reload_tileset_colliders(tiled_tileset_t *ts) {
+    if (!ts || !ts->source_path) return false;
+
+    // Only the collider arrays are kept, so the fresh animation frames go to a scratch arena.
+    tiled_tileset_t fresh;
+    bump_alloc_t scratch = {0};
+    if (!parse_tileset(ts->source_path, &fresh, &scratch)) {
+        bump_free(&scratch);
+        return false;
+    }
+
+    bool ok = fresh.tilecount == ts->tilecount;
+    if (ok) {
+        uint16_t *colliders = ts->colliders;
+        bool *no_merge = ts->no_merge_collider;
+        ts->colliders = fresh.colliders;
+        ts->no_merge_collider = fresh.no_merge_collider;
+        fresh.colliders = colliders;
+        fresh.no_merge_collider = no_merge;
+    } else {
+        LOGC(LOGCAT_TILE, LOG_LVL_WARN, "TSX %s: tilecount changed (%d -> %d), reload the map instead",
+             ts->source_path, ts->tilecount, fresh.tilecount);
+    }
+
+    tiled_free_tile_arrays(&fresh);
+    free(fresh.image_path);
+    bump_free(&scratch);
+    return ok;
 }
@@ -3,6 +3,10 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
+
+#include "modules/common/atom.h"
+#include "modules/common/hashmap.h"
+
 // TMX global tile IDs (GIDs) encode flip flags in the top bits.
 // Ref: https://doc.mapeditor.org/en/stable/reference/tmx-map-format/
 #define TILED_FLIPPED_HORIZONTALLY_FLAG 0x80000000u
@@ -24,6 +28,7 @@ static inline uint32_t tiled_gid_strip_flags(uint32_t raw_gid,
 typedef struct {
     int tile_id;
     int duration_ms;
+    int end_ms; // running total of durations through this frame
 } tiled_anim_frame_t;
 
 typedef struct {
@@ -32,6 +37,34 @@ typedef struct {
     int total_duration_ms;
 } tiled_animation_t;
 
+// Frame showing t_ms into the animation played forward: the first whose end_ms is past t_ms,
+// or the last frame once t_ms reaches the total. Binary search over the end_ms prefix sums.
+static inline size_t tiled_anim_frame_at(const tiled_animation_t* anim, double t_ms)
+{
+    size_t lo = 0, hi = anim->frame_count;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if ((double)anim->frames[mid].end_ms <= t_ms) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo < anim->frame_count ? lo : anim->frame_count - 1;
+}
+
+// Same, played backward from the last frame: the last frame starting before total - t_ms, or
+// the first frame once t_ms reaches the total.
+static inline size_t tiled_anim_frame_at_reversed(const tiled_animation_t* anim, double t_ms)
+{
+    const double from_end = (double)anim->total_duration_ms - t_ms;
+    size_t lo = 0, hi = anim->frame_count;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        const int start_ms = anim->frames[mid].end_ms - anim->frames[mid].duration_ms;
+        if ((double)start_ms < from_end) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo > 0 ? lo - 1 : 0;
+}
+
 typedef struct {
     int tilewidth;
     int tileheight;
@@ -41,6 +74,7 @@ typedef struct {
     int image_width;
     int image_height;
     char *image_path;
+    char *source_path;          // TSX path joined onto the TMX directory, not normalised; NULL when embedded
     uint16_t *colliders;
     bool *no_merge_collider;
     tiled_animation_t *anims;
@@ -50,6 +84,7 @@ typedef struct {
 
 typedef struct {
     char *name;
+    atom_t name_atom;
     int width;
     int height;
     uint32_t *gids;
@@ -61,8 +96,18 @@ typedef struct {
     char *name;
     char *type;
     char *value;
+    atom_t atom; // atom_intern_ci(name)
 } tiled_property_t;
 
+// One per property, sorted by atom (then file order), for binary-search lookup.
+typedef struct {
+    atom_t   atom;
+    uint32_t index; // into tiled_object_t.properties
+} tiled_prop_key_t;
+
+// GID -> index into world_map_t.tilesets, for every tile of every tileset.
+HM_DECLARE(tiled_gid_index, uint32_t, uint16_t, hm_hash_u32, hm_eq_u32, MEM_TAG_TILED)
+
 typedef struct {
     int id;
     uint32_t gid;
@@ -76,4 +121,5 @@ typedef struct {
     int   door_tiles[4][2];
     size_t property_count;
     tiled_property_t *properties;
+    tiled_prop_key_t *prop_keys;  // property_count entries
 } tiled_object_t;
@@ -1,4 +1,5 @@
 #include "modules/tiled/tiled_internal.h"
+#include "modules/common/mem_tag.h"
 #include "modules/core/logger.h"
 
 #include <ctype.h>
@@ -17,6 +18,16 @@ char *tiled_xstrdup(const char *s) {
     return p;
 }
 
+void *tiled_shrink_array(void *p, size_t cap, size_t count, size_t elem) {
+    if (!p || count >= cap) return p;
+    if (count == 0) {
+        mem_free(MEM_TAG_TILED, p, cap * elem);
+        return NULL;
+    }
+    void *q = mem_realloc(MEM_TAG_TILED, p, cap * elem, count * elem);
+    return q ? q : p;
+}
+
 char *tiled_xml_string_dup(struct xml_string *xs) {
     if (!xs) return NULL;
     size_t len = xml_string_length(xs);
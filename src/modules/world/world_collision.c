@@ -1,6 +1,9 @@
 #include "modules/world/world_collision_internal.h"
+#include "modules/world/world_stream_internal.h"
 #include "modules/world/world.h"
 #include "modules/core/logger.h"
+#include "modules/common/mem_tag.h"
+#include "modules/common/parallel.h"
 
 #include <math.h>
 #include <stdlib.h>
@@ -14,22 +17,24 @@
 #error "WORLD_TILE_SIZE must be divisible by WORLD_SUBTILE_SIZE"
 #endif
 
-typedef struct {
+struct world_collision_grid {
     int w, h;          // tiles
     int tile_size;     // pixels per tile
     world_tile_t* tiles;
     uint16_t* subtile_masks;
     bool* dynamic_tiles; // per-tile flag (derived from tileset property)
-} world_collision_grid_t;
+    bool streamed;       // arrays unused; cells come from world_stream
+};
 
 static world_collision_grid_t g_collision = { .tile_size = WORLD_TILE_SIZE };
 
 static void collision_grid_reset(world_collision_grid_t* grid)
 {
     if (!grid) return;
-    free(grid->tiles);
-    free(grid->subtile_masks);
-    free(grid->dynamic_tiles);
+    const size_t count = grid->tiles ? (size_t)grid->w * (size_t)grid->h : 0;
+    mem_free(MEM_TAG_WORLD, grid->tiles, count * sizeof(world_tile_t));
+    mem_free(MEM_TAG_WORLD, grid->subtile_masks, count * sizeof(uint16_t));
+    mem_free(MEM_TAG_WORLD, grid->dynamic_tiles, count * sizeof(bool));
     *grid = (world_collision_grid_t){ .tile_size = WORLD_TILE_SIZE };
 }
 
@@ -74,6 +79,13 @@ static uint16_t flip_mask_v(uint16_t mask)
 static const tiled_tileset_t* tileset_for_gid_runtime(const world_map_t* map, uint32_t gid, int* out_local)
 {
     if (!map) return NULL;
+    if (map->gid_tilesets.size) {
+        const uint16_t* ti = tiled_gid_index_get(&map->gid_tilesets, gid);
+        if (!ti) return NULL;
+        const tiled_tileset_t* ts = &map->tilesets[*ti];
+        if (out_local) *out_local = (int)gid - ts->first_gid;
+        return ts;
+    }
     for (size_t i = 0; i < map->tileset_count; ++i) {
         const tiled_tileset_t* ts = &map->tilesets[i];
         int local = (int)gid - ts->first_gid;
@@ -113,28 +125,26 @@ bool world_collision_decode_raw_gid(const world_map_t* map, uint32_t raw_gid, ui
     return true;
 }
 
-static bool layer_is_collision(tiled_layer_t* layer, const char* collision_layer_name, bool allow_mark)
+static bool layer_is_collision(tiled_layer_t* layer, atom_t collision_atom, const char* collision_layer_name)
 {
     if (!layer) return false;
     if (layer->collision) return true;
     if (!collision_layer_name || !layer->name) return false;
-    if (strcmp(layer->name, collision_layer_name) != 0) return false;
-    if (allow_mark) layer->collision = true;
+    // Parsed layers carry an interned name; hand-built ones fall back to the string.
+    const bool match = (layer->name_atom != ATOM_NONE)
+        ? layer->name_atom == collision_atom
+        : strcmp(layer->name, collision_layer_name) == 0;
+    if (!match) return false;
+    layer->collision = true;
     return true;
 }
 
-static uint32_t collision_raw_gid_build(world_map_t* map, int tx, int ty, const char* collision_layer_name)
+static void mark_collision_layers(world_map_t* map, const char* collision_layer_name)
 {
-    for (size_t li = map->layer_count; li-- > 0; ) {
-        tiled_layer_t* layer = &map->layers[li];
-        if (!layer_is_collision(layer, collision_layer_name, true)) continue;
-        if (tx >= layer->width || ty >= layer->height) continue;
-        if (!layer->gids) continue;
-        uint32_t gid = layer->gids[(size_t)ty * (size_t)layer->width + (size_t)tx];
-        if (gid == 0) continue;
-        return gid;
+    const atom_t collision_atom = atom_find(collision_layer_name);
+    for (size_t li = 0; li < map->layer_count; ++li) {
+        layer_is_collision(&map->layers[li], collision_atom, collision_layer_name);
     }
-    return 0;
 }
 
 static uint32_t collision_raw_gid_runtime(const world_map_t* map, int tx, int ty)
@@ -165,47 +175,133 @@ static void collision_grid_write_cell(world_collision_grid_t* grid, const world_
     if (grid->dynamic_tiles) grid->dynamic_tiles[idx] = dyn;
 }
 
-bool world_collision_build_from_map(world_map_t* map, const char* collision_layer_name)
+static void warn_tile_size(const world_map_t* map)
 {
-    if (!map) return false;
     if (map->tilewidth != WORLD_TILE_SIZE || map->tileheight != WORLD_TILE_SIZE) {
         LOGC(LOGCAT_WORLD, LOG_LVL_WARN, "world: TMX tile size %dx%d differs from engine tile size %d", map->tilewidth, map->tileheight, WORLD_TILE_SIZE);
     }
+}
 
-    const size_t count = (size_t)map->width * (size_t)map->height;
-    world_tile_t* tiles = (world_tile_t*)malloc(count * sizeof(world_tile_t));
-    uint16_t* masks = (uint16_t*)malloc(count * sizeof(uint16_t));
-    bool* dynamic = (bool*)malloc(count * sizeof(bool));
-    if (!tiles || !masks || !dynamic) {
-        LOGC(LOGCAT_WORLD, LOG_LVL_ERROR, "world: out of memory for collision (%d x %d)", map->width, map->height);
-        free(tiles);
-        free(masks);
-        free(dynamic);
-        return false;
+// Dense gid -> (mask | COLLISION_GID_DYNAMIC) table for a grid build, so decoding a tile is
+// an indexed read instead of a tileset lookup. Maps whose gids run past the cap decode per tile.
+#define COLLISION_GID_DYNAMIC   (1u << 16)
+#define COLLISION_GID_TABLE_MAX ((size_t)1 << 22)
+#define COLLISION_BAND_ROWS     16
+
+typedef struct {
+    uint32_t* entries; // indexed by gid without flip flags
+    size_t    count;
+} collision_gid_table_t;
+
+static bool collision_gid_table_build(collision_gid_table_t* t, const world_map_t* map)
+{
+    *t = (collision_gid_table_t){0};
+    size_t count = 0;
+    for (size_t i = 0; i < map->tileset_count; ++i) {
+        const tiled_tileset_t* ts = &map->tilesets[i];
+        if (ts->first_gid < 0 || ts->tilecount <= 0) continue;
+        const size_t end = (size_t)ts->first_gid + (size_t)ts->tilecount;
+        if (end > count) count = end;
     }
-    for (size_t i = 0; i < count; ++i) {
-        tiles[i] = WORLD_TILE_WALKABLE;
-        masks[i] = 0;
-        dynamic[i] = false;
+    if (count == 0 || count > COLLISION_GID_TABLE_MAX) return false;
+    t->entries = (uint32_t*)mem_calloc(MEM_TAG_WORLD, count, sizeof(uint32_t));
+    if (!t->entries) return false;
+    t->count = count;
+    // Back to front so the earliest tileset covering a gid wins, as in the lookup it replaces.
+    for (size_t i = map->tileset_count; i-- > 0;) {
+        const tiled_tileset_t* ts = &map->tilesets[i];
+        if (ts->first_gid < 0) continue;
+        for (int local = 0; local < ts->tilecount; ++local) {
+            uint32_t e = ts->colliders ? ts->colliders[local] : 0;
+            if (ts->no_merge_collider && ts->no_merge_collider[local]) e |= COLLISION_GID_DYNAMIC;
+            t->entries[(size_t)ts->first_gid + (size_t)local] = e;
+        }
     }
+    return true;
+}
 
-    for (int y = 0; y < map->height; ++y) {
+static void collision_gid_table_free(collision_gid_table_t* t)
+{
+    mem_free(MEM_TAG_WORLD, t->entries, t->count * sizeof(uint32_t));
+    *t = (collision_gid_table_t){0};
+}
+
+static void collision_decode_cell(const world_map_t* map, const collision_gid_table_t* t, uint32_t raw_gid, uint16_t* out_mask, bool* out_dynamic)
+{
+    *out_mask = 0;
+    *out_dynamic = false;
+    if (raw_gid == 0) return;
+    if (!t->entries) {
+        world_collision_decode_raw_gid(map, raw_gid, out_mask, out_dynamic);
+        return;
+    }
+    bool flip_h = false, flip_v = false;
+    const uint32_t gid = tiled_gid_strip_flags(raw_gid, &flip_h, &flip_v, NULL);
+    if (gid == 0 || gid >= t->count) return;
+    const uint32_t e = t->entries[gid];
+    uint16_t mask = (uint16_t)e;
+    if (flip_h) mask = flip_mask_h(mask);
+    if (flip_v) mask = flip_mask_v(mask);
+    *out_mask = mask;
+    *out_dynamic = (e & COLLISION_GID_DYNAMIC) != 0;
+}
+
+typedef struct {
+    const world_map_t*           map;
+    const collision_gid_table_t* table;
+    world_tile_t*                tiles;
+    uint16_t*                    masks;
+    bool*                        dynamic;
+} collision_band_job_t;
+
+// Rows [band * COLLISION_BAND_ROWS, +COLLISION_BAND_ROWS): bands write disjoint cells.
+static void collision_build_band(void* user, size_t band)
+{
+    const collision_band_job_t* job = (const collision_band_job_t*)user;
+    const world_map_t* map = job->map;
+    const int y0 = (int)band * COLLISION_BAND_ROWS;
+    const int y1 = (y0 + COLLISION_BAND_ROWS < map->height) ? y0 + COLLISION_BAND_ROWS : map->height;
+    for (int y = y0; y < y1; ++y) {
         for (int x = 0; x < map->width; ++x) {
-            uint32_t raw_gid = collision_raw_gid_build(map, x, y, collision_layer_name);
             const size_t idx = (size_t)y * (size_t)map->width + (size_t)x;
-            uint16_t mask = 0;
-            bool dyn = false;
-            if (raw_gid != 0) {
-                world_collision_decode_raw_gid(map, raw_gid, &mask, &dyn);
-            }
-            masks[idx] = mask;
-            tiles[idx] = (mask == subtile_full_mask()) ? WORLD_TILE_SOLID : WORLD_TILE_WALKABLE;
-            dynamic[idx] = dyn;
+            uint16_t mask;
+            bool dyn;
+            collision_decode_cell(map, job->table, collision_raw_gid_runtime(map, x, y), &mask, &dyn);
+            job->masks[idx] = mask;
+            job->tiles[idx] = (mask == subtile_full_mask()) ? WORLD_TILE_SOLID : WORLD_TILE_WALKABLE;
+            job->dynamic[idx] = dyn;
         }
     }
+}
 
-    collision_grid_reset(&g_collision);
-    g_collision = (world_collision_grid_t){
+world_collision_grid_t* world_collision_grid_build(world_map_t* map, const char* collision_layer_name)
+{
+    if (!map) return NULL;
+    warn_tile_size(map);
+
+    world_collision_grid_t* grid = (world_collision_grid_t*)mem_alloc(MEM_TAG_WORLD, sizeof(*grid));
+    const size_t count = (size_t)map->width * (size_t)map->height;
+    world_tile_t* tiles = (world_tile_t*)mem_alloc(MEM_TAG_WORLD, count * sizeof(world_tile_t));
+    uint16_t* masks = (uint16_t*)mem_alloc(MEM_TAG_WORLD, count * sizeof(uint16_t));
+    bool* dynamic = (bool*)mem_alloc(MEM_TAG_WORLD, count * sizeof(bool));
+    if (!grid || !tiles || !masks || !dynamic) {
+        LOGC(LOGCAT_WORLD, LOG_LVL_ERROR, "world: out of memory for collision (%d x %d)", map->width, map->height);
+        mem_free(MEM_TAG_WORLD, grid, sizeof(*grid));
+        mem_free(MEM_TAG_WORLD, tiles, count * sizeof(world_tile_t));
+        mem_free(MEM_TAG_WORLD, masks, count * sizeof(uint16_t));
+        mem_free(MEM_TAG_WORLD, dynamic, count * sizeof(bool));
+        return NULL;
+    }
+
+    mark_collision_layers(map, collision_layer_name);
+    collision_gid_table_t table;
+    collision_gid_table_build(&table, map); // on failure every cell decodes through the map
+    collision_band_job_t job = { map, &table, tiles, masks, dynamic };
+    const size_t bands = map->height > 0 ? ((size_t)map->height + COLLISION_BAND_ROWS - 1) / COLLISION_BAND_ROWS : 0;
+    parallel_for(bands, collision_build_band, &job);
+    collision_gid_table_free(&table);
+
+    *grid = (world_collision_grid_t){
         .w = map->width,
         .h = map->height,
         .tile_size = WORLD_TILE_SIZE,
@@ -213,8 +309,53 @@ bool world_collision_build_from_map(world_map_t* map, const char* collision_laye
         .subtile_masks = masks,
         .dynamic_tiles = dynamic,
     };
+    return grid;
+}
 
-    return true;
+world_collision_grid_t* world_collision_grid_build_streamed(world_map_t* map, const char* collision_layer_name)
+{
+    if (!map) return NULL;
+    warn_tile_size(map);
+    mark_collision_layers(map, collision_layer_name);
+
+    world_collision_grid_t* grid = (world_collision_grid_t*)mem_alloc(MEM_TAG_WORLD, sizeof(*grid));
+    if (!grid) return NULL;
+    *grid = (world_collision_grid_t){
+        .w = map->width,
+        .h = map->height,
+        .tile_size = WORLD_TILE_SIZE,
+        .streamed = true,
+    };
+    return grid;
+}
+
+void world_collision_grid_install(world_collision_grid_t* grid)
+{
+    if (!grid) return;
+    collision_grid_reset(&g_collision);
+    g_collision = *grid;
+    mem_free(MEM_TAG_WORLD, grid, sizeof(*grid));
+}
+
+void world_collision_grid_free(world_collision_grid_t* grid)
+{
+    if (!grid) return;
+    collision_grid_reset(grid);
+    mem_free(MEM_TAG_WORLD, grid, sizeof(*grid));
+}
+
+bool world_collision_build_from_map(world_map_t* map, const char* collision_layer_name)
+{
+    world_collision_grid_t* grid = world_collision_grid_build(map, collision_layer_name);
+    world_collision_grid_install(grid);
+    return grid != NULL;
+}
+
+bool world_collision_build_streamed(world_map_t* map, const char* collision_layer_name)
+{
+    world_collision_grid_t* grid = world_collision_grid_build_streamed(map, collision_layer_name);
+    world_collision_grid_install(grid);
+    return grid != NULL;
 }
 
 void world_collision_shutdown(void)
@@ -225,6 +366,10 @@ void world_collision_shutdown(void)
 void world_collision_refresh_tile(const world_map_t* map, int tx, int ty)
 {
     if (!map) return;
+    if (g_collision.streamed) {
+        world_stream_refresh_cell(tx, ty);
+        return;
+    }
     if (!g_collision.tiles || !g_collision.subtile_masks) return;
     if (tx < 0 || ty < 0 || tx >= map->width || ty >= map->height) return;
 
@@ -247,6 +392,11 @@ void world_size_px(int* out_w, int* out_h)
 
 world_tile_t world_tile_at(int tx, int ty)
 {
+    if (g_collision.streamed) {
+        uint16_t mask = 0;
+        if (!world_stream_cell(tx, ty, &mask, NULL)) return WORLD_TILE_VOID;
+        return (mask == subtile_full_mask()) ? WORLD_TILE_SOLID : WORLD_TILE_WALKABLE;
+    }
     if (tx < 0 || ty < 0 || tx >= g_collision.w || ty >= g_collision.h || !g_collision.tiles) {
         return WORLD_TILE_VOID;
     }
@@ -255,6 +405,12 @@ world_tile_t world_tile_at(int tx, int ty)
 
 uint16_t world_subtile_mask_at(int tx, int ty)
 {
+    if (g_collision.streamed) {
+        if (tx < 0 || ty < 0 || tx >= g_collision.w || ty >= g_collision.h) return 0;
+        // Chunks that aren't resident are solid so nothing wanders into them.
+        uint16_t mask = 0;
+        return world_stream_cell(tx, ty, &mask, NULL) ? mask : subtile_full_mask();
+    }
     if (tx < 0 || ty < 0 || tx >= g_collision.w || ty >= g_collision.h || !g_collision.subtile_masks) {
         return 0;
     }
@@ -263,6 +419,10 @@ uint16_t world_subtile_mask_at(int tx, int ty)
 
 bool world_tile_is_dynamic(int tx, int ty)
 {
+    if (g_collision.streamed) {
+        bool dyn = false;
+        return world_stream_cell(tx, ty, NULL, &dyn) && dyn;
+    }
     if (tx < 0 || ty < 0 || tx >= g_collision.w || ty >= g_collision.h || !g_collision.dynamic_tiles) {
         return false;
     }
@@ -272,7 +432,7 @@ bool world_tile_is_dynamic(int tx, int ty)
 bool world_is_walkable_subtile(int sx, int sy)
 {
     if (sx < 0 || sy < 0) return false;
-    if (!g_collision.tiles || !g_collision.subtile_masks) return false;
+    if (!g_collision.streamed && (!g_collision.tiles || !g_collision.subtile_masks)) return false;
     const int subtiles_per_tile = WORLD_SUBTILES_PER_TILE;
     if (subtiles_per_tile <= 0 || g_collision.w <= 0 || g_collision.h <= 0) return false;
 
@@ -284,8 +444,13 @@ bool world_is_walkable_subtile(int sx, int sy)
     int local_y = sy % subtiles_per_tile;
     int bit = local_y * subtiles_per_tile + local_x;
 
-    size_t idx = (size_t)tile_y * (size_t)g_collision.w + (size_t)tile_x;
-    uint16_t mask = g_collision.subtile_masks ? g_collision.subtile_masks[idx] : 0;
+    uint16_t mask = 0;
+    if (g_collision.streamed) {
+        mask = world_subtile_mask_at(tile_x, tile_y);
+    } else {
+        size_t idx = (size_t)tile_y * (size_t)g_collision.w + (size_t)tile_x;
+        mask = g_collision.subtile_masks[idx];
+    }
     return (mask & (uint16_t)(1u << bit)) == 0;
 }
 
@@ -6,5 +6,15 @@
 // Derived collision grid helpers used by the world map owner when tiles change.
 bool world_collision_decode_raw_gid(const world_map_t* map, uint32_t raw_gid, uint16_t* out_mask, bool* out_dynamic);
 bool world_collision_build_from_map(world_map_t* map, const char* collision_layer_name);
+// Streamed maps: no dense grid; cell queries go to the resident chunks (world_stream_internal.h).
+bool world_collision_build_streamed(world_map_t* map, const char* collision_layer_name);
+
+// The same builds into a detached grid (no global state, so safe on the map preload thread);
+// install swaps it in as the live grid and takes ownership.
+typedef struct world_collision_grid world_collision_grid_t;
+world_collision_grid_t* world_collision_grid_build(world_map_t* map, const char* collision_layer_name);
+world_collision_grid_t* world_collision_grid_build_streamed(world_map_t* map, const char* collision_layer_name);
+void world_collision_grid_install(world_collision_grid_t* grid);
+void world_collision_grid_free(world_collision_grid_t* grid);
 void world_collision_shutdown(void);
 void world_collision_refresh_tile(const world_map_t* map, int tx, int ty);
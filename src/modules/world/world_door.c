@@ -1,10 +1,13 @@
+#define DA_MEM_TAG MEM_TAG_WORLD
 #include "modules/world/world_door.h"
 #include "modules/world/world_map.h"
 #include "modules/world/world_renderer.h"
 #include "modules/common/dynarray.h"
+#include "modules/common/mem_tag.h"
 
 #include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
 
 typedef struct {
     int layer_idx;
@@ -43,23 +46,8 @@ static int door_frame_at(const tiled_tileset_t* ts, int base_tile, float t_ms, b
     tiled_animation_t* anim = ts->anims ? &ts->anims[base_tile] : NULL;
     if (!anim || anim->frame_count == 0 || anim->total_duration_ms <= 0) return base_tile;
 
-    int frame = base_tile;
-    if (opening) {
-        int acc = 0;
-        for (size_t i = 0; i < anim->frame_count; ++i) {
-            acc += anim->frames[i].duration_ms;
-            if (t_ms < acc) { frame = anim->frames[i].tile_id; break; }
-        }
-        if (t_ms >= anim->total_duration_ms) frame = anim->frames[anim->frame_count - 1].tile_id;
-    } else {
-        int acc = 0;
-        for (size_t i = anim->frame_count; i-- > 0; ) {
-            acc += anim->frames[i].duration_ms;
-            if (t_ms < acc) { frame = anim->frames[i].tile_id; break; }
-        }
-        if (t_ms >= anim->total_duration_ms) frame = anim->frames[0].tile_id;
-    }
-    return frame;
+    const size_t i = opening ? tiled_anim_frame_at(anim, t_ms) : tiled_anim_frame_at_reversed(anim, t_ms);
+    return anim->frames[i].tile_id;
 }
 
 static bool resolve_record(world_door_record_t* rec)
@@ -74,6 +62,9 @@ static bool resolve_record(world_door_record_t* rec)
     const uint32_t FLIP_MASK = 0xE0000000u;
     const uint32_t GID_MASK = TILED_GID_MASK;
 
+    // Streamed chunks that aren't resident read as empty; leave their tiles unresolved and
+    // try again on the next call rather than caching the holes.
+    bool complete = true;
     for (size_t i = 0; i < rec->tile_count; ++i) {
         world_door_tile_t* tile = &rec->tiles[i];
         tile->info.layer_idx = -1;
@@ -83,12 +74,13 @@ static bool resolve_record(world_door_record_t* rec)
 
         int tx = tile->coord.x;
         int ty = tile->coord.y;
+        if (!world_tile_resident(tx, ty)) {
+            complete = false;
+            continue;
+        }
         uint32_t raw_gid = 0;
         for (size_t li = map->layer_count; li-- > 0; ) {
-            const tiled_layer_t* layer = &map->layers[li];
-            if (!layer->gids) continue;
-            if (tx < 0 || ty < 0 || tx >= layer->width || ty >= layer->height) continue;
-            uint32_t gid = layer->gids[(size_t)ty * (size_t)layer->width + (size_t)tx];
+            uint32_t gid = world_layer_gid((int)li, tx, ty);
             if (gid == 0) continue;
             raw_gid = gid;
             tile->info.layer_idx = (int)li;
@@ -126,7 +118,7 @@ static bool resolve_record(world_door_record_t* rec)
         }
     }
 
-    rec->resolved_map_gen = current_gen;
+    rec->resolved_map_gen = complete ? current_gen : 0;
     return true;
 }
 
@@ -146,11 +138,13 @@ static void apply_record(world_door_record_t* rec, float t_ms, bool play_forward
         if ((size_t)tsi >= map->tileset_count) continue;
         const tiled_tileset_t* ts = &map->tilesets[(size_t)tsi];
         const tiled_layer_t* layer = &map->layers[(size_t)li];
-        if (!ts || !layer || !layer->gids) continue;
+        if (!ts || !layer) continue;
         int frame_tile = door_frame_at(ts, base, t_ms, play_forward);
         int tx = tile->coord.x;
         int ty = tile->coord.y;
         if (tx < 0 || ty < 0 || tx >= layer->width || ty >= layer->height) continue;
+        // The edit would be dropped; the door system re-applies every tick once it's back.
+        if (!world_tile_resident(tx, ty)) continue;
         uint32_t gid = (uint32_t)(ts->first_gid + frame_tile) | tile->info.flip_flags;
         world_set_tile_gid(li, tx, ty, gid);
     }
@@ -171,12 +165,12 @@ world_door_handle_t world_door_register(const door_tile_xy_t* tile_xy, size_t ti
     }
 
     world_door_record_t* rec = &g_world_doors.data[idx];
+    mem_free(MEM_TAG_WORLD, rec->tiles, rec->tile_count * sizeof(world_door_tile_t));
     rec->active = true;
     rec->tile_count = tile_count;
     rec->resolved_map_gen = 0;
     rec->primary_anim_total_ms = 0;
-    free(rec->tiles);
-    rec->tiles = (world_door_tile_t*)malloc(tile_count * sizeof(world_door_tile_t));
+    rec->tiles = (world_door_tile_t*)mem_alloc(MEM_TAG_WORLD, tile_count * sizeof(world_door_tile_t));
     if (!rec->tiles) {
         rec->active = false;
         rec->tile_count = 0;
@@ -198,7 +192,7 @@ void world_door_unregister(world_door_handle_t handle)
 {
     world_door_record_t* rec = record_from_handle(handle);
     if (!rec) return;
-    free(rec->tiles);
+    mem_free(MEM_TAG_WORLD, rec->tiles, rec->tile_count * sizeof(world_door_tile_t));
     rec->tiles = NULL;
     rec->tile_count = 0;
     rec->resolved_map_gen = 0;
@@ -226,10 +220,68 @@ void world_door_shutdown(void)
 {
     for (size_t i = 0; i < g_world_doors.size; ++i) {
         if (!g_world_doors.data[i].active) continue;
-        free(g_world_doors.data[i].tiles);
+        mem_free(MEM_TAG_WORLD, g_world_doors.data[i].tiles, g_world_doors.data[i].tile_count * sizeof(world_door_tile_t));
         g_world_doors.data[i].tiles = NULL;
         g_world_doors.data[i].tile_count = 0;
         g_world_doors.data[i].active = false;
     }
     DA_FREE(&g_world_doors);
 }
+
+void world_door_snapshot_write(snap_buf_t* b)
+{
+    snap_write_tag(b, SNAP_TAG('D','O','O','R'));
+    // Free records past the last live one are left over from earlier maps; leave them out so
+    // the same spawn writes the same bytes whatever was loaded before it.
+    size_t count = g_world_doors.size;
+    while (count > 0 && !g_world_doors.data[count - 1].active) --count;
+    const uint32_t count32 = (uint32_t)count;
+    SNAP_WRITE_VAL(b, count32);
+    for (size_t i = 0; i < count; ++i) {
+        const world_door_record_t* rec = &g_world_doors.data[i];
+        uint32_t tile_count = rec->active ? (uint32_t)rec->tile_count : 0;
+        SNAP_WRITE_VAL(b, tile_count);
+        for (uint32_t t = 0; t < tile_count; ++t) {
+            SNAP_WRITE_VAL(b, rec->tiles[t].coord);
+        }
+    }
+}
+
+// Records are rebuilt slot for slot; tile info re-resolves lazily against the current map.
+bool world_door_snapshot_read(snap_reader_t* r)
+{
+    uint32_t count = 0;
+    if (!snap_expect_tag(r, SNAP_TAG('D','O','O','R')) || !SNAP_READ_VAL(r, count)) return false;
+    if (count > (uint32_t)(r->size - r->pos) / sizeof(uint32_t)) {
+        r->failed = true;
+        return false;
+    }
+
+    for (size_t i = 0; i < g_world_doors.size; ++i) {
+        mem_free(MEM_TAG_WORLD, g_world_doors.data[i].tiles, g_world_doors.data[i].tile_count * sizeof(world_door_tile_t));
+    }
+    DA_RESERVE(&g_world_doors, count);
+    g_world_doors.size = count;
+    memset(g_world_doors.data, 0, count * sizeof(world_door_record_t));
+
+    for (uint32_t i = 0; i < count; ++i) {
+        world_door_record_t* rec = &g_world_doors.data[i];
+        uint32_t tile_count = 0;
+        if (!SNAP_READ_VAL(r, tile_count)) return false;
+        if (tile_count == 0) continue;
+        if (tile_count > (uint32_t)(r->size - r->pos) / sizeof(door_tile_xy_t)) {
+            r->failed = true;
+            return false;
+        }
+
+        rec->tiles = (world_door_tile_t*)mem_alloc(MEM_TAG_WORLD, tile_count * sizeof(world_door_tile_t));
+        if (!rec->tiles) return false;
+        rec->active = true;
+        rec->tile_count = tile_count;
+        for (uint32_t t = 0; t < tile_count; ++t) {
+            SNAP_READ_VAL(r, rec->tiles[t].coord);
+            rec->tiles[t].info = (world_door_tile_info_t){ -1, -1, -1, 0 };
+        }
+    }
+    return !r->failed;
+}
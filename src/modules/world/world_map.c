@@ -1,12 +1,20 @@
+#define DA_MEM_TAG MEM_TAG_WORLD
 #include "modules/world/world.h"
 #include "modules/systems/systems_registration.h"
 #include "modules/world/world_collision_internal.h"
 #include "modules/world/world_door.h"
+#include "modules/world/world_stream.h"
+#include "modules/world/world_stream_internal.h"
+#include "modules/core/build_config.h"
 #include "modules/core/logger.h"
 #include "modules/common/dynarray.h"
+#include "modules/common/mem_tag.h"
+#include "modules/common/path_util.h"
 #include "modules/tiled/tiled.h"
 
 #include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 typedef struct {
@@ -20,37 +28,111 @@ static world_map_t g_world_map = {0};
 static bool g_tiled_ready = false;
 static DA(world_tile_edit_t) g_tile_edits = {0};
 static uint32_t g_map_gen = 0;
+static size_t g_stream_min_tiles = WORLD_STREAM_MIN_TILES;
+static world_tile_edit_fn g_edit_listener;
+static void* g_edit_listener_user;
 
 static void world_unload_map(void)
 {
+    world_stream_install(NULL, NULL);
     if (g_tiled_ready) {
         tiled_free_map(&g_world_map);
         g_tiled_ready = false;
     }
 }
 
-bool world_load_from_tmx(const char* tmx_path, const char* collision_layer_name)
+void world_set_stream_min_tiles(size_t tiles)
+{
+    g_stream_min_tiles = tiles;
+}
+
+// tiled_gid_sink_t callbacks: big maps send their tile rows to a new stream instead of layer->gids.
+static bool stream_sink_begin(void* user, int width, int height)
+{
+    world_stream_t** pending = (world_stream_t**)user;
+    if (width <= 0 || height <= 0 || (size_t)width * (size_t)height < g_stream_min_tiles) return false;
+    *pending = world_stream_create(width, height);
+    return *pending != NULL;
+}
+
+static bool stream_sink_rows(void* user, size_t layer_idx, int tx, int ty, const uint32_t* gids, size_t count)
+{
+    return world_stream_write_rows(*(world_stream_t**)user, layer_idx, tx, ty, gids, count);
+}
+
+struct world_prepared_map {
+    world_map_t map;
+    world_stream_t* stream;
+    world_collision_grid_t* grid;
+    char tmx_path[256];
+};
+
+world_prepared_map_t* world_prepare_tmx(const char* tmx_path, const char* collision_layer_name)
 {
-    world_map_t new_map;
-    if (!tiled_load_map(tmx_path, &new_map)) {
+    world_prepared_map_t* p = (world_prepared_map_t*)mem_calloc(MEM_TAG_WORLD, 1, sizeof(*p));
+    if (!p) return NULL;
+    snprintf(p->tmx_path, sizeof(p->tmx_path), "%s", tmx_path ? tmx_path : "(null)");
+
+    const tiled_gid_sink_t sink = { &p->stream, stream_sink_begin, stream_sink_rows };
+    if (!tiled_load_map_streamed(tmx_path, &p->map, &sink)) {
         LOGC(LOGCAT_WORLD, LOG_LVL_ERROR, "world: failed to load TMX '%s'", tmx_path ? tmx_path : "(null)");
-        return false;
+        world_stream_destroy(p->stream);
+        mem_free(MEM_TAG_WORLD, p, sizeof(*p));
+        return NULL;
+    }
+    if (p->stream && !world_stream_finish(p->stream, p->map.layer_count)) {
+        LOGC(LOGCAT_WORLD, LOG_LVL_ERROR, "world: failed to stream TMX '%s'", tmx_path);
+        world_prepared_free(p);
+        return NULL;
     }
 
-    if (!world_collision_build_from_map(&new_map, collision_layer_name)) {
-        tiled_free_map(&new_map);
-        return false;
+    p->grid = p->stream
+        ? world_collision_grid_build_streamed(&p->map, collision_layer_name)
+        : world_collision_grid_build(&p->map, collision_layer_name);
+    if (!p->grid) {
+        world_prepared_free(p);
+        return NULL;
     }
+    return p;
+}
+
+const world_map_t* world_prepared_map(const world_prepared_map_t* prepared)
+{
+    return prepared ? &prepared->map : NULL;
+}
+
+void world_prepared_free(world_prepared_map_t* prepared)
+{
+    if (!prepared) return;
+    world_collision_grid_free(prepared->grid);
+    world_stream_destroy(prepared->stream);
+    tiled_free_map(&prepared->map);
+    mem_free(MEM_TAG_WORLD, prepared, sizeof(*prepared));
+}
+
+void world_install_prepared(world_prepared_map_t* prepared)
+{
+    if (!prepared) return;
 
     world_unload_map();
-    g_world_map = new_map;
+    g_world_map = prepared->map;
     g_tiled_ready = true;
     g_map_gen++;
+    world_collision_grid_install(prepared->grid);
+    world_stream_install(prepared->stream, &g_world_map);
 
     // Drop any pending edits from the previous map.
     DA_CLEAR(&g_tile_edits);
 
-    LOGC(LOGCAT_WORLD, LOG_LVL_INFO, "world: loaded TMX '%s' (%dx%d)", tmx_path, g_world_map.width, g_world_map.height);
+    LOGC(LOGCAT_WORLD, LOG_LVL_INFO, "world: loaded TMX '%s' (%dx%d)", prepared->tmx_path, g_world_map.width, g_world_map.height);
+    mem_free(MEM_TAG_WORLD, prepared, sizeof(*prepared));
+}
+
+bool world_load_from_tmx(const char* tmx_path, const char* collision_layer_name)
+{
+    world_prepared_map_t* prepared = world_prepare_tmx(tmx_path, collision_layer_name);
+    if (!prepared) return false;
+    world_install_prepared(prepared);
     return true;
 }
 
@@ -101,7 +183,7 @@ bool world_set_tile_gid(int layer_idx, int tx, int ty, uint32_t raw_gid)
 
     tiled_layer_t* layer = &g_world_map.layers[(size_t)layer_idx];
     if (tx >= layer->width || ty >= layer->height) return false;
-    if (!layer->gids) return false;
+    if (!layer->gids && !world_stream_active()) return false;
 
     world_tile_edit_t e = { layer_idx, tx, ty, raw_gid };
     DA_APPEND(&g_tile_edits, e);
@@ -121,18 +203,140 @@ void world_apply_tile_edits(void)
         if (e.tx < 0 || e.ty < 0 || e.tx >= g_world_map.width || e.ty >= g_world_map.height) continue;
 
         tiled_layer_t* layer = &g_world_map.layers[(size_t)e.layer_idx];
-        if (!layer->gids) continue;
         if (e.tx >= layer->width || e.ty >= layer->height) continue;
 
-        const size_t idx = (size_t)e.ty * (size_t)layer->width + (size_t)e.tx;
-        layer->gids[idx] = e.raw_gid;
+        if (layer->gids) {
+            layer->gids[(size_t)e.ty * (size_t)layer->width + (size_t)e.tx] = e.raw_gid;
+        } else if (!world_stream_set_gid((size_t)e.layer_idx, e.tx, e.ty, e.raw_gid)) {
+            continue; // chunk paged out since the edit was queued
+        }
 
         if (layer->collision) {
             world_collision_refresh_tile(&g_world_map, e.tx, e.ty);
+            if (g_edit_listener) g_edit_listener(g_edit_listener_user, e.tx, e.ty);
         }
     }
 
     DA_CLEAR(&g_tile_edits);
 }
 
+void world_set_tile_edit_listener(world_tile_edit_fn fn, void* user)
+{
+    g_edit_listener = fn;
+    g_edit_listener_user = user;
+}
+
+static void refresh_collision_for_tileset(const tiled_tileset_t* ts)
+{
+    const uint32_t lo = (uint32_t)ts->first_gid;
+    const uint32_t hi = lo + (uint32_t)ts->tilecount;
+    for (size_t li = 0; li < g_world_map.layer_count; ++li) {
+        const tiled_layer_t* layer = &g_world_map.layers[li];
+        if (!layer->collision || !layer->gids) continue;
+        for (int ty = 0; ty < layer->height && ty < g_world_map.height; ++ty) {
+            for (int tx = 0; tx < layer->width && tx < g_world_map.width; ++tx) {
+                const uint32_t gid = layer->gids[(size_t)ty * (size_t)layer->width + (size_t)tx] & TILED_GID_MASK;
+                if (gid >= lo && gid < hi) world_collision_refresh_tile(&g_world_map, tx, ty);
+            }
+        }
+    }
+}
+
+uint32_t world_layer_gid(int layer_idx, int tx, int ty)
+{
+    if (!g_tiled_ready || layer_idx < 0 || (size_t)layer_idx >= g_world_map.layer_count) return 0;
+    const tiled_layer_t* layer = &g_world_map.layers[(size_t)layer_idx];
+    if (tx < 0 || ty < 0 || tx >= layer->width || ty >= layer->height) return 0;
+    if (!layer->gids) return world_stream_gid((size_t)layer_idx, tx, ty);
+    return layer->gids[(size_t)ty * (size_t)layer->width + (size_t)tx];
+}
+
+bool world_tile_resident(int tx, int ty)
+{
+    if (!g_tiled_ready || tx < 0 || ty < 0 || tx >= g_world_map.width || ty >= g_world_map.height) return false;
+    return !world_stream_active() || world_stream_resident(tx, ty);
+}
+
+bool world_reload_tileset(const char* tsx_path)
+{
+    if (!g_tiled_ready || !tsx_path) return false;
+
+    bool found = false;
+    for (size_t i = 0; i < g_world_map.tileset_count; ++i) {
+        tiled_tileset_t* ts = &g_world_map.tilesets[i];
+        if (!ts->source_path || !path_same(ts->source_path, tsx_path)) continue;
+        found = true;
+        if (tiled_reload_tileset_colliders(ts)) {
+            refresh_collision_for_tileset(ts);
+            world_stream_refresh_all();
+            LOGC(LOGCAT_WORLD, LOG_LVL_INFO, "world: reloaded colliders from '%s'", ts->source_path);
+        }
+    }
+    return found;
+}
+
+void world_snapshot_write(snap_buf_t* b)
+{
+    snap_write_tag(b, SNAP_TAG('W','R','L','D'));
+    uint32_t layer_count = g_tiled_ready ? (uint32_t)g_world_map.layer_count : 0;
+    SNAP_WRITE_VAL(b, layer_count);
+    for (uint32_t li = 0; li < layer_count; ++li) {
+        const tiled_layer_t* layer = &g_world_map.layers[li];
+        uint32_t cells = layer->gids ? (uint32_t)(layer->width * layer->height) : 0;
+        SNAP_WRITE_VAL(b, cells);
+        snap_write(b, layer->gids, cells * sizeof(uint32_t));
+    }
+
+    uint32_t edit_count = (uint32_t)g_tile_edits.size;
+    SNAP_WRITE_VAL(b, edit_count);
+    snap_write(b, g_tile_edits.data, edit_count * sizeof(world_tile_edit_t));
+}
+
+bool world_snapshot_read(snap_reader_t* r)
+{
+    if (world_stream_active()) {
+        // Streamed tiles live in the spill file; a blob of resident chunks can't restore them.
+        r->failed = true;
+        return false;
+    }
+
+    uint32_t layer_count = 0;
+    if (!snap_expect_tag(r, SNAP_TAG('W','R','L','D')) || !SNAP_READ_VAL(r, layer_count)) return false;
+    const uint32_t have_layers = g_tiled_ready ? (uint32_t)g_world_map.layer_count : 0;
+    if (layer_count != have_layers) {
+        r->failed = true;
+        return false;
+    }
+
+    for (uint32_t li = 0; li < layer_count; ++li) {
+        tiled_layer_t* layer = &g_world_map.layers[li];
+        uint32_t cells = 0;
+        if (!SNAP_READ_VAL(r, cells)) return false;
+        const uint32_t have_cells = layer->gids ? (uint32_t)(layer->width * layer->height) : 0;
+        if (cells != have_cells) {
+            r->failed = true;
+            return false;
+        }
+
+        for (uint32_t c = 0; c < cells; ++c) {
+            uint32_t gid = 0;
+            if (!SNAP_READ_VAL(r, gid)) return false;
+            if (layer->gids[c] == gid) continue;
+            layer->gids[c] = gid;
+            if (layer->collision) {
+                world_collision_refresh_tile(&g_world_map, (int)(c % (uint32_t)layer->width), (int)(c / (uint32_t)layer->width));
+            }
+        }
+    }
+
+    uint32_t edit_count = 0;
+    if (!SNAP_READ_VAL(r, edit_count) || edit_count > (uint32_t)(r->size - r->pos) / sizeof(world_tile_edit_t)) {
+        r->failed = true;
+        return false;
+    }
+    DA_RESERVE(&g_tile_edits, edit_count);
+    g_tile_edits.size = edit_count;
+    return snap_read(r, g_tile_edits.data, edit_count * sizeof(world_tile_edit_t));
+}
+
 SYSTEMS_ADAPT_VOID(sys_world_apply_edits_adapt, world_apply_tile_edits)
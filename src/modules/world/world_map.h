@@ -3,6 +3,8 @@
 #include <stdint.h>
 #include <stddef.h>
 #include "modules/tiled/tiled_types.h"
+#include "modules/asset/bump_alloc.h"
+#include "modules/common/snapshot_io.h"
 
 typedef struct {
     int width_tiles;
@@ -20,20 +22,53 @@ typedef struct {
     int tileheight;
     size_t tileset_count;
     tiled_tileset_t *tilesets;
+    tiled_gid_index_t gid_tilesets; // filled by the TMX loader; empty for hand-built maps
     size_t layer_count;
     tiled_layer_t *layers;
     size_t object_count;
     tiled_object_t *objects;
+    bump_alloc_t anim_arena; // tileset animation frames; per map so several maps can be loaded at once
 } world_map_t;
 
 // Lifecycle (owns TMX runtime map)
 bool world_load_from_tmx(const char* tmx_path, const char* collision_layer_name);
 void world_shutdown(void);
 
+// Two-step load for map preloading: prepare parses the TMX and builds its collision without
+// touching the live world (safe on a worker thread); install swaps it in on the main thread and
+// consumes it. world_load_from_tmx is prepare + install.
+typedef struct world_prepared_map world_prepared_map_t;
+world_prepared_map_t* world_prepare_tmx(const char* tmx_path, const char* collision_layer_name);
+const world_map_t*    world_prepared_map(const world_prepared_map_t* prepared);
+void world_install_prepared(world_prepared_map_t* prepared);
+void world_prepared_free(world_prepared_map_t* prepared);
+
+// Maps with at least this many tiles load streamed (world_stream.h); default WORLD_STREAM_MIN_TILES.
+void world_set_stream_min_tiles(size_t tiles);
+
 bool world_has_map(void);
 bool world_get_map_info(world_map_info_t* out);
 uint32_t world_map_generation(void);
 
+// Raw gid of one layer cell. Streamed maps answer 0 for chunks that aren't resident.
+uint32_t world_layer_gid(int layer_idx, int tx, int ty);
+// False outside the map and for streamed chunks that aren't resident, where gids read as holes.
+bool world_tile_resident(int tx, int ty);
+
 // Runtime tile edits (queued; applied later via `world_apply_tile_edits()`).
 bool world_set_tile_gid(int layer_idx, int tx, int ty, uint32_t raw_gid);
 void world_apply_tile_edits(void);
+// Hears every edit applied to a collision layer, after its collision cell is refreshed; physics
+// wakes sleeping bodies there. One listener at a time; NULL clears it.
+typedef void (*world_tile_edit_fn)(void* user, int tx, int ty);
+void world_set_tile_edit_listener(world_tile_edit_fn fn, void* user);
+
+// Hot reload: re-read collider masks of every loaded tileset from tsx_path and refresh the
+// collision cells that use them. Returns false if the current map doesn't use that TSX.
+bool world_reload_tileset(const char* tsx_path);
+
+// Snapshot section: every layer's current gids plus queued edits. Restore only accepts a
+// blob taken from the same loaded map and refreshes collision for tiles that changed. Streamed
+// maps aren't snapshotted (snapshot_capture refuses them).
+void world_snapshot_write(snap_buf_t* b);
+bool world_snapshot_read(snap_reader_t* r);
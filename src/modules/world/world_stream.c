@@ -0,0 +1,634 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+#ifndef _FILE_OFFSET_BITS
+#define _FILE_OFFSET_BITS 64
+#endif
+
+#define DA_MEM_TAG MEM_TAG_WORLD
+#include "modules/world/world_stream.h"
+#include "modules/world/world_stream_internal.h"
+#include "modules/world/world_collision_internal.h"
+#include "modules/core/logger.h"
+#include "modules/common/dynarray.h"
+#include "modules/common/mem_tag.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+#include <pthread.h>
+#include <unistd.h>
+#define WORLD_STREAM_THREADED 1
+#else
+#define WORLD_STREAM_THREADED 0
+#endif
+
+#define CHUNK_CELLS (WORLD_CHUNK_TILES * WORLD_CHUNK_TILES)
+#define CHUNK_BYTES ((uint64_t)CHUNK_CELLS * sizeof(uint32_t))
+#define NO_SLOT     (-1)
+
+typedef enum {
+    SLOT_FREE = 0,
+    SLOT_LOADING,   // owned by the loader until it lands in the done ring
+    SLOT_RESIDENT,
+} slot_state_t;
+
+typedef struct {
+    slot_state_t state;
+    int       chunk;    // cy * chunks_x + cx
+    bool      ready;    // gids read (set under the lock by whoever read them)
+    bool      dirty;    // edited since load; written back on eviction
+    uint32_t* gids;     // layer_count * CHUNK_CELLS, layer-major
+    uint16_t* masks;    // CHUNK_CELLS collision masks (topmost collision layer)
+    bool*     dynamic;  // CHUNK_CELLS
+} chunk_slot_t;
+
+struct world_stream {
+    FILE* spill;
+    int width, height;      // tiles
+    int chunks_x, chunks_y;
+    size_t layer_count;
+    const world_map_t* map;
+
+    // Parse-time band: one row of chunks of one layer, chunk-major so it is contiguous in the spill.
+    uint32_t* band;
+    long band_layer;        // -1 = nothing buffered
+    int band_cy;
+
+    int16_t*  page;         // chunk -> slot, NO_SLOT when neither resident nor loading
+    uint32_t* active_stamp; // chunk -> update stamp of the last update it was in the active set
+    uint8_t*  active_flag;  // chunk -> fn has been told it is active
+    uint32_t  stamp;
+    DA(int)   active;       // chunks in the active set after the last update
+    DA(int)   next_active;
+
+    chunk_slot_t slots[WORLD_STREAM_MAX_CHUNKS];
+
+    int    done[WORLD_STREAM_MAX_CHUNKS]; // loaded slots waiting for the main thread
+    size_t done_count;
+#if WORLD_STREAM_THREADED
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+    pthread_t       thread;
+    bool            thread_started;
+    bool            stop;
+    int             queue[WORLD_STREAM_MAX_CHUNKS];
+    size_t          queue_head, queue_count;
+    int             in_flight;  // queued or being read
+#endif
+};
+
+static world_stream_t* g_stream = NULL;
+
+static uint64_t chunk_offset(const world_stream_t* s, size_t layer_idx, int chunk)
+{
+    const uint64_t chunks = (uint64_t)s->chunks_x * (uint64_t)s->chunks_y;
+    return ((uint64_t)layer_idx * chunks + (uint64_t)chunk) * CHUNK_BYTES;
+}
+
+static size_t band_bytes(const world_stream_t* s)
+{
+    return (size_t)s->chunks_x * (size_t)CHUNK_BYTES;
+}
+
+static size_t slot_gid_bytes(const world_stream_t* s)
+{
+    return (s->layer_count ? s->layer_count : 1) * (size_t)CHUNK_BYTES;
+}
+
+static bool spill_write(world_stream_t* s, uint64_t off, const void* data, size_t n)
+{
+#if WORLD_STREAM_THREADED
+    const uint8_t* p = (const uint8_t*)data;
+    while (n > 0) {
+        ssize_t w = pwrite(fileno(s->spill), p, n, (off_t)off);
+        if (w <= 0) return false;
+        p += w;
+        off += (uint64_t)w;
+        n -= (size_t)w;
+    }
+    return true;
+#else
+    return fseek(s->spill, (long)off, SEEK_SET) == 0 && fwrite(data, 1, n, s->spill) == n;
+#endif
+}
+
+// Regions never written (past EOF, or holes) read back as gid 0.
+static void spill_read(world_stream_t* s, uint64_t off, void* data, size_t n)
+{
+    memset(data, 0, n);
+#if WORLD_STREAM_THREADED
+    uint8_t* p = (uint8_t*)data;
+    while (n > 0) {
+        ssize_t r = pread(fileno(s->spill), p, n, (off_t)off);
+        if (r <= 0) return;
+        p += r;
+        off += (uint64_t)r;
+        n -= (size_t)r;
+    }
+#else
+    if (fseek(s->spill, (long)off, SEEK_SET) == 0) (void)fread(data, 1, n, s->spill);
+#endif
+}
+
+// ===== Parse-time writes =====
+
+world_stream_t* world_stream_create(int width_tiles, int height_tiles)
+{
+    if (width_tiles <= 0 || height_tiles <= 0) return NULL;
+
+    world_stream_t* s = (world_stream_t*)mem_calloc(MEM_TAG_WORLD, 1, sizeof(*s));
+    if (!s) return NULL;
+    s->width = width_tiles;
+    s->height = height_tiles;
+    s->chunks_x = (width_tiles + WORLD_CHUNK_TILES - 1) / WORLD_CHUNK_TILES;
+    s->chunks_y = (height_tiles + WORLD_CHUNK_TILES - 1) / WORLD_CHUNK_TILES;
+    s->band_layer = -1;
+    s->spill = tmpfile();
+    s->band = (uint32_t*)mem_alloc(MEM_TAG_WORLD, band_bytes(s));
+    if (!s->spill || !s->band) {
+        LOGC(LOGCAT_WORLD, LOG_LVL_ERROR, "world_stream: can't create spill file for %dx%d map", width_tiles, height_tiles);
+        world_stream_destroy(s);
+        return NULL;
+    }
+    return s;
+}
+
+static bool band_flush(world_stream_t* s)
+{
+    if (s->band_layer < 0) return true;
+    const uint64_t off = chunk_offset(s, (size_t)s->band_layer, s->band_cy * s->chunks_x);
+    s->band_layer = -1;
+    return spill_write(s, off, s->band, band_bytes(s));
+}
+
+static bool band_select(world_stream_t* s, size_t layer_idx, int cy)
+{
+    if (s->band_layer == (long)layer_idx && s->band_cy == cy) return true;
+    if (!band_flush(s)) return false;
+    // Chunked (infinite) TMX layers can come back to a band already written; start from it.
+    spill_read(s, chunk_offset(s, layer_idx, cy * s->chunks_x), s->band, band_bytes(s));
+    s->band_layer = (long)layer_idx;
+    s->band_cy = cy;
+    return true;
+}
+
+bool world_stream_write_rows(world_stream_t* s, size_t layer_idx, int tx, int ty, const uint32_t* gids, size_t count)
+{
+    if (!s || !gids || tx < 0 || ty < 0 || ty >= s->height || (size_t)tx + count > (size_t)s->width) return false;
+    if (!band_select(s, layer_idx, ty / WORLD_CHUNK_TILES)) return false;
+
+    const size_t row = (size_t)(ty % WORLD_CHUNK_TILES) * WORLD_CHUNK_TILES;
+    size_t i = 0;
+    while (i < count) {
+        const int x = tx + (int)i;
+        const size_t lx = (size_t)(x % WORLD_CHUNK_TILES);
+        size_t n = WORLD_CHUNK_TILES - lx;
+        if (n > count - i) n = count - i;
+        memcpy(s->band + (size_t)(x / WORLD_CHUNK_TILES) * CHUNK_CELLS + row + lx, gids + i, n * sizeof(uint32_t));
+        i += n;
+    }
+    return true;
+}
+
+bool world_stream_finish(world_stream_t* s, size_t layer_count)
+{
+    if (!s) return false;
+    if (!band_flush(s)) {
+        LOGC(LOGCAT_WORLD, LOG_LVL_ERROR, "world_stream: writing the spill file failed");
+        return false;
+    }
+    mem_free(MEM_TAG_WORLD, s->band, band_bytes(s));
+    s->band = NULL;
+
+    const size_t chunks = (size_t)s->chunks_x * (size_t)s->chunks_y;
+    s->layer_count = layer_count;
+    s->page = (int16_t*)mem_alloc(MEM_TAG_WORLD, chunks * sizeof(int16_t));
+    s->active_stamp = (uint32_t*)mem_calloc(MEM_TAG_WORLD, chunks, sizeof(uint32_t));
+    s->active_flag = (uint8_t*)mem_calloc(MEM_TAG_WORLD, chunks, sizeof(uint8_t));
+    if (!s->page || !s->active_stamp || !s->active_flag) return false;
+    for (size_t i = 0; i < chunks; ++i) s->page[i] = NO_SLOT;
+
+    for (int i = 0; i < WORLD_STREAM_MAX_CHUNKS; ++i) {
+        chunk_slot_t* slot = &s->slots[i];
+        slot->gids = (uint32_t*)mem_alloc(MEM_TAG_WORLD, slot_gid_bytes(s));
+        slot->masks = (uint16_t*)mem_alloc(MEM_TAG_WORLD, CHUNK_CELLS * sizeof(uint16_t));
+        slot->dynamic = (bool*)mem_alloc(MEM_TAG_WORLD, CHUNK_CELLS * sizeof(bool));
+        if (!slot->gids || !slot->masks || !slot->dynamic) return false;
+    }
+    return true;
+}
+
+// ===== Loader =====
+
+static void read_chunk(world_stream_t* s, chunk_slot_t* slot)
+{
+    for (size_t li = 0; li < s->layer_count; ++li) {
+        spill_read(s, chunk_offset(s, li, slot->chunk), slot->gids + li * CHUNK_CELLS, (size_t)CHUNK_BYTES);
+    }
+}
+
+static void write_back(world_stream_t* s, chunk_slot_t* slot)
+{
+    for (size_t li = 0; li < s->layer_count; ++li) {
+        if (!spill_write(s, chunk_offset(s, li, slot->chunk), slot->gids + li * CHUNK_CELLS, (size_t)CHUNK_BYTES)) {
+            LOGC(LOGCAT_WORLD, LOG_LVL_ERROR, "world_stream: lost edits to chunk %d (spill write failed)", slot->chunk);
+            return;
+        }
+    }
+}
+
+#if WORLD_STREAM_THREADED
+static void* loader_main(void* arg)
+{
+    world_stream_t* s = (world_stream_t*)arg;
+    pthread_mutex_lock(&s->lock);
+    for (;;) {
+        while (s->queue_count == 0 && !s->stop) pthread_cond_wait(&s->cond, &s->lock);
+        if (s->stop) break;
+        const int slot = s->queue[s->queue_head];
+        s->queue_head = (s->queue_head + 1) % WORLD_STREAM_MAX_CHUNKS;
+        s->queue_count--;
+        pthread_mutex_unlock(&s->lock);
+
+        read_chunk(s, &s->slots[slot]);
+
+        pthread_mutex_lock(&s->lock);
+        s->slots[slot].ready = true;
+        s->done[s->done_count++] = slot;
+        s->in_flight--;
+        pthread_cond_broadcast(&s->cond);
+    }
+    pthread_mutex_unlock(&s->lock);
+    return NULL;
+}
+#endif
+
+static void compute_cell(const world_stream_t* s, chunk_slot_t* slot, int cell)
+{
+    uint32_t raw_gid = 0;
+    for (size_t li = s->layer_count; li-- > 0; ) {
+        if (!s->map->layers[li].collision) continue;
+        const uint32_t gid = slot->gids[li * CHUNK_CELLS + (size_t)cell];
+        if (gid == 0) continue;
+        raw_gid = gid;
+        break;
+    }
+    uint16_t mask = 0;
+    bool dyn = false;
+    if (raw_gid != 0) world_collision_decode_raw_gid(s->map, raw_gid, &mask, &dyn);
+    slot->masks[cell] = mask;
+    slot->dynamic[cell] = dyn;
+}
+
+static void install_slot(world_stream_t* s, int slot_idx)
+{
+    chunk_slot_t* slot = &s->slots[slot_idx];
+    for (int c = 0; c < CHUNK_CELLS; ++c) compute_cell(s, slot, c);
+    slot->state = SLOT_RESIDENT;
+}
+
+static void drain_done(world_stream_t* s)
+{
+    int done[WORLD_STREAM_MAX_CHUNKS];
+    size_t count = 0;
+#if WORLD_STREAM_THREADED
+    pthread_mutex_lock(&s->lock);
+#endif
+    count = s->done_count;
+    memcpy(done, s->done, count * sizeof(int));
+    s->done_count = 0;
+#if WORLD_STREAM_THREADED
+    pthread_mutex_unlock(&s->lock);
+#endif
+    for (size_t i = 0; i < count; ++i) install_slot(s, done[i]);
+}
+
+static int chunk_focus_distance(const world_stream_t* s, int chunk, const v2f* focus, size_t focus_count)
+{
+    const float chunk_w = (float)(WORLD_CHUNK_TILES * (s->map->tilewidth > 0 ? s->map->tilewidth : 1));
+    const float chunk_h = (float)(WORLD_CHUNK_TILES * (s->map->tileheight > 0 ? s->map->tileheight : 1));
+    const int cx = chunk % s->chunks_x;
+    const int cy = chunk / s->chunks_x;
+    int best = INT32_MAX;
+    for (size_t i = 0; i < focus_count; ++i) {
+        const int fx = (int)floorf(focus[i].x / chunk_w);
+        const int fy = (int)floorf(focus[i].y / chunk_h);
+        const int dx = abs(cx - fx);
+        const int dy = abs(cy - fy);
+        const int d = dx > dy ? dx : dy;
+        if (d < best) best = d;
+    }
+    return best;
+}
+
+static void evict_slot(world_stream_t* s, int slot_idx)
+{
+    chunk_slot_t* slot = &s->slots[slot_idx];
+    if (slot->dirty) write_back(s, slot);
+    s->page[slot->chunk] = NO_SLOT;
+    slot->state = SLOT_FREE;
+    slot->dirty = false;
+    slot->ready = false;
+}
+
+static int alloc_slot(world_stream_t* s, const v2f* focus, size_t focus_count)
+{
+    for (int i = 0; i < WORLD_STREAM_MAX_CHUNKS; ++i) {
+        if (s->slots[i].state == SLOT_FREE) return i;
+    }
+
+    // Budget reached: drop the resident, inactive chunk farthest from every focus.
+    int best = -1;
+    int best_d = -1;
+    for (int i = 0; i < WORLD_STREAM_MAX_CHUNKS; ++i) {
+        const chunk_slot_t* slot = &s->slots[i];
+        if (slot->state != SLOT_RESIDENT || s->active_stamp[slot->chunk] == s->stamp) continue;
+        const int d = chunk_focus_distance(s, slot->chunk, focus, focus_count);
+        if (d > best_d) {
+            best_d = d;
+            best = i;
+        }
+    }
+    if (best >= 0) evict_slot(s, best);
+    return best;
+}
+
+// Queue chunk for the loader (or read it right away with inline=true / no loader thread).
+static int request_chunk(world_stream_t* s, int chunk, bool inline_read, const v2f* focus, size_t focus_count)
+{
+    const int slot_idx = alloc_slot(s, focus, focus_count);
+    if (slot_idx < 0) return NO_SLOT;
+
+    chunk_slot_t* slot = &s->slots[slot_idx];
+    slot->state = SLOT_LOADING;
+    slot->chunk = chunk;
+    slot->ready = false;
+    slot->dirty = false;
+    s->page[chunk] = (int16_t)slot_idx;
+
+#if WORLD_STREAM_THREADED
+    if (s->thread_started && !inline_read) {
+        pthread_mutex_lock(&s->lock);
+        s->queue[(s->queue_head + s->queue_count) % WORLD_STREAM_MAX_CHUNKS] = slot_idx;
+        s->queue_count++;
+        s->in_flight++;
+        pthread_cond_broadcast(&s->cond);
+        pthread_mutex_unlock(&s->lock);
+        return slot_idx;
+    }
+#else
+    (void)inline_read;
+#endif
+    read_chunk(s, slot);
+    slot->ready = true;
+    install_slot(s, slot_idx);
+    return slot_idx;
+}
+
+static bool ensure_resident(world_stream_t* s, int chunk, const v2f* focus, size_t focus_count)
+{
+    int slot_idx = s->page[chunk];
+    if (slot_idx == NO_SLOT) {
+        slot_idx = request_chunk(s, chunk, true, focus, focus_count);
+        if (slot_idx == NO_SLOT) return false;
+    }
+#if WORLD_STREAM_THREADED
+    if (s->slots[slot_idx].state == SLOT_LOADING) {
+        pthread_mutex_lock(&s->lock);
+        while (!s->slots[slot_idx].ready) pthread_cond_wait(&s->cond, &s->lock);
+        pthread_mutex_unlock(&s->lock);
+        drain_done(s);
+    }
+#endif
+    return s->slots[slot_idx].state == SLOT_RESIDENT;
+}
+
+static void notify(const world_stream_t* s, int chunk, bool active, world_stream_chunk_fn fn, void* user)
+{
+    if (!fn) return;
+    const int tx0 = (chunk % s->chunks_x) * WORLD_CHUNK_TILES;
+    const int ty0 = (chunk / s->chunks_x) * WORLD_CHUNK_TILES;
+    const int tx1 = tx0 + WORLD_CHUNK_TILES < s->width ? tx0 + WORLD_CHUNK_TILES : s->width;
+    const int ty1 = ty0 + WORLD_CHUNK_TILES < s->height ? ty0 + WORLD_CHUNK_TILES : s->height;
+    fn(user, tx0, ty0, tx1, ty1, active);
+}
+
+// Calls visit(s, chunk) for every chunk within radius of a focus, each once per pass.
+static void for_chunks_near(world_stream_t* s, const v2f* focus, size_t focus_count, int radius,
+                            void (*visit)(world_stream_t*, int, const v2f*, size_t))
+{
+    const float chunk_w = (float)(WORLD_CHUNK_TILES * (s->map->tilewidth > 0 ? s->map->tilewidth : 1));
+    const float chunk_h = (float)(WORLD_CHUNK_TILES * (s->map->tileheight > 0 ? s->map->tileheight : 1));
+    for (size_t i = 0; i < focus_count; ++i) {
+        const int fx = (int)floorf(focus[i].x / chunk_w);
+        const int fy = (int)floorf(focus[i].y / chunk_h);
+        for (int cy = fy - radius; cy <= fy + radius; ++cy) {
+            if (cy < 0 || cy >= s->chunks_y) continue;
+            for (int cx = fx - radius; cx <= fx + radius; ++cx) {
+                if (cx < 0 || cx >= s->chunks_x) continue;
+                visit(s, cy * s->chunks_x + cx, focus, focus_count);
+            }
+        }
+    }
+}
+
+static void visit_active(world_stream_t* s, int chunk, const v2f* focus, size_t focus_count)
+{
+    (void)focus;
+    (void)focus_count;
+    if (s->active_stamp[chunk] == s->stamp) return;
+    s->active_stamp[chunk] = s->stamp;
+    DA_APPEND(&s->next_active, chunk);
+}
+
+static void visit_prefetch(world_stream_t* s, int chunk, const v2f* focus, size_t focus_count)
+{
+    if (s->page[chunk] == NO_SLOT) request_chunk(s, chunk, false, focus, focus_count);
+}
+
+void world_stream_update(const v2f* focus_px, size_t focus_count, world_stream_chunk_fn fn, void* user)
+{
+    world_stream_t* s = g_stream;
+    if (!s || !focus_px || focus_count == 0) return;
+
+    drain_done(s);
+
+    // New active set (stamped first so eviction below never picks one of them).
+    s->stamp++;
+    DA_CLEAR(&s->next_active);
+    for_chunks_near(s, focus_px, focus_count, WORLD_STREAM_ACTIVE_RADIUS, visit_active);
+    for (size_t i = 0; i < s->next_active.size; ++i) {
+        ensure_resident(s, s->next_active.data[i], focus_px, focus_count);
+    }
+
+    // Leaving chunks first so the entities they park free ECS slots for the arriving ones.
+    for (size_t i = 0; i < s->active.size; ++i) {
+        const int chunk = s->active.data[i];
+        if (s->active_stamp[chunk] == s->stamp || !s->active_flag[chunk]) continue;
+        s->active_flag[chunk] = 0;
+        notify(s, chunk, false, fn, user);
+    }
+    DA_CLEAR(&s->active);
+    for (size_t i = 0; i < s->next_active.size; ++i) {
+        const int chunk = s->next_active.data[i];
+        const int slot = s->page[chunk];
+        if (slot == NO_SLOT || s->slots[slot].state != SLOT_RESIDENT) continue; // budget exhausted; retry next update
+        DA_APPEND(&s->active, chunk);
+        if (s->active_flag[chunk]) continue;
+        s->active_flag[chunk] = 1;
+        notify(s, chunk, true, fn, user);
+    }
+
+    for_chunks_near(s, focus_px, focus_count, WORLD_STREAM_PREFETCH_RADIUS, visit_prefetch);
+
+    for (int i = 0; i < WORLD_STREAM_MAX_CHUNKS; ++i) {
+        const chunk_slot_t* slot = &s->slots[i];
+        if (slot->state != SLOT_RESIDENT || s->active_flag[slot->chunk]) continue;
+        if (chunk_focus_distance(s, slot->chunk, focus_px, focus_count) > WORLD_STREAM_KEEP_RADIUS) evict_slot(s, i);
+    }
+}
+
+void world_stream_wait_idle(void)
+{
+#if WORLD_STREAM_THREADED
+    world_stream_t* s = g_stream;
+    if (!s || !s->thread_started) return;
+    pthread_mutex_lock(&s->lock);
+    while (s->in_flight > 0) pthread_cond_wait(&s->cond, &s->lock);
+    pthread_mutex_unlock(&s->lock);
+#endif
+}
+
+// ===== Lifecycle =====
+
+void world_stream_destroy(world_stream_t* s)
+{
+    if (!s) return;
+#if WORLD_STREAM_THREADED
+    if (s->thread_started) {
+        pthread_mutex_lock(&s->lock);
+        s->stop = true;
+        pthread_cond_broadcast(&s->cond);
+        pthread_mutex_unlock(&s->lock);
+        pthread_join(s->thread, NULL);
+        pthread_mutex_destroy(&s->lock);
+        pthread_cond_destroy(&s->cond);
+    }
+#endif
+    for (int i = 0; i < WORLD_STREAM_MAX_CHUNKS; ++i) {
+        mem_free(MEM_TAG_WORLD, s->slots[i].gids, slot_gid_bytes(s));
+        mem_free(MEM_TAG_WORLD, s->slots[i].masks, CHUNK_CELLS * sizeof(uint16_t));
+        mem_free(MEM_TAG_WORLD, s->slots[i].dynamic, CHUNK_CELLS * sizeof(bool));
+    }
+    DA_FREE(&s->active);
+    DA_FREE(&s->next_active);
+    const size_t chunks = (size_t)s->chunks_x * (size_t)s->chunks_y;
+    mem_free(MEM_TAG_WORLD, s->page, chunks * sizeof(int16_t));
+    mem_free(MEM_TAG_WORLD, s->active_stamp, chunks * sizeof(uint32_t));
+    mem_free(MEM_TAG_WORLD, s->active_flag, chunks * sizeof(uint8_t));
+    mem_free(MEM_TAG_WORLD, s->band, band_bytes(s));
+    if (s->spill) fclose(s->spill);
+    mem_free(MEM_TAG_WORLD, s, sizeof(*s));
+}
+
+void world_stream_install(world_stream_t* s, const world_map_t* map)
+{
+    world_stream_destroy(g_stream);
+    g_stream = s;
+    if (!s) return;
+
+    s->map = map;
+#if WORLD_STREAM_THREADED
+    pthread_mutex_init(&s->lock, NULL);
+    pthread_cond_init(&s->cond, NULL);
+    s->thread_started = pthread_create(&s->thread, NULL, loader_main, s) == 0;
+    if (!s->thread_started) {
+        LOGC(LOGCAT_WORLD, LOG_LVL_WARN, "world_stream: no loader thread; chunks load inline");
+        pthread_mutex_destroy(&s->lock);
+        pthread_cond_destroy(&s->cond);
+    }
+#endif
+    LOGC(LOGCAT_WORLD, LOG_LVL_INFO, "world_stream: %dx%d tiles in %dx%d chunks, %d resident at most",
+         s->width, s->height, s->chunks_x, s->chunks_y, WORLD_STREAM_MAX_CHUNKS);
+}
+
+bool world_stream_active(void)
+{
+    return g_stream != NULL;
+}
+
+size_t world_stream_resident_chunks(void)
+{
+    if (!g_stream) return 0;
+    size_t n = 0;
+    for (int i = 0; i < WORLD_STREAM_MAX_CHUNKS; ++i) {
+        if (g_stream->slots[i].state == SLOT_RESIDENT) n++;
+    }
+    return n;
+}
+
+// ===== Resident access =====
+
+static chunk_slot_t* resident_slot(int tx, int ty, size_t* out_cell)
+{
+    const world_stream_t* s = g_stream;
+    if (!s || tx < 0 || ty < 0 || tx >= s->width || ty >= s->height) return NULL;
+    const int chunk = (ty / WORLD_CHUNK_TILES) * s->chunks_x + tx / WORLD_CHUNK_TILES;
+    const int slot = s->page[chunk];
+    if (slot == NO_SLOT || s->slots[slot].state != SLOT_RESIDENT) return NULL;
+    *out_cell = (size_t)(ty % WORLD_CHUNK_TILES) * WORLD_CHUNK_TILES + (size_t)(tx % WORLD_CHUNK_TILES);
+    return &g_stream->slots[slot];
+}
+
+uint32_t world_stream_gid(size_t layer_idx, int tx, int ty)
+{
+    size_t cell = 0;
+    chunk_slot_t* slot = resident_slot(tx, ty, &cell);
+    if (!slot || layer_idx >= g_stream->layer_count) return 0;
+    return slot->gids[layer_idx * CHUNK_CELLS + cell];
+}
+
+bool world_stream_resident(int tx, int ty)
+{
+    size_t cell = 0;
+    return resident_slot(tx, ty, &cell) != NULL;
+}
+
+bool world_stream_set_gid(size_t layer_idx, int tx, int ty, uint32_t raw_gid)
+{
+    size_t cell = 0;
+    chunk_slot_t* slot = resident_slot(tx, ty, &cell);
+    if (!slot || layer_idx >= g_stream->layer_count) return false;
+    slot->gids[layer_idx * CHUNK_CELLS + cell] = raw_gid;
+    slot->dirty = true;
+    return true;
+}
+
+bool world_stream_cell(int tx, int ty, uint16_t* out_mask, bool* out_dynamic)
+{
+    size_t cell = 0;
+    chunk_slot_t* slot = resident_slot(tx, ty, &cell);
+    if (!slot) return false;
+    if (out_mask) *out_mask = slot->masks[cell];
+    if (out_dynamic) *out_dynamic = slot->dynamic[cell];
+    return true;
+}
+
+void world_stream_refresh_cell(int tx, int ty)
+{
+    size_t cell = 0;
+    chunk_slot_t* slot = resident_slot(tx, ty, &cell);
+    if (slot) compute_cell(g_stream, slot, (int)cell);
+}
+
+void world_stream_refresh_all(void)
+{
+    if (!g_stream) return;
+    for (int i = 0; i < WORLD_STREAM_MAX_CHUNKS; ++i) {
+        if (g_stream->slots[i].state == SLOT_RESIDENT) install_slot(g_stream, i);
+    }
+}
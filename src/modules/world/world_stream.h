@@ -0,0 +1,32 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include "modules/core/engine_types.h"
+
+/*
+  Streamed worlds: maps of at least WORLD_STREAM_MIN_TILES tiles (build_config.h) keep their tile
+  layers in a spill file cut into WORLD_CHUNK_TILES x WORLD_CHUNK_TILES chunks, and only the chunks
+  near the focus points (player, camera) are held in memory along with their collision masks.
+  Tiles in chunks that aren't resident read as gid 0 / WORLD_TILE_VOID (solid).
+
+  Each world_stream_update():
+    - chunks within WORLD_STREAM_PREFETCH_RADIUS of a focus are queued for the loader thread
+    - chunks within WORLD_STREAM_ACTIVE_RADIUS are resident before it returns (read inline if the
+      loader hasn't delivered them yet), so nothing near a focus ever sees a hole
+    - chunks beyond WORLD_STREAM_KEEP_RADIUS of every focus are dropped; edited ones are written
+      back to the spill file first
+  fn hears about chunks entering and leaving the active set (tile rect, end exclusive); the ECS
+  pages map-spawned entities in and out from there.
+*/
+#define WORLD_CHUNK_TILES            32
+#define WORLD_STREAM_ACTIVE_RADIUS   1   // chunks, Chebyshev distance from the focus chunk
+#define WORLD_STREAM_PREFETCH_RADIUS 2
+#define WORLD_STREAM_KEEP_RADIUS     3
+#define WORLD_STREAM_MAX_CHUNKS      128 // resident chunk budget
+
+typedef void (*world_stream_chunk_fn)(void* user, int tx0, int ty0, int tx1, int ty1, bool active);
+
+bool   world_stream_active(void);
+void   world_stream_update(const v2f* focus_px, size_t focus_count, world_stream_chunk_fn fn, void* user);
+size_t world_stream_resident_chunks(void);
+void   world_stream_wait_idle(void); // block until the loader thread has nothing in flight
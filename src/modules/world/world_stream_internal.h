@@ -0,0 +1,23 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "modules/world/world_map.h"
+
+// Owned by the world map: created when the TMX turns out to be large enough, fed the tile rows
+// while it parses, then installed alongside the map once loading succeeded.
+typedef struct world_stream world_stream_t;
+
+world_stream_t* world_stream_create(int width_tiles, int height_tiles);
+bool world_stream_write_rows(world_stream_t* s, size_t layer_idx, int tx, int ty, const uint32_t* gids, size_t count);
+bool world_stream_finish(world_stream_t* s, size_t layer_count); // flush parse buffers, allocate the chunk pool
+void world_stream_destroy(world_stream_t* s);
+void world_stream_install(world_stream_t* s, const world_map_t* map); // NULL shuts the current stream down
+
+// Resident-chunk access for the map owner, collision grid and renderer.
+uint32_t world_stream_gid(size_t layer_idx, int tx, int ty);
+bool     world_stream_set_gid(size_t layer_idx, int tx, int ty, uint32_t raw_gid);
+bool     world_stream_resident(int tx, int ty);
+bool     world_stream_cell(int tx, int ty, uint16_t* out_mask, bool* out_dynamic);
+void     world_stream_refresh_cell(int tx, int ty);
+void     world_stream_refresh_all(void);
@@ -0,0 +1,140 @@
+// Benchmark: physics/proximity broadphases (all-pairs, grid, sweep-and-prune) on map layouts.
+// Usage: build/bench/bench_broadphase [map.tmx]
+#include "modules/ecs/ecs_broadphase.h"
+#include "modules/tiled/tiled.h"
+#include "modules/core/logger.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define FRAMES 600
+#define MAX_SEEDS 256
+
+static float cx[ECS_MAX_ENTITIES], cy[ECS_MAX_ENTITIES], hx[ECS_MAX_ENTITIES], hy[ECS_MAX_ENTITIES];
+static float vx[ECS_MAX_ENTITIES], vy[ECS_MAX_ENTITIES];
+static int ids[ECS_MAX_ENTITIES];
+static ecs_broadphase_t bp;
+
+typedef struct { float x, y, hx, hy; } seed_box_t;
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint32_t lcg(uint32_t* s)
+{
+    *s = *s * 1664525u + 1013904223u;
+    return *s >> 8;
+}
+
+static int load_seeds(const char* path, seed_box_t* out, float* out_w, float* out_h)
+{
+    world_map_t map = {0};
+    if (!tiled_load_map(path, &map)) return -1;
+
+    int n = 0;
+    for (size_t i = 0; i < map.object_count && n < MAX_SEEDS; ++i) {
+        const tiled_object_t* o = &map.objects[i];
+        float w = (o->w > 0.0f) ? o->w : (float)map.tilewidth;
+        float h = (o->h > 0.0f) ? o->h : (float)map.tileheight;
+        out[n++] = (seed_box_t){ o->x + w * 0.5f, o->y - h * 0.5f, w * 0.5f, h * 0.5f };
+    }
+    *out_w = (float)(map.width * map.tilewidth);
+    *out_h = (float)(map.height * map.tileheight);
+    tiled_free_map(&map);
+    return n;
+}
+
+// Tile copies of the map's object layout side by side until `count` bodies exist.
+// One body in eight moves; the rest sit still like crates and storage units.
+static void build_layout(const seed_box_t* seeds, int seed_count, float map_w, float map_h, int count)
+{
+    uint32_t rng = 99u;
+    const int copies_x = 8;
+    for (int i = 0; i < count; ++i) {
+        const seed_box_t* s = &seeds[i % seed_count];
+        const int copy = i / seed_count;
+        cx[i] = s->x + map_w * (float)(copy % copies_x);
+        cy[i] = s->y + map_h * (float)(copy / copies_x);
+        hx[i] = s->hx;
+        hy[i] = s->hy;
+        ids[i] = i;
+        const bool mover = (i % 8) == 0;
+        vx[i] = mover ? (float)((int)(lcg(&rng) % 5u) - 2) * 0.5f : 0.0f;
+        vy[i] = mover ? (float)((int)(lcg(&rng) % 5u) - 2) * 0.5f : 0.0f;
+    }
+}
+
+static void step_movers(int count, int frame)
+{
+    // Reverse every 120 frames so movers stay inside their map copy.
+    const float dir = ((frame / 120) % 2 == 0) ? 1.0f : -1.0f;
+    for (int i = 0; i < count; ++i) {
+        cx[i] += vx[i] * dir;
+        cy[i] += vy[i] * dir;
+    }
+}
+
+static double run(ecs_broadphase_kind_t kind, const seed_box_t* seeds, int seed_count,
+                  float map_w, float map_h, int count, size_t* out_pairs)
+{
+    build_layout(seeds, seed_count, map_w, map_h, count);
+    ecs_broadphase_free(&bp);
+    bp.kind = kind;
+
+    aabb_batch_t boxes = { cx, cy, hx, hy, count };
+    size_t pairs = 0;
+    double t0 = now_sec();
+    for (int f = 0; f < FRAMES; ++f) {
+        step_movers(count, f);
+        ecs_broadphase_update(&bp, &boxes, ids);
+        pairs += bp.pairs.size;
+    }
+    double t1 = now_sec();
+    *out_pairs = pairs;
+    return t1 - t0;
+}
+
+int main(int argc, char** argv)
+{
+    const char* path = (argc > 1) ? argv[1] : "assets/maps/start.tmx";
+    log_set_min_level(LOG_LVL_WARN);
+
+    static seed_box_t seeds[MAX_SEEDS];
+    float map_w = 0.0f, map_h = 0.0f;
+    int seed_count = load_seeds(path, seeds, &map_w, &map_h);
+    if (seed_count <= 0) {
+        fprintf(stderr, "bench_broadphase: no objects loaded from '%s'\n", path);
+        return 1;
+    }
+
+    printf("broadphase: %s (%d objects, %.0fx%.0f px), %d frames\n", path, seed_count, map_w, map_h, FRAMES);
+    printf("%6s %12s %12s %12s %10s\n", "bodies", "all-pairs us", "grid us", "sap us", "pairs/f");
+
+    static const int sizes[] = { 0, 64, 256, 1024 };
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        const int count = sizes[s] ? sizes[s] : seed_count;
+        double us[ECS_BROADPHASE_COUNT];
+        size_t pairs[ECS_BROADPHASE_COUNT];
+        for (int k = 0; k < ECS_BROADPHASE_COUNT; ++k) {
+            us[k] = run((ecs_broadphase_kind_t)k, seeds, seed_count, map_w, map_h, count, &pairs[k]) * 1e6 / FRAMES;
+        }
+        for (int k = 1; k < ECS_BROADPHASE_COUNT; ++k) {
+            if (pairs[k] != pairs[0]) {
+                fprintf(stderr, "pair mismatch (%s) at %d bodies: %zu vs %zu\n",
+                        ecs_broadphase_kind_name((ecs_broadphase_kind_t)k), count, pairs[k], pairs[0]);
+                return 1;
+            }
+        }
+        printf("%6d %12.2f %12.2f %12.2f %10.1f\n", count,
+               us[ECS_BROADPHASE_ALL_PAIRS], us[ECS_BROADPHASE_GRID], us[ECS_BROADPHASE_SAP],
+               (double)pairs[0] / FRAMES);
+    }
+    ecs_broadphase_free(&bp);
+    return 0;
+}
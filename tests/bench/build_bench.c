@@ -0,0 +1,65 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#define NOB_IMPLEMENTATION
+#include "../../third_party/nob.h"
+
+#include <string.h>
+
+typedef struct {
+    const char *name;
+    const char *sources;
+} Bench;
+
+// Each bench links its own main plus the engine sources it exercises.
+static const Bench benches[] = {
+    { "bench_aabb", "tests/bench/bench_aabb.c src/modules/ecs/ecs_aabb.c" },
+    { "bench_broadphase",
+      "tests/bench/bench_broadphase.c src/modules/ecs/ecs_broadphase.c src/modules/ecs/ecs_aabb.c "
+      "src/modules/tiled/tiled.c src/modules/tiled/tiled_layers.c src/modules/tiled/tiled_objects.c "
+      "src/modules/tiled/tiled_tilesets.c src/modules/tiled/tiled_utils.c src/modules/asset/bump_alloc.c src/modules/common/mem_tag.c src/modules/common/atom.c src/modules/common/parallel.c "
+      "src/modules/core/logger.c third_party/xml.c/src/xml.c" },
+};
+
+int main(int argc, char **argv)
+{
+    NOB_GO_REBUILD_URSELF(argc, argv);
+
+    bool run = false;
+    bool native = false;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--run") == 0) run = true;
+        else if (strcmp(argv[i], "--native") == 0) native = true;
+    }
+
+    if (!nob_mkdir_if_not_exists("build")) return 1;
+    if (!nob_mkdir_if_not_exists("build/bench")) return 1;
+
+    const char *cc = getenv("CC");
+    if (!cc || cc[0] == '\0') cc = "cc";
+
+    for (size_t i = 0; i < NOB_ARRAY_LEN(benches); ++i) {
+        Nob_Cmd cmd = {0};
+        nob_cmd_append(&cmd, "sh", "-lc",
+            nob_temp_sprintf("%s -std=c99 -Wall -Wextra -O2 -fno-fast-math -D_POSIX_C_SOURCE=200809L %s "
+                             "-I src -I third_party/xml.c/src %s -o build/bench/%s -lm -lpthread",
+                cc,
+                native ? "-march=native" : "",
+                benches[i].sources,
+                benches[i].name
+            )
+        );
+        if (!nob_cmd_run_sync_and_reset(&cmd)) return 1;
+    }
+
+    if (run) {
+        for (size_t i = 0; i < NOB_ARRAY_LEN(benches); ++i) {
+            Nob_Cmd cmd = {0};
+            nob_cmd_append(&cmd, nob_temp_sprintf("build/bench/%s", benches[i].name));
+            if (!nob_cmd_run_sync_and_reset(&cmd)) return 1;
+        }
+    }
+
+    return 0;
+}
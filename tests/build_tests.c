@@ -110,12 +110,36 @@ int main(int argc, char **argv)
 
     if (!build_tool(cc, "tests/unit/core/dynarray/build_dynarray.c", "build/tests/bin/build_dynarray")) return 1;
     if (!run_tool("build/tests/bin/build_dynarray", coverage ? "--coverage" : NULL)) return 1;
+    if (!build_tool(cc, "tests/unit/core/mem_tag/build_mem_tag.c", "build/tests/bin/build_mem_tag")) return 1;
+    if (!run_tool("build/tests/bin/build_mem_tag", coverage ? "--coverage" : NULL)) return 1;
+    if (!build_tool(cc, "tests/unit/core/hashmap/build_hashmap.c", "build/tests/bin/build_hashmap")) return 1;
+    if (!run_tool("build/tests/bin/build_hashmap", coverage ? "--coverage" : NULL)) return 1;
+    if (!build_tool(cc, "tests/unit/core/atom/build_atom.c", "build/tests/bin/build_atom")) return 1;
+    if (!run_tool("build/tests/bin/build_atom", coverage ? "--coverage" : NULL)) return 1;
+    if (!build_tool(cc, "tests/unit/core/parallel/build_parallel.c", "build/tests/bin/build_parallel")) return 1;
+    if (!run_tool("build/tests/bin/build_parallel", coverage ? "--coverage" : NULL)) return 1;
 
     if (!build_tool(cc, "tests/unit/core/input/build_input.c", "build/tests/bin/build_input")) return 1;
     if (!run_tool("build/tests/bin/build_input", coverage ? "--coverage" : NULL)) return 1;
 
     if (!build_tool(cc, "tests/unit/core/debug_hotkeys/build_debug_hotkeys.c", "build/tests/bin/build_debug_hotkeys")) return 1;
     if (!run_tool("build/tests/bin/build_debug_hotkeys", coverage ? "--coverage" : NULL)) return 1;
+    if (!build_tool(cc, "tests/unit/core/trace/build_trace.c", "build/tests/bin/build_trace")) return 1;
+    if (!run_tool("build/tests/bin/build_trace", coverage ? "--coverage" : NULL)) return 1;
+    if (!build_tool(cc, "tests/unit/bench/scenario/build_bench_scenario.c", "build/tests/bin/build_bench_scenario")) return 1;
+    if (!run_tool("build/tests/bin/build_bench_scenario", coverage ? "--coverage" : NULL)) return 1;
+    if (!build_tool(cc, "tests/unit/ecs/snapshot/build_ecs_snapshot.c", "build/tests/bin/build_ecs_snapshot")) return 1;
+    if (!run_tool("build/tests/bin/build_ecs_snapshot", coverage ? "--coverage" : NULL)) return 1;
+    if (!build_tool(cc, "tests/unit/core/savegame/build_savegame.c", "build/tests/bin/build_savegame")) return 1;
+    if (!run_tool("build/tests/bin/build_savegame", coverage ? "--coverage" : NULL)) return 1;
+    if (!build_tool(cc, "tests/unit/core/hot_reload/build_hot_reload.c", "build/tests/bin/build_hot_reload")) return 1;
+    if (!run_tool("build/tests/bin/build_hot_reload", coverage ? "--coverage" : NULL)) return 1;
+    if (!build_tool(cc, "tests/unit/core/map_manager/build_map_manager.c", "build/tests/bin/build_map_manager")) return 1;
+    if (!run_tool("build/tests/bin/build_map_manager", coverage ? "--coverage" : NULL)) return 1;
+    if (!build_tool(cc, "tests/unit/core/frame_alloc/build_frame_alloc.c", "build/tests/bin/build_frame_alloc")) return 1;
+    if (!run_tool("build/tests/bin/build_frame_alloc", coverage ? "--coverage" : NULL)) return 1;
+    if (!build_tool(cc, "tests/unit/core/metrics/build_metrics.c", "build/tests/bin/build_metrics")) return 1;
+    if (!run_tool("build/tests/bin/build_metrics", coverage ? "--coverage" : NULL)) return 1;
 
     if (!build_tool(cc, "tests/unit/core/engine/build_engine.c", "build/tests/bin/build_engine")) return 1;
     if (!run_tool("build/tests/bin/build_engine", coverage ? "--coverage" : NULL)) return 1;
@@ -147,6 +171,12 @@ int main(int argc, char **argv)
     if (!build_tool(cc, "tests/unit/ecs/registration/build_ecs_registration.c", "build/tests/bin/build_ecs_registration")) return 1;
     if (!run_tool("build/tests/bin/build_ecs_registration", coverage ? "--coverage" : NULL)) return 1;
 
+    if (!build_tool(cc, "tests/unit/ecs/aabb/build_ecs_aabb.c", "build/tests/bin/build_ecs_aabb")) return 1;
+    if (!run_tool("build/tests/bin/build_ecs_aabb", coverage ? "--coverage" : NULL)) return 1;
+
+    if (!build_tool(cc, "tests/unit/ecs/broadphase/build_ecs_broadphase.c", "build/tests/bin/build_ecs_broadphase")) return 1;
+    if (!run_tool("build/tests/bin/build_ecs_broadphase", coverage ? "--coverage" : NULL)) return 1;
+
     if (!build_tool(cc, "tests/unit/ecs/proximity/build_ecs_proximity.c", "build/tests/bin/build_ecs_proximity")) return 1;
     if (!run_tool("build/tests/bin/build_ecs_proximity", coverage ? "--coverage" : NULL)) return 1;
 
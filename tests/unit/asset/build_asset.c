@@ -89,6 +89,9 @@ int main(int argc, char **argv)
     Nob_File_Paths sources = {0};
     nob_da_append(&sources, "third_party/Unity/src/unity.c");
     nob_da_append(&sources, "src/modules/asset/asset.c");
+    nob_da_append(&sources, "src/modules/common/mem_tag.c");
+    nob_da_append(&sources, "src/modules/core/metrics.c");
+    nob_da_append(&sources, "src/modules/common/path_util.c");
     nob_da_append(&sources, "tests/unit/asset/asset_backend_stub.c");
     nob_da_append(&sources, "tests/unit/asset/test_asset.c");
     nob_da_append(&sources, "src/modules/core/logger.c");
@@ -1,6 +1,7 @@
 #include "unity.h"
 
 #include <stdint.h>
+#include <string.h>
 
 #include "modules/asset/bump_alloc.h"
 
@@ -34,22 +35,123 @@ void test_bump_alloc_alignment_and_offset(void)
     bump_free(&b);
 }
 
-void test_bump_alloc_overflow_fails_without_advancing_offset(void)
+void test_bump_alloc_full_chunk_chains_a_new_one(void)
 {
     bump_alloc_t b = {0};
     TEST_ASSERT_TRUE(bump_init(&b, 32));
 
-    void *p1 = bump_alloc_aligned(&b, 24, 8);
+    uint8_t *p1 = (uint8_t *)bump_alloc_aligned(&b, 24, 8);
     TEST_ASSERT_NOT_NULL(p1);
-    size_t before = b.offset;
+    memset(p1, 0x11, 24);
 
-    void *p2 = bump_alloc_aligned(&b, 16, 8);
-    TEST_ASSERT_NULL(p2);
-    TEST_ASSERT_EQUAL_UINT32((uint32_t)before, (uint32_t)b.offset);
+    uint8_t *p2 = (uint8_t *)bump_alloc_aligned(&b, 16, 8);
+    TEST_ASSERT_NOT_NULL(p2);
+    TEST_ASSERT_TRUE(b.data != NULL && p2 == b.data); // start of the new chunk
+    TEST_ASSERT_EQUAL_UINT32(64, (uint32_t)b.capacity);   // doubled
+    TEST_ASSERT_EQUAL_size_t(96, b.reserved);
+    TEST_ASSERT_EQUAL_UINT32(0x11u, p1[23]);             // earlier allocation didn't move
+    TEST_ASSERT_EQUAL_size_t(32 + 16, bump_used(&b));
+
+    uint8_t *big = (uint8_t *)bump_alloc_aligned(&b, 1000, 16);
+    TEST_ASSERT_NOT_NULL(big);
+    TEST_ASSERT_EQUAL_UINT32(1000, (uint32_t)b.capacity); // oversized request gets its own chunk
+
+    TEST_ASSERT_NULL(bump_alloc_aligned(&b, 8, 3));
+
+    bump_free(&b);
+}
+
+void test_bump_alloc_honours_alignment_above_chunk_align(void)
+{
+    bump_alloc_t b = {0};
+    TEST_ASSERT_TRUE(bump_init(&b, 1024));
+
+    TEST_ASSERT_NOT_NULL(bump_alloc_aligned(&b, 1, 1));
+    uint8_t *p = (uint8_t *)bump_alloc_aligned(&b, 100, 256);
+    TEST_ASSERT_NOT_NULL(p);
+    TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)((uintptr_t)p % 256u));
+
+    // Doesn't fit what's left: the new chunk is sized to leave room for the padding.
+    uint8_t *q = (uint8_t *)bump_alloc_aligned(&b, 4096, 4096);
+    TEST_ASSERT_NOT_NULL(q);
+    TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)((uintptr_t)q % 4096u));
+    TEST_ASSERT_TRUE(q + 4096 <= b.data + b.capacity);
+    memset(q, 0x5A, 4096);
+    TEST_ASSERT_EQUAL_size_t(bump_offset_of(&b, q) + 4096, bump_used(&b));
+
+    bump_free(&b);
+}
+
+void test_bump_restore_rewinds_and_drops_later_chunks(void)
+{
+    bump_alloc_t b = {0};
+    TEST_ASSERT_TRUE(bump_init(&b, 64));
+    void *keep = bump_alloc_aligned(&b, 16, 8);
+    TEST_ASSERT_NOT_NULL(keep);
+
+    bump_marker_t m = bump_save(&b);
+    TEST_ASSERT_EQUAL_size_t(16, m.used);
+    void *tmp = bump_alloc_aligned(&b, 16, 8);
+    TEST_ASSERT_NOT_NULL(bump_alloc_aligned(&b, 200, 8)); // spills into a second chunk
+    TEST_ASSERT_EQUAL_size_t(64 + 200, b.reserved);
+
+    bump_restore(&b, m);
+    TEST_ASSERT_EQUAL_size_t(64, b.reserved);
+    TEST_ASSERT_EQUAL_size_t(16, bump_used(&b));
+    TEST_ASSERT_EQUAL_PTR(tmp, bump_alloc_aligned(&b, 16, 8)); // same bytes reused
+    TEST_ASSERT_EQUAL_size_t(64 + 200, bump_high_water(&b));
 
     bump_free(&b);
 }
 
+void test_bump_reset_coalesces_chunks(void)
+{
+    bump_alloc_t b = {0};
+    TEST_ASSERT_TRUE(bump_init(&b, 64));
+    TEST_ASSERT_NOT_NULL(bump_alloc_aligned(&b, 48, 8));
+    TEST_ASSERT_NOT_NULL(bump_alloc_aligned(&b, 48, 8));
+    TEST_ASSERT_NOT_NULL(bump_alloc_aligned(&b, 300, 8));
+
+    const size_t reserved = b.reserved;
+    bump_reset(&b);
+    TEST_ASSERT_EQUAL_size_t(reserved, b.capacity); // one chunk of the combined size
+    TEST_ASSERT_EQUAL_size_t(reserved, b.reserved);
+    TEST_ASSERT_EQUAL_size_t(0, bump_used(&b));
+
+    bump_free(&b);
+}
+
+void test_bump_offsets_flatten_and_load_round_trip(void)
+{
+    bump_alloc_t b = {0};
+    TEST_ASSERT_TRUE(bump_init(&b, 16));
+    uint32_t *a = bump_alloc_type(&b, uint32_t, 3);
+    uint32_t *c = bump_alloc_type(&b, uint32_t, 4); // second chunk, logical offset 16
+    a[0] = 7; a[2] = 9;
+    c[0] = 42; c[3] = 43;
+    TEST_ASSERT_EQUAL_size_t(0, bump_offset_of(&b, a));
+    TEST_ASSERT_EQUAL_size_t(16, bump_offset_of(&b, c));
+    TEST_ASSERT_EQUAL_PTR(c, bump_ptr_at(&b, 16));
+    TEST_ASSERT_NULL(bump_ptr_at(&b, bump_used(&b)));
+
+    uint8_t flat[64];
+    const size_t used = bump_used(&b);
+    TEST_ASSERT_EQUAL_size_t(32, used);
+    bump_flatten(&b, flat);
+    TEST_ASSERT_EQUAL_UINT32(0, flat[12]); // unused tail of the first chunk
+
+    bump_alloc_t r = {0};
+    TEST_ASSERT_TRUE(bump_load(&r, flat, used));
+    const uint32_t *ra = (const uint32_t *)bump_ptr_at(&r, 0);
+    const uint32_t *rc = (const uint32_t *)bump_ptr_at(&r, 16);
+    TEST_ASSERT_EQUAL_UINT32(9, ra[2]);
+    TEST_ASSERT_EQUAL_UINT32(42, rc[0]);
+    TEST_ASSERT_EQUAL_UINT32(43, rc[3]);
+
+    bump_free(&r);
+    bump_free(&b);
+}
+
 void test_bump_reset_reuses_buffer(void)
 {
     bump_alloc_t b = {0};
@@ -59,6 +59,21 @@ void test_asset_reload_all_uses_backend(void)
     asset_collect();
 }
 
+void test_asset_reload_texture_path_reloads_only_that_slot(void)
+{
+    tex_handle_t a = asset_acquire_texture("assets/images/a.png");
+    tex_handle_t b = asset_acquire_texture("assets/images/b.png");
+
+    TEST_ASSERT_TRUE(asset_reload_texture_path("assets/maps/../images/b.png"));
+    TEST_ASSERT_EQUAL_INT(1, asset_backend_stub_reload_count());
+    TEST_ASSERT_FALSE(asset_reload_texture_path("assets/images/c.png"));
+    TEST_ASSERT_EQUAL_INT(1, asset_backend_stub_reload_count());
+
+    asset_release_texture(a);
+    asset_release_texture(b);
+    asset_collect();
+}
+
 void test_asset_collect_reuses_generations(void)
 {
     tex_handle_t first = asset_acquire_texture("cycle");
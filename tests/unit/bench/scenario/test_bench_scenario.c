@@ -0,0 +1,91 @@
+#include "unity.h"
+
+#include "bench/bench_scenario.h"
+
+#include <math.h>
+
+static bench_scenario_t g_sc;
+
+void setUp(void)
+{
+    g_sc = (bench_scenario_t){0};
+}
+
+void tearDown(void) {}
+
+void test_parse_defaults_for_empty_text(void)
+{
+    TEST_ASSERT_TRUE(bench_scenario_parse("", &g_sc));
+    TEST_ASSERT_EQUAL_STRING("assets/maps/start.tmx", g_sc.map);
+    TEST_ASSERT_EQUAL_INT(600, g_sc.ticks);
+    TEST_ASSERT_EQUAL_INT(60, g_sc.warmup);
+    TEST_ASSERT_EQUAL_INT(0, g_sc.spawn_count);
+    TEST_ASSERT_EQUAL_INT(0, g_sc.input_count);
+}
+
+void test_parse_reads_all_keys_and_skips_comments(void)
+{
+    const char* text =
+        "# comment line\n"
+        "map assets/maps/other.tmx\n"
+        "ticks 300   # trailing comment\n"
+        "warmup 10\n"
+        "seed 42\n"
+        "\n"
+        "spawn assets/prefabs/plastic.ent 25\n"
+        "hold 0 100 right\n"
+        "press 50 lift\n"
+        "mouse 0 300 12.5 7\n";
+    TEST_ASSERT_TRUE(bench_scenario_parse(text, &g_sc));
+    TEST_ASSERT_EQUAL_STRING("assets/maps/other.tmx", g_sc.map);
+    TEST_ASSERT_EQUAL_INT(300, g_sc.ticks);
+    TEST_ASSERT_EQUAL_INT(10, g_sc.warmup);
+    TEST_ASSERT_EQUAL_UINT32(42u, g_sc.seed);
+    TEST_ASSERT_EQUAL_INT(1, g_sc.spawn_count);
+    TEST_ASSERT_EQUAL_STRING("assets/prefabs/plastic.ent", g_sc.spawns[0].prefab);
+    TEST_ASSERT_EQUAL_INT(25, g_sc.spawns[0].count);
+    TEST_ASSERT_EQUAL_INT(3, g_sc.input_count);
+    TEST_ASSERT_EQUAL_INT(BENCH_INPUT_HOLD, g_sc.inputs[0].kind);
+    TEST_ASSERT_EQUAL_INT(BTN_RIGHT, g_sc.inputs[0].button);
+    TEST_ASSERT_EQUAL_INT(BENCH_INPUT_PRESS, g_sc.inputs[1].kind);
+    TEST_ASSERT_EQUAL_INT(51, g_sc.inputs[1].to);
+    TEST_ASSERT_EQUAL_INT(BENCH_INPUT_MOUSE, g_sc.inputs[2].kind);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 12.5f, g_sc.inputs[2].x);
+}
+
+void test_parse_rejects_bad_lines(void)
+{
+    TEST_ASSERT_FALSE(bench_scenario_parse("ticks 0\n", &g_sc));
+    TEST_ASSERT_FALSE(bench_scenario_parse("hold 10 5 left\n", &g_sc));
+    TEST_ASSERT_FALSE(bench_scenario_parse("press 3 jump\n", &g_sc));
+    TEST_ASSERT_FALSE(bench_scenario_parse("spawn assets/prefabs/plastic.ent\n", &g_sc));
+    TEST_ASSERT_FALSE(bench_scenario_parse("teleport 1 2\n", &g_sc));
+}
+
+void test_input_at_follows_timeline(void)
+{
+    TEST_ASSERT_TRUE(bench_scenario_parse(
+        "hold 0 10 right\n"
+        "hold 5 10 down\n"
+        "press 7 interact\n"
+        "mouse 0 10 100 50\n", &g_sc));
+
+    input_t in = bench_scenario_input_at(&g_sc, 0);
+    TEST_ASSERT_TRUE(input_down(&in, BTN_RIGHT));
+    TEST_ASSERT_TRUE(input_pressed(&in, BTN_RIGHT));
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 1.0f, in.moveX);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 0.0f, in.moveY);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 100.0f, in.mouse.x);
+
+    in = bench_scenario_input_at(&g_sc, 6);
+    TEST_ASSERT_FALSE(input_pressed(&in, BTN_RIGHT));
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, sqrtf(0.5f), in.moveX);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, sqrtf(0.5f), in.moveY);
+
+    in = bench_scenario_input_at(&g_sc, 7);
+    TEST_ASSERT_TRUE(input_pressed(&in, BTN_INTERACT));
+
+    in = bench_scenario_input_at(&g_sc, 10);
+    TEST_ASSERT_EQUAL_UINT64(0, in.down);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 0.0f, in.moveX);
+}
@@ -0,0 +1,56 @@
+#include "unity.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "modules/common/atom.h"
+
+void test_atom_intern_is_stable_and_distinct(void)
+{
+    const atom_t a = atom_intern("collision");
+    TEST_ASSERT_NOT_EQUAL(ATOM_NONE, a);
+    TEST_ASSERT_EQUAL_UINT32(a, atom_intern("collision"));
+    TEST_ASSERT_EQUAL_UINT32(a, atom_find("collision"));
+    TEST_ASSERT_NOT_EQUAL(a, atom_intern("Collision")); // case-sensitive form
+    TEST_ASSERT_EQUAL_STRING("collision", atom_str(a));
+
+    TEST_ASSERT_EQUAL_UINT32(ATOM_NONE, atom_intern(NULL));
+    TEST_ASSERT_EQUAL_UINT32(ATOM_NONE, atom_find("never interned"));
+    TEST_ASSERT_NULL(atom_str(ATOM_NONE));
+    TEST_ASSERT_NULL(atom_str((atom_t)atom_count() + 1u));
+}
+
+void test_atom_ci_folds_case_and_joins(void)
+{
+    const atom_t a = atom_intern_ci("Pos.X");
+    TEST_ASSERT_EQUAL_STRING("pos.x", atom_str(a));
+    TEST_ASSERT_EQUAL_UINT32(a, atom_intern_ci("POS.x"));
+    TEST_ASSERT_EQUAL_UINT32(a, atom_find_ci("pos.X"));
+    TEST_ASSERT_EQUAL_UINT32(a, atom_find_join_ci("POS", '.', "x"));
+    TEST_ASSERT_EQUAL_UINT32(ATOM_NONE, atom_find_join_ci("pos", '.', "z"));
+}
+
+void test_atom_strings_survive_growth(void)
+{
+    // Enough text to chain several arena chunks; earlier strings must not move.
+    char buf[64];
+    const atom_t first = atom_intern("first_of_many");
+    const char* first_str = atom_str(first);
+    const size_t before = atom_count();
+    for (int i = 0; i < 5000; ++i) {
+        snprintf(buf, sizeof(buf), "generated_property_name_%d", i);
+        TEST_ASSERT_NOT_EQUAL(ATOM_NONE, atom_intern(buf));
+    }
+    TEST_ASSERT_EQUAL_size_t(before + 5000, atom_count());
+    TEST_ASSERT_EQUAL_PTR(first_str, atom_str(first));
+    TEST_ASSERT_EQUAL_STRING("generated_property_name_4999", atom_str(atom_find("generated_property_name_4999")));
+
+    // Names longer than the stack fold buffer go through the heap path.
+    char longname[300];
+    memset(longname, 'A', sizeof(longname) - 1);
+    longname[sizeof(longname) - 1] = '\0';
+    const atom_t l = atom_intern_ci(longname);
+    TEST_ASSERT_EQUAL_size_t(sizeof(longname) - 1, strlen(atom_str(l)));
+    TEST_ASSERT_EQUAL_INT('a', atom_str(l)[0]);
+    TEST_ASSERT_EQUAL_UINT32(l, atom_find_ci(longname));
+}
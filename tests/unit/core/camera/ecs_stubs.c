@@ -22,7 +22,7 @@ void ecs_stub_set_position(bool has_position, v2f position)
     g_pos = position;
 }
 
-bool ecs_get_position(ecs_entity_t e, v2f* out_pos)
+bool ecs_get_render_position(ecs_entity_t e, v2f* out_pos)
 {
     if (!out_pos) return false;
     if (!g_has_pos) return false;
@@ -9,6 +9,8 @@
 #include "modules/core/engine.h"
 #include "modules/ecs/ecs_game.h"
 #include "modules/ecs/ecs_internal.h"
+#include "modules/ecs/ecs_physics.h"
+#include "modules/ecs/ecs_proximity.h"
 #include "modules/core/logger.h"
 #include "modules/renderer/renderer.h"
 #include "modules/core/toast.h"
@@ -21,15 +23,22 @@ int g_renderer_phys_calls = 0;
 int g_renderer_static_calls = 0;
 int g_renderer_triggers_calls = 0;
 int g_renderer_fps_calls = 0;
+int g_renderer_profiler_calls = 0;
+int g_trace_write_calls = 0;
+char g_trace_last_path[256] = {0};
 int g_toast_calls = 0;
 char g_last_toast[256] = {0};
 int g_log_calls = 0;
 bool g_engine_reload_world_result = false;
+bool g_engine_restart_result = false;
+int g_engine_restart_calls = 0;
 int g_world_tiles_w = 0;
 int g_world_tiles_h = 0;
 bool g_ecs_alive[ECS_MAX_ENTITIES] = {0};
 int g_game_storage_plastic = 0;
 int g_game_storage_capacity = 0;
+ecs_broadphase_kind_t g_phys_broadphase = ECS_BROADPHASE_ALL_PAIRS;
+ecs_broadphase_kind_t g_prox_broadphase = ECS_BROADPHASE_ALL_PAIRS;
 
 void debug_hotkeys_stub_reset(void)
 {
@@ -40,15 +49,22 @@ void debug_hotkeys_stub_reset(void)
     g_renderer_static_calls = 0;
     g_renderer_triggers_calls = 0;
     g_renderer_fps_calls = 0;
+    g_renderer_profiler_calls = 0;
+    g_trace_write_calls = 0;
+    g_trace_last_path[0] = '\0';
     g_toast_calls = 0;
     g_last_toast[0] = '\0';
     g_log_calls = 0;
     g_engine_reload_world_result = false;
+    g_engine_restart_result = false;
+    g_engine_restart_calls = 0;
     g_world_tiles_w = 0;
     g_world_tiles_h = 0;
     memset(g_ecs_alive, 0, sizeof(g_ecs_alive));
     g_game_storage_plastic = 0;
     g_game_storage_capacity = 0;
+    g_phys_broadphase = ECS_BROADPHASE_ALL_PAIRS;
+    g_prox_broadphase = ECS_BROADPHASE_ALL_PAIRS;
 }
 
 void asset_reload_all(void)
@@ -91,6 +107,19 @@ bool renderer_toggle_fps_overlay(void)
     return (g_renderer_fps_calls % 2) == 1;
 }
 
+bool trace_write_json(const char* path)
+{
+    g_trace_write_calls++;
+    snprintf(g_trace_last_path, sizeof(g_trace_last_path), "%s", path ? path : "");
+    return true;
+}
+
+bool renderer_toggle_profiler_overlay(void)
+{
+    g_renderer_profiler_calls++;
+    return (g_renderer_profiler_calls % 2) == 1;
+}
+
 void ui_toast(float secs, const char* fmt, ...)
 {
     (void)secs;
@@ -101,11 +130,41 @@ void ui_toast(float secs, const char* fmt, ...)
     va_end(ap);
 }
 
+void ecs_physics_set_broadphase(ecs_broadphase_kind_t kind)
+{
+    g_phys_broadphase = kind;
+}
+
+ecs_broadphase_kind_t ecs_physics_broadphase(void)
+{
+    return g_phys_broadphase;
+}
+
+void ecs_proximity_set_broadphase(ecs_broadphase_kind_t kind)
+{
+    g_prox_broadphase = kind;
+}
+
+const char* ecs_broadphase_kind_name(ecs_broadphase_kind_t kind)
+{
+    switch (kind) {
+        case ECS_BROADPHASE_GRID: return "grid";
+        case ECS_BROADPHASE_SAP:  return "sap";
+        default:                  return "all-pairs";
+    }
+}
+
 bool engine_reload_world(void)
 {
     return g_engine_reload_world_result;
 }
 
+bool engine_restart_level(void)
+{
+    g_engine_restart_calls++;
+    return g_engine_restart_result;
+}
+
 void world_size_tiles(int* out_w, int* out_h)
 {
     if (out_w) *out_w = g_world_tiles_w;
@@ -3,6 +3,7 @@
 #include <stdbool.h>
 
 #include "modules/ecs/ecs.h"
+#include "modules/ecs/ecs_broadphase.h"
 
 extern int g_asset_reload_calls;
 extern int g_asset_log_calls;
@@ -11,14 +12,21 @@ extern int g_renderer_phys_calls;
 extern int g_renderer_static_calls;
 extern int g_renderer_triggers_calls;
 extern int g_renderer_fps_calls;
+extern int g_renderer_profiler_calls;
+extern int g_trace_write_calls;
+extern char g_trace_last_path[256];
 extern int g_toast_calls;
 extern char g_last_toast[256];
 extern int g_log_calls;
 extern bool g_engine_reload_world_result;
+extern bool g_engine_restart_result;
+extern int g_engine_restart_calls;
 extern int g_world_tiles_w;
 extern int g_world_tiles_h;
 extern bool g_ecs_alive[ECS_MAX_ENTITIES];
 extern int g_game_storage_plastic;
 extern int g_game_storage_capacity;
+extern ecs_broadphase_kind_t g_phys_broadphase;
+extern ecs_broadphase_kind_t g_prox_broadphase;
 
 void debug_hotkeys_stub_reset(void);
@@ -71,6 +71,17 @@ void test_debug_hotkeys_reload_world_message(void)
     TEST_ASSERT_EQUAL_STRING("TMX reload: ok (10x12 tiles)", g_last_toast);
 }
 
+void test_debug_hotkeys_restart_level_message(void)
+{
+    g_engine_restart_result = true;
+
+    input_t in = make_input_pressed(BTN_DEBUG_RESTART);
+    sys_debug_binds(&in);
+
+    TEST_ASSERT_EQUAL_INT(1, g_engine_restart_calls);
+    TEST_ASSERT_EQUAL_STRING("Level restart: ok", g_last_toast);
+}
+
 void test_debug_hotkeys_inspect_toggle_toast(void)
 {
     input_t in = make_input_pressed(BTN_DEBUG_INSPECT);
@@ -89,6 +100,39 @@ void test_debug_hotkeys_fps_toggle(void)
     TEST_ASSERT_EQUAL_STRING("FPS overlay: on", g_last_toast);
 }
 
+void test_debug_hotkeys_profiler_toggle(void)
+{
+    input_t in = make_input_pressed(BTN_DEBUG_PROFILER);
+    sys_debug_binds(&in);
+
+    TEST_ASSERT_EQUAL_INT(1, g_renderer_profiler_calls);
+    TEST_ASSERT_EQUAL_STRING("Profiler overlay: on", g_last_toast);
+}
+
+void test_debug_hotkeys_trace_dump_writes_json(void)
+{
+    input_t in = make_input_pressed(BTN_DEBUG_TRACE);
+    sys_debug_binds(&in);
+
+    TEST_ASSERT_EQUAL_INT(1, g_trace_write_calls);
+    TEST_ASSERT_EQUAL_STRING("traces/trace_00000.json", g_trace_last_path);
+    TEST_ASSERT_EQUAL_STRING("Saved trace: traces/trace_00000.json", g_last_toast);
+}
+
+void test_debug_hotkeys_broadphase_cycles_physics_and_proximity(void)
+{
+    input_t in = make_input_pressed(BTN_DEBUG_BROADPHASE);
+    sys_debug_binds(&in);
+
+    TEST_ASSERT_EQUAL_INT(ECS_BROADPHASE_GRID, g_phys_broadphase);
+    TEST_ASSERT_EQUAL_INT(ECS_BROADPHASE_GRID, g_prox_broadphase);
+    TEST_ASSERT_EQUAL_STRING("Broadphase: grid", g_last_toast);
+
+    sys_debug_binds(&in);
+    sys_debug_binds(&in);
+    TEST_ASSERT_EQUAL_INT(ECS_BROADPHASE_ALL_PAIRS, g_phys_broadphase);
+}
+
 void test_debug_hotkeys_inspect_click_logs_components(void)
 {
     int idx = 1;
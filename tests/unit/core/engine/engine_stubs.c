@@ -2,6 +2,7 @@
 
 #include <stdarg.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "modules/asset/asset.h"
@@ -9,11 +10,18 @@
 #include "modules/ecs/ecs_game.h"
 #include "modules/ecs/ecs_physics.h"
 #include "modules/core/input.h"
+#include "modules/core/input_record.h"
 #include "modules/core/logger.h"
 #include "modules/core/logger_raylib_adapter.h"
+#include "modules/core/frame_alloc.h"
+#include "modules/core/map_manager.h"
+#include "modules/core/metrics.h"
 #include "modules/core/platform.h"
+#include "modules/core/savegame.h"
+#include "modules/core/snapshot.h"
 #include "modules/renderer/renderer.h"
 #include "modules/core/toast.h"
+#include "modules/prefab/prefab_cmp.h"
 #include "modules/world/world.h"
 #include "modules/world/world_query.h"
 
@@ -23,6 +31,20 @@ int g_log_set_min_level_calls = 0;
 int g_ui_toast_init_calls = 0;
 int g_ui_toast_update_calls = 0;
 int g_input_init_calls = 0;
+int g_input_record_open_calls = 0;
+int g_input_replay_open_calls = 0;
+int g_input_record_close_calls = 0;
+int g_input_replay_close_calls = 0;
+char g_input_replay_path[256];
+char g_profile_csv_path[256];
+int g_snapshot_capture_calls = 0;
+int g_snapshot_restore_calls = 0;
+int g_snapshot_free_calls = 0;
+int g_savegame_read_calls = 0;
+int g_savegame_write_calls = 0;
+int g_savegame_shutdown_calls = 0;
+char g_savegame_write_path[256];
+char g_savegame_map[256];
 int g_asset_init_calls = 0;
 int g_asset_shutdown_calls = 0;
 int g_ecs_init_calls = 0;
@@ -45,6 +67,18 @@ int g_platform_should_close_calls = 0;
 int g_systems_tick_calls = 0;
 int g_systems_present_calls = 0;
 int g_systems_registration_init_calls = 0;
+int g_ecs_store_prev_calls = 0;
+float g_ecs_render_alpha = -1.0f;
+int g_ecs_destroy_all_calls = 0;
+int g_world_install_prepared_calls = 0;
+int g_map_manager_set_current_calls = 0;
+int g_map_manager_take_calls = 0;
+int g_map_manager_shutdown_calls = 0;
+char g_map_manager_current_path[256] = {0};
+bool g_map_manager_take_result = true;
+bool g_map_link_active = false;
+map_link_t g_map_link = {0};
+v2f g_player_pos = {0};
 
 int g_renderer_init_width = 0;
 int g_renderer_init_height = 0;
@@ -67,6 +101,15 @@ int g_world_px_h = 0;
 camera_config_t g_camera_cfg = {0};
 camera_view_t g_camera_view = {0};
 
+// Snapshots and saves carry this instead of real ECS/world state, as "world|entities|progress"
+// followed by the camera config, so a restore onto a map whose entities weren't respawned shows
+// up as a mismatch.
+char g_sim_world[256];
+char g_sim_entities[256];
+int g_sim_progress = 0;
+static char g_taken_path[256];
+static snap_buf_t g_save_file; // last payload handed to savegame_write_async
+
 void engine_stub_reset(void)
 {
     g_platform_init_calls = 0;
@@ -75,6 +118,20 @@ void engine_stub_reset(void)
     g_ui_toast_init_calls = 0;
     g_ui_toast_update_calls = 0;
     g_input_init_calls = 0;
+    g_input_record_open_calls = 0;
+    g_input_replay_open_calls = 0;
+    g_input_record_close_calls = 0;
+    g_input_replay_close_calls = 0;
+    g_input_replay_path[0] = '\0';
+    g_profile_csv_path[0] = '\0';
+    g_snapshot_capture_calls = 0;
+    g_snapshot_restore_calls = 0;
+    g_snapshot_free_calls = 0;
+    g_savegame_read_calls = 0;
+    g_savegame_write_calls = 0;
+    g_savegame_shutdown_calls = 0;
+    g_savegame_write_path[0] = '\0';
+    g_savegame_map[0] = '\0';
     g_asset_init_calls = 0;
     g_asset_shutdown_calls = 0;
     g_ecs_init_calls = 0;
@@ -96,6 +153,18 @@ void engine_stub_reset(void)
     g_systems_tick_calls = 0;
     g_systems_present_calls = 0;
     g_systems_registration_init_calls = 0;
+    g_ecs_store_prev_calls = 0;
+    g_ecs_render_alpha = -1.0f;
+    g_ecs_destroy_all_calls = 0;
+    g_world_install_prepared_calls = 0;
+    g_map_manager_set_current_calls = 0;
+    g_map_manager_take_calls = 0;
+    g_map_manager_shutdown_calls = 0;
+    g_map_manager_current_path[0] = '\0';
+    g_map_manager_take_result = true;
+    g_map_link_active = false;
+    g_map_link = (map_link_t){0};
+    g_player_pos = (v2f){0};
     g_platform_should_close_calls = 0;
 
     g_renderer_init_width = 0;
@@ -118,6 +187,12 @@ void engine_stub_reset(void)
     g_world_px_h = 0;
     g_camera_cfg = (camera_config_t){0};
     g_camera_view = (camera_view_t){0};
+
+    snprintf(g_sim_world, sizeof(g_sim_world), "none");
+    snprintf(g_sim_entities, sizeof(g_sim_entities), "none");
+    g_sim_progress = 0;
+    g_taken_path[0] = '\0';
+    g_save_file.size = 0;
 }
 
 void platform_init(void)
@@ -158,6 +233,149 @@ void input_init_defaults(void)
     g_input_init_calls++;
 }
 
+bool input_record_open(const char* path)
+{
+    (void)path;
+    g_input_record_open_calls++;
+    return true;
+}
+
+void input_record_close(void)
+{
+    g_input_record_close_calls++;
+}
+
+bool input_replay_open(const char* path)
+{
+    g_input_replay_open_calls++;
+    snprintf(g_input_replay_path, sizeof(g_input_replay_path), "%s", path ? path : "");
+    return true;
+}
+
+void input_replay_close(void)
+{
+    g_input_replay_close_calls++;
+}
+
+static bool sim_copy(snapshot_t* out, const void* data, size_t size)
+{
+    free(out->data);
+    out->data = (uint8_t*)malloc(size);
+    out->size = size;
+    memcpy(out->data, data, size);
+    return true;
+}
+
+bool snapshot_capture(snapshot_t* out)
+{
+    g_snapshot_capture_calls++;
+    if (!out) return false;
+    char text[600];
+    const int n = snprintf(text, sizeof(text), "%s|%s|%d", g_sim_world, g_sim_entities, g_sim_progress);
+    snap_buf_t b = {0};
+    snap_write(&b, text, (size_t)n + 1);
+    SNAP_WRITE_VAL(&b, g_camera_cfg);
+    free(out->data);
+    out->data = b.data;
+    out->size = b.size;
+    return true;
+}
+
+bool snapshot_restore(const snapshot_t* snap)
+{
+    g_snapshot_restore_calls++;
+    char world[256];
+    char entities[256];
+    int progress = 0;
+    if (!snap || !snap->data ||
+        sscanf((const char*)snap->data, "%255[^|]|%255[^|]|%d", world, entities, &progress) != 3) {
+        return false;
+    }
+    if (strcmp(world, g_sim_world) != 0) return false; // the real header's map_gen check
+    snprintf(g_sim_entities, sizeof(g_sim_entities), "%s", entities);
+    g_sim_progress = progress;
+    memcpy(&g_camera_cfg, snap->data + strlen((const char*)snap->data) + 1, sizeof(g_camera_cfg));
+    return true;
+}
+
+void snapshot_free(snapshot_t* snap)
+{
+    g_snapshot_free_calls++;
+    if (!snap) return;
+    free(snap->data);
+    snap->data = NULL;
+    snap->size = 0;
+}
+
+size_t snapshot_body_offset(void)
+{
+    return 0;
+}
+
+bool snapshot_wrap_body(snapshot_t* out, const uint8_t* body, size_t body_size)
+{
+    return out && body && sim_copy(out, body, body_size);
+}
+
+// Stub save: NUL-terminated map path, baseline size + bytes, then the live snapshot.
+bool savegame_encode(snap_buf_t* out, const snapshot_t* baseline, const snapshot_t* current, const char* map_path)
+{
+    if (!out || !baseline->data || !current->data || !map_path) return false;
+    snap_write(out, map_path, strlen(map_path) + 1);
+    SNAP_WRITE_VAL(out, baseline->size);
+    snap_write(out, baseline->data, baseline->size);
+    snap_write(out, current->data, current->size);
+    return true;
+}
+
+bool savegame_map_path(const uint8_t* data, size_t size, char* out, size_t out_cap)
+{
+    if (data && size) {
+        snprintf(out, out_cap, "%s", (const char*)data);
+        return true;
+    }
+    if (!g_savegame_map[0]) return false;
+    snprintf(out, out_cap, "%s", g_savegame_map);
+    return true;
+}
+
+bool savegame_decode(snapshot_t* out, const snapshot_t* baseline, const uint8_t* data, size_t size)
+{
+    if (!data || !size || !baseline->data) return false; // g_savegame_map-only saves never decode
+    snap_reader_t r = { .data = data, .size = size, .pos = strlen((const char*)data) + 1 };
+    size_t base_size = 0;
+    if (!SNAP_READ_VAL(&r, base_size) || base_size != baseline->size || base_size > size - r.pos ||
+        memcmp(data + r.pos, baseline->data, base_size) != 0) {
+        return false;
+    }
+    r.pos += base_size;
+    return sim_copy(out, data + r.pos, size - r.pos);
+}
+
+bool savegame_read_file(const char* path, snap_buf_t* out)
+{
+    (void)path;
+    g_savegame_read_calls++;
+    if (g_save_file.size) {
+        snap_write(out, g_save_file.data, g_save_file.size);
+        return true;
+    }
+    return g_savegame_map[0] != '\0'; // a save on disk when the test names its map
+}
+
+void savegame_write_async(const char* path, snap_buf_t* save)
+{
+    g_savegame_write_calls++;
+    snprintf(g_savegame_write_path, sizeof(g_savegame_write_path), "%s", path ? path : "");
+    g_save_file.size = 0;
+    snap_write(&g_save_file, save->data, save->size);
+}
+
+void savegame_shutdown(void)
+{
+    g_savegame_shutdown_calls++;
+}
+
 void asset_init(void)
 {
     g_asset_init_calls++;
@@ -198,10 +416,12 @@ bool world_load_from_tmx(const char* tmx_path, const char* collision_layer_name)
     } else {
         g_world_load_last_path[0] = '\0';
     }
+    bool ok = true;
     if (g_world_load_result_index < g_world_load_result_count) {
-        return g_world_load_results[g_world_load_result_index++];
+        ok = g_world_load_results[g_world_load_result_index++];
     }
-    return true;
+    if (ok && tmx_path) snprintf(g_sim_world, sizeof(g_sim_world), "%s", tmx_path);
+    return ok;
 }
 
 void world_shutdown(void)
@@ -264,8 +484,9 @@ camera_view_t camera_get_view(void)
 
 bool init_entities(const char* tmx_path)
 {
-    (void)tmx_path;
     g_init_entities_calls++;
+    snprintf(g_sim_entities, sizeof(g_sim_entities), "%s", tmx_path ? tmx_path : "none");
+    g_sim_progress = 0;
     return g_init_entities_result;
 }
 
@@ -274,6 +495,166 @@ ecs_entity_t ecs_find_player(void)
     return (ecs_entity_t){1u, 1u};
 }
 
+bool ecs_get_player_position(float* out_x, float* out_y)
+{
+    if (out_x) *out_x = g_player_pos.x;
+    if (out_y) *out_y = g_player_pos.y;
+    return true;
+}
+
+bool ecs_get_position(ecs_entity_t e, v2f* out_pos)
+{
+    (void)e;
+    if (out_pos) *out_pos = g_player_pos;
+    return true;
+}
+
+void cmp_add_position(ecs_entity_t e, float x, float y)
+{
+    (void)e;
+    g_player_pos = (v2f){ x, y };
+}
+
+void ecs_destroy_all(void)
+{
+    g_ecs_destroy_all_calls++;
+    snprintf(g_sim_entities, sizeof(g_sim_entities), "none");
+    g_sim_progress = 0;
+}
+
+void ecs_prefab_use_templates(const ecs_prefab_templates_t* templates)
+{
+    (void)templates;
+}
+
+void ecs_prefab_loading_shutdown(void)
+{
+}
+
+v2f prefab_object_position_default(const tiled_object_t* obj)
+{
+    return (v2f){ obj->x, obj->y };
+}
+
+const world_map_t* world_get_map(void)
+{
+    return NULL;
+}
+
+void world_install_prepared(world_prepared_map_t* prepared)
+{
+    (void)prepared;
+    g_world_install_prepared_calls++;
+    snprintf(g_sim_world, sizeof(g_sim_world), "%s", g_taken_path);
+}
+
+void map_manager_set_current(const world_map_t* map, const char* tmx_path)
+{
+    (void)map;
+    g_map_manager_set_current_calls++;
+    snprintf(g_map_manager_current_path, sizeof(g_map_manager_current_path), "%s", tmx_path ? tmx_path : "");
+}
+
+const map_link_t* map_manager_link_at(float x, float y)
+{
+    if (!g_map_link_active) return NULL;
+    const map_link_t* l = &g_map_link;
+    return (x >= l->x && x < l->x + l->w && y >= l->y && y < l->y + l->h) ? l : NULL;
+}
+
+bool map_manager_preload(const char* tmx_path)
+{
+    (void)tmx_path;
+    return true;
+}
+
+bool map_manager_take(const char* tmx_path, map_preload_t* out)
+{
+    g_map_manager_take_calls++;
+    snprintf(g_taken_path, sizeof(g_taken_path), "%s", tmx_path ? tmx_path : "");
+    *out = (map_preload_t){0};
+    return g_map_manager_take_result;
+}
+
+void map_preload_free(map_preload_t* preload)
+{
+    *preload = (map_preload_t){0};
+}
+
+void map_manager_shutdown(void)
+{
+    g_map_manager_shutdown_calls++;
+}
+
+void frame_alloc_shutdown(void)
+{
+}
+
+bool log_set_async(bool enabled)
+{
+    (void)enabled;
+    return true;
+}
+
+bool log_configure(const char* spec)
+{
+    (void)spec;
+    return true;
+}
+
+metric_t* metrics_gauge(const char* name, const char* help, const char* labels)
+{
+    (void)name; (void)help; (void)labels;
+    return NULL;
+}
+
+void metrics_set(metric_t* gauge, double v)
+{
+    (void)gauge; (void)v;
+}
+
+bool metrics_serve(const char* addr)
+{
+    (void)addr;
+    return false;
+}
+
+void metrics_shutdown(void)
+{
+}
+
+int ecs_live_count(void)
+{
+    return 0;
+}
+
+int asset_texture_slots_used(void)
+{
+    return 0;
+}
+
+size_t frame_alloc_used(frame_arena_t arena)
+{
+    (void)arena;
+    return 0;
+}
+
+size_t frame_alloc_high_water(frame_arena_t arena)
+{
+    (void)arena;
+    return 0;
+}
+
+void ecs_store_prev_positions(void)
+{
+    g_ecs_store_prev_calls++;
+}
+
+void ecs_set_render_alpha(float alpha)
+{
+    g_ecs_render_alpha = alpha;
+}
+
 bool log_would_log(log_level_t lvl)
 {
     (void)lvl;
@@ -311,6 +692,12 @@ void systems_present(float dt)
     g_systems_present_calls++;
 }
 
+bool systems_profile_write_csv(const char* path)
+{
+    snprintf(g_profile_csv_path, sizeof(g_profile_csv_path), "%s", path ? path : "");
+    return true;
+}
+
 void systems_registration_init(void)
 {
     g_systems_registration_init_calls++;
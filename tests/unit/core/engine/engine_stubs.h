@@ -5,6 +5,7 @@
 #include "modules/core/engine_types.h"
 #include "modules/ecs/ecs.h"
 #include "modules/core/camera.h"
+#include "modules/core/map_manager.h"
 
 extern int g_platform_init_calls;
 extern int g_logger_use_raylib_calls;
@@ -12,6 +13,20 @@ extern int g_log_set_min_level_calls;
 extern int g_ui_toast_init_calls;
 extern int g_ui_toast_update_calls;
 extern int g_input_init_calls;
+extern int g_input_record_open_calls;
+extern int g_input_replay_open_calls;
+extern int g_input_record_close_calls;
+extern int g_input_replay_close_calls;
+extern char g_input_replay_path[256];
+extern char g_profile_csv_path[256];
+extern int g_snapshot_capture_calls;
+extern int g_snapshot_restore_calls;
+extern int g_snapshot_free_calls;
+extern int g_savegame_read_calls;
+extern int g_savegame_write_calls;
+extern int g_savegame_shutdown_calls;
+extern char g_savegame_write_path[256];
+extern char g_savegame_map[256];
 extern int g_asset_init_calls;
 extern int g_asset_shutdown_calls;
 extern int g_ecs_init_calls;
@@ -34,6 +49,21 @@ extern int g_systems_tick_calls;
 extern int g_systems_present_calls;
 extern int g_systems_registration_init_calls;
 extern int g_platform_should_close_calls;
+extern int g_ecs_store_prev_calls;
+extern float g_ecs_render_alpha;
+extern int g_ecs_destroy_all_calls;
+extern int g_world_install_prepared_calls;
+extern int g_map_manager_set_current_calls;
+extern int g_map_manager_take_calls;
+extern int g_map_manager_shutdown_calls;
+extern char g_map_manager_current_path[256];
+extern bool g_map_manager_take_result;
+extern bool g_map_link_active;
+extern map_link_t g_map_link;
+extern v2f g_player_pos;
+extern char g_sim_world[256];    // map installed in the world
+extern char g_sim_entities[256]; // map whose entities are alive; "none" after ecs_destroy_all
+extern int g_sim_progress;       // stands in for play since the spawn
 
 extern int g_renderer_init_width;
 extern int g_renderer_init_height;
@@ -1,5 +1,11 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "unity.h"
 
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "modules/core/engine.h"
@@ -8,6 +14,7 @@
 void setUp(void)
 {
     engine_stub_reset();
+    engine_set_start_map("assets/maps/start.tmx"); // map changes move the engine's current map
 }
 
 void tearDown(void)
@@ -151,3 +158,247 @@ void test_engine_run_processes_one_frame(void)
     TEST_ASSERT_EQUAL_INT(g_systems_tick_calls, g_input_for_tick_calls);
     TEST_ASSERT_EQUAL_INT(1, g_systems_present_calls);
 }
+
+void test_engine_run_interpolates_between_ticks_at_sim_rate(void)
+{
+    engine_set_sim_hz(30);
+    TEST_ASSERT_EQUAL_INT(30, engine_sim_hz());
+    g_platform_should_close_after = 1;
+    g_time_frame_dt = 0.05f;
+
+    TEST_ASSERT_EQUAL_INT(0, engine_run());
+    TEST_ASSERT_EQUAL_INT(1, g_systems_tick_calls);
+    TEST_ASSERT_EQUAL_INT(g_systems_tick_calls, g_ecs_store_prev_calls);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.5f, g_ecs_render_alpha);
+
+    engine_set_sim_hz(1);
+    TEST_ASSERT_EQUAL_INT(ENGINE_SIM_HZ_MIN, engine_sim_hz());
+    engine_set_sim_hz(60);
+}
+
+void test_engine_init_opens_input_replay_from_env(void)
+{
+    g_world_load_results[0] = true;
+    g_world_load_result_count = 1;
+    g_renderer_init_result = true;
+    g_renderer_bind_result = true;
+    g_init_entities_result = true;
+
+    unsetenv("INPUT_RECORD");
+    setenv("INPUT_REPLAY", "session.inpr", 1);
+    TEST_ASSERT_TRUE(engine_init("UnitTest"));
+    unsetenv("INPUT_REPLAY");
+
+    TEST_ASSERT_EQUAL_INT(0, g_input_record_open_calls);
+    TEST_ASSERT_EQUAL_INT(1, g_input_replay_open_calls);
+    TEST_ASSERT_EQUAL_STRING("session.inpr", g_input_replay_path);
+
+    engine_shutdown();
+    TEST_ASSERT_EQUAL_INT(1, g_input_record_close_calls);
+    TEST_ASSERT_EQUAL_INT(1, g_input_replay_close_calls);
+}
+
+void test_engine_shutdown_writes_profile_csv_from_env(void)
+{
+    g_world_load_results[0] = true;
+    g_world_load_result_count = 1;
+    g_renderer_init_result = true;
+    g_renderer_bind_result = true;
+    g_init_entities_result = true;
+
+    TEST_ASSERT_TRUE(engine_init("UnitTest"));
+    setenv("HEADLESS_PROFILE_CSV", "profile.csv", 1);
+    engine_shutdown();
+    unsetenv("HEADLESS_PROFILE_CSV");
+    TEST_ASSERT_EQUAL_STRING("profile.csv", g_profile_csv_path);
+}
+
+void test_engine_restart_level_uses_snapshot_from_map_load(void)
+{
+    g_world_load_results[0] = true;
+    g_world_load_results[1] = true;
+    g_world_load_result_count = 2;
+    g_renderer_init_result = true;
+    g_renderer_bind_result = true;
+    g_init_entities_result = true;
+
+    TEST_ASSERT_TRUE(engine_init("UnitTest"));
+    TEST_ASSERT_EQUAL_INT(2, g_snapshot_capture_calls); // save baseline + restart state
+
+    // A reload keeps play going but doesn't make the moment of the reload the new level start.
+    g_sim_progress = 3;
+    TEST_ASSERT_TRUE(engine_reload_world());
+    TEST_ASSERT_EQUAL_STRING("assets/maps/start.tmx", g_sim_entities);
+    TEST_ASSERT_EQUAL_INT(3, g_sim_progress);
+
+    TEST_ASSERT_TRUE(engine_restart_level());
+    TEST_ASSERT_EQUAL_INT(0, g_sim_progress);
+
+    engine_shutdown();
+}
+
+void test_engine_save_game_env_loads_then_autosaves(void)
+{
+    g_world_load_results[0] = true;
+    g_world_load_result_count = 1;
+    g_renderer_init_result = true;
+    g_renderer_bind_result = true;
+    g_init_entities_result = true;
+
+    setenv("SAVE_GAME", "slot.sav", 1);
+    TEST_ASSERT_TRUE(engine_init("UnitTest"));
+    unsetenv("SAVE_GAME");
+    TEST_ASSERT_EQUAL_INT(1, g_savegame_read_calls);
+
+    g_platform_should_close_after = 1;
+    g_time_frame_dt = 0.25f; // 15 ticks at 60Hz, below the autosave interval
+    TEST_ASSERT_EQUAL_INT(0, engine_run());
+    TEST_ASSERT_EQUAL_INT(0, g_savegame_write_calls);
+
+    engine_shutdown();
+    TEST_ASSERT_EQUAL_INT(1, g_savegame_write_calls);
+    TEST_ASSERT_EQUAL_STRING("slot.sav", g_savegame_write_path);
+    TEST_ASSERT_EQUAL_INT(1, g_savegame_shutdown_calls);
+}
+
+static void init_engine_for_map_change(void)
+{
+    g_world_load_results[0] = true;
+    g_world_load_result_count = 1;
+    g_renderer_init_result = true;
+    g_renderer_bind_result = true;
+    g_init_entities_result = true;
+    engine_set_start_map("assets/maps/start.tmx");
+    TEST_ASSERT_TRUE(engine_init("UnitTest"));
+    TEST_ASSERT_EQUAL_INT(1, g_map_manager_set_current_calls);
+}
+
+void test_engine_change_map_waits_for_tick_boundary(void)
+{
+    init_engine_for_map_change();
+
+    TEST_ASSERT_TRUE(engine_change_map("assets/maps/cave.tmx", NULL));
+    TEST_ASSERT_EQUAL_INT(0, g_ecs_destroy_all_calls);
+    TEST_ASSERT_EQUAL_INT(1, g_init_entities_calls);
+
+    engine_after_tick();
+    TEST_ASSERT_EQUAL_INT(1, g_map_manager_take_calls);
+    TEST_ASSERT_EQUAL_INT(1, g_ecs_destroy_all_calls);
+    TEST_ASSERT_EQUAL_INT(1, g_world_install_prepared_calls);
+    TEST_ASSERT_EQUAL_INT(2, g_init_entities_calls);
+    TEST_ASSERT_EQUAL_INT(1, g_world_load_from_tmx_calls); // no blocking load on the main thread
+    TEST_ASSERT_EQUAL_STRING("assets/maps/cave.tmx", engine_current_map());
+    TEST_ASSERT_EQUAL_STRING("assets/maps/cave.tmx", g_map_manager_current_path);
+    TEST_ASSERT_EQUAL_INT(4, g_snapshot_capture_calls);
+
+    // Applied once.
+    engine_after_tick();
+    TEST_ASSERT_EQUAL_INT(1, g_map_manager_take_calls);
+
+    engine_shutdown();
+    TEST_ASSERT_EQUAL_INT(1, g_map_manager_shutdown_calls);
+}
+
+void test_engine_change_map_keeps_current_map_when_load_fails(void)
+{
+    init_engine_for_map_change();
+    const char* before = "assets/maps/start.tmx";
+    TEST_ASSERT_EQUAL_STRING(before, engine_current_map());
+
+    g_map_manager_take_result = false;
+    TEST_ASSERT_TRUE(engine_change_map("assets/maps/missing.tmx", NULL));
+    engine_after_tick();
+    TEST_ASSERT_EQUAL_INT(0, g_ecs_destroy_all_calls);
+    TEST_ASSERT_EQUAL_STRING(before, engine_current_map());
+
+    engine_shutdown();
+}
+
+void test_engine_map_link_triggers_once_player_walks_in(void)
+{
+    init_engine_for_map_change();
+
+    g_map_link_active = true;
+    g_map_link = (map_link_t){ .x = 100.0f, .y = 100.0f, .w = 32.0f, .h = 32.0f };
+    snprintf(g_map_link.target_map, sizeof(g_map_link.target_map), "assets/maps/house.tmx");
+
+    // Starting on a link doesn't fire it; the player has to step off first.
+    g_player_pos = (v2f){ 110.0f, 110.0f };
+    engine_after_tick();
+    TEST_ASSERT_EQUAL_INT(0, g_map_manager_take_calls);
+
+    g_player_pos = (v2f){ 10.0f, 10.0f };
+    engine_after_tick();
+    TEST_ASSERT_EQUAL_INT(0, g_map_manager_take_calls);
+
+    g_player_pos = (v2f){ 110.0f, 110.0f };
+    engine_after_tick();
+    TEST_ASSERT_EQUAL_INT(1, g_map_manager_take_calls);
+    TEST_ASSERT_EQUAL_STRING("assets/maps/house.tmx", engine_current_map());
+
+    // Arriving inside the target's own door doesn't bounce straight back.
+    engine_after_tick();
+    TEST_ASSERT_EQUAL_INT(1, g_map_manager_take_calls);
+
+    engine_shutdown();
+}
+
+void test_engine_load_game_returns_to_previous_map_when_save_is_bad(void)
+{
+    init_engine_for_map_change();
+    g_sim_progress = 4;
+    snprintf(g_savegame_map, sizeof(g_savegame_map), "%s", "assets/maps/other.tmx");
+
+    // The save's map loads, but its delta doesn't decode against it (no payload to decode).
+    TEST_ASSERT_FALSE(engine_load_game("slot.sav"));
+    TEST_ASSERT_EQUAL_INT(2, g_map_manager_take_calls);
+    TEST_ASSERT_EQUAL_STRING("assets/maps/start.tmx", engine_current_map());
+    TEST_ASSERT_EQUAL_STRING("assets/maps/start.tmx", g_sim_world);
+    TEST_ASSERT_EQUAL_STRING("assets/maps/start.tmx", g_sim_entities);
+    TEST_ASSERT_EQUAL_INT(4, g_sim_progress); // play is back exactly where it was
+
+    engine_shutdown();
+}
+
+void test_engine_load_game_restores_save_made_on_another_map(void)
+{
+    init_engine_for_map_change();
+    TEST_ASSERT_TRUE(engine_change_map("assets/maps/cave.tmx", "from_start"));
+    engine_after_tick();
+    g_sim_progress = 7;
+    TEST_ASSERT_TRUE(engine_save_game("slot.sav"));
+
+    // Back on the start map, as a fresh launch would be.
+    TEST_ASSERT_TRUE(engine_change_map("assets/maps/start.tmx", NULL));
+    engine_after_tick();
+    TEST_ASSERT_EQUAL_INT(0, g_sim_progress);
+
+    TEST_ASSERT_TRUE(engine_load_game("slot.sav"));
+    TEST_ASSERT_EQUAL_STRING("assets/maps/cave.tmx", engine_current_map());
+    TEST_ASSERT_EQUAL_STRING("assets/maps/cave.tmx", g_sim_world);
+    TEST_ASSERT_EQUAL_STRING("assets/maps/cave.tmx", g_sim_entities);
+    TEST_ASSERT_EQUAL_INT(7, g_sim_progress);
+
+    engine_shutdown();
+}
+
+void test_engine_save_game_env_does_not_autosave_over_a_bad_save(void)
+{
+    g_world_load_results[0] = true;
+    g_world_load_result_count = 1;
+    g_renderer_init_result = true;
+    g_renderer_bind_result = true;
+    g_init_entities_result = true;
+    snprintf(g_savegame_map, sizeof(g_savegame_map), "%s", "assets/maps/start.tmx");
+
+    setenv("SAVE_GAME", "slot.sav", 1);
+    TEST_ASSERT_TRUE(engine_init("UnitTest"));
+    unsetenv("SAVE_GAME");
+    TEST_ASSERT_EQUAL_INT(1, g_savegame_read_calls);
+
+    g_platform_should_close_after = 1;
+    g_time_frame_dt = 0.25f;
+    TEST_ASSERT_EQUAL_INT(0, engine_run());
+    engine_shutdown();
+    TEST_ASSERT_EQUAL_INT(0, g_savegame_write_calls);
+}
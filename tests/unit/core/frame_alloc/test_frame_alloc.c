@@ -0,0 +1,98 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "unity.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "modules/core/frame_alloc.h"
+
+void tearDown(void)
+{
+    frame_alloc_shutdown();
+    frame_alloc_thread_release();
+}
+
+void test_frame_alloc_is_aligned_and_linear(void)
+{
+    uint8_t* a = (uint8_t*)frame_alloc(FRAME_ARENA_TICK, 3, 1);
+    double*  b = frame_alloc_array(FRAME_ARENA_TICK, double, 4);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)((uintptr_t)b % __alignof__(double)));
+    TEST_ASSERT_TRUE((uint8_t*)b > a);
+    TEST_ASSERT_EQUAL_size_t(8 + 4 * sizeof(double), frame_alloc_used(FRAME_ARENA_TICK));
+
+    void* page = frame_alloc(FRAME_ARENA_TICK, 64, 4096);
+    TEST_ASSERT_NOT_NULL(page);
+    TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)((uintptr_t)page % 4096u));
+
+    TEST_ASSERT_NULL(frame_alloc(FRAME_ARENA_TICK, 8, 3)); // not a power of two
+    TEST_ASSERT_NULL(frame_alloc(FRAME_ARENA_COUNT, 8, 8));
+}
+
+void test_frame_alloc_tick_and_frame_reset_independently(void)
+{
+    void* t0 = frame_alloc(FRAME_ARENA_TICK, 64, 16);
+    void* f0 = frame_alloc(FRAME_ARENA_FRAME, 64, 16);
+    TEST_ASSERT_EQUAL_size_t(64, frame_alloc_used(FRAME_ARENA_FRAME));
+
+    frame_alloc_begin_tick();
+    TEST_ASSERT_EQUAL_size_t(0, frame_alloc_used(FRAME_ARENA_TICK));
+    TEST_ASSERT_EQUAL_size_t(64, frame_alloc_used(FRAME_ARENA_FRAME));
+    TEST_ASSERT_EQUAL_PTR(t0, frame_alloc(FRAME_ARENA_TICK, 64, 16)); // same memory, next tick
+
+    frame_alloc_begin_frame();
+    TEST_ASSERT_EQUAL_size_t(0, frame_alloc_used(FRAME_ARENA_FRAME));
+    TEST_ASSERT_EQUAL_PTR(f0, frame_alloc(FRAME_ARENA_FRAME, 64, 16));
+}
+
+void test_frame_alloc_chains_a_chunk_then_coalesces_on_reset(void)
+{
+    const size_t big = FRAME_ALLOC_INITIAL_BYTES - 16;
+    uint8_t* a = (uint8_t*)frame_alloc(FRAME_ARENA_TICK, big, 16);
+    uint8_t* b = (uint8_t*)frame_alloc(FRAME_ARENA_TICK, 256, 64); // no room left: new chunk
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)((uintptr_t)b % 64u));
+    memset(a, 0xAB, big);
+    memset(b, 0xCD, 256);
+    TEST_ASSERT_EQUAL_UINT32(0xABu, a[big - 1]);
+    TEST_ASSERT_EQUAL_size_t(3 * FRAME_ALLOC_INITIAL_BYTES, frame_alloc_capacity(FRAME_ARENA_TICK));
+
+    frame_alloc_begin_tick();
+    TEST_ASSERT_EQUAL_size_t(3 * FRAME_ALLOC_INITIAL_BYTES, frame_alloc_capacity(FRAME_ARENA_TICK));
+    TEST_ASSERT_EQUAL_size_t(FRAME_ALLOC_INITIAL_BYTES + 256, frame_alloc_high_water(FRAME_ARENA_TICK));
+    TEST_ASSERT_NOT_NULL(frame_alloc(FRAME_ARENA_TICK, big, 16));
+    TEST_ASSERT_NOT_NULL(frame_alloc(FRAME_ARENA_TICK, 256, 64));
+    TEST_ASSERT_EQUAL_size_t(big + 16 + 256, frame_alloc_used(FRAME_ARENA_TICK)); // 64-aligned after big, same chunk this time
+}
+
+static void* thread_arena_worker(void* arg)
+{
+    uintptr_t* out = (uintptr_t*)arg;
+    out[0] = (uintptr_t)frame_alloc_thread(128, 16);
+    frame_alloc_thread_reset();
+    out[1] = (uintptr_t)frame_alloc_thread(128, 16);
+    frame_alloc_thread_release();
+    return NULL;
+}
+
+void test_frame_alloc_thread_arenas_are_per_thread(void)
+{
+    uintptr_t worker[2] = {0};
+    void* mine = frame_alloc_thread(128, 16);
+    TEST_ASSERT_NOT_NULL(mine);
+
+    pthread_t t;
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&t, NULL, thread_arena_worker, worker));
+    pthread_join(t, NULL);
+
+    TEST_ASSERT_TRUE(worker[0] != 0);
+    TEST_ASSERT_TRUE(worker[0] == worker[1]); // reset rewinds the worker's own arena
+    TEST_ASSERT_TRUE(worker[0] != (uintptr_t)mine);
+    TEST_ASSERT_EQUAL_size_t(0, frame_alloc_used(FRAME_ARENA_TICK)); // tick arena untouched
+}
@@ -0,0 +1,93 @@
+#include "unity.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "modules/common/hashmap.h"
+
+HM_DECLARE(u32_map, uint32_t, int, hm_hash_u32, hm_eq_u32, MEM_TAG_MISC)
+HM_DECLARE(name_map, const char*, int, hm_hash_str_ci, hm_eq_str_ci, MEM_TAG_MISC)
+
+// Everything lands in one probe cluster, to exercise displacement and backward shift.
+static uint32_t hash_const(uint32_t k) { (void)k; return 7u; }
+HM_DECLARE(clash_map, uint32_t, uint32_t, hash_const, hm_eq_u32, MEM_TAG_MISC)
+
+void test_hashmap_put_get_overwrite(void)
+{
+    u32_map_t m = {0};
+    TEST_ASSERT_NULL(u32_map_get(&m, 1));
+
+    for (uint32_t k = 0; k < 1000; ++k) TEST_ASSERT_NOT_NULL(u32_map_put(&m, k * 2654435761u, (int)k));
+    TEST_ASSERT_EQUAL_size_t(1000, m.size);
+    TEST_ASSERT_TRUE(m.size * 8 <= m.capacity * 7);
+    for (uint32_t k = 0; k < 1000; ++k) {
+        int* v = u32_map_get(&m, k * 2654435761u);
+        TEST_ASSERT_NOT_NULL(v);
+        TEST_ASSERT_EQUAL_INT((int)k, *v);
+    }
+    TEST_ASSERT_NULL(u32_map_get(&m, 3));
+
+    u32_map_put(&m, 0, -5); // existing key: overwritten, not duplicated
+    TEST_ASSERT_EQUAL_size_t(1000, m.size);
+    TEST_ASSERT_EQUAL_INT(-5, *u32_map_get(&m, 0));
+
+    size_t seen = 0;
+    for (size_t i = 0; i < m.capacity; ++i) seen += HM_SLOT_USED(&m.slots[i]) ? 1 : 0;
+    TEST_ASSERT_EQUAL_size_t(1000, seen);
+
+    u32_map_free(&m);
+    TEST_ASSERT_NULL(m.slots);
+}
+
+void test_hashmap_remove_keeps_cluster_reachable(void)
+{
+    clash_map_t m = {0};
+    for (uint32_t k = 0; k < 10; ++k) clash_map_put(&m, k, k * 10);
+
+    TEST_ASSERT_TRUE(clash_map_remove(&m, 3));
+    TEST_ASSERT_FALSE(clash_map_remove(&m, 3));
+    TEST_ASSERT_TRUE(clash_map_remove(&m, 0));
+    TEST_ASSERT_EQUAL_size_t(8, m.size);
+    TEST_ASSERT_NULL(clash_map_get(&m, 3));
+    for (uint32_t k = 1; k < 10; ++k) {
+        if (k == 3) continue;
+        uint32_t* v = clash_map_get(&m, k);
+        TEST_ASSERT_NOT_NULL(v);
+        TEST_ASSERT_EQUAL_UINT32(k * 10, *v);
+    }
+
+    clash_map_clear(&m);
+    TEST_ASSERT_EQUAL_size_t(0, m.size);
+    TEST_ASSERT_NULL(clash_map_get(&m, 5));
+    clash_map_free(&m);
+}
+
+void test_hashmap_string_keys_case_insensitive(void)
+{
+    name_map_t m = {0};
+    char keys[64][16];
+    for (int i = 0; i < 64; ++i) {
+        snprintf(keys[i], sizeof(keys[i]), "Prop_%d", i);
+        name_map_put(&m, keys[i], i);
+    }
+    TEST_ASSERT_EQUAL_INT(17, *name_map_get(&m, "prop_17"));
+    TEST_ASSERT_EQUAL_INT(63, *name_map_get(&m, "PROP_63"));
+    TEST_ASSERT_NULL(name_map_get(&m, "prop_64"));
+    TEST_ASSERT_NULL(name_map_get(&m, "prop_1x"));
+    TEST_ASSERT_TRUE(hm_eq_str("a", "a") && !hm_eq_str("a", "A"));
+    name_map_free(&m);
+}
+
+void test_hashmap_counts_under_its_tag(void)
+{
+    mem_tag_stats_t before, during, after;
+    mem_tag_stats(MEM_TAG_MISC, &before);
+    u32_map_t m = {0};
+    TEST_ASSERT_TRUE(u32_map_reserve(&m, 100));
+    mem_tag_stats(MEM_TAG_MISC, &during);
+    TEST_ASSERT_EQUAL_size_t(before.live_bytes + m.capacity * sizeof(u32_map_slot_t), during.live_bytes);
+    u32_map_free(&m);
+    mem_tag_stats(MEM_TAG_MISC, &after);
+    TEST_ASSERT_EQUAL_size_t(before.live_bytes, after.live_bytes);
+}
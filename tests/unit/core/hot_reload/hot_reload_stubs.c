@@ -0,0 +1,116 @@
+#include "hot_reload_stubs.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "modules/asset/asset.h"
+#include "modules/core/camera.h"
+#include "modules/core/engine.h"
+#include "modules/core/map_manager.h"
+#include "modules/core/toast.h"
+#include "modules/ecs/ecs_prefab_loading.h"
+#include "modules/world/world_map.h"
+#include "modules/world/world_renderer.h"
+
+int g_reload_texture_calls = 0;
+int g_reload_tileset_calls = 0;
+int g_prefab_respawn_calls = 0;
+int g_reload_world_calls = 0;
+int g_camera_set_calls = 0;
+int g_toast_calls = 0;
+int g_map_invalidate_calls = 0;
+
+char g_last_reload_path[512];
+const char* g_current_map = NULL;
+size_t g_prefab_respawn_result = 0;
+ecs_entity_t g_player = {0};
+ecs_entity_t g_camera_target = {0};
+
+static void remember(const char* path)
+{
+    snprintf(g_last_reload_path, sizeof(g_last_reload_path), "%s", path ? path : "");
+}
+
+void hot_reload_stubs_reset(void)
+{
+    g_reload_texture_calls = 0;
+    g_reload_tileset_calls = 0;
+    g_prefab_respawn_calls = 0;
+    g_reload_world_calls = 0;
+    g_camera_set_calls = 0;
+    g_toast_calls = 0;
+    g_map_invalidate_calls = 0;
+    g_last_reload_path[0] = '\0';
+    g_current_map = NULL;
+    g_prefab_respawn_result = 0;
+    g_player = (ecs_entity_t){0};
+    g_camera_target = (ecs_entity_t){0};
+}
+
+bool asset_reload_texture_path(const char* path)
+{
+    g_reload_texture_calls++;
+    remember(path);
+    return true;
+}
+
+bool world_reload_tileset(const char* tsx_path)
+{
+    g_reload_tileset_calls++;
+    remember(tsx_path);
+    return true;
+}
+
+size_t ecs_prefab_respawn(const world_map_t* map, const char* prefab_path)
+{
+    (void)map;
+    g_prefab_respawn_calls++;
+    remember(prefab_path);
+    return g_prefab_respawn_result;
+}
+
+const world_map_t* world_get_map(void)
+{
+    return NULL;
+}
+
+bool engine_reload_world(void)
+{
+    g_reload_world_calls++;
+    return true;
+}
+
+void map_manager_invalidate(void)
+{
+    g_map_invalidate_calls++;
+}
+
+const char* engine_current_map(void)
+{
+    return g_current_map;
+}
+
+ecs_entity_t ecs_find_player(void)
+{
+    return g_player;
+}
+
+camera_config_t camera_get_config(void)
+{
+    camera_config_t cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    return cfg;
+}
+
+void camera_set_config(const camera_config_t* cfg)
+{
+    g_camera_set_calls++;
+    g_camera_target = cfg->target;
+}
+
+void ui_toast(float secs, const char* fmt, ...)
+{
+    (void)secs;
+    (void)fmt;
+    g_toast_calls++;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <stddef.h>
+
+#include "modules/ecs/ecs.h"
+
+extern int g_reload_texture_calls;
+extern int g_reload_tileset_calls;
+extern int g_prefab_respawn_calls;
+extern int g_reload_world_calls;
+extern int g_camera_set_calls;
+extern int g_toast_calls;
+extern int g_map_invalidate_calls;
+
+extern char g_last_reload_path[512];
+extern const char* g_current_map;
+extern size_t g_prefab_respawn_result;
+extern ecs_entity_t g_player;
+extern ecs_entity_t g_camera_target;
+
+void hot_reload_stubs_reset(void);
@@ -0,0 +1,147 @@
+#include "unity.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "modules/core/file_watch.h"
+#include "modules/core/hot_reload.h"
+#include "hot_reload_stubs.h"
+
+static bool ensure_dir(const char* path)
+{
+    if (mkdir(path, 0755) == 0) return true;
+    return errno == EEXIST;
+}
+
+static bool write_text_file(const char* path, const char* contents)
+{
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+    fputs(contents, f);
+    fclose(f);
+    return true;
+}
+
+typedef struct {
+    int count;
+    char last[FILE_WATCH_PATH_MAX];
+} seen_t;
+
+static void on_seen(const char* path, void* user)
+{
+    seen_t* s = (seen_t*)user;
+    s->count++;
+    snprintf(s->last, sizeof(s->last), "%s", path);
+}
+
+void setUp(void)
+{
+    hot_reload_stubs_reset();
+}
+
+void tearDown(void)
+{
+    file_watch_close();
+}
+
+void test_hot_reload_classify_by_extension(void)
+{
+    TEST_ASSERT_EQUAL_INT(HOT_RELOAD_TEXTURE, hot_reload_classify("assets/images/player.png"));
+    TEST_ASSERT_EQUAL_INT(HOT_RELOAD_TEXTURE, hot_reload_classify("assets/images/PLAYER.PNG"));
+    TEST_ASSERT_EQUAL_INT(HOT_RELOAD_TILESET, hot_reload_classify("assets/maps/tiles.tsx"));
+    TEST_ASSERT_EQUAL_INT(HOT_RELOAD_PREFAB, hot_reload_classify("assets/prefabs/coin.ent"));
+    TEST_ASSERT_EQUAL_INT(HOT_RELOAD_MAP, hot_reload_classify("assets/maps/start.tmx"));
+    TEST_ASSERT_EQUAL_INT(HOT_RELOAD_NONE, hot_reload_classify("assets/maps/start.tmx~"));
+    TEST_ASSERT_EQUAL_INT(HOT_RELOAD_NONE, hot_reload_classify("assets/maps.d/README"));
+    TEST_ASSERT_EQUAL_INT(HOT_RELOAD_NONE, hot_reload_classify(NULL));
+}
+
+void test_hot_reload_apply_dispatches_only_the_matching_reload(void)
+{
+    TEST_ASSERT_TRUE(hot_reload_apply("assets/images/player.png"));
+    TEST_ASSERT_EQUAL_INT(1, g_reload_texture_calls);
+    TEST_ASSERT_EQUAL_STRING("assets/images/player.png", g_last_reload_path);
+
+    TEST_ASSERT_TRUE(hot_reload_apply("assets/maps/tiles.tsx"));
+    TEST_ASSERT_EQUAL_INT(1, g_reload_tileset_calls);
+    TEST_ASSERT_EQUAL_STRING("assets/maps/tiles.tsx", g_last_reload_path);
+
+    TEST_ASSERT_FALSE(hot_reload_apply("assets/notes.txt"));
+    TEST_ASSERT_EQUAL_INT(1, g_reload_texture_calls);
+    TEST_ASSERT_EQUAL_INT(1, g_reload_tileset_calls);
+    TEST_ASSERT_EQUAL_INT(0, g_prefab_respawn_calls);
+    TEST_ASSERT_EQUAL_INT(0, g_reload_world_calls);
+}
+
+void test_hot_reload_prefab_retargets_camera_only_when_entities_respawned(void)
+{
+    g_prefab_respawn_result = 0;
+    TEST_ASSERT_FALSE(hot_reload_apply("assets/prefabs/unused.ent"));
+    TEST_ASSERT_EQUAL_INT(1, g_prefab_respawn_calls);
+    TEST_ASSERT_EQUAL_INT(0, g_camera_set_calls);
+
+    g_prefab_respawn_result = 2;
+    g_player = (ecs_entity_t){ .idx = 7, .gen = 3 };
+    TEST_ASSERT_TRUE(hot_reload_apply("assets/prefabs/player.ent"));
+    TEST_ASSERT_EQUAL_INT(2, g_prefab_respawn_calls);
+    TEST_ASSERT_EQUAL_INT(1, g_camera_set_calls);
+    TEST_ASSERT_EQUAL_UINT32(7, g_camera_target.idx);
+    TEST_ASSERT_EQUAL_UINT32(3, g_camera_target.gen);
+}
+
+void test_hot_reload_map_reloads_only_the_current_map(void)
+{
+    g_current_map = "assets/maps/start.tmx";
+
+    TEST_ASSERT_FALSE(hot_reload_apply("assets/maps/other.tmx"));
+    TEST_ASSERT_EQUAL_INT(0, g_reload_world_calls);
+
+    TEST_ASSERT_TRUE(hot_reload_apply("assets/maps/../maps/./start.tmx"));
+    TEST_ASSERT_EQUAL_INT(1, g_reload_world_calls);
+}
+
+void test_hot_reload_drops_map_preloads_for_map_tileset_and_prefab_changes(void)
+{
+    hot_reload_apply("assets/images/player.png");
+    hot_reload_apply("assets/notes.txt");
+    TEST_ASSERT_EQUAL_INT(0, g_map_invalidate_calls);
+
+    // A map that isn't current reloads nothing, but its preload is stale all the same.
+    g_current_map = "assets/maps/start.tmx";
+    hot_reload_apply("assets/maps/other.tmx");
+    TEST_ASSERT_EQUAL_INT(1, g_map_invalidate_calls);
+    hot_reload_apply("assets/maps/tiles.tsx");
+    TEST_ASSERT_EQUAL_INT(2, g_map_invalidate_calls);
+    hot_reload_apply("assets/prefabs/coin.ent");
+    TEST_ASSERT_EQUAL_INT(3, g_map_invalidate_calls);
+}
+
+void test_file_watch_reports_each_written_file_once(void)
+{
+#if defined(__linux__)
+    TEST_ASSERT_TRUE(ensure_dir("build"));
+    TEST_ASSERT_TRUE(ensure_dir("build/testdata"));
+    TEST_ASSERT_TRUE(ensure_dir("build/testdata/hot_reload"));
+    TEST_ASSERT_TRUE(ensure_dir("build/testdata/hot_reload/maps"));
+
+    TEST_ASSERT_TRUE(file_watch_open("build/testdata/hot_reload"));
+    TEST_ASSERT_TRUE(file_watch_active());
+
+    seen_t seen = {0};
+    TEST_ASSERT_EQUAL_size_t(0, file_watch_poll(on_seen, &seen));
+
+    // Two writes of the same file between polls collapse into one report.
+    TEST_ASSERT_TRUE(write_text_file("build/testdata/hot_reload/maps/tiles.tsx", "<tileset/>"));
+    TEST_ASSERT_TRUE(write_text_file("build/testdata/hot_reload/maps/tiles.tsx", "<tileset />"));
+    TEST_ASSERT_EQUAL_size_t(1, file_watch_poll(on_seen, &seen));
+    TEST_ASSERT_EQUAL_INT(1, seen.count);
+    TEST_ASSERT_EQUAL_STRING("build/testdata/hot_reload/maps/tiles.tsx", seen.last);
+
+    TEST_ASSERT_EQUAL_size_t(0, file_watch_poll(on_seen, &seen));
+    TEST_ASSERT_EQUAL_INT(1, seen.count);
+#else
+    TEST_IGNORE_MESSAGE("file_watch is inotify-only");
+#endif
+}
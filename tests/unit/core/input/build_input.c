@@ -68,6 +68,7 @@ int main(int argc, char **argv)
 
     Nob_File_Paths test_sources = {0};
     nob_da_append(&test_sources, "tests/unit/core/input/test_input.c");
+    nob_da_append(&test_sources, "tests/unit/core/input/test_input_record.c");
 
     const char *runner_path = "build/tests/gen/tests_input_runner.c";
     if (!generate_unity_runner("input", &test_sources, runner_path)) return 1;
@@ -89,7 +90,10 @@ int main(int argc, char **argv)
     nob_da_append(&sources, "third_party/Unity/src/unity.c");
     nob_da_append(&sources, "tests/unit/core/input/raylib_stubs.c");
     nob_da_append(&sources, "src/modules/core/input.c");
+    nob_da_append(&sources, "src/modules/core/input_record.c");
+    nob_da_append(&sources, "src/modules/core/logger.c");
     nob_da_append(&sources, "tests/unit/core/input/test_input.c");
+    nob_da_append(&sources, "tests/unit/core/input/test_input_record.c");
     nob_da_append(&sources, runner_path);
 
     Nob_File_Paths objs = {0};
@@ -23,6 +23,10 @@
 #define KEY_FIVE 17
 #define KEY_R 18
 #define KEY_GRAVE 19
+#define KEY_SIX 20
+#define KEY_SEVEN 21
+#define KEY_EIGHT 22
+#define KEY_NINE 23
 
 #define MOUSE_BUTTON_LEFT 1000
 #define MOUSE_BUTTON_RIGHT 1001
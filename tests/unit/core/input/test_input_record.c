@@ -0,0 +1,140 @@
+#include "unity.h"
+
+#include "modules/core/input_record.h"
+#include "raylib.h"
+
+#include <stdio.h>
+
+#define REC_PATH "build/tests/input_record_test.inpr"
+
+static long file_size(const char* path)
+{
+    FILE* f = fopen(path, "rb");
+    if (!f) return -1;
+    fseek(f, 0, SEEK_END);
+    long n = ftell(f);
+    fclose(f);
+    return n;
+}
+
+void test_input_record_roundtrips_tick_stream(void)
+{
+    const input_t ticks[] = {
+        { .down = 0x2, .pressed = 0x2, .moveX = 1.0f, .mouse = { 10.0f, 20.0f } },
+        { .down = 0x2, .moveX = 1.0f, .mouse = { 10.0f, 20.0f } },
+        { .down = 0x6, .pressed = 0x4, .moveX = 0.7071f, .moveY = -0.7071f, .mouse = { 11.0f, 20.0f }, .mouse_wheel = -1.0f },
+        { 0 },
+    };
+    const int n = (int)(sizeof(ticks) / sizeof(ticks[0]));
+
+    TEST_ASSERT_TRUE(input_record_open(REC_PATH));
+    TEST_ASSERT_TRUE(input_recording());
+    for (int i = 0; i < n; ++i) input_record_write(&ticks[i]);
+    input_record_close();
+    TEST_ASSERT_FALSE(input_recording());
+
+    TEST_ASSERT_TRUE(input_replay_open(REC_PATH));
+    for (int i = 0; i < n; ++i) {
+        input_t in;
+        TEST_ASSERT_TRUE(input_replay_next(&in));
+        TEST_ASSERT_EQUAL_UINT64(ticks[i].down, in.down);
+        TEST_ASSERT_EQUAL_UINT64(ticks[i].pressed, in.pressed);
+        TEST_ASSERT_EQUAL_FLOAT(ticks[i].moveX, in.moveX);
+        TEST_ASSERT_EQUAL_FLOAT(ticks[i].moveY, in.moveY);
+        TEST_ASSERT_EQUAL_FLOAT(ticks[i].mouse.x, in.mouse.x);
+        TEST_ASSERT_EQUAL_FLOAT(ticks[i].mouse.y, in.mouse.y);
+        TEST_ASSERT_EQUAL_FLOAT(ticks[i].mouse_wheel, in.mouse_wheel);
+    }
+    TEST_ASSERT_EQUAL_INT(n, input_replay_ticks());
+    TEST_ASSERT_TRUE(input_replaying());
+
+    input_t end = { .down = 0xFF };
+    TEST_ASSERT_FALSE(input_replay_next(&end));
+    TEST_ASSERT_EQUAL_UINT64(0, end.down);
+    TEST_ASSERT_FALSE(input_replaying());
+    TEST_ASSERT_TRUE(input_replay_finished());
+
+    input_replay_close();
+    TEST_ASSERT_FALSE(input_replay_finished());
+    remove(REC_PATH);
+}
+
+void test_input_record_idle_tick_is_one_byte(void)
+{
+    TEST_ASSERT_TRUE(input_record_open(REC_PATH));
+    const long header = 8;
+    const input_t idle = {0};
+    for (int i = 0; i < 100; ++i) input_record_write(&idle);
+    input_record_close();
+
+    TEST_ASSERT_EQUAL_INT(header + 100, (int)file_size(REC_PATH));
+    remove(REC_PATH);
+}
+
+void test_input_replay_rejects_foreign_file(void)
+{
+    FILE* f = fopen(REC_PATH, "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    fputs("not a recording", f);
+    fclose(f);
+
+    TEST_ASSERT_FALSE(input_replay_open(REC_PATH));
+    TEST_ASSERT_FALSE(input_replaying());
+
+    input_t in = { .down = 1 };
+    TEST_ASSERT_FALSE(input_replay_next(&in));
+    TEST_ASSERT_EQUAL_UINT64(0, in.down);
+    remove(REC_PATH);
+}
+
+void test_input_replay_stops_on_truncated_record(void)
+{
+    TEST_ASSERT_TRUE(input_record_open(REC_PATH));
+    const input_t held = { .down = 0x1, .moveX = -1.0f };
+    input_record_write(&held);
+    input_record_close();
+
+    // Chop the last byte off the only record.
+    long n = file_size(REC_PATH);
+    FILE* f = fopen(REC_PATH, "rb");
+    char buf[64];
+    size_t got = fread(buf, 1, sizeof(buf), f);
+    fclose(f);
+    TEST_ASSERT_EQUAL_INT((int)n, (int)got);
+    f = fopen(REC_PATH, "wb");
+    fwrite(buf, 1, got - 1, f);
+    fclose(f);
+
+    TEST_ASSERT_TRUE(input_replay_open(REC_PATH));
+    input_t in;
+    TEST_ASSERT_FALSE(input_replay_next(&in));
+    TEST_ASSERT_TRUE(input_replay_finished());
+    input_replay_close();
+    remove(REC_PATH);
+}
+
+void test_input_for_tick_records_what_it_returns(void)
+{
+    raylib_stub_reset();
+    input_init_defaults();
+    raylib_stub_set_key_down(KEY_E, true);
+    raylib_stub_set_key_pressed(KEY_E, true);
+
+    TEST_ASSERT_TRUE(input_record_open(REC_PATH));
+    input_begin_frame();
+    input_t first = input_for_tick();
+    input_t second = input_for_tick();
+    input_record_close();
+
+    TEST_ASSERT_TRUE(input_replay_open(REC_PATH));
+    input_t in;
+    TEST_ASSERT_TRUE(input_replay_next(&in));
+    TEST_ASSERT_EQUAL_UINT64(first.down, in.down);
+    TEST_ASSERT_TRUE(input_pressed(&in, BTN_INTERACT));
+    TEST_ASSERT_TRUE(input_replay_next(&in));
+    TEST_ASSERT_EQUAL_UINT64(second.down, in.down);
+    TEST_ASSERT_FALSE(input_pressed(&in, BTN_INTERACT));
+    TEST_ASSERT_FALSE(input_replay_next(&in));
+    input_replay_close();
+    remove(REC_PATH);
+}
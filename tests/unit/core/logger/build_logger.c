@@ -106,7 +106,7 @@ int main(int argc, char **argv)
         nob_sb_appendf(&link, "%s -shared ", cc);
         sb_append_paths(&link, &objs);
         if (coverage) nob_sb_append_cstr(&link, "--coverage ");
-        nob_sb_append_cstr(&link, "-o build/tests/plugins/tests_logger.so -lm");
+        nob_sb_append_cstr(&link, "-o build/tests/plugins/tests_logger.so -lm -lpthread");
         nob_sb_append_null(&link);
         nob_cmd_append(&cmd, "sh", "-lc", link.items);
         if (!nob_cmd_run_sync_and_reset(&cmd)) return 1;
@@ -1,8 +1,14 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "unity.h"
 
+#include <pthread.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 
 #include "modules/core/logger.h"
 
@@ -15,6 +21,14 @@ typedef struct {
 
 static sink_state_t g_sink;
 
+// Async tests: records every message in arrival order; can be held shut to back the ring up.
+#define ASYNC_LOG_MAX 64
+static char g_async_msgs[ASYNC_LOG_MAX][64];
+static log_level_t g_async_lvls[ASYNC_LOG_MAX];
+static int  g_async_count;
+static int  g_async_total;
+static volatile int g_async_hold;
+
 static void test_sink(log_level_t lvl, const log_cat_t* cat, const char* fmt, va_list ap)
 {
     g_sink.calls++;
@@ -23,6 +37,39 @@ static void test_sink(log_level_t lvl, const log_cat_t* cat, const char* fmt, va
     vsnprintf(g_sink.msg, sizeof(g_sink.msg), fmt, ap);
 }
 
+static void async_sink(log_level_t lvl, const log_cat_t* cat, const char* fmt, va_list ap)
+{
+    while (__atomic_load_n(&g_async_hold, __ATOMIC_ACQUIRE)) {
+        const struct timespec nap = { 0, 100000 };
+        nanosleep(&nap, NULL);
+    }
+    g_async_total++;
+    if (g_async_count == ASYNC_LOG_MAX) return;
+    char msg[64];
+    vsnprintf(msg, sizeof(msg), fmt, ap);
+    snprintf(g_async_msgs[g_async_count], sizeof(g_async_msgs[0]), "%s%s%s",
+             (cat && cat->name) ? cat->name : "", (cat && cat->name) ? ":" : "", msg);
+    g_async_lvls[g_async_count++] = lvl;
+}
+
+static void async_reset(void)
+{
+    g_async_count = 0;
+    g_async_total = 0;
+    g_async_hold = 0;
+    log_set_min_level(LOG_LVL_TRACE);
+    log_set_sink(async_sink);
+}
+
+void tearDown(void)
+{
+    __atomic_store_n(&g_async_hold, 0, __ATOMIC_RELEASE);
+    log_set_async(false);
+    log_set_sink(NULL);
+    log_clear_category_levels();
+    log_set_min_level(LOG_LVL_TRACE);
+}
+
 void test_logger_min_level_gate(void)
 {
     log_set_sink(test_sink);
@@ -71,3 +118,175 @@ void test_logger_default_sink_path_does_not_crash(void)
     log_cat_t anon = {0};
     log_msg(LOG_LVL_INFO, &anon, "anon cat");
 }
+
+void test_logger_async_delivers_in_order_after_flush(void)
+{
+    async_reset();
+    TEST_ASSERT_TRUE(log_set_async(true));
+    TEST_ASSERT_TRUE(log_async_enabled());
+
+    LOGC(LOGCAT_ECS, LOG_LVL_INFO, "first %d", 1);
+    log_msg(LOG_LVL_WARN, NULL, "second %s", "two");
+    LOGC(LOGCAT_WORLD, LOG_LVL_DEBUG, "third %.1f", 3.0);
+    log_flush();
+
+    TEST_ASSERT_EQUAL_INT(3, g_async_count);
+    TEST_ASSERT_EQUAL_STRING("ECS:first 1", g_async_msgs[0]);
+    TEST_ASSERT_EQUAL_STRING("second two", g_async_msgs[1]);
+    TEST_ASSERT_EQUAL_STRING("WORLD:third 3.0", g_async_msgs[2]);
+    TEST_ASSERT_EQUAL_INT(LOG_LVL_DEBUG, g_async_lvls[2]);
+}
+
+void test_logger_async_full_ring_drops_and_reports(void)
+{
+    async_reset();
+    TEST_ASSERT_TRUE(log_set_async(true));
+    const unsigned long dropped_before = log_dropped_count();
+
+    // The writer parks in the sink on the first record; that slot stays taken until it returns.
+    __atomic_store_n(&g_async_hold, 1, __ATOMIC_RELEASE);
+    for (int i = 0; i < LOG_ASYNC_RING + 10; ++i) log_msg(LOG_LVL_INFO, NULL, "burst %d", i);
+    TEST_ASSERT_EQUAL_UINT32(10, (uint32_t)(log_dropped_count() - dropped_before));
+
+    __atomic_store_n(&g_async_hold, 0, __ATOMIC_RELEASE);
+    TEST_ASSERT_TRUE(log_set_async(false)); // drains everything that made it in
+    TEST_ASSERT_EQUAL_INT(LOG_ASYNC_RING + 1, g_async_total); // + the drop report
+    TEST_ASSERT_EQUAL_STRING("burst 0", g_async_msgs[0]);
+}
+
+void test_logger_async_fatal_is_synchronous_and_ordered(void)
+{
+    async_reset();
+    TEST_ASSERT_TRUE(log_set_async(true));
+
+    log_msg(LOG_LVL_INFO, &LOGCAT_MAIN, "before");
+    log_msg(LOG_LVL_FATAL, &LOGCAT_MAIN, "boom");
+
+    TEST_ASSERT_EQUAL_INT(2, g_async_count);
+    TEST_ASSERT_EQUAL_STRING("MAIN:before", g_async_msgs[0]);
+    TEST_ASSERT_EQUAL_STRING("MAIN:boom", g_async_msgs[1]);
+    TEST_ASSERT_EQUAL_INT(LOG_LVL_FATAL, g_async_lvls[1]);
+}
+
+void test_logger_async_truncates_long_messages(void)
+{
+    async_reset();
+    TEST_ASSERT_TRUE(log_set_async(true));
+
+    char big[LOG_ASYNC_MSG_MAX * 2];
+    memset(big, 'x', sizeof(big) - 1);
+    big[sizeof(big) - 1] = '\0';
+    log_set_sink(test_sink);
+    memset(&g_sink, 0, sizeof(g_sink));
+    log_msg(LOG_LVL_INFO, NULL, "%s", big);
+    log_flush();
+
+    TEST_ASSERT_EQUAL_INT(1, g_sink.calls);
+    TEST_ASSERT_EQUAL_size_t(LOG_ASYNC_MSG_MAX - 1, strlen(g_sink.msg));
+}
+
+#define RACE_THREADS 4
+#define RACE_MSGS    5000
+
+static int g_race_seen;
+
+static void race_sink(log_level_t lvl, const log_cat_t* cat, const char* fmt, va_list ap)
+{
+    (void)lvl;
+    (void)cat;
+    char msg[16];
+    vsnprintf(msg, sizeof(msg), fmt, ap);
+    if (strncmp(msg, "race", 4) == 0) __atomic_add_fetch(&g_race_seen, 1, __ATOMIC_RELAXED);
+}
+
+static void* race_producer(void* arg)
+{
+    (void)arg;
+    for (int i = 0; i < RACE_MSGS; ++i) log_msg(LOG_LVL_INFO, NULL, "race %d", i);
+    return NULL;
+}
+
+void test_logger_async_disable_loses_nothing_to_racing_producers(void)
+{
+    g_race_seen = 0;
+    log_set_min_level(LOG_LVL_TRACE);
+    log_set_sink(race_sink);
+    TEST_ASSERT_TRUE(log_set_async(true));
+    const unsigned long dropped_before = log_dropped_count();
+
+    pthread_t threads[RACE_THREADS];
+    for (int t = 0; t < RACE_THREADS; ++t) TEST_ASSERT_EQUAL_INT(0, pthread_create(&threads[t], NULL, race_producer, NULL));
+    const struct timespec nap = { 0, 500000 };
+    nanosleep(&nap, NULL);
+    TEST_ASSERT_TRUE(log_set_async(false)); // producers switch to the sink mid-stream
+    for (int t = 0; t < RACE_THREADS; ++t) pthread_join(threads[t], NULL);
+
+    const unsigned long dropped = log_dropped_count() - dropped_before;
+    TEST_ASSERT_EQUAL_UINT32(RACE_THREADS * RACE_MSGS, (uint32_t)(__atomic_load_n(&g_race_seen, __ATOMIC_RELAXED) + dropped));
+}
+
+static double g_fake_now;
+static double fake_clock(void) { return g_fake_now; }
+
+static void limited_warn(int i)
+{
+    LOGC_LIMITED(LOGCAT_REND, LOG_LVL_WARN, "overflow %d", i);
+}
+
+void test_logger_limited_site_bursts_then_summarises(void)
+{
+    async_reset();
+    log_set_clock(fake_clock);
+    g_fake_now = 100.0;
+
+    for (int i = 0; i < LOG_SITE_BURST + 7; ++i) limited_warn(i);
+    TEST_ASSERT_EQUAL_INT(LOG_SITE_BURST, g_async_count);
+    TEST_ASSERT_EQUAL_STRING("RENDER:overflow 0", g_async_msgs[0]);
+
+    // One token back after a second: the summary goes out first, then the message.
+    g_fake_now += 1.0 / LOG_SITE_PER_SEC;
+    limited_warn(99);
+    TEST_ASSERT_EQUAL_INT(LOG_SITE_BURST + 2, g_async_count);
+    TEST_ASSERT_EQUAL_STRING("RENDER:(7 similar message(s) suppressed)", g_async_msgs[LOG_SITE_BURST]);
+    TEST_ASSERT_EQUAL_STRING("RENDER:overflow 99", g_async_msgs[LOG_SITE_BURST + 1]);
+
+    limited_warn(100);
+    TEST_ASSERT_EQUAL_INT(LOG_SITE_BURST + 2, g_async_count);
+    log_set_clock(NULL);
+}
+
+void test_logger_category_levels_override_global_min(void)
+{
+    async_reset();
+    log_set_min_level(LOG_LVL_INFO);
+    TEST_ASSERT_TRUE(log_set_category_level("RENDER", LOG_LVL_ERROR));
+    TEST_ASSERT_TRUE(log_set_category_level("ECS", LOG_LVL_TRACE));
+
+    TEST_ASSERT_TRUE(log_would_log(LOG_LVL_TRACE)); // some category wants trace
+    LOGC(LOGCAT_REND, LOG_LVL_WARN, "quiet");
+    LOGC(LOGCAT_ECS, LOG_LVL_DEBUG, "loud");
+    LOGC(LOGCAT_MAIN, LOG_LVL_DEBUG, "below global");
+    LOGC(LOGCAT_MAIN, LOG_LVL_INFO, "global");
+    LOGC(LOGCAT_REND, LOG_LVL_ERROR, "still errors");
+
+    TEST_ASSERT_EQUAL_INT(3, g_async_count);
+    TEST_ASSERT_EQUAL_STRING("ECS:loud", g_async_msgs[0]);
+    TEST_ASSERT_EQUAL_STRING("MAIN:global", g_async_msgs[1]);
+    TEST_ASSERT_EQUAL_STRING("RENDER:still errors", g_async_msgs[2]);
+
+    log_clear_category_levels();
+    TEST_ASSERT_FALSE(log_would_log(LOG_LVL_DEBUG));
+}
+
+void test_logger_configure_parses_spec(void)
+{
+    async_reset();
+    TEST_ASSERT_TRUE(log_configure("*=warn,TILE=debug,ECS=Error"));
+    TEST_ASSERT_FALSE(log_category_would_log(&LOGCAT_MAIN, LOG_LVL_INFO));
+    TEST_ASSERT_TRUE(log_category_would_log(&LOGCAT_TILE, LOG_LVL_DEBUG));
+    TEST_ASSERT_FALSE(log_category_would_log(&LOGCAT_ECS, LOG_LVL_WARN));
+
+    TEST_ASSERT_FALSE(log_configure("WORLD=loud,=info,PREFAB"));
+    TEST_ASSERT_TRUE(log_category_would_log(&LOGCAT_WORLD, LOG_LVL_WARN)); // bad entry ignored
+    log_clear_category_levels();
+}
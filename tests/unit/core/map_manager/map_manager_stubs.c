@@ -0,0 +1,36 @@
+#include "map_manager_stubs.h"
+
+#include <stdlib.h>
+
+#include "modules/ecs/ecs_prefab_loading.h"
+
+struct ecs_prefab_templates {
+    int object_count;
+};
+
+// Built on the preload thread, read by the test after map_manager_take synchronises with it.
+int g_templates_built = 0;
+int g_templates_freed = 0;
+
+void map_manager_stubs_reset(void)
+{
+    g_templates_built = 0;
+    g_templates_freed = 0;
+}
+
+ecs_prefab_templates_t* ecs_prefab_templates_build(const world_map_t* map, const char* tmx_path)
+{
+    (void)tmx_path;
+    ecs_prefab_templates_t* t = (ecs_prefab_templates_t*)malloc(sizeof(*t));
+    if (!t) return NULL;
+    t->object_count = map ? (int)map->object_count : 0;
+    g_templates_built++;
+    return t;
+}
+
+void ecs_prefab_templates_free(ecs_prefab_templates_t* templates)
+{
+    if (!templates) return;
+    g_templates_freed++;
+    free(templates);
+}
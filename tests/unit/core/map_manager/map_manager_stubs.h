@@ -0,0 +1,6 @@
+#pragma once
+
+extern int g_templates_built;
+extern int g_templates_freed;
+
+void map_manager_stubs_reset(void);
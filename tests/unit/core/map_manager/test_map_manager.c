@@ -0,0 +1,194 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "unity.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#include "modules/core/map_manager.h"
+#include "modules/tiled/tiled.h"
+#include "modules/world/world.h"
+#include "modules/world/world_renderer.h"
+#include "map_manager_stubs.h"
+
+#define MM_DIR "build/testdata/map_manager"
+
+static world_map_t g_map_a;
+
+static bool ensure_dir(const char* path)
+{
+    if (mkdir(path, 0755) == 0) return true;
+    return errno == EEXIST;
+}
+
+static bool write_text_file(const char* path, const char* contents)
+{
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+    fputs(contents, f);
+    fclose(f);
+    return true;
+}
+
+// width x height map of gid 1, plus the given <objectgroup> body.
+static bool write_map(const char* path, int width, int height, const char* objects)
+{
+    char buf[2048];
+    int n = snprintf(buf, sizeof(buf),
+        "<map width=\"%d\" height=\"%d\" tilewidth=\"32\" tileheight=\"32\">"
+        "<tileset firstgid=\"1\" source=\"tiles.tsx\"/>"
+        "<layer name=\"walls\" width=\"%d\" height=\"%d\"><data encoding=\"csv\">",
+        width, height, width, height);
+    for (int i = 0; i < width * height; ++i) n += snprintf(buf + n, sizeof(buf) - (size_t)n, i ? ",1" : "1");
+    snprintf(buf + n, sizeof(buf) - (size_t)n, "</data></layer><objectgroup name=\"objects\">%s</objectgroup></map>", objects);
+    return write_text_file(path, buf);
+}
+
+static bool write_testdata(void)
+{
+    if (!ensure_dir("build") || !ensure_dir("build/testdata") || !ensure_dir(MM_DIR)) return false;
+    return write_text_file(MM_DIR "/tiles.tsx",
+               "<tileset name=\"t\" tilewidth=\"32\" tileheight=\"32\" tilecount=\"1\" columns=\"1\">"
+               "<image source=\"tiles.png\" width=\"32\" height=\"32\"/>"
+               "<tile id=\"0\"><properties><property name=\"collider\" value=\"[1111],[1111],[1111],[1111]\"/></properties></tile>"
+               "</tileset>") &&
+           write_map(MM_DIR "/a.tmx", 4, 4,
+               "<object id=\"1\" name=\"to_b\" x=\"32\" y=\"64\" width=\"32\" height=\"32\">"
+               "<properties><property name=\"target_map\" value=\"b.tmx\"/>"
+               "<property name=\"target_spawn\" value=\"from_a\"/></properties></object>"
+               "<object id=\"2\" name=\"to_c\" gid=\"1\" x=\"96\" y=\"128\" width=\"32\" height=\"32\">"
+               "<properties><property name=\"target_map\" value=\"../map_manager/c.tmx\"/></properties></object>"
+               "<object id=\"3\" name=\"sign\" x=\"0\" y=\"0\" width=\"8\" height=\"8\"/>") &&
+           write_map(MM_DIR "/b.tmx", 6, 3,
+               "<object id=\"1\" name=\"from_a\" x=\"32\" y=\"32\" width=\"32\" height=\"32\"/>") &&
+           write_map(MM_DIR "/c.tmx", 2, 2, "") &&
+           write_map(MM_DIR "/lonely.tmx", 3, 3, "");
+}
+
+static bool wait_ready(const char* path)
+{
+    const struct timespec nap = { 0, 1000000 }; // 1ms
+    for (int i = 0; i < 5000; ++i) {
+        if (map_manager_is_ready(path)) return true;
+        nanosleep(&nap, NULL);
+    }
+    return false;
+}
+
+void setUp(void)
+{
+    map_manager_stubs_reset();
+    TEST_ASSERT_TRUE(write_testdata());
+    TEST_ASSERT_TRUE(tiled_load_map(MM_DIR "/a.tmx", &g_map_a));
+}
+
+void tearDown(void)
+{
+    map_manager_shutdown();
+    tiled_free_map(&g_map_a);
+    world_shutdown();
+}
+
+void test_map_manager_collects_links_from_current_map(void)
+{
+    map_manager_set_current(&g_map_a, MM_DIR "/a.tmx");
+    TEST_ASSERT_EQUAL_size_t(2, map_manager_link_count());
+
+    const map_link_t* to_b = map_manager_link(0);
+    TEST_ASSERT_EQUAL_STRING(MM_DIR "/b.tmx", to_b->target_map);
+    TEST_ASSERT_EQUAL_STRING("from_a", to_b->target_spawn);
+    TEST_ASSERT_EQUAL_PTR(to_b, map_manager_link_at(40.0f, 70.0f));
+    TEST_ASSERT_NULL(map_manager_link_at(40.0f, 100.0f));
+
+    // Tile objects hang up from their y.
+    const map_link_t* to_c = map_manager_link(1);
+    TEST_ASSERT_EQUAL_STRING(MM_DIR "/c.tmx", to_c->target_map);
+    TEST_ASSERT_EQUAL_STRING("", to_c->target_spawn);
+    TEST_ASSERT_EQUAL_PTR(to_c, map_manager_link_at(100.0f, 100.0f));
+    TEST_ASSERT_NULL(map_manager_link_at(100.0f, 130.0f));
+}
+
+void test_map_manager_preloads_linked_maps_off_thread(void)
+{
+    map_manager_set_current(&g_map_a, MM_DIR "/a.tmx");
+    TEST_ASSERT_TRUE(wait_ready(MM_DIR "/b.tmx"));
+    TEST_ASSERT_TRUE(wait_ready(MM_DIR "/./b.tmx")); // keyed by normalised path
+
+    map_preload_t next = {0};
+    TEST_ASSERT_TRUE(map_manager_take(MM_DIR "/b.tmx", &next));
+    TEST_ASSERT_NOT_NULL(next.world);
+    TEST_ASSERT_NOT_NULL(next.templates);
+    TEST_ASSERT_FALSE(map_manager_is_ready(MM_DIR "/b.tmx")); // handed over, not cached any more
+
+    const world_map_t* prepared = world_prepared_map(next.world);
+    TEST_ASSERT_EQUAL_INT(6, prepared->width);
+    TEST_ASSERT_EQUAL_size_t(1, prepared->object_count);
+
+    // The live world is untouched until the prepared map is installed.
+    TEST_ASSERT_NULL(world_get_map());
+    world_install_prepared(next.world);
+    next.world = NULL;
+    int w = 0, h = 0;
+    world_size_tiles(&w, &h);
+    TEST_ASSERT_EQUAL_INT(6, w);
+    TEST_ASSERT_EQUAL_INT(3, h);
+    TEST_ASSERT_EQUAL_INT(WORLD_TILE_SOLID, world_tile_at(5, 2));
+
+    map_preload_free(&next);
+    TEST_ASSERT_EQUAL_INT(1, g_templates_freed);
+}
+
+void test_map_manager_drops_preloads_the_new_map_does_not_link(void)
+{
+    map_manager_set_current(&g_map_a, MM_DIR "/a.tmx");
+    TEST_ASSERT_TRUE(wait_ready(MM_DIR "/b.tmx"));
+    TEST_ASSERT_TRUE(wait_ready(MM_DIR "/c.tmx"));
+    TEST_ASSERT_EQUAL_INT(2, g_templates_built);
+
+    world_map_t lonely;
+    TEST_ASSERT_TRUE(tiled_load_map(MM_DIR "/lonely.tmx", &lonely));
+    map_manager_set_current(&lonely, MM_DIR "/lonely.tmx");
+    tiled_free_map(&lonely);
+
+    TEST_ASSERT_EQUAL_size_t(0, map_manager_link_count());
+    TEST_ASSERT_FALSE(map_manager_is_ready(MM_DIR "/b.tmx"));
+    TEST_ASSERT_FALSE(map_manager_is_ready(MM_DIR "/c.tmx"));
+    TEST_ASSERT_EQUAL_INT(2, g_templates_freed);
+}
+
+void test_map_manager_invalidate_rebuilds_linked_preloads(void)
+{
+    map_manager_set_current(&g_map_a, MM_DIR "/a.tmx");
+    TEST_ASSERT_TRUE(wait_ready(MM_DIR "/b.tmx"));
+    TEST_ASSERT_TRUE(wait_ready(MM_DIR "/c.tmx"));
+    TEST_ASSERT_EQUAL_INT(2, g_templates_built);
+
+    // b.tmx changes on disk: the next take must see the new file, not the cached parse.
+    TEST_ASSERT_TRUE(write_map(MM_DIR "/b.tmx", 5, 3, ""));
+    map_manager_invalidate();
+    TEST_ASSERT_EQUAL_INT(2, g_templates_freed);
+    TEST_ASSERT_TRUE(wait_ready(MM_DIR "/b.tmx"));
+    TEST_ASSERT_TRUE(wait_ready(MM_DIR "/c.tmx"));
+    TEST_ASSERT_EQUAL_INT(4, g_templates_built);
+
+    map_preload_t next = {0};
+    TEST_ASSERT_TRUE(map_manager_take(MM_DIR "/b.tmx", &next));
+    TEST_ASSERT_EQUAL_INT(5, world_prepared_map(next.world)->width);
+    map_preload_free(&next);
+}
+
+void test_map_manager_take_loads_unrequested_maps_inline(void)
+{
+    map_preload_t next = {0};
+    TEST_ASSERT_TRUE(map_manager_take(MM_DIR "/c.tmx", &next));
+    TEST_ASSERT_EQUAL_INT(2, world_prepared_map(next.world)->width);
+    map_preload_free(&next);
+
+    TEST_ASSERT_FALSE(map_manager_take(MM_DIR "/missing.tmx", &next));
+    TEST_ASSERT_NULL(next.world);
+    TEST_ASSERT_NULL(next.templates);
+}
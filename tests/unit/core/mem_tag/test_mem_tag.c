@@ -0,0 +1,113 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#define DA_MEM_TAG MEM_TAG_WORLD
+
+#include "unity.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "modules/common/dynarray.h"
+#include "modules/common/mem_tag.h"
+
+// Counters are process-wide, so every test compares against a snapshot taken at its start.
+static mem_tag_stats_t stats_of(mem_tag_t tag)
+{
+    mem_tag_stats_t st;
+    mem_tag_stats(tag, &st);
+    return st;
+}
+
+void test_mem_tag_tracks_live_peak_and_counts(void)
+{
+    const mem_tag_stats_t base = stats_of(MEM_TAG_TILED);
+    mem_tag_reset_peaks();
+
+    uint8_t* a = (uint8_t*)mem_alloc(MEM_TAG_TILED, 100);
+    uint32_t* b = (uint32_t*)mem_calloc(MEM_TAG_TILED, 10, sizeof(uint32_t));
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_EQUAL_UINT32(0, b[9]);
+    mem_tag_stats_t st = stats_of(MEM_TAG_TILED);
+    TEST_ASSERT_EQUAL_size_t(base.live_bytes + 140, st.live_bytes);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)base.live_blocks + 2, (uint32_t)st.live_blocks);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)base.alloc_count + 2, (uint32_t)st.alloc_count);
+
+    a = (uint8_t*)mem_realloc(MEM_TAG_TILED, a, 100, 300); // grows the block, not the block count
+    st = stats_of(MEM_TAG_TILED);
+    TEST_ASSERT_EQUAL_size_t(base.live_bytes + 340, st.live_bytes);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)base.live_blocks + 2, (uint32_t)st.live_blocks);
+
+    mem_free(MEM_TAG_TILED, a, 300);
+    mem_free(MEM_TAG_TILED, b, 10 * sizeof(uint32_t));
+    mem_free(MEM_TAG_TILED, NULL, 64); // no-op
+    st = stats_of(MEM_TAG_TILED);
+    TEST_ASSERT_EQUAL_size_t(base.live_bytes, st.live_bytes);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)base.live_blocks, (uint32_t)st.live_blocks);
+    TEST_ASSERT_EQUAL_size_t(base.live_bytes + 340, st.peak_bytes);
+
+    mem_tag_reset_peaks();
+    TEST_ASSERT_EQUAL_size_t(base.live_bytes, stats_of(MEM_TAG_TILED).peak_bytes);
+}
+
+void test_mem_tag_tags_are_independent(void)
+{
+    const mem_tag_stats_t prefab = stats_of(MEM_TAG_PREFAB);
+    const mem_tag_stats_t asset = stats_of(MEM_TAG_ASSET);
+
+    char* s = mem_strdup(MEM_TAG_PREFAB, "coin.ent");
+    TEST_ASSERT_EQUAL_STRING("coin.ent", s);
+    mem_track_alloc(MEM_TAG_ASSET, 4096); // e.g. texture pixels owned by the backend
+    TEST_ASSERT_EQUAL_size_t(prefab.live_bytes + 9, stats_of(MEM_TAG_PREFAB).live_bytes);
+    TEST_ASSERT_EQUAL_size_t(asset.live_bytes + 4096, stats_of(MEM_TAG_ASSET).live_bytes);
+
+    mem_free_str(MEM_TAG_PREFAB, s);
+    mem_track_free(MEM_TAG_ASSET, 4096);
+    TEST_ASSERT_EQUAL_size_t(prefab.live_bytes, stats_of(MEM_TAG_PREFAB).live_bytes);
+    TEST_ASSERT_EQUAL_size_t(asset.live_bytes, stats_of(MEM_TAG_ASSET).live_bytes);
+    TEST_ASSERT_EQUAL_STRING("asset", mem_tag_name(MEM_TAG_ASSET));
+}
+
+void test_mem_tag_dynarray_opts_in_with_da_mem_tag(void)
+{
+    const mem_tag_stats_t base = stats_of(MEM_TAG_WORLD);
+    DA(int) xs = {0};
+    for (int i = 0; i < 100; ++i) DA_APPEND(&xs, i);
+    DA_RESERVE(&xs, 500);
+    TEST_ASSERT_EQUAL_INT(99, xs.data[99]);
+
+    mem_tag_stats_t st = stats_of(MEM_TAG_WORLD);
+    TEST_ASSERT_EQUAL_size_t(base.live_bytes + xs.capacity * sizeof(int), st.live_bytes);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)base.live_blocks + 1, (uint32_t)st.live_blocks);
+
+    DA_FREE(&xs);
+    st = stats_of(MEM_TAG_WORLD);
+    TEST_ASSERT_EQUAL_size_t(base.live_bytes, st.live_bytes);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)base.live_blocks, (uint32_t)st.live_blocks);
+}
+
+static void* churn(void* arg)
+{
+    (void)arg;
+    for (int i = 0; i < 5000; ++i) {
+        void* p = mem_alloc(MEM_TAG_ECS, 32);
+        mem_free(MEM_TAG_ECS, p, 32);
+    }
+    return NULL;
+}
+
+void test_mem_tag_counts_from_several_threads(void)
+{
+    const mem_tag_stats_t base = stats_of(MEM_TAG_ECS);
+    pthread_t t[4];
+    for (int i = 0; i < 4; ++i) TEST_ASSERT_EQUAL_INT(0, pthread_create(&t[i], NULL, churn, NULL));
+    for (int i = 0; i < 4; ++i) pthread_join(t[i], NULL);
+
+    const mem_tag_stats_t st = stats_of(MEM_TAG_ECS);
+    TEST_ASSERT_EQUAL_size_t(base.live_bytes, st.live_bytes);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)base.alloc_count + 20000, (uint32_t)st.alloc_count);
+    TEST_ASSERT_TRUE(st.peak_bytes >= base.live_bytes + 32);
+}
@@ -0,0 +1,135 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "unity.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "modules/core/metrics.h"
+
+// Metrics live for the whole process, so every test uses its own names.
+static char g_text[8192];
+
+static const char* render(void)
+{
+    const size_t n = metrics_render(g_text, sizeof(g_text));
+    TEST_ASSERT_TRUE(n < sizeof(g_text));
+    return g_text;
+}
+
+void tearDown(void)
+{
+    metrics_shutdown();
+}
+
+void test_metrics_counter_and_gauge_exposition(void)
+{
+    metric_t* c = metrics_counter("t1_items_total", "Items seen", NULL);
+    metric_t* g = metrics_gauge("t1_live", "Live things", NULL);
+    TEST_ASSERT_NOT_NULL(c);
+    TEST_ASSERT_EQUAL_PTR(c, metrics_counter("t1_items_total", "again", NULL)); // same name: same metric
+    TEST_ASSERT_NULL(metrics_gauge("t1_items_total", NULL, NULL));             // ... but not another type
+
+    metrics_add(c, 3);
+    metrics_add(c, 2);
+    metrics_set(g, 42.5);
+    metrics_add(NULL, 1); // unregistered metrics are no-ops
+    TEST_ASSERT_EQUAL_UINT32(5, (uint32_t)metrics_counter_value(c));
+
+    const char* text = render();
+    TEST_ASSERT_NOT_NULL(strstr(text, "# HELP t1_items_total Items seen\n# TYPE t1_items_total counter\nt1_items_total 5\n"));
+    TEST_ASSERT_NOT_NULL(strstr(text, "# TYPE t1_live gauge\nt1_live 42.5\n"));
+}
+
+void test_metrics_histogram_buckets_are_cumulative(void)
+{
+    static const double bounds[] = { 1.0, 5.0 };
+    metric_t* h = metrics_histogram("t2_latency", NULL, "phase=\"sim\"", bounds, 2);
+    metrics_observe(h, 0.5);
+    metrics_observe(h, 1.0); // le is inclusive
+    metrics_observe(h, 3.0);
+    metrics_observe(h, 9.0);
+    TEST_ASSERT_EQUAL_UINT32(4, (uint32_t)metrics_histogram_count(h));
+
+    const char* text = render();
+    TEST_ASSERT_NOT_NULL(strstr(text,
+        "# TYPE t2_latency histogram\n"
+        "t2_latency_bucket{phase=\"sim\",le=\"1\"} 2\n"
+        "t2_latency_bucket{phase=\"sim\",le=\"5\"} 3\n"
+        "t2_latency_bucket{phase=\"sim\",le=\"+Inf\"} 4\n"
+        "t2_latency_sum{phase=\"sim\"} 13.5\n"
+        "t2_latency_count{phase=\"sim\"} 4\n"));
+}
+
+void test_metrics_labelled_series_share_one_family_block(void)
+{
+    metric_t* a = metrics_counter("t3_calls_total", "Calls", "sys=\"a\"");
+    metrics_counter("t3_other_total", NULL, NULL);
+    metric_t* b = metrics_counter("t3_calls_total", "Calls", "sys=\"b\"");
+    TEST_ASSERT_TRUE(a != b);
+    metrics_add(b, 7);
+
+    const char* text = render();
+    TEST_ASSERT_NOT_NULL(strstr(text,
+        "# HELP t3_calls_total Calls\n# TYPE t3_calls_total counter\n"
+        "t3_calls_total{sys=\"a\"} 0\nt3_calls_total{sys=\"b\"} 7\n"));
+    const char* first = strstr(text, "# TYPE t3_calls_total");
+    TEST_ASSERT_NULL(strstr(first + 1, "# TYPE t3_calls_total"));
+}
+
+static void* hammer(void* arg)
+{
+    metric_t* m = (metric_t*)arg;
+    for (int i = 0; i < 10000; ++i) metrics_observe(m, 0.25);
+    return NULL;
+}
+
+void test_metrics_concurrent_updates_are_not_lost(void)
+{
+    metric_t* h = metrics_histogram("t4_hammer", NULL, NULL, NULL, 0);
+    pthread_t t[4];
+    for (int i = 0; i < 4; ++i) TEST_ASSERT_EQUAL_INT(0, pthread_create(&t[i], NULL, hammer, h));
+    for (int i = 0; i < 4; ++i) pthread_join(t[i], NULL);
+    TEST_ASSERT_EQUAL_UINT32(40000, (uint32_t)metrics_histogram_count(h));
+    TEST_ASSERT_NOT_NULL(strstr(render(), "t4_hammer_sum 10000\n"));
+}
+
+void test_metrics_serves_http_on_unix_socket(void)
+{
+    const char* path = "build/tests/metrics_test.sock";
+    metric_t* c = metrics_counter("t5_scraped_total", NULL, NULL);
+    metrics_add(c, 11);
+    TEST_ASSERT_TRUE(metrics_serve("unix:build/tests/metrics_test.sock"));
+    TEST_ASSERT_FALSE(metrics_serve("unix:build/tests/other.sock")); // one server at a time
+
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sun_family = AF_UNIX;
+    snprintf(sa.sun_path, sizeof(sa.sun_path), "%s", path);
+    TEST_ASSERT_EQUAL_INT(0, connect(fd, (struct sockaddr*)&sa, sizeof(sa)));
+    const char req[] = "GET /metrics HTTP/1.0\r\n\r\n";
+    TEST_ASSERT_EQUAL_INT((int)sizeof(req) - 1, (int)write(fd, req, sizeof(req) - 1));
+
+    char resp[8192];
+    size_t got = 0;
+    ssize_t n;
+    while (got < sizeof(resp) - 1 && (n = read(fd, resp + got, sizeof(resp) - 1 - got)) > 0) got += (size_t)n;
+    resp[got] = '\0';
+    close(fd);
+
+    TEST_ASSERT_EQUAL_INT(0, strncmp(resp, "HTTP/1.0 200 OK\r\n", 17));
+    TEST_ASSERT_NOT_NULL(strstr(resp, "text/plain; version=0.0.4"));
+    TEST_ASSERT_NOT_NULL(strstr(resp, "\r\n\r\n"));
+    TEST_ASSERT_NOT_NULL(strstr(resp, "t5_scraped_total 11\n"));
+
+    metrics_shutdown();
+    TEST_ASSERT_EQUAL_INT(-1, access(path, F_OK)); // socket file removed
+    TEST_ASSERT_FALSE(metrics_serve("not-a-port"));
+}
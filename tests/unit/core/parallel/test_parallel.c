@@ -0,0 +1,62 @@
+#include "unity.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include "modules/common/parallel.h"
+
+#define ITEMS 10000
+
+static uint32_t g_hits[ITEMS];
+static size_t   g_order[ITEMS];
+static size_t   g_order_count;
+
+void setUp(void)
+{
+    memset(g_hits, 0, sizeof(g_hits));
+    g_order_count = 0;
+    parallel_set_max_workers(0);
+}
+
+void tearDown(void)
+{
+    parallel_set_max_workers(0);
+}
+
+static void count_hit(void* user, size_t i)
+{
+    (void)user;
+    __atomic_add_fetch(&g_hits[i], 1u, __ATOMIC_RELAXED);
+}
+
+static void record_order(void* user, size_t i)
+{
+    (void)user;
+    g_order[g_order_count++] = i;
+}
+
+void test_parallel_for_runs_every_index_once(void)
+{
+    parallel_for(ITEMS, count_hit, NULL);
+    for (size_t i = 0; i < ITEMS; ++i) TEST_ASSERT_EQUAL_UINT32(1, g_hits[i]);
+
+    parallel_for(0, count_hit, NULL); // no-op
+    parallel_for(5, NULL, NULL);
+    for (size_t i = 0; i < ITEMS; ++i) TEST_ASSERT_EQUAL_UINT32(1, g_hits[i]);
+}
+
+void test_parallel_for_single_worker_runs_inline_in_order(void)
+{
+    parallel_set_max_workers(1);
+    TEST_ASSERT_EQUAL_size_t(1, parallel_worker_count());
+    parallel_for(100, record_order, NULL);
+    TEST_ASSERT_EQUAL_size_t(100, g_order_count);
+    for (size_t i = 0; i < 100; ++i) TEST_ASSERT_EQUAL_size_t(i, g_order[i]);
+}
+
+void test_parallel_worker_count_respects_cap(void)
+{
+    TEST_ASSERT_TRUE(parallel_worker_count() >= 1);
+    parallel_set_max_workers(2);
+    TEST_ASSERT_TRUE(parallel_worker_count() <= 2);
+}
@@ -0,0 +1,30 @@
+#include "savegame_stubs.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "modules/common/snapshot_io.h"
+#include "modules/core/snapshot.h"
+
+size_t snapshot_body_offset(void)
+{
+    return SAVEGAME_STUB_HEADER_SIZE;
+}
+
+bool snapshot_wrap_body(snapshot_t* out, const uint8_t* body, size_t body_size)
+{
+    snapshot_free(out);
+    snap_buf_t b = {0};
+    snap_write(&b, SAVEGAME_STUB_HEADER, SAVEGAME_STUB_HEADER_SIZE);
+    snap_write(&b, body, body_size);
+    out->data = b.data;
+    out->size = b.size;
+    return true;
+}
+
+void snapshot_free(snapshot_t* snap)
+{
+    free(snap->data);
+    snap->data = NULL;
+    snap->size = 0;
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+// Stand-in snapshot framing: an 8-byte header in front of the body.
+#define SAVEGAME_STUB_HEADER "SNAPHDR!"
+#define SAVEGAME_STUB_HEADER_SIZE 8
@@ -0,0 +1,175 @@
+#include "unity.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "modules/common/delta_codec.h"
+#include "modules/core/savegame.h"
+#include "savegame_stubs.h"
+
+#define BLOB_SIZE 4096
+
+static uint8_t g_base[BLOB_SIZE + SAVEGAME_STUB_HEADER_SIZE];
+static uint8_t g_live[BLOB_SIZE + 64];
+static size_t  g_live_size;
+
+void setUp(void)
+{
+    // Deterministic "component data": mostly structured, not compressible by accident.
+    uint32_t x = 12345u;
+    memcpy(g_base, SAVEGAME_STUB_HEADER, SAVEGAME_STUB_HEADER_SIZE);
+    for (size_t i = SAVEGAME_STUB_HEADER_SIZE; i < sizeof(g_base); ++i) {
+        x = x * 1664525u + 1013904223u;
+        g_base[i] = (uint8_t)(x >> 24);
+    }
+
+    // Live state: one 40-byte record destroyed near the start (everything after shifts), a float
+    // changed in place further on, and a new 24-byte record spawned at the end.
+    const size_t cut = SAVEGAME_STUB_HEADER_SIZE + 200;
+    memcpy(g_live, g_base, cut);
+    memcpy(g_live + cut, g_base + cut + 40, sizeof(g_base) - cut - 40);
+    g_live_size = sizeof(g_base) - 40;
+    g_live[2000] ^= 0x5A;
+    g_live[2001] ^= 0x11;
+    memset(g_live + g_live_size, 0xAB, 24);
+    g_live_size += 24;
+}
+
+void tearDown(void)
+{
+}
+
+void test_delta_round_trips_shifted_and_edited_data(void)
+{
+    snap_buf_t enc = {0};
+    delta_encode(&enc, g_base, sizeof(g_base), g_live, g_live_size);
+    TEST_ASSERT_TRUE(enc.size < 96);
+
+    snap_buf_t dec = {0};
+    snap_reader_t r = { .data = enc.data, .size = enc.size };
+    TEST_ASSERT_TRUE(delta_decode(&dec, g_base, sizeof(g_base), &r, g_live_size));
+    TEST_ASSERT_EQUAL_size_t(enc.size, r.pos);
+    TEST_ASSERT_EQUAL_size_t(g_live_size, dec.size);
+    TEST_ASSERT_EQUAL_MEMORY(g_live, dec.data, g_live_size);
+
+    DA_FREE(&enc);
+    DA_FREE(&dec);
+}
+
+void test_delta_against_empty_base_is_all_literal(void)
+{
+    snap_buf_t enc = {0};
+    delta_encode(&enc, NULL, 0, g_live, 100);
+
+    snap_buf_t dec = {0};
+    snap_reader_t r = { .data = enc.data, .size = enc.size };
+    TEST_ASSERT_TRUE(delta_decode(&dec, NULL, 0, &r, 100));
+    TEST_ASSERT_EQUAL_MEMORY(g_live, dec.data, 100);
+
+    DA_FREE(&enc);
+    DA_FREE(&dec);
+}
+
+void test_delta_decode_rejects_copy_outside_base(void)
+{
+    snap_buf_t enc = {0};
+    snap_write_varint(&enc, 0);   // no literal
+    snap_write_varint(&enc, 16);  // copy 16 bytes...
+    snap_write_varint(&enc, 200); // ...from offset 100 of an 8-byte base
+
+    snap_buf_t dec = {0};
+    snap_reader_t r = { .data = enc.data, .size = enc.size };
+    TEST_ASSERT_FALSE(delta_decode(&dec, g_base, 8, &r, 16));
+
+    DA_FREE(&enc);
+    DA_FREE(&dec);
+}
+
+void test_savegame_round_trips_against_baseline(void)
+{
+    snapshot_t baseline = { g_base, sizeof(g_base) };
+    uint8_t current_blob[sizeof(g_live) + SAVEGAME_STUB_HEADER_SIZE];
+    memcpy(current_blob, SAVEGAME_STUB_HEADER, SAVEGAME_STUB_HEADER_SIZE);
+    memcpy(current_blob + SAVEGAME_STUB_HEADER_SIZE, g_live, g_live_size);
+    snapshot_t current = { current_blob, g_live_size + SAVEGAME_STUB_HEADER_SIZE };
+
+    snap_buf_t save = {0};
+    TEST_ASSERT_TRUE(savegame_encode(&save, &baseline, &current, "assets/maps/start.tmx"));
+    TEST_ASSERT_TRUE(save.size < 160);
+
+    char map[64];
+    TEST_ASSERT_TRUE(savegame_map_path(save.data, save.size, map, sizeof(map)));
+    TEST_ASSERT_EQUAL_STRING("assets/maps/start.tmx", map);
+
+    snapshot_t loaded = {0};
+    TEST_ASSERT_TRUE(savegame_decode(&loaded, &baseline, save.data, save.size));
+    TEST_ASSERT_EQUAL_size_t(current.size, loaded.size);
+    TEST_ASSERT_EQUAL_MEMORY(current.data, loaded.data, current.size);
+
+    snapshot_free(&loaded);
+    DA_FREE(&save);
+}
+
+void test_savegame_rejects_changed_baseline_and_truncation(void)
+{
+    snapshot_t baseline = { g_base, sizeof(g_base) };
+    snap_buf_t save = {0};
+    TEST_ASSERT_TRUE(savegame_encode(&save, &baseline, &baseline, "m.tmx"));
+
+    snapshot_t loaded = {0};
+    TEST_ASSERT_FALSE(savegame_decode(&loaded, &baseline, save.data, save.size - 1));
+
+    g_base[100] ^= 1; // the map's fresh state no longer matches what the save was taken against
+    TEST_ASSERT_FALSE(savegame_decode(&loaded, &baseline, save.data, save.size));
+    TEST_ASSERT_NULL(loaded.data);
+
+    DA_FREE(&save);
+}
+
+void test_savegame_rejects_delta_that_decodes_to_the_wrong_state(void)
+{
+    snapshot_t baseline = { g_base, sizeof(g_base) };
+    uint8_t current_blob[sizeof(g_live) + SAVEGAME_STUB_HEADER_SIZE];
+    memcpy(current_blob, SAVEGAME_STUB_HEADER, SAVEGAME_STUB_HEADER_SIZE);
+    memcpy(current_blob + SAVEGAME_STUB_HEADER_SIZE, g_live, g_live_size);
+    snapshot_t current = { current_blob, g_live_size + SAVEGAME_STUB_HEADER_SIZE };
+
+    snap_buf_t save = {0};
+    TEST_ASSERT_TRUE(savegame_encode(&save, &baseline, &current, "m.tmx"));
+
+    // Flip a byte of the spawned record's literal run: the stream stays well formed, the
+    // rebuilt state doesn't.
+    size_t lit = save.size;
+    while (lit > 0 && save.data[lit - 1] != 0xAB) lit--;
+    TEST_ASSERT_TRUE(lit > 0);
+    save.data[lit - 1] ^= 0x01;
+
+    snapshot_t loaded = {0};
+    TEST_ASSERT_FALSE(savegame_decode(&loaded, &baseline, save.data, save.size));
+    TEST_ASSERT_NULL(loaded.data);
+
+    DA_FREE(&save);
+}
+
+void test_savegame_async_write_lands_after_flush(void)
+{
+    const char* path = "build/tests/savegame_test.sav";
+    snap_buf_t first = {0};
+    snap_write(&first, "old", 3);
+    snap_buf_t second = {0};
+    snap_write(&second, "newest", 6);
+
+    savegame_write_async(path, &first);
+    savegame_write_async(path, &second);
+    TEST_ASSERT_NULL(second.data);
+    savegame_flush();
+
+    snap_buf_t back = {0};
+    TEST_ASSERT_TRUE(savegame_read_file(path, &back));
+    TEST_ASSERT_EQUAL_size_t(6, back.size);
+    TEST_ASSERT_EQUAL_MEMORY("newest", back.data, 6);
+
+    savegame_shutdown();
+    DA_FREE(&back);
+    remove(path);
+}
@@ -0,0 +1,107 @@
+#include "unity.h"
+
+#include "modules/core/trace.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Fake clock: tests advance it explicitly.
+static double g_fake_now = 0.0;
+
+double time_now(void)
+{
+    return g_fake_now;
+}
+
+static char* read_file(const char* path)
+{
+    FILE* f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long n = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char* buf = (char*)malloc((size_t)n + 1);
+    size_t got = fread(buf, 1, (size_t)n, f);
+    buf[got] = '\0';
+    fclose(f);
+    return buf;
+}
+
+void setUp(void)
+{
+    trace_reset();
+}
+
+void tearDown(void)
+{
+}
+
+void test_trace_nested_scopes_export_complete_events(void)
+{
+    TRACE_BEGIN("frame");
+    g_fake_now += 0.001;
+    TRACE_BEGIN("physics");
+    g_fake_now += 0.002;
+    TRACE_END();
+    g_fake_now += 0.001;
+    TRACE_END();
+
+    TEST_ASSERT_EQUAL_UINT32(2, (uint32_t)trace_event_count());
+
+    const char* path = "build/tests/trace_test.json";
+    TEST_ASSERT_TRUE(trace_write_json(path));
+    char* json = read_file(path);
+    TEST_ASSERT_NOT_NULL(json);
+
+    TEST_ASSERT_NOT_NULL(strstr(json, "\"traceEvents\":["));
+    // Inner scope closes first, so it is recorded first.
+    const char* physics = strstr(json, "{\"name\":\"physics\",\"ph\":\"X\"");
+    const char* frame = strstr(json, "{\"name\":\"frame\",\"ph\":\"X\"");
+    TEST_ASSERT_NOT_NULL(physics);
+    TEST_ASSERT_NOT_NULL(frame);
+    TEST_ASSERT_TRUE(physics < frame);
+    TEST_ASSERT_NOT_NULL(strstr(physics, "\"dur\":2000.000}"));
+    TEST_ASSERT_NOT_NULL(strstr(frame, "\"dur\":4000.000}"));
+
+    free(json);
+    remove(path);
+}
+
+void test_trace_unbalanced_end_is_ignored(void)
+{
+    TRACE_END();
+    TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)trace_event_count());
+}
+
+void test_trace_shutdown_frees_buffers_and_tracing_starts_over(void)
+{
+    TRACE_BEGIN("before");
+    TRACE_END();
+    TEST_ASSERT_EQUAL_UINT32(1, (uint32_t)trace_event_count());
+
+    trace_shutdown();
+    TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)trace_event_count());
+    trace_shutdown();
+
+    TRACE_BEGIN("after");
+    TRACE_END();
+    TEST_ASSERT_EQUAL_UINT32(1, (uint32_t)trace_event_count());
+}
+
+void test_trace_ring_keeps_newest_events(void)
+{
+    for (int i = 0; i < TRACE_MAX_EVENTS + 10; ++i) {
+        TRACE_BEGIN((i < 10) ? "old" : "new");
+        TRACE_END();
+    }
+    TEST_ASSERT_EQUAL_UINT32(TRACE_MAX_EVENTS, (uint32_t)trace_event_count());
+
+    const char* path = "build/tests/trace_ring_test.json";
+    TEST_ASSERT_TRUE(trace_write_json(path));
+    char* json = read_file(path);
+    TEST_ASSERT_NOT_NULL(json);
+    TEST_ASSERT_NULL(strstr(json, "\"old\""));
+    free(json);
+    remove(path);
+}
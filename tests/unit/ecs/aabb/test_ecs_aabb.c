@@ -0,0 +1,76 @@
+#include "unity.h"
+
+#include <stdint.h>
+
+#include "modules/ecs/ecs_aabb.h"
+
+#define N 40
+
+static float cx[N], cy[N], hx[N], hy[N];
+
+static aabb_batch_t make_batch(int count)
+{
+    return (aabb_batch_t){ cx, cy, hx, hy, count };
+}
+
+void setUp(void)
+{
+    for (int i = 0; i < N; ++i) {
+        cx[i] = (float)(i * 10);
+        cy[i] = 0.0f;
+        hx[i] = 2.0f;
+        hy[i] = 2.0f;
+    }
+}
+
+void test_aabb_overlap_mask_sets_bits_for_hits(void)
+{
+    aabb_batch_t b = make_batch(N);
+    // Box at x=20 with hx=9 reaches 11..29; boxes 1,2,3 (10,20,30 +-2) overlap.
+    uint32_t m = aabb_overlap_mask(20.0f, 0.0f, 9.0f, 1.0f, &b, 0, false);
+    TEST_ASSERT_EQUAL_HEX32((1u << 1) | (1u << 2) | (1u << 3), m);
+}
+
+void test_aabb_overlap_mask_touching_edges_inclusive_only(void)
+{
+    aabb_batch_t b = make_batch(N);
+    // Right edge at 8 touches box 1's left edge at 8.
+    TEST_ASSERT_EQUAL_HEX32(1u << 0, aabb_overlap_mask(4.0f, 0.0f, 4.0f, 1.0f, &b, 0, false));
+    TEST_ASSERT_EQUAL_HEX32((1u << 0) | (1u << 1), aabb_overlap_mask(4.0f, 0.0f, 4.0f, 1.0f, &b, 0, true));
+}
+
+void test_aabb_overlap_mask_respects_first_and_count(void)
+{
+    aabb_batch_t b = make_batch(N);
+    // Lane 0 is box 35; only 5 boxes remain so higher lanes stay clear.
+    uint32_t m = aabb_overlap_mask(355.0f, 0.0f, 100.0f, 1.0f, &b, 35, false);
+    TEST_ASSERT_EQUAL_HEX32(0x1Fu, m);
+    TEST_ASSERT_EQUAL_HEX32(0u, aabb_overlap_mask(0.0f, 0.0f, 1000.0f, 1.0f, &b, N, false));
+}
+
+void test_aabb_overlap_mask_matches_scalar(void)
+{
+    for (int i = 0; i < N; ++i) {
+        cx[i] = (float)((i * 37) % 23) - 11.0f;
+        cy[i] = (float)((i * 17) % 19) - 9.0f;
+        hx[i] = 0.5f + (float)(i % 3);
+        hy[i] = 0.5f + (float)(i % 4);
+    }
+    aabb_batch_t b = make_batch(N);
+    for (int first = 0; first < N; first += 7) {
+        for (int inc = 0; inc < 2; ++inc) {
+            uint32_t simd = aabb_overlap_mask(1.0f, -2.0f, 3.0f, 2.5f, &b, first, inc != 0);
+            uint32_t ref = aabb_overlap_mask_scalar(1.0f, -2.0f, 3.0f, 2.5f, &b, first, inc != 0);
+            TEST_ASSERT_EQUAL_HEX32(ref, simd);
+        }
+    }
+}
+
+void test_aabb_mask_pop_walks_lanes_in_order(void)
+{
+    uint32_t m = (1u << 3) | (1u << 0) | (1u << 31);
+    TEST_ASSERT_EQUAL_INT(0, aabb_mask_pop(&m));
+    TEST_ASSERT_EQUAL_INT(3, aabb_mask_pop(&m));
+    TEST_ASSERT_EQUAL_INT(31, aabb_mask_pop(&m));
+    TEST_ASSERT_EQUAL_HEX32(0u, m);
+}
@@ -88,6 +88,7 @@ int main(int argc, char **argv)
     Nob_File_Paths sources = {0};
     nob_da_append(&sources, "third_party/Unity/src/unity.c");
     nob_da_append(&sources, "src/modules/ecs/ecs_anim.c");
+    nob_da_append(&sources, "src/modules/common/mem_tag.c");
     nob_da_append(&sources, "src/modules/asset/bump_alloc.c");
     nob_da_append(&sources, "tests/unit/ecs/anim/ecs_anim_stubs.c");
     nob_da_append(&sources, "tests/unit/ecs/anim/test_ecs_anim.c");
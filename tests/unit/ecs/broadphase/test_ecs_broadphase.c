@@ -0,0 +1,106 @@
+#include "unity.h"
+
+#include <string.h>
+
+#include "modules/ecs/ecs_broadphase.h"
+
+#define N 96
+
+static float cx[N], cy[N], hx[N], hy[N];
+static int ids[N];
+static ecs_broadphase_t ref_bp;
+static ecs_broadphase_t test_bp;
+
+static uint32_t lcg(uint32_t* s)
+{
+    *s = *s * 1664525u + 1013904223u;
+    return *s >> 8;
+}
+
+static void fill(uint32_t seed, int n)
+{
+    for (int i = 0; i < n; ++i) {
+        // Snap to whole pixels so plenty of boxes touch exactly.
+        cx[i] = (float)(lcg(&seed) % 160u);
+        cy[i] = (float)(lcg(&seed) % 160u);
+        hx[i] = (float)(2u + lcg(&seed) % 8u);
+        hy[i] = (float)(2u + lcg(&seed) % 8u);
+        ids[i] = i * 3;
+    }
+}
+
+static void assert_same_pairs(const ecs_broadphase_t* a, const ecs_broadphase_t* b)
+{
+    TEST_ASSERT_EQUAL_INT((int)a->pairs.size, (int)b->pairs.size);
+    for (size_t i = 0; i < a->pairs.size; ++i) {
+        TEST_ASSERT_EQUAL_INT(a->pairs.data[i].a, b->pairs.data[i].a);
+        TEST_ASSERT_EQUAL_INT(a->pairs.data[i].b, b->pairs.data[i].b);
+    }
+}
+
+static void check_kind(ecs_broadphase_kind_t kind, int n)
+{
+    aabb_batch_t boxes = { cx, cy, hx, hy, n };
+    ref_bp.kind = ECS_BROADPHASE_ALL_PAIRS;
+    test_bp.kind = kind;
+    ecs_broadphase_update(&ref_bp, &boxes, ids);
+    ecs_broadphase_update(&test_bp, &boxes, ids);
+    assert_same_pairs(&ref_bp, &test_bp);
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+    ecs_broadphase_free(&ref_bp);
+    ecs_broadphase_free(&test_bp);
+}
+
+void test_broadphase_grid_matches_all_pairs(void)
+{
+    fill(7u, N);
+    check_kind(ECS_BROADPHASE_GRID, N);
+    TEST_ASSERT_TRUE(ref_bp.pairs.size > 0);
+}
+
+void test_broadphase_grid_small_cells_dedups_pairs(void)
+{
+    fill(11u, N);
+    test_bp.cell_size = 3.0f;
+    check_kind(ECS_BROADPHASE_GRID, N);
+}
+
+void test_broadphase_sap_matches_all_pairs(void)
+{
+    fill(7u, N);
+    check_kind(ECS_BROADPHASE_SAP, N);
+}
+
+void test_broadphase_reports_touching_boxes(void)
+{
+    cx[0] = 0.0f;  cy[0] = 0.0f; hx[0] = 2.0f; hy[0] = 2.0f; ids[0] = 0;
+    cx[1] = 4.0f;  cy[1] = 0.0f; hx[1] = 2.0f; hy[1] = 2.0f; ids[1] = 1;
+    cx[2] = 20.0f; cy[2] = 0.0f; hx[2] = 2.0f; hy[2] = 2.0f; ids[2] = 2;
+    for (int k = ECS_BROADPHASE_GRID; k < ECS_BROADPHASE_COUNT; ++k) {
+        check_kind((ecs_broadphase_kind_t)k, 3);
+        TEST_ASSERT_EQUAL_INT(1, (int)test_bp.pairs.size);
+    }
+}
+
+void test_broadphase_sap_tracks_moves_adds_and_removals(void)
+{
+    fill(3u, N);
+    test_bp.kind = ECS_BROADPHASE_SAP;
+    check_kind(ECS_BROADPHASE_SAP, N - 8);
+
+    // Move a few bodies, drop one id and bring in new ones on the next update.
+    for (int i = 0; i < 10; ++i) cx[i] += 13.0f;
+    ids[5] = 1000;
+    check_kind(ECS_BROADPHASE_SAP, N);
+    TEST_ASSERT_EQUAL_INT(2 * N, (int)test_bp.endpoints.size);
+
+    check_kind(ECS_BROADPHASE_SAP, N / 2);
+    TEST_ASSERT_EQUAL_INT(N, (int)test_bp.endpoints.size);
+}
@@ -89,6 +89,10 @@ int main(int argc, char **argv)
     nob_da_append(&sources, "third_party/Unity/src/unity.c");
     nob_da_append(&sources, "src/modules/core/logger.c");
     nob_da_append(&sources, "src/modules/systems/systems.c");
+    nob_da_append(&sources, "src/modules/core/metrics.c");
+    nob_da_append(&sources, "src/modules/core/frame_alloc.c");
+    nob_da_append(&sources, "src/modules/asset/bump_alloc.c");
+    nob_da_append(&sources, "src/modules/common/mem_tag.c");
     nob_da_append(&sources, "tests/unit/ecs/test_ecs_systems.c");
     nob_da_append(&sources, runner_path);
 
@@ -88,6 +88,7 @@ int main(int argc, char **argv)
     Nob_File_Paths sources = {0};
     nob_da_append(&sources, "third_party/Unity/src/unity.c");
     nob_da_append(&sources, "src/modules/ecs/ecs_core.c");
+    nob_da_append(&sources, "src/modules/core/metrics.c");
     nob_da_append(&sources, "src/modules/ecs/ecs_doors.c");
     nob_da_append(&sources, "src/modules/ecs/ecs_render_components.c");
     nob_da_append(&sources, "tests/unit/ecs/core/ecs_core_stubs.c");
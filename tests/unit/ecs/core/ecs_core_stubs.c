@@ -233,6 +233,10 @@ void ecs_anim_shutdown_allocator(void)
 {
 }
 
+void ecs_proximity_reset(void)
+{
+}
+
 bool world_resolve_rect_mtv_px(float* io_cx, float* io_cy, float hx, float hy)
 {
     (void)io_cx;
@@ -89,6 +89,9 @@ int main(int argc, char **argv)
     nob_da_append(&sources, "third_party/Unity/src/unity.c");
     nob_da_append(&sources, "src/modules/ecs/ecs_game.c");
     nob_da_append(&sources, "src/modules/ecs/ecs_door_systems.c");
+    nob_da_append(&sources, "src/modules/core/frame_alloc.c");
+    nob_da_append(&sources, "src/modules/asset/bump_alloc.c");
+    nob_da_append(&sources, "src/modules/common/mem_tag.c");
     nob_da_append(&sources, "tests/unit/ecs/game/ecs_game_stubs.c");
     nob_da_append(&sources, "tests/unit/ecs/game/test_ecs_game.c");
     nob_da_append(&sources, runner_path);
@@ -13,6 +13,7 @@
 #include "modules/world/world_door.h"
 #include "modules/ecs/ecs_prefab_loading.h"
 #include "modules/world/world_renderer.h"
+#include "modules/world/world_stream.h"
 
 uint32_t        ecs_mask[ECS_MAX_ENTITIES];
 uint32_t        ecs_gen[ECS_MAX_ENTITIES];
@@ -188,6 +189,18 @@ size_t ecs_prefab_spawn_from_map(const world_map_t* map, const char* tmx_path)
     return 0;
 }
 
+size_t ecs_prefab_stream_begin(const world_map_t* map, const char* tmx_path)
+{
+    (void)map;
+    (void)tmx_path;
+    return 0;
+}
+
+bool world_stream_active(void)
+{
+    return false;
+}
+
 void world_door_apply_state(world_door_handle_t handle, float t_ms, bool play_forward)
 {
     (void)handle;
@@ -4,6 +4,7 @@ uint32_t        ecs_mask[ECS_MAX_ENTITIES];
 uint32_t        ecs_gen[ECS_MAX_ENTITIES];
 uint32_t        ecs_next_gen[ECS_MAX_ENTITIES];
 cmp_position_t  cmp_pos[ECS_MAX_ENTITIES];
+cmp_position_t  cmp_pos_prev[ECS_MAX_ENTITIES];
 cmp_velocity_t  cmp_vel[ECS_MAX_ENTITIES];
 cmp_follow_t    cmp_follow[ECS_MAX_ENTITIES];
 cmp_anim_t      cmp_anim[ECS_MAX_ENTITIES];
@@ -24,3 +25,8 @@ float clampf(float v, float a, float b)
 {
     return (v < a) ? a : ((v > b) ? b : v);
 }
+
+int ent_index_checked(ecs_entity_t e)
+{
+    return (e.idx < ECS_MAX_ENTITIES && ecs_gen[e.idx] == e.gen && e.gen != 0) ? (int)e.idx : -1;
+}
@@ -12,6 +12,7 @@ static void reset_ecs_storage(void)
     memset(ecs_mask, 0, sizeof(ecs_mask));
     memset(ecs_gen, 0, sizeof(ecs_gen));
     memset(cmp_pos, 0, sizeof(cmp_pos));
+    memset(cmp_pos_prev, 0, sizeof(cmp_pos_prev));
     memset(cmp_spr, 0, sizeof(cmp_spr));
     memset(cmp_col, 0, sizeof(cmp_col));
     memset(cmp_trigger, 0, sizeof(cmp_trigger));
@@ -22,6 +23,7 @@ static void reset_ecs_storage(void)
 void setUp(void)
 {
     reset_ecs_storage();
+    ecs_set_render_alpha(1.0f);
 }
 
 void tearDown(void)
@@ -109,3 +111,33 @@ void test_ecs_billboards_iterator_filters_and_fades(void)
     TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.5f, view.alpha);
     TEST_ASSERT_EQUAL_STRING("hi", view.text);
 }
+
+void test_ecs_render_views_interpolate_from_previous_tick(void)
+{
+    ecs_gen[0] = 1;
+    ecs_mask[0] = CMP_POS | CMP_SPR | CMP_COL;
+    cmp_pos_prev[0] = (cmp_position_t){ 0.0f, 10.0f };
+    cmp_pos[0] = (cmp_position_t){ 8.0f, 20.0f };
+    cmp_col[0] = (cmp_collider_t){ 1.0f, 1.0f };
+
+    ecs_set_render_alpha(0.25f);
+
+    ecs_sprite_iter_t it = ecs_sprites_begin();
+    ecs_sprite_view_t view;
+    TEST_ASSERT_TRUE(ecs_sprites_next(&it, &view));
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 2.0f, view.x);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 12.5f, view.y);
+
+    ecs_collider_iter_t cit = ecs_colliders_begin();
+    ecs_collider_view_t col;
+    TEST_ASSERT_TRUE(ecs_colliders_next(&cit, &col));
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 2.0f, col.ecs_x);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 8.0f, col.phys_x);
+
+    v2f p;
+    TEST_ASSERT_TRUE(ecs_get_render_position((ecs_entity_t){ 0, 1 }, &p));
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 12.5f, p.y);
+
+    ecs_set_render_alpha(3.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 1.0f, ecs_render_alpha());
+}
@@ -36,6 +36,8 @@ void test_grav_gun_grab_and_release(void)
     cmp_pos[1] = (cmp_position_t){ 10.0f, 0.0f };
     cmp_col[1] = (cmp_collider_t){ 3.0f, 3.0f };
     cmp_phys_body[1].type = PHYS_DYNAMIC;
+    cmp_phys_body[1].sleeping = true;
+    cmp_phys_body[1].quiet_ticks = PHYS_SLEEP_TICKS;
     cmp_grav_gun[1].state = GRAV_GUN_STATE_FREE;
     cmp_grav_gun[1].pickup_distance = 20.0f;
     cmp_grav_gun[1].pickup_radius = 5.0f;
@@ -52,6 +54,7 @@ void test_grav_gun_grab_and_release(void)
     TEST_ASSERT_EQUAL_INT(GRAV_GUN_STATE_HELD, cmp_grav_gun[1].state);
     TEST_ASSERT_EQUAL_UINT32(0u, cmp_grav_gun[1].holder.idx);
     TEST_ASSERT_TRUE(cmp_grav_gun[1].saved_mask_valid);
+    TEST_ASSERT_FALSE(cmp_phys_body[1].sleeping);
     TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFFu & ~PHYS_CAT_PLAYER, cmp_phys_body[1].mask_bits);
 
     input_t release = {0};
@@ -40,6 +40,7 @@ int g_prefab_load_calls = 0;
 char g_prefab_load_path[256];
 bool g_prefab_load_result = true;
 int g_log_warn_calls = 0;
+int g_ecs_destroy_calls = 0;
 
 bool g_prefab_cmp_follow_result = false;
 prefab_cmp_follow_t g_prefab_cmp_follow_out = {0};
@@ -61,6 +62,7 @@ void ecs_prefab_loading_stub_reset(void)
     g_prefab_load_path[0] = '\0';
     g_prefab_load_result = true;
     g_log_warn_calls = 0;
+    g_ecs_destroy_calls = 0;
     g_prefab_cmp_follow_result = false;
     g_prefab_cmp_follow_out = (prefab_cmp_follow_t){0};
 }
@@ -76,6 +78,15 @@ ecs_entity_t ecs_create(void)
     return (ecs_entity_t){0, 1};
 }
 
+void ecs_destroy(ecs_entity_t e)
+{
+    int idx = ent_index_checked(e);
+    if (idx < 0) return;
+    g_ecs_destroy_calls++;
+    ecs_gen[idx] = 0;
+    ecs_mask[idx] = 0;
+}
+
 int ent_index_checked(ecs_entity_t e)
 {
     return (e.idx < ECS_MAX_ENTITIES && ecs_gen[e.idx] == e.gen && e.gen != 0) ? (int)e.idx : -1;
@@ -305,3 +316,15 @@ void log_msg(log_level_t lvl, const log_cat_t* cat, const char* fmt, ...)
     (void)cat; (void)fmt;
     if (lvl == LOG_LVL_WARN) g_log_warn_calls++;
 }
+
+const char* tiled_object_get_scoped_value(const tiled_object_t* obj, const char* scope, const char* field)
+{
+    if (!obj || !field) return NULL;
+    if (scope) {
+        char key[128];
+        snprintf(key, sizeof(key), "%s.%s", scope, field);
+        const char* v = tiled_object_get_property_value(obj, key);
+        if (v) return v;
+    }
+    return tiled_object_get_property_value(obj, field);
+}
@@ -17,6 +17,7 @@ extern int g_prefab_load_calls;
 extern char g_prefab_load_path[256];
 extern bool g_prefab_load_result;
 extern int g_log_warn_calls;
+extern int g_ecs_destroy_calls;
 
 extern bool g_prefab_cmp_follow_result;
 extern prefab_cmp_follow_t g_prefab_cmp_follow_out;
@@ -11,6 +11,7 @@ void setUp(void)
 
 void tearDown(void)
 {
+    ecs_prefab_loading_shutdown();
 }
 
 void test_prefab_spawn_entity_adds_default_position(void)
@@ -52,6 +53,35 @@ void test_prefab_spawn_from_map_resolves_relative_path(void)
     TEST_ASSERT_EQUAL_STRING("assets/maps/foo.ent", g_prefab_load_path);
 }
 
+void test_prefab_respawn_replaces_only_entities_from_that_prefab(void)
+{
+    tiled_property_t props[1];
+    props[0].name = "entityprefab";
+    props[0].value = "../prefabs/coin.ent";
+    props[0].type = NULL;
+
+    tiled_object_t obj = {0};
+    obj.property_count = 1;
+    obj.properties = props;
+
+    world_map_t map = {0};
+    map.object_count = 1;
+    map.objects = &obj;
+
+    TEST_ASSERT_EQUAL_UINT32(1u, (uint32_t)ecs_prefab_spawn_from_map(&map, "assets/maps/start.tmx"));
+    cmp_pos[0] = (cmp_position_t){ 5.0f, 6.0f }; // moved during play
+
+    TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)ecs_prefab_respawn(&map, "assets/prefabs/vendor.ent"));
+    TEST_ASSERT_EQUAL_INT(0, g_ecs_destroy_calls);
+
+    TEST_ASSERT_EQUAL_UINT32(1u, (uint32_t)ecs_prefab_respawn(&map, "assets/prefabs/coin.ent"));
+    TEST_ASSERT_EQUAL_INT(1, g_ecs_destroy_calls);
+    TEST_ASSERT_EQUAL_INT(2, g_prefab_load_calls);
+    TEST_ASSERT_EQUAL_STRING("assets/prefabs/coin.ent", g_prefab_load_path);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 5.0f, cmp_pos[0].x);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 6.0f, cmp_pos[0].y);
+}
+
 void test_prefab_spawn_entity_applies_position_overrides(void)
 {
     tiled_property_t props[2];
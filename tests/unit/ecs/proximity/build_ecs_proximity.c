@@ -88,6 +88,9 @@ int main(int argc, char **argv)
     Nob_File_Paths sources = {0};
     nob_da_append(&sources, "third_party/Unity/src/unity.c");
     nob_da_append(&sources, "src/modules/ecs/ecs_proximity.c");
+    nob_da_append(&sources, "src/modules/common/mem_tag.c");
+    nob_da_append(&sources, "src/modules/ecs/ecs_aabb.c");
+    nob_da_append(&sources, "src/modules/ecs/ecs_broadphase.c");
     nob_da_append(&sources, "tests/unit/ecs/proximity/ecs_proximity_stubs.c");
     nob_da_append(&sources, "tests/unit/ecs/proximity/test_ecs_proximity.c");
     nob_da_append(&sources, runner_path);
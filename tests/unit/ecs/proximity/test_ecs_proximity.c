@@ -69,3 +69,41 @@ void test_proximity_enter_stay_exit(void)
     ecs_prox_iter_t exit_it = ecs_prox_exit_begin();
     TEST_ASSERT_TRUE(ecs_prox_exit_next(&exit_it, &v));
 }
+
+void test_proximity_broadphase_modes_build_same_view(void)
+{
+    // Two triggers (one padded) and a row of targets, some exactly touching the pad.
+    for (int i = 0; i < 8; ++i) {
+        ecs_gen[i] = 1;
+        ecs_mask[i] = CMP_POS | CMP_COL | CMP_PLASTIC;
+        cmp_pos[i] = (cmp_position_t){ (float)(i * 3), 0.0f };
+        cmp_col[i] = (cmp_collider_t){ 1.0f, 1.0f };
+    }
+    ecs_mask[2] |= CMP_TRIGGER;
+    cmp_trigger[2] = (cmp_trigger_t){ 2.0f, CMP_PLASTIC };
+    ecs_mask[6] |= CMP_TRIGGER;
+    cmp_trigger[6] = (cmp_trigger_t){ 1.0f, CMP_PLASTIC };
+
+    ecs_prox_view_t ref[16];
+    int ref_n = 0;
+    sys_prox_build_adapt(0.0f, NULL);
+    ecs_prox_iter_t it = ecs_prox_stay_begin();
+    while (ref_n < 16 && ecs_prox_stay_next(&it, &ref[ref_n])) ref_n++;
+    TEST_ASSERT_EQUAL_INT(4, ref_n);
+
+    for (int k = ECS_BROADPHASE_GRID; k < ECS_BROADPHASE_COUNT; ++k) {
+        ecs_proximity_set_broadphase((ecs_broadphase_kind_t)k);
+        sys_prox_build_adapt(0.0f, NULL);
+        it = ecs_prox_stay_begin();
+        ecs_prox_view_t v;
+        int n = 0;
+        while (ecs_prox_stay_next(&it, &v)) {
+            TEST_ASSERT_TRUE(n < ref_n);
+            TEST_ASSERT_EQUAL_UINT32(ref[n].trigger_owner.idx, v.trigger_owner.idx);
+            TEST_ASSERT_EQUAL_UINT32(ref[n].matched_entity.idx, v.matched_entity.idx);
+            n++;
+        }
+        TEST_ASSERT_EQUAL_INT(ref_n, n);
+    }
+    ecs_proximity_set_broadphase(ECS_BROADPHASE_ALL_PAIRS);
+}
@@ -220,6 +220,12 @@ void sys_world_apply_edits_adapt(float dt, const input_t* in)
     (void)in;
 }
 
+void sys_world_stream_adapt(float dt, const input_t* in)
+{
+    (void)dt;
+    (void)in;
+}
+
 void sys_asset_collect_adapt(float dt, const input_t* in)
 {
     (void)dt;
@@ -0,0 +1,150 @@
+#include "ecs_snapshot_stubs.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "modules/asset/asset.h"
+#include "modules/core/camera.h"
+#include "modules/core/logger.h"
+#include "modules/ecs/ecs_internal.h"
+#include "modules/world/world_door.h"
+#include "modules/world/world_map.h"
+#include "modules/world/world_stream.h"
+
+int g_asset_acquire_calls = 0;
+int g_asset_release_calls = 0;
+char g_asset_last_path[128] = {0};
+uint32_t g_world_map_gen = 1;
+int g_world_cell = 0;
+int g_log_error_calls = 0;
+
+// Textures are slots 1..7 named by path; handles stay valid for the whole test.
+static char g_tex_paths[8][64];
+
+tex_handle_t ecs_snapshot_stub_texture(const char* path)
+{
+    for (uint32_t i = 1; i < 8; ++i) {
+        if (g_tex_paths[i][0] == '\0') snprintf(g_tex_paths[i], sizeof(g_tex_paths[i]), "%s", path);
+        if (strcmp(g_tex_paths[i], path) == 0) return (tex_handle_t){ i, 1 };
+    }
+    return (tex_handle_t){0, 0};
+}
+
+void ecs_snapshot_stub_reset(void)
+{
+    g_asset_acquire_calls = 0;
+    g_asset_release_calls = 0;
+    g_asset_last_path[0] = '\0';
+    g_world_map_gen = 1;
+    g_world_cell = 0;
+    g_log_error_calls = 0;
+    memset(g_tex_paths, 0, sizeof(g_tex_paths));
+}
+
+tex_handle_t asset_acquire_texture(const char* path)
+{
+    g_asset_acquire_calls++;
+    snprintf(g_asset_last_path, sizeof(g_asset_last_path), "%s", path);
+    return ecs_snapshot_stub_texture(path);
+}
+
+void asset_release_texture(tex_handle_t h)
+{
+    (void)h;
+    g_asset_release_calls++;
+}
+
+bool asset_texture_valid(tex_handle_t h)
+{
+    return h.idx > 0 && h.idx < 8 && h.gen == 1 && g_tex_paths[h.idx][0] != '\0';
+}
+
+const char* asset_texture_path(tex_handle_t h)
+{
+    return asset_texture_valid(h) ? g_tex_paths[h.idx] : NULL;
+}
+
+void ecs_game_snapshot_write(snap_buf_t* b)
+{
+    snap_write_tag(b, SNAP_TAG('G','A','M','E'));
+}
+
+bool ecs_game_snapshot_read(snap_reader_t* r)
+{
+    return snap_expect_tag(r, SNAP_TAG('G','A','M','E'));
+}
+
+void ecs_proximity_snapshot_write(snap_buf_t* b)
+{
+    snap_write_tag(b, SNAP_TAG('P','R','O','X'));
+}
+
+bool ecs_proximity_snapshot_read(snap_reader_t* r)
+{
+    return snap_expect_tag(r, SNAP_TAG('P','R','O','X'));
+}
+
+void ecs_proximity_reset(void)
+{
+}
+
+uint32_t world_map_generation(void)
+{
+    return g_world_map_gen;
+}
+
+bool world_stream_active(void)
+{
+    return false;
+}
+
+void world_snapshot_write(snap_buf_t* b)
+{
+    SNAP_WRITE_VAL(b, g_world_cell);
+}
+
+bool world_snapshot_read(snap_reader_t* r)
+{
+    return SNAP_READ_VAL(r, g_world_cell);
+}
+
+void world_door_snapshot_write(snap_buf_t* b)
+{
+    (void)b;
+}
+
+bool world_door_snapshot_read(snap_reader_t* r)
+{
+    (void)r;
+    return true;
+}
+
+void camera_snapshot_write(snap_buf_t* b)
+{
+    (void)b;
+}
+
+bool camera_snapshot_read(snap_reader_t* r)
+{
+    (void)r;
+    return true;
+}
+
+bool log_would_log(log_level_t lvl)
+{
+    (void)lvl;
+    return true;
+}
+
+void log_msg(log_level_t lvl, const log_cat_t* cat, const char* fmt, ...)
+{
+    (void)cat;
+    (void)fmt;
+    if (lvl == LOG_LVL_ERROR) g_log_error_calls++;
+}
+
+bool log_site_allow(log_site_t* site, log_level_t lvl, const log_cat_t* cat)
+{
+    (void)site; (void)lvl; (void)cat;
+    return true;
+}
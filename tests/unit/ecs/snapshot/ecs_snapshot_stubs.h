@@ -0,0 +1,16 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "modules/common/resource_handles.h"
+
+extern int g_asset_acquire_calls;
+extern int g_asset_release_calls;
+extern char g_asset_last_path[128];
+extern uint32_t g_world_map_gen;
+extern int g_world_cell;        // stands in for the world/door/camera sections
+extern int g_log_error_calls;
+
+tex_handle_t ecs_snapshot_stub_texture(const char* path); // registers path, returns its handle
+void ecs_snapshot_stub_reset(void);
@@ -0,0 +1,180 @@
+#include "unity.h"
+
+#include "modules/asset/asset.h"
+#include "modules/core/snapshot.h"
+#include "modules/ecs/ecs.h"
+#include "modules/ecs/ecs_internal.h"
+#include "ecs_snapshot_stubs.h"
+
+static snapshot_t g_snap;
+
+void setUp(void)
+{
+    ecs_snapshot_stub_reset();
+    ecs_init();
+    g_snap = (snapshot_t){0};
+}
+
+void tearDown(void)
+{
+    snapshot_free(&g_snap);
+    ecs_shutdown();
+}
+
+static ecs_entity_t spawn_body(float x, float y)
+{
+    ecs_entity_t e = ecs_create();
+    cmp_add_position(e, x, y);
+    int i = ent_index_checked(e);
+    ecs_mask[i] |= CMP_VEL | CMP_COL;
+    cmp_vel[i] = (cmp_velocity_t){ 1.0f, -2.0f, {0} };
+    cmp_col[i] = (cmp_collider_t){ 8.0f, 4.0f };
+    return e;
+}
+
+void test_snapshot_restores_entities_components_and_free_list(void)
+{
+    ecs_entity_t a = spawn_body(10.0f, 20.0f);
+    ecs_entity_t b = spawn_body(30.0f, 40.0f);
+    g_world_cell = 7;
+    TEST_ASSERT_TRUE(snapshot_capture(&g_snap));
+    TEST_ASSERT_TRUE(g_snap.size > 0);
+
+    // Diverge: spawn a probe, move a, destroy b, spawn c into b's slot.
+    ecs_entity_t probe = ecs_create();
+    cmp_pos[ent_index_checked(a)].x = 99.0f;
+    cmp_vel[ent_index_checked(a)].x = 0.0f;
+    ecs_destroy(b);
+    ecs_entity_t c = ecs_create();
+    g_world_cell = 0;
+
+    TEST_ASSERT_TRUE(snapshot_restore(&g_snap));
+    TEST_ASSERT_TRUE(ecs_alive_handle(a));
+    TEST_ASSERT_TRUE(ecs_alive_handle(b));
+    TEST_ASSERT_FALSE(ecs_alive_handle(c));
+    TEST_ASSERT_FALSE(ecs_alive_handle(probe));
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 10.0f, cmp_pos[a.idx].x);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 1.0f, cmp_vel[a.idx].x);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 40.0f, cmp_pos[b.idx].y);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 8.0f, cmp_col[b.idx].hx);
+    TEST_ASSERT_EQUAL_INT(7, g_world_cell);
+
+    // The free list came back too: the next create hands out exactly what the probe got.
+    ecs_entity_t d = ecs_create();
+    TEST_ASSERT_EQUAL_UINT32(probe.idx, d.idx);
+    TEST_ASSERT_EQUAL_UINT32(probe.gen, d.gen);
+}
+
+void test_snapshot_relocates_animation_tables(void)
+{
+    ecs_entity_t e = spawn_body(0.0f, 0.0f);
+    const int frames_per_anim[2] = { 2, 1 };
+    const anim_frame_coord_t frames[2 * 2] = { {0, 0}, {1, 0}, {0, 1}, {0, 0} };
+    cmp_add_anim(e, 16, 16, 2, frames_per_anim, frames, 2, 10.0f);
+    const int i = ent_index_checked(e);
+    cmp_anim[i].current_anim = 1;
+    const anim_frame_coord_t* before = cmp_anim[i].frames;
+
+    TEST_ASSERT_TRUE(snapshot_capture(&g_snap));
+    cmp_anim[i].current_anim = 0;
+    cmp_anim[i].frames = NULL;
+
+    TEST_ASSERT_TRUE(snapshot_restore(&g_snap));
+    TEST_ASSERT_EQUAL_INT(1, cmp_anim[i].current_anim);
+    TEST_ASSERT_TRUE(cmp_anim[i].frames == before);
+    TEST_ASSERT_EQUAL_INT(2, cmp_anim[i].frames_per_anim[0]);
+    TEST_ASSERT_EQUAL_INT(1, cmp_anim[i].frames[cmp_anim[i].anim_offsets[1]].row);
+}
+
+void test_snapshot_reacquires_sprite_textures_and_releases_old(void)
+{
+    ecs_entity_t e = spawn_body(0.0f, 0.0f);
+    const int i = ent_index_checked(e);
+    ecs_mask[i] |= CMP_SPR;
+    cmp_spr[i].tex = ecs_snapshot_stub_texture("assets/images/player.png");
+    TEST_ASSERT_TRUE(snapshot_capture(&g_snap));
+
+    cmp_spr[i].tex = ecs_snapshot_stub_texture("assets/images/hat.png");
+    TEST_ASSERT_TRUE(snapshot_restore(&g_snap));
+
+    TEST_ASSERT_EQUAL_INT(1, g_asset_acquire_calls);
+    TEST_ASSERT_EQUAL_STRING("assets/images/player.png", g_asset_last_path);
+    TEST_ASSERT_EQUAL_INT(1, g_asset_release_calls);
+    TEST_ASSERT_EQUAL_STRING("assets/images/player.png", asset_texture_path(cmp_spr[i].tex));
+}
+
+void test_snapshot_rejects_blob_from_another_map(void)
+{
+    ecs_entity_t e = spawn_body(5.0f, 5.0f);
+    TEST_ASSERT_TRUE(snapshot_capture(&g_snap));
+    cmp_pos[e.idx].x = 50.0f;
+
+    g_world_map_gen = 2;
+    TEST_ASSERT_FALSE(snapshot_restore(&g_snap));
+    TEST_ASSERT_EQUAL_INT(1, g_log_error_calls);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 50.0f, cmp_pos[e.idx].x);
+}
+
+void test_snapshot_rejects_truncated_blob(void)
+{
+    spawn_body(5.0f, 5.0f);
+    TEST_ASSERT_TRUE(snapshot_capture(&g_snap));
+
+    snapshot_t cut = { g_snap.data, g_snap.size - 4 };
+    TEST_ASSERT_FALSE(snapshot_restore(&cut));
+    TEST_ASSERT_EQUAL_INT(1, g_log_error_calls);
+}
+
+void test_snapshot_failed_restore_leaves_state_untouched(void)
+{
+    ecs_entity_t a = spawn_body(5.0f, 5.0f);
+    const int i = ent_index_checked(a);
+    ecs_mask[i] |= CMP_SPR;
+    cmp_spr[i].tex = ecs_snapshot_stub_texture("assets/images/player.png");
+    g_world_cell = 3;
+    TEST_ASSERT_TRUE(snapshot_capture(&g_snap));
+
+    // Diverge, then feed a blob whose ECS section parses but whose world section is cut short.
+    ecs_destroy(a);
+    ecs_entity_t b = spawn_body(70.0f, 80.0f);
+    const int j = ent_index_checked(b);
+    ecs_mask[j] |= CMP_SPR;
+    cmp_spr[j].tex = ecs_snapshot_stub_texture("assets/images/hat.png");
+    g_world_cell = 9;
+    g_asset_acquire_calls = 0;
+    g_asset_release_calls = 0;
+
+    snapshot_t cut = { g_snap.data, g_snap.size - 2 };
+    TEST_ASSERT_FALSE(snapshot_restore(&cut));
+    TEST_ASSERT_FALSE(ecs_alive_handle(a));
+    TEST_ASSERT_TRUE(ecs_alive_handle(b));
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 70.0f, cmp_pos[j].x);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 8.0f, cmp_col[j].hx);
+    TEST_ASSERT_EQUAL_INT(9, g_world_cell);
+    TEST_ASSERT_EQUAL_STRING("assets/images/hat.png", asset_texture_path(cmp_spr[j].tex));
+    // Every texture picked up on the way was handed back.
+    TEST_ASSERT_EQUAL_INT(g_asset_acquire_calls, g_asset_release_calls);
+}
+
+void test_destroy_all_then_respawn_snapshots_like_a_fresh_start(void)
+{
+    spawn_body(1.0f, 2.0f);
+    spawn_body(3.0f, 4.0f);
+    TEST_ASSERT_TRUE(snapshot_capture(&g_snap));
+
+    // Play churns slots and generations: a spawn, a destroy out of order, another spawn.
+    ecs_entity_t extra = spawn_body(9.0f, 9.0f);
+    ecs_destroy(ecs_create());
+    ecs_destroy(extra);
+    spawn_body(7.0f, 7.0f);
+
+    // A map change back to the same map has to reproduce the first capture byte for byte.
+    ecs_destroy_all();
+    spawn_body(1.0f, 2.0f);
+    spawn_body(3.0f, 4.0f);
+    snapshot_t again = {0};
+    TEST_ASSERT_TRUE(snapshot_capture(&again));
+    TEST_ASSERT_EQUAL_size_t(g_snap.size, again.size);
+    TEST_ASSERT_EQUAL_MEMORY(g_snap.data, again.data, g_snap.size);
+    snapshot_free(&again);
+}
@@ -88,8 +88,14 @@ int main(int argc, char **argv)
     Nob_File_Paths sources = {0};
     nob_da_append(&sources, "third_party/Unity/src/unity.c");
     nob_da_append(&sources, "src/modules/ecs/ecs_input_system.c");
+    nob_da_append(&sources, "src/modules/common/mem_tag.c");
     nob_da_append(&sources, "src/modules/ecs/ecs_movement_system.c");
     nob_da_append(&sources, "src/modules/ecs/ecs_physics_system.c");
+    nob_da_append(&sources, "src/modules/ecs/ecs_aabb.c");
+    nob_da_append(&sources, "src/modules/ecs/ecs_broadphase.c");
+    nob_da_append(&sources, "src/modules/core/logger.c");
+    nob_da_append(&sources, "src/modules/core/frame_alloc.c");
+    nob_da_append(&sources, "src/modules/asset/bump_alloc.c");
     nob_da_append(&sources, "tests/unit/ecs/system_domains/ecs_system_domains_stubs.c");
     nob_da_append(&sources, "tests/unit/ecs/system_domains/test_ecs_system_domains.c");
     nob_da_append(&sources, runner_path);
@@ -103,6 +103,11 @@ bool world_is_walkable_rect_px(float x, float y, float hx, float hy)
     return g_world_walkable;
 }
 
+int world_tile_size(void)
+{
+    return 16;
+}
+
 bool world_has_map(void)
 {
     return g_world_has_map;
@@ -13,6 +13,7 @@ extern bool g_world_has_los;
 extern bool g_world_walkable;
 extern int g_world_resolve_axis_calls;
 extern int g_phys_create_calls;
+extern int g_world_resolve_mtv_calls;
 
 void setUp(void)
 {
@@ -102,3 +103,162 @@ void test_sys_physics_integrate_creates_missing_body(void)
     TEST_ASSERT_EQUAL_INT(1, g_phys_create_calls);
     TEST_ASSERT_TRUE(cmp_phys_body[0].created);
 }
+
+static void setup_pushing_pair(void)
+{
+    for (int i = 0; i < 2; ++i) {
+        ecs_gen[i] = 1;
+        ecs_mask[i] = CMP_POS | CMP_VEL | CMP_COL | CMP_PHYS_BODY;
+        cmp_col[i] = (cmp_collider_t){ 4.0f, 4.0f };
+        cmp_vel[i] = (cmp_velocity_t){ 0.0f, 0.0f, {0} };
+        cmp_phys_body[i] = (cmp_phys_body_t){ .type = PHYS_DYNAMIC, .mass = 1.0f, .inv_mass = 1.0f, .created = true };
+    }
+    cmp_pos[0] = (cmp_position_t){ 0.0f, 0.0f };
+    cmp_pos[1] = (cmp_position_t){ 6.0f, 1.0f };
+    cmp_vel[0].x = 30.0f;
+}
+
+void test_sys_physics_broadphase_modes_resolve_alike(void)
+{
+    setup_pushing_pair();
+    sys_physics_integrate_impl(0.1f);
+    const cmp_position_t ref0 = cmp_pos[0];
+    const cmp_position_t ref1 = cmp_pos[1];
+    TEST_ASSERT_TRUE(cmp_pos[1].x - cmp_pos[0].x >= 8.0f - 0.001f);
+
+    for (int k = ECS_BROADPHASE_GRID; k < ECS_BROADPHASE_COUNT; ++k) {
+        ecs_physics_set_broadphase((ecs_broadphase_kind_t)k);
+        setup_pushing_pair();
+        sys_physics_integrate_impl(0.1f);
+        TEST_ASSERT_FLOAT_WITHIN(0.0001f, ref0.x, cmp_pos[0].x);
+        TEST_ASSERT_FLOAT_WITHIN(0.0001f, ref0.y, cmp_pos[0].y);
+        TEST_ASSERT_FLOAT_WITHIN(0.0001f, ref1.x, cmp_pos[1].x);
+        TEST_ASSERT_FLOAT_WITHIN(0.0001f, ref1.y, cmp_pos[1].y);
+    }
+    ecs_physics_set_broadphase(ECS_BROADPHASE_ALL_PAIRS);
+}
+
+static void setup_resting_body(int i, float x, float y)
+{
+    ecs_gen[i] = 1;
+    ecs_mask[i] = CMP_POS | CMP_VEL | CMP_COL | CMP_PHYS_BODY;
+    cmp_pos[i] = (cmp_position_t){ x, y };
+    cmp_vel[i] = (cmp_velocity_t){ 0.0f, 0.0f, {0} };
+    cmp_col[i] = (cmp_collider_t){ 4.0f, 4.0f };
+    cmp_phys_body[i] = (cmp_phys_body_t){ .type = PHYS_DYNAMIC, .mass = 1.0f, .inv_mass = 1.0f, .created = true,
+                                          .rest_x = x, .rest_y = y };
+}
+
+void test_sys_physics_resting_body_sleeps_and_skips_tiles(void)
+{
+    setup_resting_body(0, 0.0f, 0.0f);
+
+    for (int t = 0; t < PHYS_SLEEP_TICKS - 1; ++t) sys_physics_integrate_impl(0.1f);
+    TEST_ASSERT_FALSE(cmp_phys_body[0].sleeping);
+    sys_physics_integrate_impl(0.1f);
+    TEST_ASSERT_TRUE(cmp_phys_body[0].sleeping);
+
+    g_world_resolve_mtv_calls = 0;
+    sys_physics_integrate_impl(0.1f);
+    TEST_ASSERT_EQUAL_INT(0, g_world_resolve_mtv_calls);
+}
+
+void test_sys_physics_contact_wakes_sleeping_body(void)
+{
+    setup_resting_body(0, 0.0f, 0.0f);
+    setup_resting_body(1, 6.0f, 1.0f);
+    cmp_phys_body[1].sleeping = true;
+    cmp_vel[0].x = 30.0f;
+
+    sys_physics_integrate_impl(0.1f);
+
+    TEST_ASSERT_FALSE(cmp_phys_body[1].sleeping);
+    TEST_ASSERT_TRUE(cmp_pos[1].x - cmp_pos[0].x >= 8.0f - 0.001f);
+}
+
+void test_sys_physics_sleeping_pair_is_not_resolved(void)
+{
+    setup_resting_body(0, 0.0f, 0.0f);
+    setup_resting_body(1, 6.0f, 1.0f);
+    cmp_phys_body[0].sleeping = true;
+    cmp_phys_body[1].sleeping = true;
+
+    sys_physics_integrate_impl(0.1f);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 0.0f, cmp_pos[0].x);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 6.0f, cmp_pos[1].x);
+    TEST_ASSERT_TRUE(cmp_phys_body[0].sleeping);
+    TEST_ASSERT_TRUE(cmp_phys_body[1].sleeping);
+}
+
+void test_sys_physics_external_move_wakes_sleeping_body(void)
+{
+    setup_resting_body(0, 0.0f, 0.0f);
+    cmp_phys_body[0].sleeping = true;
+    cmp_phys_body[0].quiet_ticks = PHYS_SLEEP_TICKS;
+    cmp_pos[0].x = 20.0f;
+
+    g_world_resolve_mtv_calls = 0;
+    sys_physics_integrate_impl(0.1f);
+
+    TEST_ASSERT_FALSE(cmp_phys_body[0].sleeping);
+    TEST_ASSERT_TRUE(g_world_resolve_mtv_calls > 0);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 20.0f, cmp_phys_body[0].rest_x);
+}
+
+void test_sys_physics_door_closing_on_sleeping_body_wakes_it(void)
+{
+    setup_resting_body(0, 28.0f, 20.0f);  // x 24..32, y 16..24: tile (1,1) only (16px tiles)
+    setup_resting_body(1, 60.0f, 20.0f);
+    cmp_phys_body[0].sleeping = true;
+    cmp_phys_body[1].sleeping = true;
+
+    // Tile (2,1) only touches its right edge.
+    ecs_phys_wake_bodies_on_tile(NULL, 2, 1);
+    TEST_ASSERT_TRUE(cmp_phys_body[0].sleeping);
+    ecs_phys_wake_bodies_on_tile(NULL, 1, 1);
+    TEST_ASSERT_FALSE(cmp_phys_body[0].sleeping);
+    TEST_ASSERT_TRUE(cmp_phys_body[1].sleeping);
+
+    g_world_resolve_mtv_calls = 0;
+    sys_physics_integrate_impl(0.1f);
+    TEST_ASSERT_EQUAL_INT(1, g_world_resolve_mtv_calls);
+}
+
+void test_sys_physics_solver_stops_early_when_settled(void)
+{
+    setup_resting_body(0, 0.0f, 0.0f);
+
+    sys_physics_integrate_impl(0.1f);
+
+    ecs_phys_solver_stats_t stats = ecs_physics_solver_stats();
+    TEST_ASSERT_EQUAL_INT(1, stats.iterations);
+    TEST_ASSERT_EQUAL_INT(0, stats.contacts);
+    TEST_ASSERT_EQUAL_INT(0, stats.pair_resolves);
+}
+
+void test_sys_physics_solver_caches_contacts_and_respects_cap(void)
+{
+    setup_pushing_pair();
+    sys_physics_integrate_impl(0.1f);
+
+    ecs_phys_solver_stats_t stats = ecs_physics_solver_stats();
+    TEST_ASSERT_EQUAL_INT(1, stats.contacts);
+    TEST_ASSERT_TRUE(stats.iterations >= 2);
+    TEST_ASSERT_TRUE(stats.iterations <= PHYS_SOLVER_DEFAULT_ITERATIONS);
+    TEST_ASSERT_TRUE(stats.max_correction < 0.01f);
+
+    ecs_physics_set_solver_iterations(1);
+    TEST_ASSERT_EQUAL_INT(1, ecs_physics_solver_iterations());
+    setup_pushing_pair();
+    sys_physics_integrate_impl(0.1f);
+    stats = ecs_physics_solver_stats();
+    TEST_ASSERT_EQUAL_INT(1, stats.iterations);
+    TEST_ASSERT_EQUAL_INT(1, stats.pair_resolves);
+
+    ecs_physics_set_solver_iterations(0);
+    TEST_ASSERT_EQUAL_INT(1, ecs_physics_solver_iterations());
+    ecs_physics_set_solver_iterations(PHYS_SOLVER_MAX_ITERATIONS + 5);
+    TEST_ASSERT_EQUAL_INT(PHYS_SOLVER_MAX_ITERATIONS, ecs_physics_solver_iterations());
+    ecs_physics_set_solver_iterations(PHYS_SOLVER_DEFAULT_ITERATIONS);
+}
@@ -1,5 +1,6 @@
 #include "unity.h"
 
+#include <stdio.h>
 #include <string.h>
 
 #include "modules/systems/systems.h"
@@ -18,6 +19,17 @@ static void sys_a(float dt, const input_t* in) { (void)dt; (void)in; record_call
 static void sys_b(float dt, const input_t* in) { (void)dt; (void)in; record_call(2); }
 static void sys_c(float dt, const input_t* in) { (void)dt; (void)in; record_call(3); }
 
+// Fake clock for the profiler: each system call advances it by g_fake_step seconds.
+static double g_fake_now = 0.0;
+static double g_fake_step = 0.0;
+
+double time_now(void)
+{
+    return g_fake_now;
+}
+
+static void sys_timed(float dt, const input_t* in) { (void)dt; (void)in; g_fake_now += g_fake_step; }
+
 void test_ecs_systems_run_phase_orders_by_order_field(void)
 {
     systems_init();
@@ -66,3 +78,81 @@ void test_ecs_systems_caps_system_count(void)
     size_t n = systems_get_phase_systems(PHASE_INPUT, &list);
     TEST_ASSERT_TRUE(n <= 64);
 }
+
+void test_ecs_systems_profile_reports_min_mean_p99_max(void)
+{
+    systems_init();
+    systems_register(PHASE_PHYSICS, 10, sys_timed, "timed");
+    systems_register(PHASE_SIM_PRE, 10, sys_a, "a");
+
+    // 99 calls at 1ms, then one at 10ms.
+    for (int i = 0; i < 100; ++i) {
+        g_fake_step = (i == 99) ? 0.010 : 0.001;
+        systems_run_phase(PHASE_PHYSICS, 0.0f, NULL);
+    }
+
+    systems_profile_stats_t stats[4];
+    size_t n = systems_profile_stats(stats, 4);
+    TEST_ASSERT_EQUAL_UINT32(2, (uint32_t)n);
+    // Run order: SIM_PRE before PHYSICS.
+    TEST_ASSERT_EQUAL_STRING("a", stats[0].name);
+    TEST_ASSERT_EQUAL_INT(0, stats[0].samples);
+    TEST_ASSERT_EQUAL_STRING("timed", stats[1].name);
+    TEST_ASSERT_EQUAL_INT(100, stats[1].samples);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 1.0f, stats[1].min_ms);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 1.09f, stats[1].mean_ms);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 1.0f, stats[1].p99_ms);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 10.0f, stats[1].max_ms);
+    TEST_ASSERT_EQUAL_INT(100, (int)stats[1].calls);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 109.0, stats[1].total_ms);
+}
+
+void test_ecs_systems_profile_ring_keeps_last_calls(void)
+{
+    systems_init();
+    systems_register(PHASE_PHYSICS, 10, sys_timed, "timed");
+
+    g_fake_step = 0.005;
+    for (int i = 0; i < SYSTEMS_PROFILE_RING; ++i) systems_run_phase(PHASE_PHYSICS, 0.0f, NULL);
+    g_fake_step = 0.002;
+    for (int i = 0; i < SYSTEMS_PROFILE_RING; ++i) systems_run_phase(PHASE_PHYSICS, 0.0f, NULL);
+
+    systems_profile_stats_t st;
+    TEST_ASSERT_EQUAL_UINT32(1, (uint32_t)systems_profile_stats(&st, 1));
+    TEST_ASSERT_EQUAL_INT(SYSTEMS_PROFILE_RING, st.samples);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 2.0f, st.max_ms);
+
+    TEST_ASSERT_EQUAL_INT(2 * SYSTEMS_PROFILE_RING, (int)st.calls);
+
+    systems_profile_reset();
+    TEST_ASSERT_EQUAL_UINT32(1, (uint32_t)systems_profile_stats(&st, 1));
+    TEST_ASSERT_EQUAL_INT(0, st.samples);
+    TEST_ASSERT_EQUAL_INT(0, (int)st.calls);
+
+    systems_profile_set_enabled(false);
+    systems_run_phase(PHASE_PHYSICS, 0.0f, NULL);
+    systems_profile_set_enabled(true);
+    TEST_ASSERT_EQUAL_UINT32(1, (uint32_t)systems_profile_stats(&st, 1));
+    TEST_ASSERT_EQUAL_INT(0, st.samples);
+}
+
+void test_ecs_systems_profile_writes_csv(void)
+{
+    systems_init();
+    systems_register(PHASE_PHYSICS, 10, sys_timed, "timed");
+    g_fake_step = 0.001;
+    systems_run_phase(PHASE_PHYSICS, 0.0f, NULL);
+
+    const char* path = "build/tests/systems_profile_test.csv";
+    TEST_ASSERT_TRUE(systems_profile_write_csv(path));
+
+    FILE* f = fopen(path, "r");
+    TEST_ASSERT_NOT_NULL(f);
+    char line[128];
+    TEST_ASSERT_NOT_NULL(fgets(line, sizeof(line), f));
+    TEST_ASSERT_EQUAL_STRING("phase,system,samples,min_ms,mean_ms,p99_ms,max_ms\n", line);
+    TEST_ASSERT_NOT_NULL(fgets(line, sizeof(line), f));
+    TEST_ASSERT_EQUAL_STRING("2,timed,1,1.0000,1.0000,1.0000,1.0000\n", line);
+    fclose(f);
+    remove(path);
+}
@@ -90,6 +90,9 @@ int main(int argc, char **argv)
     Nob_File_Paths sources = {0};
     nob_da_append(&sources, "third_party/Unity/src/unity.c");
     nob_da_append(&sources, "src/modules/core/logger.c");
+    nob_da_append(&sources, "src/modules/common/mem_tag.c");
+    nob_da_append(&sources, "src/modules/common/atom.c");
+    nob_da_append(&sources, "src/modules/common/parallel.c");
     nob_da_append(&sources, "src/modules/asset/bump_alloc.c");
     nob_da_append(&sources, "src/modules/tiled/tiled.c");
     nob_da_append(&sources, "src/modules/tiled/tiled_layers.c");
@@ -116,7 +119,7 @@ int main(int argc, char **argv)
         nob_sb_appendf(&link, "%s -shared ", cc);
         sb_append_paths(&link, &objs);
         if (coverage) nob_sb_append_cstr(&link, "--coverage ");
-        nob_sb_append_cstr(&link, "-o build/tests/plugins/tests_tiled.so -lm");
+        nob_sb_append_cstr(&link, "-o build/tests/plugins/tests_tiled.so -lm -lpthread");
         nob_sb_append_null(&link);
         nob_cmd_append(&cmd, "sh", "-lc", link.items);
         if (!nob_cmd_run_sync_and_reset(&cmd)) return 1;
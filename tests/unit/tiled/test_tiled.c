@@ -257,6 +257,8 @@ void test_tiled_load_map_inline_tileset_and_chunked_layer(void)
     TEST_ASSERT_EQUAL_INT(100, ts0->anims[0].frames[0].duration_ms);
     TEST_ASSERT_EQUAL_INT(2, ts0->anims[0].frames[1].tile_id);
     TEST_ASSERT_EQUAL_INT(0, ts0->anims[0].frames[1].duration_ms);
+    TEST_ASSERT_EQUAL_INT(100, ts0->anims[0].frames[0].end_ms);
+    TEST_ASSERT_EQUAL_INT(100, ts0->anims[0].frames[1].end_ms);
 
     // Door/no-merge and painter flags propagate to frame tiles.
     TEST_ASSERT_TRUE(ts0->no_merge_collider[1]);
@@ -320,6 +322,60 @@ void test_tiled_object_properties_and_helpers(void)
     tiled_free_map(&map);
 }
 
+void test_tiled_indexes_many_properties_and_tileset_gids(void)
+{
+    char dir[128], tmx[160], tsx[160], png[160];
+    setup_tiled_fixture_paths(dir, sizeof(dir), tmx, sizeof(tmx), tsx, sizeof(tsx), png, sizeof(png));
+
+    write_text_file(png, "x");
+    write_text_file(tsx,
+        "<tileset name=\"t\" tilewidth=\"32\" tileheight=\"32\" tilecount=\"4\" columns=\"2\">"
+        "<image source=\"tiles.png\" width=\"64\" height=\"64\"/></tileset>"
+    );
+
+    // Enough properties for the hashed lookup, including a duplicate name.
+    write_text_file(tmx,
+        "<map width=\"1\" height=\"1\" tilewidth=\"32\" tileheight=\"32\">"
+        "<tileset firstgid=\"1\" source=\"tiles.tsx\"/>"
+        "<tileset firstgid=\"5\" source=\"tiles.tsx\"/>"
+        "<layer name=\"L\" width=\"1\" height=\"1\"><data>0</data></layer>"
+        "<objectgroup name=\"entities\">"
+        "  <object id=\"1\" x=\"0\" y=\"0\">"
+        "    <properties>"
+        "      <property name=\"p0\" value=\"a\"/><property name=\"p1\" value=\"b\"/>"
+        "      <property name=\"p2\" value=\"c\"/><property name=\"p3\" value=\"d\"/>"
+        "      <property name=\"p4\" value=\"e\"/><property name=\"p5\" value=\"f\"/>"
+        "      <property name=\"Target_Map\" value=\"first\"/><property name=\"target_map\" value=\"second\"/>"
+        "    </properties>"
+        "  </object>"
+        "</objectgroup>"
+        "</map>"
+    );
+
+    world_map_t map = {0};
+    TEST_ASSERT_TRUE(tiled_load_map(tmx, &map));
+    const tiled_object_t *o = &map.objects[0];
+    TEST_ASSERT_EQUAL_size_t(8, o->property_count);
+    TEST_ASSERT_NOT_NULL(o->prop_keys);
+    for (size_t i = 1; i < o->property_count; ++i) {
+        TEST_ASSERT_TRUE(o->prop_keys[i - 1].atom <= o->prop_keys[i].atom);
+    }
+    TEST_ASSERT_EQUAL_UINT32(o->properties[6].atom, o->properties[7].atom);
+    TEST_ASSERT_EQUAL_STRING("c", tiled_object_get_property_value_atom(o, atom_find_ci("p2")));
+    TEST_ASSERT_NULL(tiled_object_get_scoped_value(o, "target", "map"));
+    TEST_ASSERT_EQUAL_STRING("d", tiled_object_get_scoped_value(o, "none", "P3"));
+    TEST_ASSERT_EQUAL_STRING("f", tiled_object_get_property_value(o, "P5"));
+    TEST_ASSERT_EQUAL_STRING("first", tiled_object_get_property_value(o, "TARGET_MAP"));
+    TEST_ASSERT_NULL(tiled_object_get_property_value(o, "p6"));
+
+    TEST_ASSERT_EQUAL_size_t(8, map.gid_tilesets.size);
+    TEST_ASSERT_EQUAL_UINT32(0, *tiled_gid_index_get(&map.gid_tilesets, 4));
+    TEST_ASSERT_EQUAL_UINT32(1, *tiled_gid_index_get(&map.gid_tilesets, 5));
+    TEST_ASSERT_NULL(tiled_gid_index_get(&map.gid_tilesets, 9));
+
+    tiled_free_map(&map);
+}
+
 void test_tiled_normalizes_relative_tsx_paths_and_parses_empty_bool_property(void)
 {
     char dir[128], tmx[160], tsx[160], png[160];
@@ -454,3 +510,38 @@ void test_tiled_tsx_scan_attr_in_file_fallback_for_missing_image_source(void)
     TEST_ASSERT_TRUE(strstr(map.tilesets[0].image_path, "tiles.png") != NULL);
     tiled_free_map(&map);
 }
+
+// The linear walks the frame searches replaced, kept here as the reference.
+static size_t anim_frame_linear(const tiled_animation_t* a, double t, bool forward)
+{
+    int acc = 0;
+    if (forward) {
+        for (size_t i = 0; i < a->frame_count; ++i) {
+            acc += a->frames[i].duration_ms;
+            if (t < acc) return i;
+        }
+        return a->frame_count - 1;
+    }
+    for (size_t i = a->frame_count; i-- > 0; ) {
+        acc += a->frames[i].duration_ms;
+        if (t < acc) return i;
+    }
+    return 0;
+}
+
+void test_tiled_anim_frame_search_matches_linear_walk(void)
+{
+    tiled_anim_frame_t frames[6] = {
+        { .tile_id = 10, .duration_ms = 100 }, { .tile_id = 11, .duration_ms = 0 },
+        { .tile_id = 12, .duration_ms = 50 },  { .tile_id = 13, .duration_ms = 0 },
+        { .tile_id = 14, .duration_ms = 0 },   { .tile_id = 15, .duration_ms = 250 },
+    };
+    int total = 0;
+    for (size_t i = 0; i < 6; ++i) frames[i].end_ms = (total += frames[i].duration_ms);
+    const tiled_animation_t anim = { .frames = frames, .frame_count = 6, .total_duration_ms = total };
+
+    for (double t = -10.0; t <= total + 10.0; t += 0.5) {
+        TEST_ASSERT_EQUAL_size_t(anim_frame_linear(&anim, t, true), tiled_anim_frame_at(&anim, t));
+        TEST_ASSERT_EQUAL_size_t(anim_frame_linear(&anim, t, false), tiled_anim_frame_at_reversed(&anim, t));
+    }
+}
@@ -71,6 +71,7 @@ int main(int argc, char **argv)
     nob_da_append(&test_sources, "tests/unit/world/test_world_collision_slide.c");
     nob_da_append(&test_sources, "tests/unit/world/test_world_collision_decode.c");
     nob_da_append(&test_sources, "tests/unit/world/test_world_collision_grid.c");
+    nob_da_append(&test_sources, "tests/unit/world/test_world_stream.c");
 
     const char *runner_path = "build/tests/gen/tests_world_runner.c";
     if (!generate_unity_runner("world", &test_sources, runner_path)) return 1;
@@ -93,6 +94,9 @@ int main(int argc, char **argv)
     Nob_File_Paths sources = {0};
     nob_da_append(&sources, "third_party/Unity/src/unity.c");
     nob_da_append(&sources, "src/modules/core/logger.c");
+    nob_da_append(&sources, "src/modules/common/mem_tag.c");
+    nob_da_append(&sources, "src/modules/common/atom.c");
+    nob_da_append(&sources, "src/modules/common/parallel.c");
     nob_da_append(&sources, "src/modules/asset/bump_alloc.c");
     nob_da_append(&sources, "src/modules/tiled/tiled.c");
     nob_da_append(&sources, "src/modules/tiled/tiled_layers.c");
@@ -103,11 +107,14 @@ int main(int argc, char **argv)
     nob_da_append(&sources, "src/modules/world/world_collision.c");
     nob_da_append(&sources, "src/modules/world/world_door.c");
     nob_da_append(&sources, "src/modules/world/world_map.c");
+    nob_da_append(&sources, "src/modules/world/world_stream.c");
+    nob_da_append(&sources, "src/modules/common/path_util.c");
     nob_da_append(&sources, "tests/unit/stubs/test_log_sink.c");
     nob_da_append(&sources, "tests/unit/world/test_world_map_edits.c");
     nob_da_append(&sources, "tests/unit/world/test_world_collision_slide.c");
     nob_da_append(&sources, "tests/unit/world/test_world_collision_decode.c");
     nob_da_append(&sources, "tests/unit/world/test_world_collision_grid.c");
+    nob_da_append(&sources, "tests/unit/world/test_world_stream.c");
     nob_da_append(&sources, runner_path);
 
     Nob_File_Paths objs = {0};
@@ -125,7 +132,7 @@ int main(int argc, char **argv)
         nob_sb_appendf(&link, "%s -shared ", cc);
         sb_append_paths(&link, &objs);
         if (coverage) nob_sb_append_cstr(&link, "--coverage ");
-        nob_sb_append_cstr(&link, "-o build/tests/plugins/tests_world.so -lm");
+        nob_sb_append_cstr(&link, "-o build/tests/plugins/tests_world.so -lm -lpthread");
         nob_sb_append_null(&link);
         nob_cmd_append(&cmd, "sh", "-lc", link.items);
         if (!nob_cmd_run_sync_and_reset(&cmd)) return 1;
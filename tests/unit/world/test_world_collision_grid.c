@@ -242,3 +242,71 @@ void test_world_collision_build_from_map_ignores_non_collision_layers(void)
     world_collision_shutdown();
     free(layer.gids);
 }
+
+void test_world_collision_banded_build_matches_per_tile_decode(void)
+{
+    // Taller than one build band (16 rows) with a partial last band, flipped gids, a dynamic
+    // tile, and a second tileset overlapping the first one's gids 3..4 (the first must win).
+    enum { W = 9, H = 37 };
+    uint16_t colliders_a[4] = { 0x0001, 0x00F0, 0xFFFF, 0x1234 };
+    bool no_merge_a[4] = { false, true, false, false };
+    uint16_t colliders_b[3] = { 0x8001, 0x0F0F, 0xFFFF };
+    bool no_merge_b[3] = { true, false, false };
+    tiled_tileset_t tilesets[2] = {0};
+    tilesets[0].first_gid = 1;
+    tilesets[0].tilecount = 4;
+    tilesets[0].colliders = colliders_a;
+    tilesets[0].no_merge_collider = no_merge_a;
+    tilesets[1].first_gid = 3;
+    tilesets[1].tilecount = 3;
+    tilesets[1].colliders = colliders_b;
+    tilesets[1].no_merge_collider = no_merge_b;
+
+    const uint32_t flips[4] = {
+        0u,
+        TILED_FLIPPED_HORIZONTALLY_FLAG,
+        TILED_FLIPPED_VERTICALLY_FLAG,
+        TILED_FLIPPED_HORIZONTALLY_FLAG | TILED_FLIPPED_VERTICALLY_FLAG,
+    };
+    tiled_layer_t layers[2] = {0};
+    layers[0].name = "walls";
+    layers[1].name = "decor"; // not a collision layer; never consulted
+    for (int l = 0; l < 2; ++l) {
+        layers[l].width = W;
+        layers[l].height = H;
+        layers[l].gids = (uint32_t*)calloc(W * H, sizeof(uint32_t));
+        TEST_ASSERT_NOT_NULL(layers[l].gids);
+    }
+    for (int y = 0; y < H; ++y) {
+        for (int x = 0; x < W; ++x) {
+            const uint32_t gid = (uint32_t)((x + 3 * y) % 7); // 0 = empty, 6 = no tileset
+            layers[0].gids[y * W + x] = gid ? gid | flips[(x + y) % 4] : 0u;
+            layers[1].gids[y * W + x] = 3u;
+        }
+    }
+    world_map_t map = make_min_map(W, H, tilesets, 2, layers, 2);
+
+    TEST_ASSERT_TRUE(world_collision_build_from_map(&map, "walls"));
+    for (int y = 0; y < H; ++y) {
+        for (int x = 0; x < W; ++x) {
+            uint16_t mask = 0;
+            bool dyn = false;
+            world_collision_decode_raw_gid(&map, layers[0].gids[y * W + x], &mask, &dyn);
+            TEST_ASSERT_EQUAL_UINT16(mask, world_subtile_mask_at(x, y));
+            TEST_ASSERT_EQUAL_INT(dyn, world_tile_is_dynamic(x, y));
+            TEST_ASSERT_EQUAL_INT(mask == 0xFFFF ? WORLD_TILE_SOLID : WORLD_TILE_WALKABLE, world_tile_at(x, y));
+        }
+    }
+
+    // Cell (x, y) holds gid (x + 3y) % 7 with flip (x + y) % 4.
+    TEST_ASSERT_EQUAL_UINT16(0x1234, world_subtile_mask_at(4, 0)); // gid 4 from tileset A, not B
+    TEST_ASSERT_FALSE(world_tile_is_dynamic(4, 0));
+    TEST_ASSERT_EQUAL_UINT16(0x0F00, world_subtile_mask_at(2, 0)); // gid 2 flipped vertically
+    TEST_ASSERT_TRUE(world_tile_is_dynamic(2, 0));
+    TEST_ASSERT_EQUAL_INT(WORLD_TILE_SOLID, world_tile_at(5, 0));  // gid 5 only in tileset B
+    TEST_ASSERT_EQUAL_UINT16(0, world_subtile_mask_at(6, 0));      // gid 6: no tileset
+    TEST_ASSERT_EQUAL_UINT16(0x0008, world_subtile_mask_at(5, 36)); // gid 1 flipped H, last band
+
+    world_collision_shutdown();
+    for (int l = 0; l < 2; ++l) free(layers[l].gids);
+}
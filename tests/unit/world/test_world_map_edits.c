@@ -198,6 +198,42 @@ void test_world_apply_tile_edits_refreshes_collision_only_for_collision_layers(v
     world_shutdown();
 }
 
+static int g_edit_tile_at_call;
+
+static void record_tile_edit(void* user, int tx, int ty)
+{
+    (*(int*)user)++;
+    g_edit_tile_at_call = world_tile_at(tx, ty);
+}
+
+void test_world_apply_tile_edits_notifies_listener_for_collision_layers(void)
+{
+    ensure_clean_world();
+
+    const char* full = "[1111],[1111],[1111],[1111]";
+    TEST_ASSERT_TRUE(write_world_testdata(true, 0u, 0u, false, full));
+    TEST_ASSERT_TRUE(world_load_from_tmx("build/testdata/world_map/map.tmx", NULL));
+    int calls = 0;
+    world_set_tile_edit_listener(record_tile_edit, &calls);
+
+    TEST_ASSERT_TRUE(world_set_tile_gid(1, 0, 0, 1u));
+    world_apply_tile_edits();
+    TEST_ASSERT_EQUAL_INT(0, calls);
+
+    // A door closing: the cell is already solid by the time the listener hears about it.
+    TEST_ASSERT_TRUE(world_set_tile_gid(0, 0, 0, 1u));
+    world_apply_tile_edits();
+    TEST_ASSERT_EQUAL_INT(1, calls);
+    TEST_ASSERT_EQUAL_INT(WORLD_TILE_SOLID, g_edit_tile_at_call);
+
+    world_set_tile_edit_listener(NULL, NULL);
+    TEST_ASSERT_TRUE(world_set_tile_gid(0, 0, 0, 0u));
+    world_apply_tile_edits();
+    TEST_ASSERT_EQUAL_INT(1, calls);
+
+    world_shutdown();
+}
+
 void test_world_apply_tile_edits_is_safe_when_unloaded(void)
 {
     ensure_clean_world();
@@ -219,3 +255,20 @@ void test_world_load_from_tmx_fails_for_missing_file_and_preserves_state(void)
     TEST_ASSERT_EQUAL_UINT32(g0, world_map_generation());
     TEST_ASSERT_NULL(world_get_map());
 }
+
+void test_world_reload_tileset_refreshes_collision_from_tsx(void)
+{
+    ensure_clean_world();
+
+    TEST_ASSERT_TRUE(write_world_testdata(false, 1u, 0u, false, "[0000],[0000],[0000],[0000]"));
+    TEST_ASSERT_TRUE(world_load_from_tmx("build/testdata/world_map/map.tmx", NULL));
+    TEST_ASSERT_EQUAL_INT(WORLD_TILE_WALKABLE, world_tile_at(0, 0));
+
+    TEST_ASSERT_TRUE(write_test_tileset("build/testdata/world_map/tiles.tsx", "[1111],[1111],[1111],[1111]"));
+    TEST_ASSERT_TRUE(world_reload_tileset("build/testdata/world_map/../world_map/tiles.tsx"));
+    TEST_ASSERT_EQUAL_INT(WORLD_TILE_SOLID, world_tile_at(0, 0));
+
+    TEST_ASSERT_FALSE(world_reload_tileset("build/testdata/world_map/other.tsx"));
+
+    world_shutdown();
+}
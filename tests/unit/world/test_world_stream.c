@@ -0,0 +1,276 @@
+#include "unity.h"
+
+#include "modules/core/build_config.h"
+#include "modules/world/world.h"
+#include "modules/world/world_door.h"
+#include "modules/world/world_renderer.h"
+#include "modules/world/world_stream.h"
+#include "test_log_sink.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+
+#define STREAM_MAP_W 256
+#define STREAM_MAP_H 96
+
+typedef struct {
+    int activated;
+    int deactivated;
+    int last_tx0, last_ty0, last_tx1, last_ty1;
+} chunk_log_t;
+
+static bool ensure_dir(const char* path)
+{
+    if (mkdir(path, 0755) == 0) return true;
+    return errno == EEXIST;
+}
+
+// gid 1 (tile 0) is solid, gid 2 (tile 1) is open and animates 1 -> 0 like a door.
+static bool write_stream_tileset(const char* path)
+{
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+    fprintf(f,
+        "<tileset name=\"stream\" tilewidth=\"%d\" tileheight=\"%d\" tilecount=\"2\" columns=\"2\">"
+        "<image source=\"tiles.png\" width=\"%d\" height=\"%d\"/>"
+        "<tile id=\"0\"><properties><property name=\"collider\" value=\"[1111],[1111],[1111],[1111]\"/></properties></tile>"
+        "<tile id=\"1\"><properties><property name=\"collider\" value=\"[0000],[0000],[0000],[0000]\"/></properties>"
+        "<animation><frame tileid=\"1\" duration=\"100\"/><frame tileid=\"0\" duration=\"100\"/></animation></tile>"
+        "</tileset>",
+        world_tile_size(), world_tile_size(), world_tile_size() * 2, world_tile_size());
+    fclose(f);
+    return true;
+}
+
+static uint32_t pattern_gid(int x, int y)
+{
+    return (x % 5 == 0 || y % 7 == 0) ? 1u : 2u;
+}
+
+static bool write_stream_map(const char* path)
+{
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+    fprintf(f,
+        "<map width=\"%d\" height=\"%d\" tilewidth=\"%d\" tileheight=\"%d\">"
+        "<tileset firstgid=\"1\" source=\"tiles.tsx\"/>"
+        "<layer name=\"ground\" width=\"%d\" height=\"%d\">"
+        "<properties><property name=\"collision\" value=\"true\"/></properties>"
+        "<data encoding=\"csv\">",
+        STREAM_MAP_W, STREAM_MAP_H, world_tile_size(), world_tile_size(), STREAM_MAP_W, STREAM_MAP_H);
+    for (int y = 0; y < STREAM_MAP_H; ++y) {
+        for (int x = 0; x < STREAM_MAP_W; ++x) {
+            const bool last = (x == STREAM_MAP_W - 1 && y == STREAM_MAP_H - 1);
+            fprintf(f, "%u%s", (unsigned)pattern_gid(x, y), last ? "" : ",");
+        }
+        fputc('\n', f);
+    }
+    fputs("</data></layer></map>", f);
+    fclose(f);
+    return true;
+}
+
+// Infinite-style layer: two 16x16 <chunk>s, everything else empty.
+static bool write_stream_chunked_map(const char* path)
+{
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+    fprintf(f,
+        "<map width=\"64\" height=\"64\" tilewidth=\"%d\" tileheight=\"%d\">"
+        "<tileset firstgid=\"1\" source=\"tiles.tsx\"/>"
+        "<layer name=\"ground\" width=\"64\" height=\"64\">"
+        "<properties><property name=\"collision\" value=\"true\"/></properties>"
+        "<data encoding=\"csv\">",
+        world_tile_size(), world_tile_size());
+    const int origins[2][2] = { { 16, 0 }, { 32, 48 } };
+    for (int c = 0; c < 2; ++c) {
+        fprintf(f, "<chunk x=\"%d\" y=\"%d\" width=\"16\" height=\"16\">", origins[c][0], origins[c][1]);
+        for (int i = 0; i < 16 * 16; ++i) fprintf(f, "%u%s", c == 0 ? 1u : 2u, i == 16 * 16 - 1 ? "" : ",");
+        fputs("</chunk>", f);
+    }
+    fputs("</data></layer></map>", f);
+    fclose(f);
+    return true;
+}
+
+static bool write_stream_testdata(bool chunked)
+{
+    if (!ensure_dir("build")) return false;
+    if (!ensure_dir("build/testdata")) return false;
+    if (!ensure_dir("build/testdata/world_stream")) return false;
+    if (!write_stream_tileset("build/testdata/world_stream/tiles.tsx")) return false;
+    return chunked ? write_stream_chunked_map("build/testdata/world_stream/map.tmx")
+                   : write_stream_map("build/testdata/world_stream/map.tmx");
+}
+
+static void record_chunk(void* user, int tx0, int ty0, int tx1, int ty1, bool active)
+{
+    chunk_log_t* log = (chunk_log_t*)user;
+    if (active) log->activated++;
+    else        log->deactivated++;
+    log->last_tx0 = tx0;
+    log->last_ty0 = ty0;
+    log->last_tx1 = tx1;
+    log->last_ty1 = ty1;
+}
+
+// Focus in the middle of chunk (cx, cy).
+static v2f chunk_center_px(int cx, int cy)
+{
+    const float chunk_px = (float)(WORLD_CHUNK_TILES * world_tile_size());
+    return v2f_make(((float)cx + 0.5f) * chunk_px, ((float)cy + 0.5f) * chunk_px);
+}
+
+static void stream_to(v2f focus, chunk_log_t* log)
+{
+    world_stream_update(&focus, 1, record_chunk, log);
+    world_stream_wait_idle();
+    world_stream_update(&focus, 1, record_chunk, log);
+}
+
+static bool load_streamed(bool chunked)
+{
+    world_shutdown();
+    if (!write_stream_testdata(chunked)) return false;
+    world_set_stream_min_tiles(1);
+    return world_load_from_tmx("build/testdata/world_stream/map.tmx", NULL);
+}
+
+void tearDown(void)
+{
+    world_shutdown();
+    world_set_stream_min_tiles(WORLD_STREAM_MIN_TILES);
+}
+
+void test_world_stream_small_maps_stay_dense(void)
+{
+    world_shutdown();
+    TEST_ASSERT_TRUE(write_stream_testdata(false));
+    world_set_stream_min_tiles(WORLD_STREAM_MIN_TILES);
+    TEST_ASSERT_TRUE(world_load_from_tmx("build/testdata/world_stream/map.tmx", NULL));
+
+    TEST_ASSERT_FALSE(world_stream_active());
+    TEST_ASSERT_NOT_NULL(world_get_map()->layers[0].gids);
+    TEST_ASSERT_EQUAL_UINT32(pattern_gid(200, 90), world_layer_gid(0, 200, 90));
+}
+
+void test_world_stream_loads_chunks_around_focus_only(void)
+{
+    TEST_ASSERT_TRUE(load_streamed(false));
+    TEST_ASSERT_TRUE(world_stream_active());
+    TEST_ASSERT_NULL(world_get_map()->layers[0].gids);
+
+    int w = 0, h = 0;
+    world_size_tiles(&w, &h);
+    TEST_ASSERT_EQUAL_INT(STREAM_MAP_W, w);
+    TEST_ASSERT_EQUAL_INT(STREAM_MAP_H, h);
+
+    // Nothing resident before the first update: in-bounds tiles read as holes.
+    TEST_ASSERT_EQUAL_UINT32(0u, world_layer_gid(0, 1, 1));
+    TEST_ASSERT_EQUAL_INT(WORLD_TILE_VOID, world_tile_at(1, 1));
+
+    chunk_log_t log = {0};
+    stream_to(chunk_center_px(0, 0), &log);
+
+    // Active radius 1 around chunk (0,0), clipped to the map.
+    TEST_ASSERT_EQUAL_INT(4, log.activated);
+    TEST_ASSERT_EQUAL_INT(0, log.deactivated);
+
+    for (int y = 0; y < 2 * WORLD_CHUNK_TILES; y += 3) {
+        for (int x = 0; x < 2 * WORLD_CHUNK_TILES; x += 3) {
+            TEST_ASSERT_EQUAL_UINT32(pattern_gid(x, y), world_layer_gid(0, x, y));
+            TEST_ASSERT_EQUAL_INT(pattern_gid(x, y) == 1u ? WORLD_TILE_SOLID : WORLD_TILE_WALKABLE, world_tile_at(x, y));
+        }
+    }
+
+    // Chunk (7,2) is beyond the prefetch radius.
+    TEST_ASSERT_EQUAL_UINT32(0u, world_layer_gid(0, 7 * WORLD_CHUNK_TILES + 1, 2 * WORLD_CHUNK_TILES + 1));
+    TEST_ASSERT_TRUE(world_stream_resident_chunks() <= (size_t)((2 * WORLD_STREAM_PREFETCH_RADIUS + 1) * (2 * WORLD_STREAM_PREFETCH_RADIUS + 1)));
+}
+
+void test_world_stream_moving_focus_swaps_active_chunks(void)
+{
+    TEST_ASSERT_TRUE(load_streamed(false));
+
+    chunk_log_t log = {0};
+    stream_to(chunk_center_px(0, 0), &log);
+    log = (chunk_log_t){0};
+
+    stream_to(chunk_center_px(7, 1), &log);
+    TEST_ASSERT_EQUAL_INT(4, log.deactivated);
+    TEST_ASSERT_EQUAL_INT(6, log.activated);
+
+    // Last activated chunk is clipped to the map's right/bottom edge.
+    TEST_ASSERT_EQUAL_INT(STREAM_MAP_W, log.last_tx1);
+    TEST_ASSERT_EQUAL_INT(STREAM_MAP_H, log.last_ty1);
+
+    TEST_ASSERT_EQUAL_UINT32(pattern_gid(250, 40), world_layer_gid(0, 250, 40));
+    // The origin chunk fell out of the keep radius and was dropped.
+    TEST_ASSERT_EQUAL_UINT32(0u, world_layer_gid(0, 1, 1));
+    TEST_ASSERT_EQUAL_INT(WORLD_TILE_VOID, world_tile_at(1, 1));
+}
+
+void test_world_stream_edits_survive_eviction(void)
+{
+    TEST_ASSERT_TRUE(load_streamed(false));
+
+    chunk_log_t log = {0};
+    stream_to(chunk_center_px(0, 0), &log);
+
+    TEST_ASSERT_EQUAL_UINT32(2u, world_layer_gid(0, 1, 1));
+    TEST_ASSERT_TRUE(world_set_tile_gid(0, 1, 1, 1u));
+    world_apply_tile_edits();
+    TEST_ASSERT_EQUAL_UINT32(1u, world_layer_gid(0, 1, 1));
+    TEST_ASSERT_EQUAL_INT(WORLD_TILE_SOLID, world_tile_at(1, 1));
+
+    stream_to(chunk_center_px(7, 1), &log);
+    TEST_ASSERT_EQUAL_UINT32(0u, world_layer_gid(0, 1, 1));
+
+    stream_to(chunk_center_px(0, 0), &log);
+    TEST_ASSERT_EQUAL_UINT32(1u, world_layer_gid(0, 1, 1));
+    TEST_ASSERT_EQUAL_INT(WORLD_TILE_SOLID, world_tile_at(1, 1));
+    TEST_ASSERT_EQUAL_UINT32(pattern_gid(2, 1), world_layer_gid(0, 2, 1));
+}
+
+void test_world_stream_places_infinite_map_chunks(void)
+{
+    TEST_ASSERT_TRUE(load_streamed(true));
+    TEST_ASSERT_TRUE(world_stream_active());
+
+    chunk_log_t log = {0};
+    stream_to(chunk_center_px(0, 0), &log);
+
+    TEST_ASSERT_EQUAL_UINT32(0u, world_layer_gid(0, 15, 0));
+    TEST_ASSERT_EQUAL_UINT32(1u, world_layer_gid(0, 16, 0));
+    TEST_ASSERT_EQUAL_UINT32(1u, world_layer_gid(0, 31, 15));
+    TEST_ASSERT_EQUAL_UINT32(0u, world_layer_gid(0, 16, 16));
+    TEST_ASSERT_EQUAL_UINT32(2u, world_layer_gid(0, 32, 48));
+    TEST_ASSERT_EQUAL_UINT32(2u, world_layer_gid(0, 47, 63));
+    TEST_ASSERT_EQUAL_UINT32(0u, world_layer_gid(0, 48, 48));
+    TEST_ASSERT_EQUAL_INT(WORLD_TILE_SOLID, world_tile_at(20, 4));
+}
+
+void test_world_stream_door_resolves_once_its_chunk_is_resident(void)
+{
+    TEST_ASSERT_TRUE(load_streamed(false));
+    const door_tile_xy_t tile = { 1, 1 };
+    world_door_handle_t door = world_door_register(&tile, 1);
+    TEST_ASSERT_NOT_EQUAL(WORLD_DOOR_INVALID_HANDLE, door);
+
+    // Nothing resident yet: the tile reads as a hole, so there's nothing to resolve or write.
+    TEST_ASSERT_FALSE(world_tile_resident(1, 1));
+    TEST_ASSERT_EQUAL_INT(0, world_door_primary_animation_duration(door));
+
+    chunk_log_t log = {0};
+    stream_to(chunk_center_px(0, 0), &log);
+    TEST_ASSERT_TRUE(world_tile_resident(1, 1));
+    TEST_ASSERT_EQUAL_INT(200, world_door_primary_animation_duration(door));
+
+    world_door_apply_state(door, 150.0f, true);
+    world_apply_tile_edits();
+    TEST_ASSERT_EQUAL_UINT32(1u, world_layer_gid(0, 1, 1));
+
+    world_door_unregister(door);
+}